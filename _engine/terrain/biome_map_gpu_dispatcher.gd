@@ -12,6 +12,8 @@ var _total_compute_time_us: int = 0
 var _compute_call_count: int = 0
 
 const CHUNK_SIZE: int = 32
+const SDF_BATCH_SLOTS: int = 32  # Must match MAX_BATCH_CHUNKS in biome_gpu_sdf.compute
+const PUSH_CONSTANT_SIZE: int = 80  # Must match the Params block of biome_gpu_sdf.compute
 
 func _init() -> void:
 	print_rich("[color=cyan][BiomeMapGPUDispatcher] Initializing GPU dispatcher...[/color]")
@@ -113,36 +115,93 @@ func generate_chunk_sdf(chunk_origin: Vector3i, world_seed: int) -> Dictionary:
 	uniform_biome.binding = 0
 	uniform_biome.add_id(_biome_map_texture)
 	
+	# The SDF shader is batched: image bindings are arrays of SDF_BATCH_SLOTS textures.
+	# This dispatcher generates one chunk at a time, so every slot points at the same texture.
 	var uniform_sdf := RDUniform.new()
 	uniform_sdf.uniform_type = RenderingDevice.UNIFORM_TYPE_IMAGE
 	uniform_sdf.binding = 1
-	uniform_sdf.add_id(sdf_texture)
+	for i in range(SDF_BATCH_SLOTS):
+		uniform_sdf.add_id(sdf_texture)
 	
 	var uniform_material := RDUniform.new()
 	uniform_material.uniform_type = RenderingDevice.UNIFORM_TYPE_IMAGE
 	uniform_material.binding = 2
-	uniform_material.add_id(material_texture)
+	for i in range(SDF_BATCH_SLOTS):
+		uniform_material.add_id(material_texture)
 	
-	var uniform_set := _rd.uniform_set_create([uniform_biome, uniform_sdf, uniform_material], _shader, 0)
+	# w = world units per voxel: this dispatcher only generates LOD 0
+	var origin_data := PackedFloat32Array([chunk_origin.x, chunk_origin.y, chunk_origin.z, 1.0]).to_byte_array()
+	var origin_buffer := _rd.storage_buffer_create(origin_data.size(), origin_data)
 	
-	var push_constant := PackedFloat32Array([
-		chunk_origin.x, chunk_origin.y, chunk_origin.z,
-		16000.0,
-		0.0,
-		0.2,
-		CHUNK_SIZE,
-		float(world_seed)
-	])
+	var uniform_origins := RDUniform.new()
+	uniform_origins.uniform_type = RenderingDevice.UNIFORM_TYPE_STORAGE_BUFFER
+	uniform_origins.binding = 3
+	uniform_origins.add_id(origin_buffer)
+	
+	# Per-chunk SDF/material min-max summary (min slots start at 0xFFFFFFFF, max slots at 0)
+	var summary_data := PackedByteArray()
+	summary_data.resize(16)
+	summary_data.encode_u32(0, 0xFFFFFFFF)
+	summary_data.encode_u32(4, 0)
+	summary_data.encode_u32(8, 0xFFFFFFFF)
+	summary_data.encode_u32(12, 0)
+	var summary_buffer := _rd.storage_buffer_create(summary_data.size(), summary_data)
+	
+	var uniform_summary := RDUniform.new()
+	uniform_summary.uniform_type = RenderingDevice.UNIFORM_TYPE_STORAGE_BUFFER
+	uniform_summary.binding = 4
+	uniform_summary.add_id(summary_buffer)
+	
+	# Page table of the virtual biome map; unused with a full map (biome_tiled = 0), one empty entry
+	var page_data := PackedByteArray()
+	page_data.resize(16)
+	var page_buffer := _rd.storage_buffer_create(page_data.size(), page_data)
+	
+	var uniform_pages := RDUniform.new()
+	uniform_pages.uniform_type = RenderingDevice.UNIFORM_TYPE_STORAGE_BUFFER
+	uniform_pages.binding = 5
+	uniform_pages.add_id(page_buffer)
+	
+	var uniform_set := _rd.uniform_set_create([uniform_biome, uniform_sdf, uniform_material, uniform_origins, uniform_summary, uniform_pages], _shader, 0)
+	
+	# Params: world_size, sea_level, blend_dist, chunk_size (int), seed (uint), chunk_count (int),
+	# biome_tiled (int), biome_texel_size, then biome_map.compute's hash inputs (only read when tiled),
+	# then the ore and cave fields at NativeTerrainGenerator's defaults (iron veins, no caves)
+	var push_constant := PackedByteArray()
+	push_constant.resize(PUSH_CONSTANT_SIZE)
+	push_constant.encode_float(0, 16000.0)
+	push_constant.encode_float(4, 0.0)
+	push_constant.encode_float(8, 0.2)
+	push_constant.encode_s32(12, CHUNK_SIZE)
+	push_constant.encode_u32(16, world_seed)
+	push_constant.encode_s32(20, 1)
+	push_constant.encode_s32(24, 0)  # biome_tiled: the full map from set_biome_map_texture()
+	push_constant.encode_float(28, 0.0)
+	push_constant.encode_s32(32, 0)
+	push_constant.encode_float(36, 0.0)
+	push_constant.encode_float(40, 0.0)
+	push_constant.encode_u32(44, 0)
+	push_constant.encode_float(48, 0.07)  # ore_frequency
+	push_constant.encode_float(52, 0.6)  # ore_threshold
+	push_constant.encode_float(56, 10.0)  # ore_min_depth
+	push_constant.encode_u32(60, 3)  # ore_material: MAT_IRON_ORE
+	push_constant.encode_s32(64, 0)  # caves_enabled
+	push_constant.encode_float(68, 0.02)  # cave_frequency
+	push_constant.encode_float(72, 0.35)  # cave_threshold
+	push_constant.encode_float(76, 8.0)  # cave_min_depth
 	
 	var start_time := Time.get_ticks_usec()
 	var compute_list := _rd.compute_list_begin()
 	_rd.compute_list_bind_compute_pipeline(compute_list, _pipeline)
 	_rd.compute_list_bind_uniform_set(compute_list, uniform_set, 0)
-	_rd.compute_list_set_push_constant(compute_list, push_constant.to_byte_array(), push_constant.size() * 4)
+	_rd.compute_list_set_push_constant(compute_list, push_constant, push_constant.size())
 	_rd.compute_list_dispatch(compute_list, 8, 8, 8)
 	_rd.compute_list_end()
 	_rd.submit()
 	_rd.sync()
+	_rd.free_rid(origin_buffer)
+	_rd.free_rid(summary_buffer)
+	_rd.free_rid(page_buffer)
 	
 	var end_time := Time.get_ticks_usec()
 	_last_compute_time_us = end_time - start_time
@@ -116,9 +116,9 @@ func generate_placements(
 	if not biome_map_texture.is_valid():
 		return []
 	
-	# Create output buffer (std430 vec3 aligns to 16 bytes -> stride 48 per PlacementData)
+	# Create output buffer (std430 vec3 aligns to 16 bytes -> 16-byte header, stride 48 per PlacementData)
 	var buffer_bytes := PackedByteArray()
-	buffer_bytes.resize(4 + MAX_PLACEMENTS * 48)
+	buffer_bytes.resize(16 + MAX_PLACEMENTS * 48)
 	var buffer := _rd.storage_buffer_create(buffer_bytes.size(), buffer_bytes)
 	
 	var uniform_sdf := RDUniform.new()
@@ -187,7 +187,7 @@ func generate_placements(
 	var placement_count := data.decode_u32(0)
 	placement_count = min(placement_count, MAX_PLACEMENTS)
 	
-	var cursor := 4
+	var cursor := 16
 	for _i in range(placement_count):
 		if cursor + 48 > data.size():
 			break
@@ -206,7 +206,7 @@ func generate_placements(
 		var rot_y := data.decode_float(cursor); cursor += 4
 		
 		# Skip potential padding to align next struct
-		cursor = 4 + (_i + 1) * 48
+		cursor = 16 + (_i + 1) * 48
 		
 		placements.append({
 			"position": Vector3(pos_x, pos_y, pos_z),
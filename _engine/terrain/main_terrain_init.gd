@@ -81,6 +81,11 @@ func _process(delta: float) -> void:
 	if _player and _gpu_generator.has_method("set_player_position"):
 		_gpu_generator.set_player_position(_player.global_position)
 	
+	# Chunks in front of the camera are scheduled before those behind it
+	var camera := get_viewport().get_camera_3d()
+	if camera and _gpu_generator.has_method("set_view_direction"):
+		_gpu_generator.set_view_direction(-camera.global_transform.basis.z)
+	
 	# Drive async chunk queue processing
 	if _gpu_generator.has_method("process_chunk_queue"):
 		_gpu_generator.process_chunk_queue(delta)
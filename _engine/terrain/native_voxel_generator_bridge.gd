@@ -52,3 +52,17 @@ func get_gpu_status() -> String:
 func set_player_position(position: Vector3) -> void:
 	if native_generator:
 		native_generator.set_player_position(position)
+
+func set_view_direction(direction: Vector3) -> void:
+	if native_generator:
+		native_generator.set_view_direction(direction)
+
+func cancel_chunk_request(origin: Vector3i, lod: int = 0) -> bool:
+	if native_generator:
+		return native_generator.cancel_chunk_request(origin, lod)
+	return false
+
+func sample_surface(positions: PackedVector2Array, include_height: bool = true) -> Dictionary:
+	if native_generator:
+		return native_generator.sample_surface(positions, include_height)
+	return {}
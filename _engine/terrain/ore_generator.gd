@@ -4,6 +4,9 @@ class_name OreGenerator
 
 ## Ore Generator - Wraps base terrain generator and adds 3D ore vein noise
 ## Writes terrain shape to SDF channel and material IDs to INDICES channel with weights
+## With use_native_pipeline set and the native extension loaded, blocks come from NativeTerrainGenerator
+## instead: ore veins (and optionally caves) are evaluated in the same SDF pass, with no per-voxel script loop.
+## Note the native path generates the biome terrain, not basic_generator.tres.
 
 # Ore generation parameters
 @export var ore_frequency: float = 0.02:
@@ -11,9 +14,27 @@ class_name OreGenerator
 		ore_frequency = value
 		if _ore_noise:
 			_ore_noise.frequency = ore_frequency
-@export var ore_threshold: float = 0.6
-@export var ore_material_id: int = 3
-@export var min_ore_depth: float = 5.0
+		_configure_native_generator()
+@export var ore_threshold: float = 0.6:
+	set(value):
+		ore_threshold = value
+		_configure_native_generator()
+@export var ore_material_id: int = 3:
+	set(value):
+		ore_material_id = value
+		_configure_native_generator()
+@export var min_ore_depth: float = 5.0:
+	set(value):
+		min_ore_depth = value
+		_configure_native_generator()
+
+# Native pipeline (NativeTerrainGenerator), used when the extension is loaded. Opt-in: it generates
+# the biome terrain instead of basic_generator.tres, and its generator sets up the GPU on creation.
+@export var use_native_pipeline: bool = false
+@export var caves_enabled: bool = false:
+	set(value):
+		caves_enabled = value
+		_configure_native_generator()
 
 # Material IDs
 const MAT_AIR: int = 0
@@ -30,6 +51,10 @@ var _base_generator: VoxelGeneratorNoise
 # Ore vein noise
 var _ore_noise: FastNoiseLite
 
+# NativeTerrainGenerator, created by the first native block; null until then or without the extension
+var _native_generator: Object
+var _native_mutex: Mutex = Mutex.new()
+
 
 func _init() -> void:
 	# Load the base terrain generator
@@ -46,6 +71,34 @@ func _init() -> void:
 	_ore_noise.fractal_gain = 0.5
 
 
+## The native generator, created on first use (blocks run on worker threads, hence the lock).
+## Instantiated by name so the script still parses without the extension; null without it.
+func _get_native_generator() -> Object:
+	_native_mutex.lock()
+	if not _native_generator and ClassDB.class_exists("NativeTerrainGenerator"):
+		_native_generator = ClassDB.instantiate("NativeTerrainGenerator")
+		_configure_native_generator()
+	var native_generator := _native_generator
+	_native_mutex.unlock()
+	return native_generator
+
+
+## Applies the ore exports to the native generator (on change, not per block: blocks run on worker threads).
+## Thresholds map from the normalized 0-1 noise used here to the native fbm's signed range,
+## and depths are measured from the surface instead of below the dirt layer. A change drops the native
+## generator's cached chunks, so blocks generated afterwards use the new settings. No-op before the first
+## native block; creating the generator applies them.
+func _configure_native_generator() -> void:
+	_native_mutex.lock()
+	if _native_generator:
+		_native_generator.ore_frequency = ore_frequency
+		_native_generator.ore_threshold = ore_threshold * 2.0 - 1.0
+		_native_generator.ore_min_depth = min_ore_depth + DIRT_LAYER_THICKNESS
+		_native_generator.ore_material_id = ore_material_id
+		_native_generator.caves_enabled = caves_enabled
+	_native_mutex.unlock()
+
+
 func _get_used_channels_mask() -> int:
 	# We write to SDF (terrain shape) and INDICES (material IDs)
 	# Single texture mode uses 8-bit INDICES channel
@@ -53,6 +106,12 @@ func _get_used_channels_mask() -> int:
 
 
 func _generate_block(out_buffer: VoxelBuffer, origin: Vector3i, lod: int) -> void:
+	if use_native_pipeline:
+		var native_generator := _get_native_generator()
+		if native_generator:
+			native_generator.generate_block(out_buffer, origin, lod)
+			return
+	
 	var block_size := out_buffer.get_size()
 	var lod_scale := 1 << lod
 	
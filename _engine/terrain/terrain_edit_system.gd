@@ -8,6 +8,7 @@
 ##
 ## Signals:
 ##   terrain_edited(position, volume, material_id) - Emitted after successful edit
+##   region_edited(region, operation) - World-space bounds of the same edit
 ##
 ## Notes:
 ##   - Material data (INDICES channel) is automatically preserved by keeping
@@ -22,6 +23,12 @@ extends Node
 ## @param operation: Operation type (SUBTRACT, ADD, SMOOTH)
 signal terrain_edited(position: Vector3, volume: float, material_id: int, operation: Operation)
 
+## Emitted after terrain_edited with the world-space bounds the brush could have changed,
+## for systems that cache per-chunk data derived from the terrain (vegetation placements)
+## @param region: Brush bounds, padded by one voxel
+## @param operation: Operation type (SUBTRACT, ADD, SMOOTH)
+signal region_edited(region: AABB, operation: Operation)
+
 ## Brush shape types for terrain editing
 enum BrushType {
 	SPHERE,   ## Spherical brush - smooth, natural-looking edits
@@ -285,8 +292,12 @@ func _execute_brush(position: Vector3, brush_type: BrushType, operation: Operati
 	# Calculate approximate volume for signal
 	var volume: float = _calculate_brush_volume(brush_type, radius)
 	
+	# Cached GPU chunk textures get the same edit before anything samples them again
+	_apply_native_edit(position, brush_type, operation, radius)
+	
 	# Emit signal for MiningSystem integration (includes operation type)
 	terrain_edited.emit(position, volume, material_id, operation)
+	region_edited.emit(_calculate_brush_bounds(brush_type, position, radius), operation)
 	
 	# Debug visualization
 	if enable_debug_visualization:
@@ -344,6 +355,21 @@ func _apply_box_brush(center: Vector3, operation: Operation, radius: float, stre
 	_voxel_tool.mode = VoxelTool.MODE_REMOVE
 
 
+func _apply_native_edit(position: Vector3, brush_type: BrushType, operation: Operation, radius: float) -> void:
+	var generator = _terrain.generator if _terrain else null
+	if generator and generator.has_method("apply_sdf_edit"):
+		generator.apply_sdf_edit(position, radius, brush_type, operation)
+
+
+func _calculate_brush_bounds(brush_type: BrushType, center: Vector3, radius: float) -> AABB:
+	# Matches the shapes above; one voxel of padding for meshing/sampling footprints
+	var half_extent := Vector3.ONE * radius
+	if brush_type == BrushType.CAPSULE:
+		half_extent = Vector3(radius * 0.8, radius * 1.8, radius * 0.8)
+	half_extent += Vector3.ONE
+	return AABB(center - half_extent, half_extent * 2.0)
+
+
 func _calculate_brush_volume(brush_type: BrushType, radius: float) -> float:
 	match brush_type:
 		BrushType.SPHERE:
@@ -6,6 +6,8 @@ class_name TerrainPrewarmer
 ## Used by WorldInitManager to ensure terrain is ready before player spawns.
 
 const CHUNK_SIZE: int = 32
+## Radius multiplier per LOD for NativeTerrainGenerator.prewarm_region()
+const NATIVE_LOD_PROFILE: Array[float] = [1.0, 2.0]
 
 ## DEPRECATED: Use signal-based chunk tracking instead.
 ## This function forces synchronous generation and blocks the main thread.
@@ -70,6 +72,46 @@ static func prewarm_area_async(terrain: VoxelLodTerrain, center: Vector3, radius
 	print("[TerrainPrewarmer] Viewer positioned at %s - terrain will generate automatically" % center)
 	progress_callback.call(0.0)
 
+	# With the native generator, the whole region is generated up front in GPU batches, so the
+	# viewer's blocks come out of its cache instead of one round trip per block
+	var native := _get_native_generator(terrain)
+	if native:
+		var radius := (radius_chunks + 0.5) * CHUNK_SIZE
+		var scheduled: int = native.prewarm_region(center, radius, PackedFloat32Array(NATIVE_LOD_PROFILE))
+		if scheduled > 0:
+			print("[TerrainPrewarmer] Native prewarm: %d chunks around %s" % [scheduled, center])
+			_track_native_prewarm(terrain, native, progress_callback, complete_callback)
+
+
+static func _get_native_generator(terrain: VoxelLodTerrain) -> Object:
+	var generator = terrain.generator
+	if not generator:
+		return null
+	if generator.has_method("prewarm_region"):
+		return generator
+	# NativeVoxelGeneratorBridge
+	var native = generator.get("native_generator")
+	if native and native.has_method("prewarm_region"):
+		return native
+	return null
+
+
+static func _track_native_prewarm(terrain: VoxelLodTerrain, native: Object, progress_callback: Callable, complete_callback: Callable) -> void:
+	var tree := terrain.get_tree()
+	# The generator reports progress when polled; poll every frame until it completes
+	var poll := func() -> void:
+		native.poll_prewarm()
+	var on_progress := func(completed: int, total: int) -> void:
+		progress_callback.call(float(completed) / float(max(total, 1)))
+	var on_completed := func(total: int, failed: int, elapsed_ms: float) -> void:
+		tree.process_frame.disconnect(poll)
+		native.prewarm_progress.disconnect(on_progress)
+		print("[TerrainPrewarmer] Native prewarm finished: %d chunks (%d failed) in %.0f ms" % [total, failed, elapsed_ms])
+		complete_callback.call()
+	tree.process_frame.connect(poll)
+	native.prewarm_progress.connect(on_progress)
+	native.prewarm_completed.connect(on_completed, CONNECT_ONE_SHOT)
+
 
 static func _get_or_create_viewer(terrain: VoxelLodTerrain, position: Vector3) -> Node3D:
 	var players := terrain.get_tree().get_nodes_in_group("player")
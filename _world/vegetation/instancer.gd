@@ -30,6 +30,19 @@ const VISIBILITY_RANGES: Dictionary = {
 
 const MAX_GRASS_DENSITY: float = 0.15
 
+# GPU culling (NativeVegetationCuller): LOD levels per mesh, drawn from the generator's LOD meshes.
+# The last level is the coarsest and stands in for impostors out to the visibility range.
+const CULL_LOD_LEVELS: int = 3
+
+# Share of instances left at the visibility range; thinning starts at half of it
+const CULL_MIN_DENSITY: Dictionary = {
+	VegetationManager.VegetationType.TREE: 1.0,
+	VegetationManager.VegetationType.BUSH: 0.5,
+	VegetationManager.VegetationType.ROCK_SMALL: 0.5,
+	VegetationManager.VegetationType.ROCK_MEDIUM: 1.0,
+	VegetationManager.VegetationType.GRASS_TUFT: 0.2
+}
+
 # =============================================================================
 # EXPORTS
 # =============================================================================
@@ -75,6 +88,12 @@ var _debug_last_placements: Dictionary = {}
 var _biome_query_counts: Dictionary = {}
 var _terrain_dispatcher_wired: bool = false
 var _terrain_dispatcher: BiomeMapGPUDispatcher
+var _edit_refresh_chunks: Dictionary = {}  # Vector3i -> Array of veg types re-placed after a terrain edit
+
+# GPU-culled rendering of the GPU placement path; null without the extension or a RenderingDevice
+var _culler: RefCounted
+var _cull_buckets: Dictionary = {}  # "type_variant" -> {"bucket": int, "type": int, "instances": Array}
+var _culled_chunks: Dictionary = {}  # Vector3i -> instance count handed to the culler
 
 # =============================================================================
 # INITIALIZATION
@@ -100,12 +119,14 @@ func _ready() -> void:
 	
 	# Setup MultiMesh instances
 	_setup_multimesh_instances()
+	_setup_culler()
 	
 	# Find player
 	call_deferred("_find_player")
 	
 	# Connect to terrain signals if available
 	call_deferred("_connect_terrain_signals")
+	call_deferred("_connect_edit_signals")
 	
 	# Retry connection after 1s if first attempt fails
 	get_tree().create_timer(1.0).timeout.connect(func ():
@@ -182,6 +203,69 @@ func _setup_multimesh_instances() -> void:
 			_multimesh_instances[veg_type][variant_name] = mmi
 
 
+func _setup_culler() -> void:
+	if not ClassDB.class_exists("NativeVegetationCuller") or RenderingServer.get_rendering_device() == null:
+		return
+	var culler: RefCounted = ClassDB.instantiate("NativeVegetationCuller")
+	if culler and culler.initialize():
+		_culler = culler
+		if debug_logging:
+			print("[VegetationInstancer] GPU culling enabled")
+
+
+## Culler bucket for a type+variant; its LOD MultiMeshes are created from the generator's LOD meshes
+## on first use. Returns -1 when GPU culling is unavailable.
+func _get_cull_bucket(veg_type: int, biome_id: int, variant: String) -> int:
+	if _culler == null:
+		return -1
+	var key := "%d_%s" % [veg_type, variant]
+	if _cull_buckets.has(key):
+		return _cull_buckets[key]["bucket"]
+	
+	var vis_range: float = VISIBILITY_RANGES.get(veg_type, 256.0)
+	var lod_ends := PackedFloat32Array()
+	for distance: float in LOD_DISTANCES:
+		if distance < vis_range and lod_ends.size() < CULL_LOD_LEVELS - 1:
+			lod_ends.append(distance)
+	lod_ends.append(vis_range)
+	
+	var multimeshes: Array = []
+	var instances: Array = []
+	for level in range(lod_ends.size()):
+		var mesh := VegetationManager.get_mesh_for_type(veg_type, biome_id, variant, 0, level)
+		if mesh == null:
+			for mmi: MultiMeshInstance3D in instances:
+				mmi.queue_free()
+			return -1
+		var mm := MultiMesh.new()
+		mm.transform_format = MultiMesh.TRANSFORM_3D
+		mm.mesh = mesh
+		var mmi := MultiMeshInstance3D.new()
+		mmi.name = "VegetationCull_%d_%s_lod%d" % [veg_type, variant, level]
+		mmi.multimesh = mm
+		mmi.cast_shadow = GeometryInstance3D.SHADOW_CASTING_SETTING_OFF if veg_type == VegetationManager.VegetationType.GRASS_TUFT else GeometryInstance3D.SHADOW_CASTING_SETTING_ON
+		add_child(mmi)
+		multimeshes.append(mm)
+		instances.append(mmi)
+	
+	# Sphere around the mesh origin containing the finest mesh, at scale 1
+	var aabb: AABB = multimeshes[0].mesh.get_aabb()
+	var extent := aabb.position.abs().max(aabb.end.abs())
+	var variant_count := maxi(_multimesh_instances.get(veg_type, {}).size(), 1)
+	var capacity := int(_get_max_instances_for_type(veg_type) / variant_count)
+	var bucket: int = _culler.create_bucket(multimeshes, lod_ends, capacity, extent.length(),
+		vis_range * 0.5, CULL_MIN_DENSITY.get(veg_type, 1.0))
+	if bucket < 0:
+		for mmi: MultiMeshInstance3D in instances:
+			mmi.queue_free()
+		return -1
+	
+	for mmi: MultiMeshInstance3D in instances:
+		mmi.visible = enabled
+	_cull_buckets[key] = {"bucket": bucket, "type": veg_type, "instances": instances}
+	return bucket
+
+
 func _get_max_instances_for_type(veg_type: int) -> int:
 	match veg_type:
 		VegetationManager.VegetationType.TREE:
@@ -247,6 +331,12 @@ func _connect_terrain_signals() -> void:
 		print("[VegetationInstancer] Connection attempt #%d -> verified=%s" % [_connection_attempts, str(_connection_verified)])
 
 
+func _connect_edit_signals() -> void:
+	var edit_system = get_node_or_null("/root/TerrainEditSystem")
+	if edit_system and edit_system.has_signal("region_edited") and not edit_system.region_edited.is_connected(_on_region_edited):
+		edit_system.region_edited.connect(_on_region_edited)
+
+
 func _verify_signal_connection() -> bool:
 	if not _terrain or not _terrain.generator:
 		if debug_logging:
@@ -275,6 +365,10 @@ func _process(delta: float) -> void:
 	
 	# Process pending chunks
 	_process_pending_chunks()
+	_process_edit_refreshes()
+	
+	if _culler and not _cull_buckets.is_empty():
+		_culler.cull(get_viewport().get_camera_3d())
 
 
 func _update_streaming() -> void:
@@ -331,6 +425,64 @@ func _process_pending_chunks() -> void:
 	_is_processing = false
 
 
+# =============================================================================
+# TERRAIN EDITS
+# =============================================================================
+
+## Re-places only the (chunk, type) pairs an edit touched. The native dispatcher keeps serving the
+## old placements while the new ones are computed, so the chunk is rebuilt once, when they are ready.
+func _on_region_edited(region: AABB, _operation: int) -> void:
+	var gpu_dispatcher = get_gpu_dispatcher()
+	if gpu_dispatcher == null or not gpu_dispatcher.has_method("invalidate_region"):
+		return
+	
+	# Vegetation chunks are XZ columns at y = 0: match the edit over the whole column
+	var column := AABB(Vector3(region.position.x, 0.0, region.position.z), Vector3(region.size.x, CHUNK_SIZE, region.size.z))
+	var touched: Array = gpu_dispatcher.invalidate_region(column)
+	for pair: Dictionary in touched:
+		var chunk: Vector3i = pair["chunk_origin"]
+		if not _populated_chunks.has(chunk):
+			continue
+		var types: Array = _edit_refresh_chunks.get(chunk, [])
+		if not pair["veg_type"] in types:
+			types.append(pair["veg_type"])
+		_edit_refresh_chunks[chunk] = types
+	
+	if debug_logging and not touched.is_empty():
+		print("[VegetationInstancer] Terrain edit touched %d placement entries in %d chunks" % [touched.size(), _edit_refresh_chunks.size()])
+
+
+func _process_edit_refreshes() -> void:
+	if _edit_refresh_chunks.is_empty():
+		return
+	
+	var gpu_dispatcher = get_gpu_dispatcher()
+	if gpu_dispatcher == null:
+		_edit_refresh_chunks.clear()
+		return
+	
+	var refreshed: Array[Vector3i] = []
+	for chunk: Vector3i in _edit_refresh_chunks.keys():
+		var still_pending := false
+		for veg_type: int in _edit_refresh_chunks[chunk]:
+			if gpu_dispatcher.is_request_pending(chunk, veg_type):
+				still_pending = true
+				break
+		if not still_pending:
+			refreshed.append(chunk)
+	
+	for chunk: Vector3i in refreshed:
+		_edit_refresh_chunks.erase(chunk)
+		if not _populated_chunks.has(chunk):
+			continue
+		# Rebuilt from the refreshed cache entries; keep the biome captured at generation
+		var biome_id: int = int(_chunk_biomes.get(chunk, -1))
+		_unload_chunk(chunk)
+		if biome_id != -1:
+			_chunk_biomes[chunk] = biome_id
+		_populate_chunk(chunk)
+
+
 # =============================================================================
 # CHUNK POPULATION
 # =============================================================================
@@ -455,90 +607,75 @@ func _populate_chunk(chunk_origin: Vector3i) -> void:
 				var variant: String = variants[0] if not variants.is_empty() else "default"
 				var type_variants: Dictionary = _multimesh_instances.get(veg_type, {})
 				var mmi: MultiMeshInstance3D = type_variants.get(variant)
+				var cull_bucket := _get_cull_bucket(veg_type, biome_id, variant)
 				
-				if mmi and mmi.multimesh:
-					var mm := mmi.multimesh
-					
-					# Set mesh if not already set
-					if mm.mesh == null:
-						var mesh := VegetationManager.get_mesh_for_type(veg_type, biome_id, variant, 0, 0)
-						if mesh:
-							mm.mesh = mesh
-					
-					# Ensure MultiMesh has enough capacity
-					var current_visible := mm.visible_instance_count
-					var required_capacity := current_visible + placement_count
-					if required_capacity > mm.instance_count:
-						mm.instance_count = required_capacity * 2
-					
+				if cull_bucket >= 0 or (mmi and mmi.multimesh):
 					# Interim solution: CPU loop to read transform buffer and populate MultiMesh
 					# This minimizes readback to only transform data (no placement data)
-					var rd := RenderingServer.get_rendering_device()
-					if not rd:
-						push_warning("[VegetationInstancer] RenderingDevice not available for GPU path")
+					var transform_floats := PackedFloat32Array()
+					if gpu_dispatcher.has_method("get_multimesh_buffer"):
+						# Native dispatcher: flat 3x4 matrices, read back on the thread that owns its device
+						transform_floats = gpu_dispatcher.get_multimesh_buffer(chunk_origin, veg_type)
+					else:
+						var rd := RenderingServer.get_rendering_device()
+						if not rd:
+							push_warning("[VegetationInstancer] RenderingDevice not available for GPU path")
+							gpu_failed = true
+							break
+						transform_floats = rd.buffer_get_data(transform_buffer_rid).to_float32_array()
+					var float_count := placement_count * 12
+					
+					if transform_floats.size() < float_count:
+						push_warning("[VegetationInstancer] Transform buffer size mismatch: expected %d floats, got %d" % [float_count, transform_floats.size()])
 						gpu_failed = true
 						break
 					
-					var transform_data: PackedByteArray = rd.buffer_get_data(transform_buffer_rid)
-					var float_count := placement_count * 12
-					
-					if transform_data.size() >= float_count * 4:
-							var base_index := current_visible
-							
-							# Track instances for chunk unloading
-							if not _chunk_instance_indices.has(chunk_origin):
-								_chunk_instance_indices[chunk_origin] = []
-							
-							for i in range(placement_count):
-								var offset := i * 12 * 4  # 12 floats * 4 bytes per float
-								
-								# Decode 3x4 transform matrix from buffer
-								var basis_x := Vector3(
-									transform_data.decode_float(offset + 0),
-									transform_data.decode_float(offset + 4),
-									transform_data.decode_float(offset + 8)
-								)
-								var basis_y := Vector3(
-									transform_data.decode_float(offset + 16),
-									transform_data.decode_float(offset + 20),
-									transform_data.decode_float(offset + 24)
-								)
-								var basis_z := Vector3(
-									transform_data.decode_float(offset + 32),
-									transform_data.decode_float(offset + 36),
-									transform_data.decode_float(offset + 40)
-								)
-								var origin := Vector3(
-									transform_data.decode_float(offset + 12),
-									transform_data.decode_float(offset + 28),
-									transform_data.decode_float(offset + 44)
-								)
-								
-								var transform := Transform3D(
-									Basis(basis_x, basis_y, basis_z),
-									origin
-								)
-								
-								mm.set_instance_transform(base_index + i, transform)
-								
-								# Track instance for chunk unloading
-								_chunk_instance_indices[chunk_origin].append({
-									"type": veg_type,
-									"variant": variant,
-									"index": base_index + i
-								})
-								
-								# Register with VegetationManager
-								VegetationManager.register_instance_position(origin, chunk_origin, veg_type, transform)
+					if cull_bucket >= 0:
+						# Drawn by the culler: frustum, distance, LOD and density are decided on the GPU every frame
+						_culler.set_chunk(cull_bucket, chunk_origin, transform_floats.slice(0, float_count))
+						_culled_chunks[chunk_origin] = int(_culled_chunks.get(chunk_origin, 0)) + placement_count
+						for i in range(placement_count):
+							var transform := _decode_instance_transform(transform_floats, i * 12)
+							VegetationManager.register_instance_position(transform.origin, chunk_origin, veg_type, transform)
+					else:
+						var mm := mmi.multimesh
+						
+						# Set mesh if not already set
+						if mm.mesh == null:
+							var mesh := VegetationManager.get_mesh_for_type(veg_type, biome_id, variant, 0, 0)
+							if mesh:
+								mm.mesh = mesh
+						
+						# Ensure MultiMesh has enough capacity
+						var current_visible := mm.visible_instance_count
+						var required_capacity := current_visible + placement_count
+						if required_capacity > mm.instance_count:
+							mm.instance_count = required_capacity * 2
+						
+						var base_index := current_visible
+						
+						# Track instances for chunk unloading
+						if not _chunk_instance_indices.has(chunk_origin):
+							_chunk_instance_indices[chunk_origin] = []
+						
+						for i in range(placement_count):
+							var transform := _decode_instance_transform(transform_floats, i * 12)
+							mm.set_instance_transform(base_index + i, transform)
 							
-							mm.visible_instance_count = base_index + placement_count
+							# Track instance for chunk unloading
+							_chunk_instance_indices[chunk_origin].append({
+								"type": veg_type,
+								"variant": variant,
+								"index": base_index + i
+							})
 							
-							if debug_logging:
-								print("[VegetationInstancer] GPU path: chunk=%s type=%d variant=%s count=%d" % [chunk_origin, veg_type, variant, placement_count])
-					else:
-						push_warning("[VegetationInstancer] Transform buffer size mismatch: expected %d bytes, got %d" % [float_count * 4, transform_data.size()])
-						gpu_failed = true
-						break
+							# Register with VegetationManager
+							VegetationManager.register_instance_position(transform.origin, chunk_origin, veg_type, transform)
+						
+						mm.visible_instance_count = base_index + placement_count
+					
+					if debug_logging:
+						print("[VegetationInstancer] GPU path: chunk=%s type=%d variant=%s count=%d culled=%s" % [chunk_origin, veg_type, variant, placement_count, cull_bucket >= 0])
 	
 	# Fall back to CPU path if GPU path not used or failed
 	var placements: Array[Dictionary] = []
@@ -589,6 +726,15 @@ func _populate_chunk(chunk_origin: Vector3i) -> void:
 				print("[VegetationInstancer] Chunk %s populated: %s" % [chunk_origin, str(counts)])
 
 
+## 3x4 row-major transform at offset (MultiMesh TRANSFORM_3D layout)
+func _decode_instance_transform(transform_floats: PackedFloat32Array, offset: int) -> Transform3D:
+	var basis_x := Vector3(transform_floats[offset + 0], transform_floats[offset + 1], transform_floats[offset + 2])
+	var basis_y := Vector3(transform_floats[offset + 4], transform_floats[offset + 5], transform_floats[offset + 6])
+	var basis_z := Vector3(transform_floats[offset + 8], transform_floats[offset + 9], transform_floats[offset + 10])
+	var origin := Vector3(transform_floats[offset + 3], transform_floats[offset + 7], transform_floats[offset + 11])
+	return Transform3D(Basis(basis_x, basis_y, basis_z), origin)
+
+
 func _summarize_placements(placements: Array) -> Dictionary:
 	var summary := {
 		"total": placements.size(),
@@ -601,6 +747,10 @@ func _summarize_placements(placements: Array) -> Dictionary:
 
 
 func _unload_chunk(chunk_origin: Vector3i) -> void:
+	if _culler and _culled_chunks.has(chunk_origin):
+		_culler.remove_chunk_all(chunk_origin)
+		_culled_chunks.erase(chunk_origin)
+	
 	# Remove instances for this chunk from MultiMeshes
 	if not _chunk_instance_indices.has(chunk_origin):
 		_populated_chunks.erase(chunk_origin)
@@ -944,10 +1094,14 @@ func reload_vegetation() -> void:
 			var mmi: MultiMeshInstance3D = type_variants[variant]
 			if mmi and mmi.multimesh:
 				mmi.multimesh.visible_instance_count = 0
+	if _culler:
+		_culler.clear_chunks()
+	_culled_chunks.clear()
 	
 	# Clear tracking
 	_populated_chunks.clear()
 	_pending_chunks.clear()
+	_edit_refresh_chunks.clear()
 	_chunk_instance_indices.clear()
 	_terrain_ready_chunks.clear()
 	_deferred_chunks.clear()
@@ -973,6 +1127,7 @@ func trigger_test_signal(chunk_origin: Vector3i, biome_id: int) -> void:
 
 
 ## Get instance count for a vegetation type (sum of all variants)
+## GPU-culled instances count once each, whether or not they are drawn this frame.
 func get_instance_count(veg_type: int) -> int:
 	var type_variants: Dictionary = _multimesh_instances.get(veg_type, {})
 	var total := 0
@@ -980,9 +1135,18 @@ func get_instance_count(veg_type: int) -> int:
 		var mmi: MultiMeshInstance3D = type_variants[variant]
 		if mmi and mmi.multimesh:
 			total += mmi.multimesh.visible_instance_count
+	if _culler:
+		for cull_data: Dictionary in _cull_buckets.values():
+			if cull_data["type"] == veg_type:
+				total += _culler.get_bucket_instance_count(cull_data["bucket"])
 	return total
 
 
+## NativeVegetationCuller telemetry; empty when GPU culling is off
+func get_cull_telemetry() -> Dictionary:
+	return _culler.get_telemetry() if _culler else {}
+
+
 ## Get total instance count
 func get_total_instance_count() -> int:
 	var total := 0
@@ -998,6 +1162,10 @@ func set_type_visible(veg_type: int, vis: bool) -> void:
 		var mmi: MultiMeshInstance3D = type_variants[variant]
 		if mmi:
 			mmi.visible = vis
+	for cull_data: Dictionary in _cull_buckets.values():
+		if cull_data["type"] == veg_type:
+			for mmi: MultiMeshInstance3D in cull_data["instances"]:
+				mmi.visible = vis
 
 
 func _verify_vegetation_spawning() -> void:
@@ -1018,9 +1186,9 @@ func _verify_vegetation_spawning() -> void:
 	
 	for off in offsets:
 		var co: Vector3i = player_chunk + off
-		var count := 0
+		var count: int = _culled_chunks.get(co, 0)
 		if _chunk_instance_indices.has(co):
-			count = _chunk_instance_indices[co].size()
+			count += _chunk_instance_indices[co].size()
 		results.append("%s -> %d" % [co, count])
 	
 	print("[VegetationInstancer] Spawn verification around player: %s" % ", ".join(results))
@@ -1035,6 +1203,9 @@ func set_enabled(value: bool) -> void:
 			var mmi: MultiMeshInstance3D = type_variants[variant]
 			if mmi:
 				mmi.visible = value
+	for cull_data: Dictionary in _cull_buckets.values():
+		for mmi: MultiMeshInstance3D in cull_data["instances"]:
+			mmi.visible = value
 
 
 func _ensure_terrain_dispatcher() -> void:
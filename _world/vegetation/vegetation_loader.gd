@@ -8,11 +8,14 @@ const VegetationPositionData := preload("res://_world/vegetation/vegetation_posi
 ## ----------------
 ## Loads prebaked vegetation meshes and positions from user://veg_cache/{seed}
 ## and instantiates static MultiMeshInstance3D nodes. Replaces runtime chunk
-## streaming to eliminate CPU spikes during exploration.
+## streaming to eliminate CPU spikes during exploration. A native atlas
+## (VegetationPrebaker.ATLAS_FILE) is preferred: each MultiMesh buffer is
+## copied from the mapped file in one call instead of per-instance transforms.
 
 signal cache_missing(world_seed: int)
 
 const CACHE_ROOT: String = "user://veg_cache"
+const ATLAS_FILE: String = "vegetation.atlas"
 const VARIANTS_PER_TYPE: int = 32
 
 var _loaded_instances: Array[MultiMeshInstance3D] = []
@@ -30,6 +33,8 @@ func _ready() -> void:
 func load_vegetation(world_seed: int) -> void:
 	## Entry point to load all prebaked data for a seed.
 	_clear_loaded()
+	if _load_from_atlas(world_seed):
+		return
 	if not _check_cache_complete(world_seed):
 		cache_missing.emit(world_seed)
 		return
@@ -46,6 +51,56 @@ func load_vegetation(world_seed: int) -> void:
 			_create_multimesh_instances(biome_id, veg_type, data.get("meshes", []), data.get("positions", []))
 
 
+func _load_from_atlas(world_seed: int) -> bool:
+	## One MultiMesh per atlas group (biome, type, variant); false when there is no usable atlas.
+	var atlas_path := "%s/%d/%s" % [CACHE_ROOT, world_seed, ATLAS_FILE]
+	if not ClassDB.class_exists("NativeVegetationAtlas") or not FileAccess.file_exists(atlas_path):
+		return false
+	var atlas: Object = ClassDB.instantiate("NativeVegetationAtlas")
+	if not atlas.open(atlas_path) or atlas.get_world_seed() != world_seed:
+		push_warning("[VegetationLoader] Unreadable vegetation atlas for seed %d" % world_seed)
+		return false
+	
+	var meshes_by_group: Dictionary = {}
+	for group in atlas.get_groups():
+		var biome_id: int = group["biome"]
+		var veg_type: int = group["type"]
+		var mesh_key := Vector2i(biome_id, veg_type)
+		if not meshes_by_group.has(mesh_key):
+			meshes_by_group[mesh_key] = _load_biome_type_data(world_seed, biome_id, str(veg_type), false).get("meshes", [])
+		var meshes: Array = meshes_by_group[mesh_key]
+		var variant_idx: int = group["variant"]
+		if variant_idx >= meshes.size() or meshes[variant_idx] == null:
+			continue
+		_create_multimesh_from_buffer(biome_id, veg_type, variant_idx, meshes[variant_idx],
+			atlas.get_group_buffer(biome_id, veg_type, variant_idx))
+	atlas.close()
+	return true
+
+
+func _create_multimesh_from_buffer(biome_id: int, veg_type: int, variant_idx: int, mesh: Mesh, buffer: PackedFloat32Array) -> void:
+	var count := buffer.size() / 12
+	if count == 0:
+		return
+	var mmi := MultiMeshInstance3D.new()
+	mmi.name = "Veg_%d_%d_%d" % [biome_id, veg_type, variant_idx]
+	var mm := MultiMesh.new()
+	mm.transform_format = MultiMesh.TRANSFORM_3D
+	mm.instance_count = count
+	mm.visible_instance_count = count
+	mm.mesh = mesh
+	mm.buffer = buffer
+	
+	mmi.multimesh = mm
+	_configure_visibility_and_shadows(mmi, veg_type)
+	add_child(mmi)
+	_loaded_instances.append(mmi)
+	
+	_stats["total_instances"] += count
+	var type_key := str(veg_type)
+	_stats["by_type"][type_key] = _stats["by_type"].get(type_key, 0) + count
+
+
 func _clear_loaded() -> void:
 	for inst in _loaded_instances:
 		if is_instance_valid(inst):
@@ -70,13 +125,13 @@ func _check_cache_complete(world_seed: int) -> bool:
 	return true
 
 
-func _load_biome_type_data(world_seed: int, biome_id: int, type_name: String) -> Dictionary:
+func _load_biome_type_data(world_seed: int, biome_id: int, type_name: String, with_positions: bool = true) -> Dictionary:
 	var base_dir := "%s/%d" % [CACHE_ROOT, world_seed]
 	var mesh_path := "%s/meshes_%d_%s.res" % [base_dir, biome_id, type_name]
 	var pos_path := "%s/positions_%d_%s.res" % [base_dir, biome_id, type_name]
 	
 	var mesh_res: Variant = ResourceLoader.load(mesh_path)
-	var pos_res: Variant = ResourceLoader.load(pos_path)
+	var pos_res: Variant = ResourceLoader.load(pos_path) if with_positions else []
 	if mesh_res == null or pos_res == null:
 		push_warning("[VegetationLoader] Missing cached data for biome %d type %s" % [biome_id, type_name])
 		return {}
@@ -21,6 +21,8 @@ const VegetationManager := preload("res://_world/vegetation/vegetation_manager.g
 ## Offline prebaking pipeline for vegetation meshes and placements.
 ## Generates deterministic mesh variants per biome/type and samples terrain
 ## to find valid positions, then writes data to user://veg_cache/{seed}/.
+## With the native extension, placements are baked by NativeVegetationDispatcher
+## into one binary atlas (ATLAS_FILE) instead of per biome/type resources.
 ## Consumers: VegetationLoader (runtime instancing) and dev console tools.
 
 signal prebake_progress(current: int, total: int, stage_name: String)
@@ -29,6 +31,27 @@ signal prebake_complete()
 const VARIANTS_PER_TYPE: int = 8
 const GRID_RESOLUTION: int = 512  ## 16 km / 512 ≈ 31.25 m spacing
 const CACHE_ROOT: String = "user://veg_cache"
+const ATLAS_FILE: String = "vegetation.atlas"
+
+## NativeTerrainGenerator biome ids (biome_gpu_sdf.compute) to MapGenerator.Biome. The native set has
+## MARSH and HELLSCAPE, which use the SWAMP and VOLCANIC rules here.
+const NATIVE_BIOME_TO_MAP: Array[int] = [
+	MapGenerator.Biome.PLAINS,
+	MapGenerator.Biome.FOREST,
+	MapGenerator.Biome.DESERT,
+	MapGenerator.Biome.SWAMP,
+	MapGenerator.Biome.JUNGLE,
+	MapGenerator.Biome.TUNDRA,
+	MapGenerator.Biome.SWAMP,  # MARSH
+	MapGenerator.Biome.MOUNTAIN,
+	MapGenerator.Biome.SAVANNA,
+	MapGenerator.Biome.MUSHROOM,
+	MapGenerator.Biome.ICE_SPIRES,
+	MapGenerator.Biome.VOLCANIC,
+	MapGenerator.Biome.VOLCANIC,  # HELLSCAPE
+	MapGenerator.Biome.BEACH,
+	MapGenerator.Biome.DEEP_OCEAN,
+]
 
 var _stage_total: int = 1
 var _stage_current: int = 0
@@ -37,9 +60,13 @@ var _prebake_thread: Thread = null
 var _thread_mutex: Mutex = Mutex.new()
 var _thread_should_exit: bool = false
 var _progress_batch_size: int = 50
+var _native_dispatcher: Object = null
 
+## World XZ area baked into the atlas; empty bakes the whole map
+@export var atlas_bounds: Rect2 = Rect2()
 
-func prebake_vegetation(world_seed: int, terrain_generator: VoxelGeneratorScript) -> void:
+
+func prebake_vegetation(world_seed: int, terrain_generator: VoxelGenerator) -> void:
 	if terrain_generator == null:
 		push_error("[VegetationPrebaker] Terrain generator missing; aborting prebake.")
 		return
@@ -63,21 +90,31 @@ func prebake_vegetation(world_seed: int, terrain_generator: VoxelGeneratorScript
 
 func _threaded_prebake(data: Dictionary) -> void:
 	var world_seed: int = data["seed"]
-	var terrain_generator: VoxelGeneratorScript = data["generator"]
+	var terrain_generator: VoxelGenerator = data["generator"]
 	
 	var biome_keys := _veg_mgr.BIOME_VEGETATION_RULES.keys()
 	biome_keys.sort()
 	_stage_total = biome_keys.size() * 2
 	_stage_current = 0
 	
+	if terrain_generator.has_method("sample_surface") and ClassDB.class_exists("NativeVegetationDispatcher"):
+		_threaded_prebake_native(world_seed, terrain_generator, biome_keys)
+		return
+	
 	# Phase 1: Sample candidate positions per biome
 	var candidate_positions_per_biome: Dictionary = {}
-	for biome_id in biome_keys:
-		if _thread_should_exit:
-			return
-		_stage_current += 1
-		call_deferred("emit_signal", "prebake_progress", _stage_current, _stage_total, "biome_%d_candidates" % biome_id)
-		candidate_positions_per_biome[biome_id] = _sample_candidate_positions(biome_id, terrain_generator, world_seed)
+	if terrain_generator.has_method("sample_surface"):
+		# Native generator: the grid is queried once, in one batch, for every biome
+		candidate_positions_per_biome = _sample_candidate_positions_native(biome_keys, terrain_generator)
+		_stage_current += biome_keys.size()
+		call_deferred("emit_signal", "prebake_progress", _stage_current, _stage_total, "biome_candidates")
+	else:
+		for biome_id in biome_keys:
+			if _thread_should_exit:
+				return
+			_stage_current += 1
+			call_deferred("emit_signal", "prebake_progress", _stage_current, _stage_total, "biome_%d_candidates" % biome_id)
+			candidate_positions_per_biome[biome_id] = _sample_candidate_positions(biome_id, terrain_generator, world_seed)
 	
 	# Phase 2: Generate meshes and subsample positions per type
 	var item_count := 0
@@ -100,10 +137,85 @@ func _threaded_prebake(data: Dictionary) -> void:
 	print("[VegetationPrebaker] Thread complete for seed %d" % world_seed)
 
 
+func _threaded_prebake_native(world_seed: int, terrain_generator: VoxelGenerator, biome_keys: Array) -> void:
+	## Meshes per biome/type as resources, then every placement in one multi-threaded atlas bake.
+	for biome_id in biome_keys:
+		for veg_type in _veg_mgr.VegetationType.values():
+			if _thread_should_exit:
+				return
+			var meshes := _generate_mesh_variants(biome_id, veg_type, world_seed)
+			_save_mesh_variants(world_seed, biome_id, str(veg_type), meshes)
+		_stage_current += 1
+		call_deferred("emit_signal", "prebake_progress", _stage_current, _stage_total, "biome_%d_meshes" % biome_id)
+	
+	var bounds := atlas_bounds
+	if not bounds.has_area():
+		var half_world: float = MapGenerator.WORLD_SIZE * 0.5
+		bounds = Rect2(-half_world, -half_world, MapGenerator.WORLD_SIZE, MapGenerator.WORLD_SIZE)
+	
+	_thread_mutex.lock()
+	_native_dispatcher = ClassDB.instantiate("NativeVegetationDispatcher")
+	_thread_mutex.unlock()
+	if _thread_should_exit:
+		return
+	var result: Dictionary = _native_dispatcher.prebake_atlas(
+		terrain_generator, get_atlas_path(world_seed), bounds, _build_native_passes(), world_seed
+	)
+	_thread_mutex.lock()
+	_native_dispatcher = null
+	_thread_mutex.unlock()
+	if not result.get("ok", false):
+		if not _thread_should_exit:
+			push_error("[VegetationPrebaker] Atlas prebake failed for seed %d" % world_seed)
+		return
+	
+	_stage_current = _stage_total
+	call_deferred("emit_signal", "prebake_progress", _stage_current, _stage_total, "atlas")
+	call_deferred("emit_signal", "prebake_complete")
+	print("[VegetationPrebaker] Atlas for seed %d: %d instances, %d chunks in %.0f ms" % [
+		world_seed, result.get("instances", 0), result.get("chunks", 0), result.get("elapsed_ms", 0.0)
+	])
+
+
+func _build_native_passes() -> Array:
+	## One placement pass per native biome and rule type, as PlacementSampler feeds the GPU pass.
+	var passes: Array = []
+	for native_id in range(NATIVE_BIOME_TO_MAP.size()):
+		var biome_id: int = NATIVE_BIOME_TO_MAP[native_id]
+		var rules := _veg_mgr.get_biome_rules(biome_id)
+		var height_range: Dictionary = rules.get("height_range", {"min": -50, "max": 200})
+		for type_entry in rules.get("types", []):
+			var density := _veg_mgr.get_effective_density(biome_id, type_entry)
+			if density <= 0.0:
+				continue
+			var veg_type: int = type_entry.get("type", 0)
+			passes.append({
+				"native_biome": native_id,
+				"biome": biome_id,
+				"type": veg_type,
+				"variants": VARIANTS_PER_TYPE,
+				"density": density,
+				"grid_spacing": PlacementSampler.GRID_SPACING.get(veg_type, 2.0),
+				"noise_frequency": PlacementSampler.NOISE_FREQUENCY.get(veg_type, 0.1),
+				"slope_max": rules.get("slope_max", 30.0),
+				"height_min": float(height_range.get("min", -50)),
+				"height_max": float(height_range.get("max", 200)),
+			})
+	return passes
+
+
+static func get_atlas_path(world_seed: int) -> String:
+	return "%s/%d/%s" % [CACHE_ROOT, world_seed, ATLAS_FILE]
+
+
 func cancel_prebake() -> void:
 	if _prebake_thread == null or not _prebake_thread.is_alive():
 		return
 	_thread_should_exit = true
+	_thread_mutex.lock()
+	if _native_dispatcher != null:
+		_native_dispatcher.cancel_prebake()
+	_thread_mutex.unlock()
 	_prebake_thread.wait_to_finish()
 	_prebake_thread = null
 	print("[VegetationPrebaker] Prebake cancelled.")
@@ -113,7 +225,7 @@ func _exit_tree() -> void:
 	cancel_prebake()
 
 
-func _process_biome_type(world_seed: int, biome_id: int, veg_type: int, terrain_generator: VoxelGeneratorScript) -> void:
+func _process_biome_type(world_seed: int, biome_id: int, veg_type: int, terrain_generator: VoxelGenerator) -> void:
 	## Generate mesh variants and positions for a biome/type, then save both resources.
 	var type_name := str(veg_type)
 	var meshes := _generate_mesh_variants(biome_id, veg_type, world_seed)
@@ -172,7 +284,7 @@ func _generate_mesh_for_type(veg_type: int, biome_id: int, variant: String, seed
 func _sample_positions_for_biome(
 	biome_id: int,
 	veg_type: int,
-	terrain_generator: VoxelGeneratorScript,
+	terrain_generator: VoxelGenerator,
 	world_seed: int
 ) -> Array[Vector3]:
 	## Offline sampling on a fixed grid; filters by biome match, slope, density.
@@ -193,7 +305,7 @@ func _sample_positions_for_biome(
 
 func _sample_candidate_positions(
 	biome_id: int,
-	terrain_generator: VoxelGeneratorScript,
+	terrain_generator: VoxelGenerator,
 	world_seed: int
 ) -> Array[Vector3]:
 	## Shared biome-level sampling: scans grid once to collect matching biome positions.
@@ -215,11 +327,49 @@ func _sample_candidate_positions(
 	return positions
 
 
+func _sample_candidate_positions_native(biome_keys: Array, terrain_generator: VoxelGenerator) -> Dictionary:
+	## _sample_candidate_positions() for every biome at once through one sample_surface() query.
+	var positions_per_biome: Dictionary = {}
+	for biome_id in biome_keys:
+		var positions: Array[Vector3] = []
+		positions_per_biome[biome_id] = positions
+	
+	var world_size: float = MapGenerator.WORLD_SIZE
+	var half_world := world_size * 0.5
+	var step: float = world_size / float(GRID_RESOLUTION)
+	var grid := PackedVector2Array()
+	grid.resize(GRID_RESOLUTION * GRID_RESOLUTION)
+	var index := 0
+	for ix in range(GRID_RESOLUTION):
+		var x := -half_world + ix * step
+		for iz in range(GRID_RESOLUTION):
+			grid[index] = Vector2(x, -half_world + iz * step)
+			index += 1
+	
+	var surface: Dictionary = terrain_generator.sample_surface(grid, true)
+	var biome_ids: PackedInt32Array = surface.get("biome_ids", PackedInt32Array())
+	var heights: PackedFloat32Array = surface.get("heights", PackedFloat32Array())
+	if biome_ids.size() != grid.size() or heights.size() != grid.size():
+		push_warning("[VegetationPrebaker] sample_surface() returned no data; no candidates sampled.")
+		return positions_per_biome
+	
+	for i in range(grid.size()):
+		var native_id := biome_ids[i]
+		if native_id < 0 or native_id >= NATIVE_BIOME_TO_MAP.size():
+			continue
+		var biome_id: int = NATIVE_BIOME_TO_MAP[native_id]
+		if not positions_per_biome.has(biome_id):
+			continue
+		var p := grid[i]
+		positions_per_biome[biome_id].append(Vector3(p.x, heights[i], p.y))
+	return positions_per_biome
+
+
 func _subsample_positions_for_type(
 	candidates: Array[Vector3],
 	veg_type: int,
 	biome_id: int,
-	terrain_generator: VoxelGeneratorScript,
+	terrain_generator: VoxelGenerator,
 	world_seed: int
 ) -> Array[Vector3]:
 	## Per-type subsampling using density RNG and slope checks on biome candidates.
@@ -240,9 +390,16 @@ func _subsample_positions_for_type(
 	var rng := RandomNumberGenerator.new()
 	rng.seed = world_seed + biome_id * 17 + veg_type * 37
 	
+	# The density roll comes first so both slope paths keep the same RNG sequence
+	var kept: Array[Vector3] = []
 	for candidate in candidates:
 		if rng.randf() > density:
 			continue
+		kept.append(candidate)
+	
+	if terrain_generator != null and terrain_generator.has_method("sample_surface"):
+		return _filter_slope_native(kept, terrain_generator, type_entry)
+	for candidate in kept:
 		if not _is_slope_within_limit(terrain_generator, candidate.x, candidate.z, type_entry):
 			continue
 		positions.append(candidate)
@@ -250,19 +407,19 @@ func _subsample_positions_for_type(
 	return positions
 
 
-func _safe_sample_biome(generator: VoxelGeneratorScript, x: float, z: float) -> int:
+func _safe_sample_biome(generator: VoxelGenerator, x: float, z: float) -> int:
 	if generator and generator.has_method("sample_biome_at_position"):
 		return int(generator.sample_biome_at_position(x, z))
 	return MapGenerator.Biome.PLAINS
 
 
-func _safe_sample_height(generator: VoxelGeneratorScript, x: float, z: float) -> float:
+func _safe_sample_height(generator: VoxelGenerator, x: float, z: float) -> float:
 	if generator and generator.has_method("sample_height_at"):
 		return generator.sample_height_at(x, z)
 	return 0.0
 
 
-func _is_slope_within_limit(generator: VoxelGeneratorScript, x: float, z: float, type_entry: Dictionary) -> bool:
+func _is_slope_within_limit(generator: VoxelGenerator, x: float, z: float, type_entry: Dictionary) -> bool:
 	var slope_max: float = type_entry.get("slope_max", 45.0)
 	if generator == null or not generator.has_method("sample_height_at"):
 		return true
@@ -272,10 +429,37 @@ func _is_slope_within_limit(generator: VoxelGeneratorScript, x: float, z: float,
 	var h_xn: float = generator.sample_height_at(x - delta, z)
 	var h_zp: float = generator.sample_height_at(x, z + delta)
 	var h_zn: float = generator.sample_height_at(x, z - delta)
-	var grad_x: float = (h_xp - h_xn) * 0.5
-	var grad_z: float = (h_zp - h_zn) * 0.5
-	var slope: float = atan2(sqrt(grad_x * grad_x + grad_z * grad_z), 1.0) * 180.0 / PI
-	return slope <= slope_max
+	return _slope_degrees(h_xp, h_xn, h_zp, h_zn, delta) <= slope_max
+
+
+func _filter_slope_native(candidates: Array[Vector3], terrain_generator: VoxelGenerator, type_entry: Dictionary) -> Array[Vector3]:
+	## _is_slope_within_limit() for every candidate, with the neighbour heights from one sample_surface() query.
+	var slope_max: float = type_entry.get("slope_max", 45.0)
+	var delta: float = 1.0
+	var offsets := PackedVector2Array()
+	offsets.resize(candidates.size() * 4)
+	for i in range(candidates.size()):
+		var c := candidates[i]
+		offsets[i * 4] = Vector2(c.x + delta, c.z)
+		offsets[i * 4 + 1] = Vector2(c.x - delta, c.z)
+		offsets[i * 4 + 2] = Vector2(c.x, c.z + delta)
+		offsets[i * 4 + 3] = Vector2(c.x, c.z - delta)
+	
+	var heights: PackedFloat32Array = terrain_generator.sample_surface(offsets, true).get("heights", PackedFloat32Array())
+	if heights.size() != offsets.size():
+		return candidates
+	var positions: Array[Vector3] = []
+	for i in range(candidates.size()):
+		var slope := _slope_degrees(heights[i * 4], heights[i * 4 + 1], heights[i * 4 + 2], heights[i * 4 + 3], delta)
+		if slope <= slope_max:
+			positions.append(candidates[i])
+	return positions
+
+
+func _slope_degrees(h_xp: float, h_xn: float, h_zp: float, h_zn: float, delta: float) -> float:
+	var grad_x: float = (h_xp - h_xn) / (2.0 * delta)
+	var grad_z: float = (h_zp - h_zn) / (2.0 * delta)
+	return atan2(sqrt(grad_x * grad_x + grad_z * grad_z), 1.0) * 180.0 / PI
 
 
 func _save_prebaked_data(
@@ -287,17 +471,7 @@ func _save_prebaked_data(
 ) -> void:
 	## Serialize meshes and positions to user://.
 	var base_dir := "%s/%d" % [CACHE_ROOT, world_seed]
-	DirAccess.make_dir_recursive_absolute(base_dir)
-	
-	var mesh_res := VegetationMeshVariants.new()
-	mesh_res.meshes = meshes
-	mesh_res.biome_id = biome_id
-	mesh_res.type_name = type_name
-	mesh_res.world_seed = world_seed
-	var meshes_path := "%s/meshes_%d_%s.res" % [base_dir, biome_id, type_name]
-	var mesh_save := ResourceSaver.save(mesh_res, meshes_path)
-	if mesh_save != OK:
-		push_warning("[VegetationPrebaker] Failed to save meshes for biome %d type %s" % [biome_id, type_name])
+	_save_mesh_variants(world_seed, biome_id, type_name, meshes)
 	
 	var pos_res := VegetationPositionData.new()
 	pos_res.positions = positions
@@ -311,6 +485,21 @@ func _save_prebaked_data(
 		push_warning("[VegetationPrebaker] Failed to save positions for biome %d type %s" % [biome_id, type_name])
 
 
+func _save_mesh_variants(world_seed: int, biome_id: int, type_name: String, meshes: Array[ArrayMesh]) -> void:
+	var base_dir := "%s/%d" % [CACHE_ROOT, world_seed]
+	DirAccess.make_dir_recursive_absolute(base_dir)
+	
+	var mesh_res := VegetationMeshVariants.new()
+	mesh_res.meshes = meshes
+	mesh_res.biome_id = biome_id
+	mesh_res.type_name = type_name
+	mesh_res.world_seed = world_seed
+	var meshes_path := "%s/meshes_%d_%s.res" % [base_dir, biome_id, type_name]
+	var mesh_save := ResourceSaver.save(mesh_res, meshes_path)
+	if mesh_save != OK:
+		push_warning("[VegetationPrebaker] Failed to save meshes for biome %d type %s" % [biome_id, type_name])
+
+
 func _check_cache_exists(world_seed: int) -> bool:
 	var base_dir := "%s/%d" % [CACHE_ROOT, world_seed]
 	if not DirAccess.dir_exists_absolute(base_dir):
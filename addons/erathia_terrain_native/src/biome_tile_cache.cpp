@@ -0,0 +1,93 @@
+#include "biome_tile_cache.h"
+
+BiomeTileCache::BiomeTileCache() :
+        slots(MAX_SLOTS),
+        page_table((size_t)PAGE_TABLE_SIZE * PAGE_TABLE_SIZE, PageEntry{ 0, 0, 0, 0 }),
+        page_table_dirty(true),
+        pass(0),
+        hits(0),
+        generated(0),
+        evictions(0),
+        unplaced(0) {
+}
+
+int BiomeTileCache::request(const std::vector<TileCoord> &tiles, std::vector<Upload> &r_uploads) {
+    pass++;
+    int left_out = 0;
+    for (const TileCoord &tile : tiles) {
+        auto it = resident.find(tile);
+        if (it != resident.end()) {
+            slots[it->second].last_pass = pass;
+            hits++;
+            continue;
+        }
+
+        // The page table is toroidal: a resident tile at the same entry has to go first
+        PageEntry &entry = page_table[get_page_index(tile)];
+        if (entry.resident) {
+            if (slots[entry.slot].last_pass == pass) {
+                left_out++;
+                continue;
+            }
+            evict(entry.slot);
+        }
+
+        int slot = find_slot();
+        if (slot < 0) {
+            left_out++;
+            continue;
+        }
+        if (slots[slot].used) {
+            evict(slot);
+        }
+
+        slots[slot].tile = tile;
+        slots[slot].last_pass = pass;
+        slots[slot].used = true;
+        resident[tile] = slot;
+        entry = PageEntry{ tile.x, tile.z, slot, 1 };
+        page_table_dirty = true;
+        r_uploads.push_back({ tile, slot });
+        generated++;
+    }
+    unplaced += (uint64_t)left_out;
+    return left_out;
+}
+
+void BiomeTileCache::clear() {
+    for (Slot &slot : slots) {
+        slot = Slot();
+    }
+    resident.clear();
+    for (PageEntry &entry : page_table) {
+        entry = PageEntry{ 0, 0, 0, 0 };
+    }
+    page_table_dirty = true;
+}
+
+int BiomeTileCache::find_slot() const {
+    // A free slot, else the least recently used one that this pass does not need
+    int best = -1;
+    for (int i = 0; i < MAX_SLOTS; i++) {
+        const Slot &slot = slots[i];
+        if (!slot.used) {
+            return i;
+        }
+        if (slot.last_pass != pass && (best < 0 || slot.last_pass < slots[best].last_pass)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void BiomeTileCache::evict(int slot) {
+    Slot &victim = slots[slot];
+    resident.erase(victim.tile);
+    PageEntry &entry = page_table[get_page_index(victim.tile)];
+    if (entry.resident && entry.slot == slot) {
+        entry.resident = 0;
+    }
+    victim.used = false;
+    page_table_dirty = true;
+    evictions++;
+}
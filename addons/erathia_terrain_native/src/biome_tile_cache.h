@@ -0,0 +1,104 @@
+#ifndef BIOME_TILE_CACHE_H
+#define BIOME_TILE_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// BiomeTileCache: GPU residency of the virtual biome map
+// The map is an unbounded texel grid (biome_map.compute's Voronoi, one texel per texel_size world
+// units) cut into TILE_TEXELS^2 tiles. Resident tiles occupy slots of a fixed atlas texture and a
+// toroidal page table, indexed by tile coordinate, tells biome_gpu_sdf.compute which slot holds
+// which tile. Slots are reused least recently used first, never while the current pass needs them.
+// Not synchronized; NativeTerrainGenerator uses it on the device thread only.
+class BiomeTileCache {
+public:
+    static constexpr int TILE_SHIFT = 6;
+    static constexpr int TILE_TEXELS = 1 << TILE_SHIFT;
+    // A slot also holds the next tiles' first row and column, so bilinear taps never leave it
+    static constexpr int SLOT_TEXELS = TILE_TEXELS + 1;
+    static constexpr int ATLAS_SLOTS_PER_SIDE = 16;
+    static constexpr int ATLAS_TEXELS = SLOT_TEXELS * ATLAS_SLOTS_PER_SIDE;
+    static constexpr int MAX_SLOTS = ATLAS_SLOTS_PER_SIDE * ATLAS_SLOTS_PER_SIDE;
+    static constexpr int PAGE_TABLE_SIZE = 64;  // Entries per side (power of two)
+
+    struct TileCoord {
+        int32_t x;
+        int32_t z;
+
+        bool operator==(const TileCoord &other) const {
+            return x == other.x && z == other.z;
+        }
+    };
+
+    struct TileCoordHash {
+        std::size_t operator()(const TileCoord &tile) const {
+            uint64_t h = (uint64_t)(uint32_t)tile.x * 0x9E3779B97F4A7C15ull;
+            h ^= (uint64_t)(uint32_t)tile.z * 0xC2B2AE3D27D4EB4Full;
+            h ^= h >> 29;
+            return (std::size_t)h;
+        }
+    };
+
+    // One page table entry, as the ivec4 biome_gpu_sdf.compute reads
+    struct PageEntry {
+        int32_t tile_x;
+        int32_t tile_z;
+        int32_t slot;
+        int32_t resident;
+    };
+
+    // A tile that must be written into its slot before the pass samples it
+    struct Upload {
+        TileCoord tile;
+        int slot;
+    };
+
+    BiomeTileCache();
+
+    // Starts a pass needing these (distinct) tiles. Tiles that are not resident get a slot and are
+    // appended to r_uploads; a tile is left out when its page table entry belongs to another tile of
+    // the same pass or every slot is taken by this pass. Returns the number of tiles left out.
+    int request(const std::vector<TileCoord> &tiles, std::vector<Upload> &r_uploads);
+    void clear();
+
+    const std::vector<PageEntry> &get_page_table() const { return page_table; }
+    bool is_page_table_dirty() const { return page_table_dirty; }
+    void mark_page_table_clean() { page_table_dirty = false; }
+
+    int get_resident_count() const { return (int)resident.size(); }
+    uint64_t get_hits() const { return hits; }
+    uint64_t get_generated() const { return generated; }
+    uint64_t get_evictions() const { return evictions; }
+    uint64_t get_unplaced() const { return unplaced; }
+
+    static int get_page_index(const TileCoord &tile) {
+        return (tile.z & (PAGE_TABLE_SIZE - 1)) * PAGE_TABLE_SIZE + (tile.x & (PAGE_TABLE_SIZE - 1));
+    }
+    static int get_slot_origin_x(int slot) { return (slot % ATLAS_SLOTS_PER_SIDE) * SLOT_TEXELS; }
+    static int get_slot_origin_y(int slot) { return (slot / ATLAS_SLOTS_PER_SIDE) * SLOT_TEXELS; }
+
+private:
+    struct Slot {
+        TileCoord tile = { 0, 0 };
+        uint64_t last_pass = 0;
+        bool used = false;
+    };
+
+    std::vector<Slot> slots;
+    std::unordered_map<TileCoord, int, TileCoordHash> resident;
+    std::vector<PageEntry> page_table;
+    bool page_table_dirty;
+    uint64_t pass;
+
+    uint64_t hits;
+    uint64_t generated;
+    uint64_t evictions;
+    uint64_t unplaced;
+
+    int find_slot() const;
+    void evict(int slot);
+};
+
+#endif // BIOME_TILE_CACHE_H
@@ -0,0 +1,129 @@
+#include "chunk_cache.h"
+
+const ChunkCache::Entry *ChunkCache::find(const ChunkKey &key) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        misses++;
+        return nullptr;
+    }
+    hits++;
+    Slot &slot = slots[it->second];
+    slot.referenced = true;
+    return &slot.entry;
+}
+
+const ChunkCache::Entry *ChunkCache::peek(const ChunkKey &key) const {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return nullptr;
+    }
+    return &slots[it->second].entry;
+}
+
+ChunkCache::Entry *ChunkCache::peek(const ChunkKey &key) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return nullptr;
+    }
+    return &slots[it->second].entry;
+}
+
+bool ChunkCache::contains(const ChunkKey &key) const {
+    return index.find(key) != index.end();
+}
+
+void ChunkCache::insert(const ChunkKey &key, const Entry &entry, std::vector<Entry> &r_evicted) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+        Slot &existing = slots[it->second];
+        r_evicted.push_back(existing.entry);
+        remove_slot(it->second);
+    }
+
+    evict_to_fit(entry.get_size_bytes(), r_evicted);
+
+    size_t slot_index;
+    if (!free_slots.empty()) {
+        slot_index = free_slots.back();
+        free_slots.pop_back();
+    } else {
+        slot_index = slots.size();
+        slots.push_back(Slot());
+    }
+
+    Slot &slot = slots[slot_index];
+    slot.key = key;
+    slot.entry = entry;
+    slot.occupied = true;
+    slot.referenced = true;  // New entries survive the first sweep
+
+    index[key] = slot_index;
+    size_bytes += entry.get_size_bytes();
+}
+
+bool ChunkCache::erase(const ChunkKey &key, Entry &r_entry) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return false;
+    }
+    r_entry = slots[it->second].entry;
+    remove_slot(it->second);
+    return true;
+}
+
+void ChunkCache::clear(std::vector<Entry> &r_removed) {
+    for (Slot &slot : slots) {
+        if (slot.occupied) {
+            r_removed.push_back(slot.entry);
+        }
+    }
+    slots.clear();
+    free_slots.clear();
+    index.clear();
+    clock_hand = 0;
+    size_bytes = 0;
+}
+
+void ChunkCache::collect_keys(std::vector<ChunkKey> &r_keys) const {
+    r_keys.reserve(r_keys.size() + index.size());
+    for (const Slot &slot : slots) {
+        if (slot.occupied) {
+            r_keys.push_back(slot.key);
+        }
+    }
+}
+
+void ChunkCache::set_byte_budget(uint64_t budget, std::vector<Entry> &r_evicted) {
+    byte_budget = budget;
+    evict_to_fit(0, r_evicted);
+}
+
+void ChunkCache::remove_slot(size_t slot_index) {
+    Slot &slot = slots[slot_index];
+    size_bytes -= slot.entry.get_size_bytes();
+    index.erase(slot.key);
+    slot.entry = Entry();
+    slot.occupied = false;
+    slot.referenced = false;
+    free_slots.push_back(slot_index);
+}
+
+void ChunkCache::evict_to_fit(uint64_t incoming_bytes, std::vector<Entry> &r_evicted) {
+    // Each full revolution clears every reference bit, so this terminates within two sweeps per victim
+    while (!index.empty() && size_bytes + incoming_bytes > byte_budget) {
+        if (clock_hand >= slots.size()) {
+            clock_hand = 0;
+        }
+        Slot &slot = slots[clock_hand];
+        if (slot.occupied) {
+            if (slot.referenced) {
+                slot.referenced = false;
+            } else {
+                r_evicted.push_back(slot.entry);
+                remove_slot(clock_hand);
+                evictions++;
+            }
+        }
+        clock_hand++;
+    }
+}
@@ -0,0 +1,121 @@
+#ifndef CHUNK_CACHE_H
+#define CHUNK_CACHE_H
+
+#include <godot_cpp/variant/vector3i.hpp>
+#include <godot_cpp/variant/rid.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+using namespace godot;
+
+// Cache key for generated chunks: the same origin is a distinct entry per LOD
+struct ChunkKey {
+    Vector3i origin;
+    int lod;
+
+    bool operator==(const ChunkKey &other) const {
+        return origin == other.origin && lod == other.lod;
+    }
+};
+
+struct ChunkKeyHash {
+    std::size_t operator()(const ChunkKey &key) const {
+        // Multiply-xorshift mix: neighbouring chunk origins land in distant buckets
+        uint64_t h = (uint64_t)(uint32_t)key.origin.x * 0x9E3779B97F4A7C15ull;
+        h ^= (uint64_t)(uint32_t)key.origin.y * 0xC2B2AE3D27D4EB4Full;
+        h ^= (uint64_t)(uint32_t)key.origin.z * 0x165667B19E3779F9ull;
+        h ^= (uint64_t)(uint32_t)key.lod * 0x27D4EB2F165667C5ull;
+        h ^= h >> 29;
+        h *= 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 32;
+        return (std::size_t)h;
+    }
+};
+
+// ChunkCache: byte-bounded cache of completed chunks with CLOCK (second-chance) eviction
+// Not synchronized; NativeTerrainGenerator guards it with cache_mutex.
+// Evicted entries are handed back to the caller so their textures can be recycled outside the lock.
+class ChunkCache {
+public:
+    struct Entry {
+        RID sdf_texture;
+        RID material_texture;
+        PackedByteArray sdf_data;  // CPU copy, only for chunks that needed physics readback
+        PackedByteArray mat_data;
+        uint64_t gpu_bytes = 0;  // Texture memory held by this entry
+        // Uniform chunks (all air or all solid with one material) keep no textures or CPU copy
+        bool uniform = false;
+        float uniform_sdf = 0.0f;
+        uint32_t uniform_material = 0;
+        // Collision-only mode: surface mesh from collision_mesh.compute instead of a CPU copy
+        // (world-space xyz triplets and a triangle list; both empty for uniform chunks)
+        bool has_collision = false;
+        PackedFloat32Array collision_vertices;
+        PackedInt32Array collision_indices;
+        // Texture patched by sdf_edit.compute: collision aprons of its neighbours copy from it
+        bool sdf_edited = false;
+
+        bool has_cpu_data() const { return !sdf_data.is_empty() && !mat_data.is_empty(); }
+        uint64_t get_size_bytes() const {
+            // Fixed cost of the ring slot and index node, so uniform chunks (no textures, no copy)
+            // still count against the budget and cannot grow the cache without bound
+            const uint64_t overhead = sizeof(Entry) + sizeof(ChunkKey) + sizeof(size_t) + 2 * sizeof(void *);
+            return overhead + gpu_bytes + (uint64_t)sdf_data.size() + (uint64_t)mat_data.size() +
+                (uint64_t)collision_vertices.size() * sizeof(float) + (uint64_t)collision_indices.size() * sizeof(int32_t);
+        }
+    };
+
+    // Counted lookup: updates hit/miss counters and gives the entry a second chance
+    const Entry *find(const ChunkKey &key);
+    // Uncounted lookup that does not affect eviction order
+    const Entry *peek(const ChunkKey &key) const;
+    // In-place update of an entry's contents; the caller must keep get_size_bytes() unchanged
+    Entry *peek(const ChunkKey &key);
+    bool contains(const ChunkKey &key) const;
+
+    // Inserts or replaces; entries pushed out to fit the budget are appended to r_evicted
+    // (a replaced entry is appended too so its textures are not leaked)
+    void insert(const ChunkKey &key, const Entry &entry, std::vector<Entry> &r_evicted);
+    bool erase(const ChunkKey &key, Entry &r_entry);
+    void clear(std::vector<Entry> &r_removed);
+    // Appends the key of every cached entry (used to match edited regions against the cache)
+    void collect_keys(std::vector<ChunkKey> &r_keys) const;
+
+    void set_byte_budget(uint64_t budget, std::vector<Entry> &r_evicted);
+    uint64_t get_byte_budget() const { return byte_budget; }
+    uint64_t get_size_bytes() const { return size_bytes; }
+    int get_entry_count() const { return (int)index.size(); }
+
+    uint64_t get_hits() const { return hits; }
+    uint64_t get_misses() const { return misses; }
+    uint64_t get_evictions() const { return evictions; }
+
+private:
+    struct Slot {
+        ChunkKey key;
+        Entry entry;
+        bool occupied = false;
+        bool referenced = false;  // CLOCK bit: set on access, cleared as the hand passes
+    };
+
+    std::vector<Slot> slots;
+    std::vector<size_t> free_slots;
+    std::unordered_map<ChunkKey, size_t, ChunkKeyHash> index;
+    size_t clock_hand = 0;
+
+    uint64_t byte_budget = 512ull * 1024ull * 1024ull;
+    uint64_t size_bytes = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+
+    void remove_slot(size_t slot_index);
+    void evict_to_fit(uint64_t incoming_bytes, std::vector<Entry> &r_evicted);
+};
+
+#endif // CHUNK_CACHE_H
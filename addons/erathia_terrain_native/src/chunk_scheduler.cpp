@@ -0,0 +1,125 @@
+#include "chunk_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+bool ChunkScheduler::push(const ChunkKey &key, uint64_t now_us) {
+    if (index.find(key) != index.end()) {
+        return false;
+    }
+    Request request;
+    request.key = key;
+    request.enqueue_time_us = now_us;
+    index[key] = requests.size();
+    requests.push_back(request);
+    return true;
+}
+
+bool ChunkScheduler::cancel(const ChunkKey &key) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return false;
+    }
+    remove_at(it->second);
+    return true;
+}
+
+void ChunkScheduler::clear() {
+    requests.clear();
+    index.clear();
+    age_stats = AgeStats();
+}
+
+void ChunkScheduler::remove_at(size_t position) {
+    // Swap with the last request so removal never shifts the array
+    index.erase(requests[position].key);
+    const size_t last = requests.size() - 1;
+    if (position != last) {
+        requests[position] = requests[last];
+        index[requests[position].key] = position;
+    }
+    requests.pop_back();
+}
+
+float ChunkScheduler::score_request(const ChunkKey &key, const View &view) {
+    // A block at LOD n spans chunk_size << n voxels; its score is its distance in units of its
+    // own size, so each LOD ring fills in at the same pace instead of after every finer ring
+    const int lod = std::max(key.lod, 0);
+    const float extent = (float)(view.chunk_size << lod);
+    const Vector3 center = Vector3(key.origin) + Vector3(extent, extent, extent) * 0.5f;
+    const Vector3 to_chunk = center - view.position;
+    float distance = to_chunk.length();
+
+    // Beyond the chunks around the player, what is behind the camera waits for what is in front
+    const float forward_length = view.forward.length();
+    if (forward_length > 0.0f && distance > extent) {
+        const float facing = to_chunk.dot(view.forward) / (distance * forward_length);
+        const float behind = (1.0f - facing) * 0.5f;  // 0 straight ahead, 1 straight behind
+        distance *= 1.0f + view.view_weight * behind;
+    }
+    return distance / (float)(1 << lod);
+}
+
+int ChunkScheduler::select(const View &view, uint64_t now_us, int max_count, std::vector<Request> &r_selected) {
+    const size_t pending = requests.size();
+
+    // Queue age is measured over everything still waiting, before this pass takes any of it
+    age_scratch.resize(pending);
+    for (size_t i = 0; i < pending; i++) {
+        age_scratch[i] = now_us > requests[i].enqueue_time_us ? now_us - requests[i].enqueue_time_us : 0;
+    }
+    age_stats = AgeStats();
+    age_stats.count = (int)pending;
+    if (pending > 0) {
+        auto percentile = [this, pending](double fraction) {
+            const size_t rank = std::min(pending - 1, (size_t)(fraction * (double)(pending - 1) + 0.5));
+            std::nth_element(age_scratch.begin(), age_scratch.begin() + rank, age_scratch.end());
+            return age_scratch[rank];
+        };
+        age_stats.p50_us = percentile(0.50);
+        age_stats.p95_us = percentile(0.95);
+        age_stats.p99_us = percentile(0.99);
+        age_stats.max_us = *std::max_element(age_scratch.begin(), age_scratch.end());
+    }
+
+    // Re-score against the current view; after a teleport the old neighbourhood is dropped here
+    int dropped = 0;
+    for (size_t i = 0; i < requests.size();) {
+        Request &request = requests[i];
+        if (view.max_distance > 0.0f) {
+            const float extent = (float)(view.chunk_size << std::max(request.key.lod, 0));
+            const Vector3 center = Vector3(request.key.origin) + Vector3(extent, extent, extent) * 0.5f;
+            if (center.distance_to(view.position) > view.max_distance + extent) {
+                remove_at(i);
+                dropped++;
+                continue;
+            }
+        }
+        request.score = score_request(request.key, view);
+        i++;
+    }
+
+    const size_t take = std::min(requests.size(), (size_t)std::max(max_count, 0));
+    if (take == 0) {
+        return dropped;
+    }
+
+    order_scratch.resize(requests.size());
+    for (size_t i = 0; i < requests.size(); i++) {
+        order_scratch[i] = i;
+    }
+    auto better = [this](size_t a, size_t b) {
+        return requests[a].score < requests[b].score;
+    };
+    std::partial_sort(order_scratch.begin(), order_scratch.begin() + take, order_scratch.end(), better);
+
+    const size_t first = r_selected.size();
+    for (size_t i = 0; i < take; i++) {
+        r_selected.push_back(requests[order_scratch[i]]);
+    }
+    // Removed by key afterwards: removal moves requests, which would invalidate order_scratch
+    for (size_t i = first; i < r_selected.size(); i++) {
+        cancel(r_selected[i].key);
+    }
+    return dropped;
+}
@@ -0,0 +1,70 @@
+#ifndef CHUNK_SCHEDULER_H
+#define CHUNK_SCHEDULER_H
+
+#include <godot_cpp/variant/vector3.hpp>
+
+#include "chunk_cache.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+using namespace godot;
+
+// ChunkScheduler: pending async chunk requests, scored against the current view on every pass
+// Requests live in a dense array with a key -> position index, so push (deduplicated), cancel
+// and removal of a selected request are O(1); select() re-scores everything that is pending.
+// Not synchronized; NativeTerrainGenerator guards it with queue_mutex.
+class ChunkScheduler {
+public:
+    struct Request {
+        ChunkKey key;
+        uint64_t enqueue_time_us = 0;
+        float score = 0.0f;  // Lower = sooner; valid after the select() that returned it
+    };
+
+    // Where the player is and looks; forward may be zero when the view direction is unknown
+    struct View {
+        Vector3 position;
+        Vector3 forward;
+        int chunk_size = 32;
+        float view_weight = 1.0f;  // Extra distance factor for chunks directly behind the view
+        float max_distance = 0.0f;  // Requests farther than this are dropped (0 = keep all)
+    };
+
+    // Pending-age distribution measured by the last select()
+    struct AgeStats {
+        int count = 0;
+        uint64_t p50_us = 0;
+        uint64_t p95_us = 0;
+        uint64_t p99_us = 0;
+        uint64_t max_us = 0;
+    };
+
+    // False when the key is already pending (the original enqueue time is kept)
+    bool push(const ChunkKey &key, uint64_t now_us);
+    bool cancel(const ChunkKey &key);
+    bool contains(const ChunkKey &key) const { return index.find(key) != index.end(); }
+    void clear();
+
+    // Re-scores every pending request, drops those beyond view.max_distance and moves the
+    // max_count best into r_selected (best first). Returns the number of dropped requests.
+    int select(const View &view, uint64_t now_us, int max_count, std::vector<Request> &r_selected);
+
+    int get_size() const { return (int)requests.size(); }
+    const AgeStats &get_age_stats() const { return age_stats; }
+
+    static float score_request(const ChunkKey &key, const View &view);
+
+private:
+    std::vector<Request> requests;
+    std::unordered_map<ChunkKey, size_t, ChunkKeyHash> index;
+    std::vector<uint64_t> age_scratch;
+    std::vector<size_t> order_scratch;
+    AgeStats age_stats;
+
+    void remove_at(size_t position);
+};
+
+#endif // CHUNK_SCHEDULER_H
@@ -0,0 +1,187 @@
+#include "cpu_placement_sampler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const float TAU = 6.28318530718f;
+const float RAD_TO_DEG = 57.2957795131f;
+
+inline float fract(float x) {
+    return x - std::floor(x);
+}
+
+// GLSL spec definition: x * (1 - a) + y * a
+inline float mix(float x, float y, float a) {
+    return x * (1.0f - a) + y * a;
+}
+
+// hash(): only .x of the shader's vec3 result is used, i.e. one dot product
+inline float hash(float x, float y, float z) {
+    return fract(std::sin(x * 127.1f + y * 311.7f + z * 74.7f) * 43758.5453123f);
+}
+
+float noise3d(float x, float y, float z) {
+    const float ix = std::floor(x), iy = std::floor(y), iz = std::floor(z);
+    float fx = x - ix, fy = y - iy, fz = z - iz;
+    fx = fx * fx * (3.0f - 2.0f * fx);
+    fy = fy * fy * (3.0f - 2.0f * fy);
+    fz = fz * fz * (3.0f - 2.0f * fz);
+
+    const float nx00 = mix(hash(ix, iy, iz), hash(ix + 1.0f, iy, iz), fx);
+    const float nx10 = mix(hash(ix, iy + 1.0f, iz), hash(ix + 1.0f, iy + 1.0f, iz), fx);
+    const float nx01 = mix(hash(ix, iy, iz + 1.0f), hash(ix + 1.0f, iy, iz + 1.0f), fx);
+    const float nx11 = mix(hash(ix, iy + 1.0f, iz + 1.0f), hash(ix + 1.0f, iy + 1.0f, iz + 1.0f), fx);
+
+    return mix(mix(nx00, nx10, fy), mix(nx01, nx11, fy), fz) * 2.0f - 1.0f;
+}
+
+float fbm(float x, float y, float z, float freq, int octaves) {
+    float value = 0.0f;
+    float amplitude = 0.5f;
+    for (int i = 0; i < octaves; i++) {
+        value += amplitude * noise3d(x * freq, y * freq, z * freq);
+        amplitude *= 0.5f;
+        freq *= 2.0f;
+    }
+    return value;
+}
+
+struct Candidate {
+    int pass;
+    float x;
+    float z;
+};
+
+} // namespace
+
+void CpuPlacementSampler::place_chunk(const CpuBiomeMap &biome_map, const CpuTerrainSampler::Params &terrain,
+        const float origin_xz[2], int chunk_size, float surface_spacing, uint32_t world_seed,
+        const Pass *passes, int pass_count, std::vector<std::vector<Instance>> &r_instances) {
+    r_instances.resize(pass_count);
+    for (std::vector<Instance> &instances : r_instances) {
+        instances.clear();
+    }
+
+    const float seed = (float)world_seed;
+    const float size = (float)chunk_size;
+
+    // Biomes first (no root search): passes of biomes absent from the column cost nothing more
+    const int cells = std::max(1, (int)std::ceil(size / std::max(surface_spacing, 0.25f)));
+    const float cell = size / (float)cells;
+    const int side = cells + 1;
+    const int grid_count = side * side;
+    thread_local std::vector<float> grid_xz;
+    thread_local std::vector<int32_t> grid_biomes;
+    thread_local std::vector<float> grid_dist_edge;
+    thread_local std::vector<float> grid_heights;
+    grid_xz.resize((size_t)grid_count * 2);
+    grid_biomes.resize((size_t)grid_count);
+    grid_dist_edge.resize((size_t)grid_count);
+    grid_heights.resize((size_t)grid_count);
+    for (int j = 0; j < side; j++) {
+        for (int i = 0; i < side; i++) {
+            float *xz = &grid_xz[((size_t)j * side + i) * 2];
+            xz[0] = origin_xz[0] + (float)i * cell;
+            xz[1] = origin_xz[1] + (float)j * cell;
+        }
+    }
+    CpuTerrainSampler::sample_surface(biome_map, terrain, grid_xz.data(), grid_count,
+            grid_biomes.data(), grid_dist_edge.data(), nullptr);
+
+    // check_density() needs noise only: heights are sampled just for columns that keep a candidate
+    thread_local std::vector<Candidate> candidates;
+    candidates.clear();
+    for (int p = 0; p < pass_count; p++) {
+        const Pass &pass = passes[p];
+        if (pass.biome >= 0 && std::find(grid_biomes.begin(), grid_biomes.end(), pass.biome) == grid_biomes.end()) {
+            continue;
+        }
+        const float step = std::max(pass.grid_spacing, 0.001f);
+        const int steps = (int)std::ceil(size / step);
+        const float max_extent = size - step;
+        for (int gz = 0; gz < steps; gz++) {
+            const float z = origin_xz[1] + std::min((float)gz * pass.grid_spacing, max_extent);
+            const int j = std::min((int)std::lround((z - origin_xz[1]) / cell), cells);
+            for (int gx = 0; gx < steps; gx++) {
+                const float x = origin_xz[0] + std::min((float)gx * pass.grid_spacing, max_extent);
+                if (pass.biome >= 0) {
+                    const int i = std::min((int)std::lround((x - origin_xz[0]) / cell), cells);
+                    if (grid_biomes[(size_t)j * side + i] != pass.biome) {
+                        continue;
+                    }
+                }
+                const float n = (fbm(x + seed, seed, z + seed, pass.noise_frequency, 3) + 1.0f) * 0.5f;
+                if (n >= 1.0f - pass.density) {
+                    candidates.push_back({ p, x, z });
+                }
+            }
+        }
+    }
+    if (candidates.empty()) {
+        return;
+    }
+
+    CpuTerrainSampler::sample_surface(biome_map, terrain, grid_xz.data(), grid_count,
+            grid_biomes.data(), grid_dist_edge.data(), grid_heights.data());
+
+    for (const Candidate &candidate : candidates) {
+        const Pass &pass = passes[candidate.pass];
+        std::vector<Instance> &instances = r_instances[candidate.pass];
+        if ((int)instances.size() >= MAX_INSTANCES_PER_PASS) {
+            continue;
+        }
+
+        const float u = (candidate.x - origin_xz[0]) / cell;
+        const float v = (candidate.z - origin_xz[1]) / cell;
+        const int i = std::min(std::max((int)std::floor(u), 0), cells - 1);
+        const int j = std::min(std::max((int)std::floor(v), 0), cells - 1);
+        const float fu = u - (float)i;
+        const float fv = v - (float)j;
+        const float h00 = grid_heights[(size_t)j * side + i];
+        const float h10 = grid_heights[(size_t)j * side + i + 1];
+        const float h01 = grid_heights[(size_t)(j + 1) * side + i];
+        const float h11 = grid_heights[(size_t)(j + 1) * side + i + 1];
+
+        const float height = mix(mix(h00, h10, fu), mix(h01, h11, fu), fv);
+        if (height < pass.height_min || height > pass.height_max) {
+            continue;
+        }
+
+        // calculate_slope(): the angle of the surface normal (-dh/dx, 1, -dh/dz) from vertical
+        const float grad_x = mix(h10 - h00, h11 - h01, fv) / cell;
+        const float grad_z = mix(h01 - h00, h11 - h10, fu) / cell;
+        const float slope = std::atan(std::sqrt(grad_x * grad_x + grad_z * grad_z)) * RAD_TO_DEG;
+        if (slope > pass.slope_max) {
+            continue;
+        }
+
+        // random_variant(), random_scale() and random_rotation() at the surface position
+        const float x = candidate.x;
+        const float z = candidate.z;
+        const float type = (float)pass.type;
+        const uint32_t variant_index = (uint32_t)(hash(x + seed * 0.37f, height + 13.37f, z + type) * 65535.0f);
+        const float scale = 0.8f + hash(x + 91.0f, height + 17.0f, z + type * 3.0f) * 0.4f;
+        const float rotation = hash(x + 7.0f, height + 19.0f, z + seed * 0.11f) * TAU;
+        const float cos_y = std::cos(rotation);
+        const float sin_y = std::sin(rotation);
+
+        Instance instance;
+        instance.variant = (int32_t)(variant_index % (uint32_t)pass.variant_count);
+        float *t = instance.transform;
+        t[0] = cos_y * scale;
+        t[1] = 0.0f;
+        t[2] = sin_y * scale;
+        t[3] = x;
+        t[4] = 0.0f;
+        t[5] = scale;
+        t[6] = 0.0f;
+        t[7] = height;
+        t[8] = -sin_y * scale;
+        t[9] = 0.0f;
+        t[10] = cos_y * scale;
+        t[11] = z;
+        instances.push_back(instance);
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef CPU_PLACEMENT_SAMPLER_H
+#define CPU_PLACEMENT_SAMPLER_H
+
+#include "cpu_terrain_sampler.h"
+
+#include <cstdint>
+#include <vector>
+
+// CpuPlacementSampler: CPU port of vegetation_placement.compute for prebakes over whole regions
+// The sampling grid, density noise and per-instance hashes are the shader's; the surface comes from
+// CpuTerrainSampler::sample_surface() on a height grid over the chunk column instead of a chunk SDF
+// texture, so no chunk has to be generated first. Values match the shader within sin() precision.
+class CpuPlacementSampler {
+public:
+    // placements[] capacity of vegetation_placement.compute, per pass and chunk
+    static constexpr int MAX_INSTANCES_PER_PASS = 4096;
+
+    // One vegetation_placement.compute pass (PlacementParams); variant_count > 0
+    struct Pass {
+        int32_t biome;  // Biome id (biome_gpu_sdf.compute) whose columns the pass places on, -1 for all
+        int type;
+        int variant_count;
+        float density;
+        float grid_spacing;
+        float noise_frequency;
+        float slope_max;  // Degrees
+        float height_min;
+        float height_max;
+    };
+
+    struct Instance {
+        int32_t variant;  // variant_index % variant_count
+        float transform[12];  // MultiMesh TRANSFORM_3D order, as transform_placement.compute
+    };
+
+    // Places every pass over the chunk column at origin_xz (chunk_size world units square); biomes and
+    // surface heights are sampled every surface_spacing units and a candidate takes the biome of the
+    // nearest sample. r_instances[i] receives pass i's instances.
+    static void place_chunk(const CpuBiomeMap &biome_map, const CpuTerrainSampler::Params &terrain,
+            const float origin_xz[2], int chunk_size, float surface_spacing, uint32_t world_seed,
+            const Pass *passes, int pass_count, std::vector<std::vector<Instance>> &r_instances);
+};
+
+#endif // CPU_PLACEMENT_SAMPLER_H
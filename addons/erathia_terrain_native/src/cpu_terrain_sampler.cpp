@@ -0,0 +1,874 @@
+#include "cpu_terrain_sampler.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CPU_SAMPLER_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CPU_SAMPLER_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CPU_SAMPLER_NEON
+#endif
+
+namespace {
+
+// ---------------------------------------------------------------------------------------------
+// Lane wrapper: VF holds LANES floats, VM a per-lane mask. Everything below the wrapper is
+// written once against it, so the ISA only changes this block.
+// ---------------------------------------------------------------------------------------------
+
+#if defined(CPU_SAMPLER_AVX2)
+
+constexpr int LANES = 8;
+const char *const SIMD_NAME = "AVX2";
+
+struct VF { __m256 v; };
+struct VM { __m256 m; };
+
+inline VF vset(float x) { return { _mm256_set1_ps(x) }; }
+inline VF vload(const float *p) { return { _mm256_loadu_ps(p) }; }
+inline void vstore(float *p, VF a) { _mm256_storeu_ps(p, a.v); }
+inline VF operator+(VF a, VF b) { return { _mm256_add_ps(a.v, b.v) }; }
+inline VF operator-(VF a, VF b) { return { _mm256_sub_ps(a.v, b.v) }; }
+inline VF operator*(VF a, VF b) { return { _mm256_mul_ps(a.v, b.v) }; }
+inline VF operator/(VF a, VF b) { return { _mm256_div_ps(a.v, b.v) }; }
+inline VF vmin(VF a, VF b) { return { _mm256_min_ps(a.v, b.v) }; }
+inline VF vmax(VF a, VF b) { return { _mm256_max_ps(a.v, b.v) }; }
+inline VF vfloor(VF a) { return { _mm256_floor_ps(a.v) }; }
+inline VF vround(VF a) { return { _mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) }; }
+inline VF vsqrt(VF a) { return { _mm256_sqrt_ps(a.v) }; }
+inline VF vabs(VF a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+inline VM operator<(VF a, VF b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+inline VM operator>(VF a, VF b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+inline VM operator&(VM a, VM b) { return { _mm256_and_ps(a.m, b.m) }; }
+inline VF vselect(VM m, VF a, VF b) { return { _mm256_blendv_ps(b.v, a.v, m.m) }; }
+inline uint32_t vmask_bits(VM m) { return (uint32_t)_mm256_movemask_ps(m.m); }
+inline VM vmask_from_bits(uint32_t bits) {
+    const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    __m256i hit = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32((int)bits), lane_bits), lane_bits);
+    return { _mm256_castsi256_ps(hit) };
+}
+
+#elif defined(CPU_SAMPLER_SSE2)
+
+constexpr int LANES = 4;
+const char *const SIMD_NAME = "SSE2";
+
+struct VF { __m128 v; };
+struct VM { __m128 m; };
+
+inline VF vset(float x) { return { _mm_set1_ps(x) }; }
+inline VF vload(const float *p) { return { _mm_loadu_ps(p) }; }
+inline void vstore(float *p, VF a) { _mm_storeu_ps(p, a.v); }
+inline VF operator+(VF a, VF b) { return { _mm_add_ps(a.v, b.v) }; }
+inline VF operator-(VF a, VF b) { return { _mm_sub_ps(a.v, b.v) }; }
+inline VF operator*(VF a, VF b) { return { _mm_mul_ps(a.v, b.v) }; }
+inline VF operator/(VF a, VF b) { return { _mm_div_ps(a.v, b.v) }; }
+inline VF vmin(VF a, VF b) { return { _mm_min_ps(a.v, b.v) }; }
+inline VF vmax(VF a, VF b) { return { _mm_max_ps(a.v, b.v) }; }
+inline VF vfloor(VF a) {
+    // SSE2 has no floor: truncate, then step down where truncation rounded up (valid for |a| < 2^31)
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+    return { _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a.v), _mm_set1_ps(1.0f))) };
+}
+inline VF vround(VF a) { return { _mm_cvtepi32_ps(_mm_cvtps_epi32(a.v)) }; }
+inline VF vsqrt(VF a) { return { _mm_sqrt_ps(a.v) }; }
+inline VF vabs(VF a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+inline VM operator<(VF a, VF b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+inline VM operator>(VF a, VF b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+inline VM operator&(VM a, VM b) { return { _mm_and_ps(a.m, b.m) }; }
+inline VF vselect(VM m, VF a, VF b) { return { _mm_or_ps(_mm_and_ps(m.m, a.v), _mm_andnot_ps(m.m, b.v)) }; }
+inline uint32_t vmask_bits(VM m) { return (uint32_t)_mm_movemask_ps(m.m); }
+inline VM vmask_from_bits(uint32_t bits) {
+    const __m128i lane_bits = _mm_setr_epi32(1, 2, 4, 8);
+    __m128i hit = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32((int)bits), lane_bits), lane_bits);
+    return { _mm_castsi128_ps(hit) };
+}
+
+#elif defined(CPU_SAMPLER_NEON)
+
+constexpr int LANES = 4;
+const char *const SIMD_NAME = "NEON";
+
+struct VF { float32x4_t v; };
+struct VM { uint32x4_t m; };
+
+inline VF vset(float x) { return { vdupq_n_f32(x) }; }
+inline VF vload(const float *p) { return { vld1q_f32(p) }; }
+inline void vstore(float *p, VF a) { vst1q_f32(p, a.v); }
+inline VF operator+(VF a, VF b) { return { vaddq_f32(a.v, b.v) }; }
+inline VF operator-(VF a, VF b) { return { vsubq_f32(a.v, b.v) }; }
+inline VF operator*(VF a, VF b) { return { vmulq_f32(a.v, b.v) }; }
+inline VF operator/(VF a, VF b) { return { vdivq_f32(a.v, b.v) }; }
+inline VF vmin(VF a, VF b) { return { vminq_f32(a.v, b.v) }; }
+inline VF vmax(VF a, VF b) { return { vmaxq_f32(a.v, b.v) }; }
+inline VF vfloor(VF a) { return { vrndmq_f32(a.v) }; }
+inline VF vround(VF a) { return { vrndnq_f32(a.v) }; }
+inline VF vsqrt(VF a) { return { vsqrtq_f32(a.v) }; }
+inline VF vabs(VF a) { return { vabsq_f32(a.v) }; }
+inline VM operator<(VF a, VF b) { return { vcltq_f32(a.v, b.v) }; }
+inline VM operator>(VF a, VF b) { return { vcgtq_f32(a.v, b.v) }; }
+inline VM operator&(VM a, VM b) { return { vandq_u32(a.m, b.m) }; }
+inline VF vselect(VM m, VF a, VF b) { return { vbslq_f32(m.m, a.v, b.v) }; }
+inline uint32_t vmask_bits(VM m) {
+    const uint32_t lane_bits[4] = { 1, 2, 4, 8 };
+    return vaddvq_u32(vandq_u32(m.m, vld1q_u32(lane_bits)));
+}
+inline VM vmask_from_bits(uint32_t bits) {
+    const uint32_t lane_bits[4] = { 1, 2, 4, 8 };
+    return { vtstq_u32(vdupq_n_u32(bits), vld1q_u32(lane_bits)) };
+}
+
+#else
+
+constexpr int LANES = 1;
+const char *const SIMD_NAME = "scalar";
+
+struct VF { float v; };
+struct VM { bool m; };
+
+inline VF vset(float x) { return { x }; }
+inline VF vload(const float *p) { return { *p }; }
+inline void vstore(float *p, VF a) { *p = a.v; }
+inline VF operator+(VF a, VF b) { return { a.v + b.v }; }
+inline VF operator-(VF a, VF b) { return { a.v - b.v }; }
+inline VF operator*(VF a, VF b) { return { a.v * b.v }; }
+inline VF operator/(VF a, VF b) { return { a.v / b.v }; }
+inline VF vmin(VF a, VF b) { return { a.v < b.v ? a.v : b.v }; }
+inline VF vmax(VF a, VF b) { return { a.v > b.v ? a.v : b.v }; }
+inline VF vfloor(VF a) { return { std::floor(a.v) }; }
+inline VF vround(VF a) { return { std::nearbyint(a.v) }; }
+inline VF vsqrt(VF a) { return { std::sqrt(a.v) }; }
+inline VF vabs(VF a) { return { std::fabs(a.v) }; }
+inline VM operator<(VF a, VF b) { return { a.v < b.v }; }
+inline VM operator>(VF a, VF b) { return { a.v > b.v }; }
+inline VM operator&(VM a, VM b) { return { a.m && b.m }; }
+inline VF vselect(VM m, VF a, VF b) { return m.m ? a : b; }
+inline uint32_t vmask_bits(VM m) { return m.m ? 1u : 0u; }
+inline VM vmask_from_bits(uint32_t bits) { return { (bits & 1u) != 0 }; }
+
+#endif
+
+constexpr uint32_t ALL_LANES = (LANES >= 32) ? 0xFFFFFFFFu : ((1u << LANES) - 1u);
+
+// ---------------------------------------------------------------------------------------------
+// GLSL built-ins
+// ---------------------------------------------------------------------------------------------
+
+inline VF vfract(VF a) { return a - vfloor(a); }
+inline VF vclamp(VF a, float lo, float hi) { return vmin(vmax(a, vset(lo)), vset(hi)); }
+// GLSL spec definition: x * (1 - a) + y * a
+inline VF vmix(VF x, VF y, VF a) { return x * (vset(1.0f) - a) + y * a; }
+inline VF vsmoothstep(float edge0, float edge1, VF x) {
+    VF t = vclamp((x - vset(edge0)) / vset(edge1 - edge0), 0.0f, 1.0f);
+    return t * t * (vset(3.0f) - vset(2.0f) * t);
+}
+
+// sin(x + quadrant * pi/2): Cody-Waite reduction to [-pi/4, pi/4], then Cephes minimax polynomials
+inline VF vsin_quadrant(VF x, float quadrant) {
+    VF j = vround(x * vset(0.63661977236758134f));
+    VF r = ((x - j * vset(1.5703125f)) - j * vset(4.837512969970703125e-4f)) - j * vset(7.54978995489188216e-8f);
+    VF r2 = r * r;
+    VF s = r + r * r2 * (vset(-1.6666654611e-1f) + r2 * (vset(8.3321608736e-3f) + r2 * vset(-1.9515295891e-4f)));
+    VF c = (vset(1.0f) - r2 * vset(0.5f)) + r2 * r2 * (vset(4.166664568298827e-2f) + r2 * (vset(-1.388731625493765e-3f) + r2 * vset(2.443315711809948e-5f)));
+
+    VF q = j + vset(quadrant);
+    q = q - vset(4.0f) * vfloor(q * vset(0.25f));  // 0..3
+    VM odd = (q - vset(2.0f) * vfloor(q * vset(0.5f))) > vset(0.5f);
+    VF v = vselect(odd, c, s);
+    return vselect(q > vset(1.5f), vset(0.0f) - v, v);
+}
+
+inline VF vsin(VF x) { return vsin_quadrant(x, 0.0f); }
+inline VF vcos(VF x) { return vsin_quadrant(x, 1.0f); }
+
+// ---------------------------------------------------------------------------------------------
+// biome_gpu_sdf.compute, lane-wide
+// ---------------------------------------------------------------------------------------------
+
+const int BIOME_COUNT = 15;
+const int BIOME_PLAINS = 0;
+const int BIOME_FOREST = 1;
+const int BIOME_DESERT = 2;
+const int BIOME_SWAMP = 3;
+const int BIOME_JUNGLE = 4;
+const int BIOME_TUNDRA = 5;
+const int BIOME_MARSH = 6;
+const int BIOME_MOUNTAIN = 7;
+const int BIOME_SAVANNA = 8;
+const int BIOME_MUSHROOM = 9;
+const int BIOME_ICE_SPIRES = 10;
+const int BIOME_VOLCANIC = 11;
+const int BIOME_HELLSCAPE = 12;
+const int BIOME_BEACH = 13;
+const int BIOME_OCEAN = 14;
+
+const uint32_t MAT_AIR = 0;
+const uint32_t MAT_DIRT = 1;
+const uint32_t MAT_STONE = 2;
+const uint32_t MAT_IRON_ORE = 3;
+const uint32_t MAT_SAND = 4;
+const uint32_t MAT_SNOW = 5;
+const uint32_t MAT_GRASS = 6;
+
+const float SURFACE_THICKNESS = 3.0f;
+const float DIRT_THICKNESS = 6.0f;
+
+struct V3 {
+    VF x, y, z;
+};
+
+inline V3 scale3(const V3 &p, float s) {
+    VF vs = vset(s);
+    return { p.x * vs, p.y * vs, p.z * vs };
+}
+
+// hash(): only .x of the shader's vec3 result is used, i.e. one dot product
+inline VF hash(VF x, VF y, VF z) {
+    VF d = x * vset(127.1f) + y * vset(311.7f) + z * vset(74.7f);
+    return vfract(vsin(d) * vset(43758.5453123f));
+}
+
+VF noise3d(const V3 &p) {
+    const VF one = vset(1.0f);
+    VF ix = vfloor(p.x), iy = vfloor(p.y), iz = vfloor(p.z);
+    VF fx = vfract(p.x), fy = vfract(p.y), fz = vfract(p.z);
+    fx = fx * fx * (vset(3.0f) - vset(2.0f) * fx);
+    fy = fy * fy * (vset(3.0f) - vset(2.0f) * fy);
+    fz = fz * fz * (vset(3.0f) - vset(2.0f) * fz);
+
+    VF ix1 = ix + one, iy1 = iy + one, iz1 = iz + one;
+    VF n000 = hash(ix, iy, iz);
+    VF n100 = hash(ix1, iy, iz);
+    VF n010 = hash(ix, iy1, iz);
+    VF n110 = hash(ix1, iy1, iz);
+    VF n001 = hash(ix, iy, iz1);
+    VF n101 = hash(ix1, iy, iz1);
+    VF n011 = hash(ix, iy1, iz1);
+    VF n111 = hash(ix1, iy1, iz1);
+
+    VF nx00 = vmix(n000, n100, fx);
+    VF nx10 = vmix(n010, n110, fx);
+    VF nx01 = vmix(n001, n101, fx);
+    VF nx11 = vmix(n011, n111, fx);
+
+    VF nxy0 = vmix(nx00, nx10, fy);
+    VF nxy1 = vmix(nx01, nx11, fy);
+
+    return vmix(nxy0, nxy1, fz) * vset(2.0f) - one;
+}
+
+VF fbm(const V3 &p, float freq, int octaves) {
+    VF value = vset(0.0f);
+    float amplitude = 0.5f;
+    for (int i = 0; i < octaves; i++) {
+        value = value + vset(amplitude) * noise3d(scale3(p, freq));
+        amplitude *= 0.5f;
+        freq *= 2.0f;
+    }
+    return value;
+}
+
+VF get_biome_sdf(int biome_id, const V3 &p, const CpuTerrainSampler::Params &params) {
+    switch (biome_id) {
+        case BIOME_FOREST:
+            return p.y - fbm(p, 0.004f, 3) * vset(25.0f);
+        case BIOME_DESERT: {
+            VF dunes = vsin(p.x * vset(0.01f)) * vcos(p.z * vset(0.01f)) * vset(15.0f);
+            return p.y - (fbm(p, 0.005f, 2) * vset(10.0f) + dunes);
+        }
+        case BIOME_SWAMP:
+            return p.y - (fbm(p, 0.002f, 3) * vset(8.0f) - vset(5.0f));
+        case BIOME_JUNGLE:
+            return p.y - fbm(p, 0.006f, 4) * vset(35.0f);
+        case BIOME_TUNDRA:
+            return p.y - (fbm(p, 0.003f, 3) * vset(15.0f) + vset(5.0f));
+        case BIOME_MARSH:
+            return p.y - (fbm(p, 0.0025f, 3) * vset(6.0f) - vset(8.0f));
+        case BIOME_MOUNTAIN: {
+            VF n = fbm(p, 0.008f, 4);
+            return p.y - (vabs(n) * vset(100.0f) + n * vset(50.0f));
+        }
+        case BIOME_SAVANNA:
+            return p.y - fbm(p, 0.0035f, 3) * vset(18.0f);
+        case BIOME_MUSHROOM: {
+            VF m = fbm(p, 0.01f, 3);
+            return p.y - (m * vset(30.0f) + vsin(p.x * vset(0.02f)) * vset(10.0f));
+        }
+        case BIOME_ICE_SPIRES: {
+            // pow(abs(x), 2.0) == x * x
+            VF f = fbm(p, 0.015f, 3);
+            return p.y - f * f * vset(120.0f);
+        }
+        case BIOME_VOLCANIC: {
+            VF cone = vsqrt(p.x * p.x + p.z * p.z) * vset(0.5f);
+            return p.y - (vabs(fbm(p, 0.01f, 3)) * vset(80.0f) + cone);
+        }
+        case BIOME_HELLSCAPE: {
+            V3 warped_p = { p.x, p.y + p.y * vset(0.05f), p.z };
+            return p.y - fbm(warped_p, 0.02f, 3) * vset(60.0f);
+        }
+        case BIOME_BEACH: {
+            VF ripples = fbm(scale3(p, 0.02f), 0.8f, 2) * vset(1.5f);
+            VF terrace = vsmoothstep(-3.0f, 3.0f, p.y - vset(params.sea_level)) * vset(3.0f);
+            return (vabs(p.y - vset(params.sea_level)) - vset(1.5f)) + ripples + terrace;
+        }
+        case BIOME_OCEAN: {
+            VF swell = fbm(scale3(p, 0.008f), 1.2f, 3) * vset(4.0f);
+            return (p.y - vset(params.sea_level - 18.0f)) + swell;
+        }
+        case BIOME_PLAINS:
+        default:
+            return p.y - fbm(p, 0.003f, 4) * vset(20.0f);
+    }
+}
+
+// Lanes may straddle a biome border: evaluate each distinct biome once and merge by lane mask
+VF get_biome_sdf_lanes(const int *biome_ids, const V3 &p, const CpuTerrainSampler::Params &params) {
+    VF result = vset(0.0f);
+    uint32_t done = 0;
+    for (int l = 0; l < LANES; l++) {
+        if (done & (1u << l)) {
+            continue;
+        }
+        uint32_t lanes = 0;
+        for (int k = l; k < LANES; k++) {
+            if (biome_ids[k] == biome_ids[l]) {
+                lanes |= 1u << k;
+            }
+        }
+        VF sdf = get_biome_sdf(biome_ids[l], p, params);
+        if (lanes == ALL_LANES) {
+            return sdf;
+        }
+        result = vselect(vmask_from_bits(lanes), sdf, result);
+        done |= lanes;
+    }
+    return result;
+}
+
+VF calculate_slope(const V3 &p, const CpuTerrainSampler::Params &params) {
+    const float sample_dist = 2.0f;
+    VF vd = vset(sample_dist);
+    VF h_east = p.y - get_biome_sdf(BIOME_PLAINS, { p.x + vd, p.y, p.z }, params);
+    VF h_west = p.y - get_biome_sdf(BIOME_PLAINS, { p.x - vd, p.y, p.z }, params);
+    VF h_north = p.y - get_biome_sdf(BIOME_PLAINS, { p.x, p.y, p.z + vd }, params);
+    VF h_south = p.y - get_biome_sdf(BIOME_PLAINS, { p.x, p.y, p.z - vd }, params);
+    VF dx = (h_east - h_west) / vset(2.0f * sample_dist);
+    VF dz = (h_north - h_south) / vset(2.0f * sample_dist);
+    return vsqrt(dx * dx + dz * dz);
+}
+
+uint32_t get_subsurface_material(int biome_id) {
+    if (biome_id == BIOME_DESERT || biome_id == BIOME_BEACH) {
+        return MAT_SAND;
+    }
+    return MAT_DIRT;
+}
+
+uint32_t get_surface_material(int biome_id, float slope) {
+    if (slope > 0.577f) {
+        return MAT_STONE;
+    }
+    if (biome_id == BIOME_DESERT || biome_id == BIOME_BEACH) {
+        return MAT_SAND;
+    }
+    if (biome_id == BIOME_TUNDRA || biome_id == BIOME_ICE_SPIRES) {
+        if (slope > 0.364f) {
+            float blend = (slope - 0.364f) / (0.577f - 0.364f);
+            return blend > 0.5f ? MAT_STONE : MAT_SNOW;
+        }
+        return MAT_SNOW;
+    }
+    if (biome_id == BIOME_VOLCANIC || biome_id == BIOME_MOUNTAIN) {
+        return MAT_STONE;
+    }
+    if (biome_id == BIOME_MARSH || biome_id == BIOME_SWAMP || biome_id == BIOME_MUSHROOM) {
+        return MAT_DIRT;
+    }
+    if (biome_id == BIOME_OCEAN) {
+        return MAT_SAND;
+    }
+    if (slope > 0.466f) {
+        float blend = (slope - 0.466f) / (0.577f - 0.466f);
+        return blend > 0.5f ? MAT_STONE : MAT_GRASS;
+    }
+    return MAT_GRASS;
+}
+
+inline int biome_from_norm(float r) {
+    int id = (int)std::floor(r * (float)BIOME_COUNT);
+    return id < 0 ? 0 : (id > BIOME_COUNT - 1 ? BIOME_COUNT - 1 : id);
+}
+
+// Biome lookups only depend on XZ: resolved once per column instead of per voxel
+struct ColumnBiome {
+    int biome_id;
+    float dist_edge;
+    int neighbors[4];
+};
+
+// biome_map.compute hash(uvec2)
+inline uint32_t hash2(uint32_t x, uint32_t y) {
+    x = x * 1664525u + 1013904223u;
+    y = y * 1664525u + 1013904223u;
+    uint32_t hx = x ^ y;
+    return hx * 1664525u;
+}
+
+inline float rand2(uint32_t x, uint32_t y) {
+    return (float)hash2(x, y) * (1.0f / 4294967295.0f);
+}
+
+// Texel space coordinate of the virtual map (texel centres at integers), as sample_virtual_biome()
+inline float virtual_texel_coord(float world, float world_size, float texel_size, float offset) {
+    return (world + 0.5f * world_size) / texel_size - 0.5f + offset;
+}
+
+// Bilinear filtering of the four texels around (tx, tz); fetch(x, z, float[2]) supplies a texel
+template <typename Fetch>
+void filter_virtual_texels(float tx, float tz, const Fetch &fetch, float r_value[2]) {
+    const float fx = std::floor(tx);
+    const float fz = std::floor(tz);
+    const float ax = tx - fx;
+    const float az = tz - fz;
+    const int32_t x0 = (int32_t)fx;
+    const int32_t z0 = (int32_t)fz;
+
+    float v00[2], v10[2], v01[2], v11[2];
+    fetch(x0, z0, v00);
+    fetch(x0 + 1, z0, v10);
+    fetch(x0, z0 + 1, v01);
+    fetch(x0 + 1, z0 + 1, v11);
+    for (int c = 0; c < 2; c++) {
+        float top = v00[c] + (v10[c] - v00[c]) * ax;
+        float bottom = v01[c] + (v11[c] - v01[c]) * ax;
+        r_value[c] = top + (bottom - top) * az;
+    }
+}
+
+// Column biome and, near an edge, the four neighbours sdf() blends with (one texel away);
+// sample(world_x, world_z, offset_x, offset_z, r_biome, r_dist_edge) reads the biome map
+template <typename Sample>
+void resolve_column(const Sample &sample, float world_x, float world_z, float blend_dist, ColumnBiome &r_column) {
+    float biome_r;
+    sample(world_x, world_z, 0.0f, 0.0f, biome_r, r_column.dist_edge);
+    r_column.biome_id = biome_from_norm(biome_r);
+
+    if (r_column.dist_edge < blend_dist) {
+        float r, g;
+        sample(world_x, world_z, 1.0f, 0.0f, r, g);
+        r_column.neighbors[0] = biome_from_norm(r);
+        sample(world_x, world_z, -1.0f, 0.0f, r, g);
+        r_column.neighbors[1] = biome_from_norm(r);
+        sample(world_x, world_z, 0.0f, 1.0f, r, g);
+        r_column.neighbors[2] = biome_from_norm(r);
+        sample(world_x, world_z, 0.0f, -1.0f, r, g);
+        r_column.neighbors[3] = biome_from_norm(r);
+    } else {
+        for (int n = 0; n < 4; n++) {
+            r_column.neighbors[n] = r_column.biome_id;
+        }
+    }
+}
+
+// sdf() in biome_gpu_sdf.compute: near an edge the biome SDF is mixed with its neighbours' average
+VF blend_biome_sdf(VF raw_sdf, const int (&neighbors)[4][LANES], VF dist_edge, const V3 &p, const CpuTerrainSampler::Params &params) {
+    VF neighbor_sum = get_biome_sdf_lanes(neighbors[0], p, params) +
+            get_biome_sdf_lanes(neighbors[1], p, params) +
+            get_biome_sdf_lanes(neighbors[2], p, params) +
+            get_biome_sdf_lanes(neighbors[3], p, params);
+    VF neighbor_avg = neighbor_sum * vset(0.25f);
+    VF blend_factor = dist_edge / vset(params.blend_dist);
+    return vselect(dist_edge < vset(params.blend_dist), vmix(neighbor_avg, raw_sdf, blend_factor), raw_sdf);
+}
+
+// carve_caves() in biome_gpu_sdf.compute; the noise is skipped when no lane can be carved
+const float CAVE_FBM_MAX = 0.875f;
+const float CAVE_SDF_SCALE = 0.5f;
+const float CAVE_NOISE_OFFSET[3] = { 37.0f, -91.0f, 53.0f };
+
+VF carve_caves(VF sdf, const V3 &p, const CpuTerrainSampler::Params &params) {
+    if (!params.caves_enabled) {
+        return sdf;
+    }
+    const float scale = CAVE_SDF_SCALE / params.cave_frequency;
+    VF fade = vmax(vset(params.cave_min_depth) + sdf, vset(0.0f));
+    if (vmask_bits(vset((CAVE_FBM_MAX - params.cave_threshold) * scale) - fade > sdf) == 0) {
+        return sdf;
+    }
+    const VF freq = vset(params.cave_frequency);
+    const float seed_offset = (float)params.seed;
+    V3 cave_p = {
+        p.x * freq + vset(seed_offset + CAVE_NOISE_OFFSET[0]),
+        p.y * freq + vset(seed_offset + CAVE_NOISE_OFFSET[1]),
+        p.z * freq + vset(seed_offset + CAVE_NOISE_OFFSET[2]),
+    };
+    VF cave_noise = fbm(cave_p, 1.0f, 3);
+    return vmax(sdf, (cave_noise - vset(params.cave_threshold)) * vset(scale) - fade);
+}
+
+// sample_surface() root search: fixed-point steps from y = 0, then a bracket widened from
+// SURFACE_BRACKET_STEP by doubling (about 16 km either way), then bisection
+const int SURFACE_ESTIMATE_STEPS = 4;
+const int SURFACE_BRACKET_STEPS = 12;
+const float SURFACE_BRACKET_STEP = 4.0f;
+const int SURFACE_BISECT_STEPS = 16;
+
+} // namespace
+
+CpuBiomeMap CpuBiomeMap::make_virtual(int32_t biome_count, float cell_scale, float jitter, uint32_t seed, float texel_size) {
+    CpuBiomeMap map;
+    map.biome_count = biome_count;
+    map.cell_scale = cell_scale;
+    map.jitter = jitter;
+    map.seed = seed;
+    map.texel_size = texel_size;
+    return map;
+}
+
+void CpuBiomeMap::evaluate_texel(int32_t tx, int32_t tz, float &r_biome, float &r_dist_edge) const {
+    // biome_at() in biome_map.compute, at the texel centre
+    const int32_t count = biome_count > 1 ? biome_count : 1;
+    const float norm_divisor = (float)(biome_count - 1 > 1 ? biome_count - 1 : 1);
+    const float cell = cell_scale;
+    const float world_x = ((float)tx + 0.5f) * texel_size;
+    const float world_y = ((float)tz + 0.5f) * texel_size;
+    const int base_x = (int)std::floor(world_x / cell);
+    const int base_y = (int)std::floor(world_y / cell);
+
+    float best1 = 1e9f;
+    float best2 = 1e9f;
+    int best_biome = 0;
+
+    for (int j = -1; j <= 1; ++j) {
+        for (int i = -1; i <= 1; ++i) {
+            int cx = base_x + i;
+            int cy = base_y + j;
+            uint32_t hx = (uint32_t)cx ^ seed;
+            uint32_t hy = (uint32_t)cy ^ seed;
+
+            float jitter_x = rand2(hx, hy) * jitter * cell;
+            float jitter_y = rand2(hx + 17u, hy + 17u) * jitter * cell;
+            float site_x = ((float)cx * cell) + (cell * 0.5f) + jitter_x;
+            float site_y = ((float)cy * cell) + (cell * 0.5f) + jitter_y;
+
+            float dx = world_x - site_x;
+            float dy = world_y - site_y;
+            float d = std::sqrt(dx * dx + dy * dy);
+            if (d < best1) {
+                best2 = best1;
+                best1 = d;
+                best_biome = (int)(hash2(hx * 31337u, hy * 31337u) % (uint32_t)count);
+            } else if (d < best2) {
+                best2 = d;
+            }
+        }
+    }
+
+    float dist_edge = (best2 - best1) / cell;
+    r_dist_edge = dist_edge < 0.0f ? 0.0f : (dist_edge > 1.0f ? 1.0f : dist_edge);
+    r_biome = (float)best_biome / norm_divisor;
+}
+
+void CpuBiomeMap::sample_world(float world_x, float world_z, float offset_x, float offset_z, float world_size, float &r_biome, float &r_dist_edge) const {
+    if (is_virtual()) {
+        float texel[2];
+        filter_virtual_texels(virtual_texel_coord(world_x, world_size, texel_size, offset_x),
+                virtual_texel_coord(world_z, world_size, texel_size, offset_z),
+                [this](int32_t tx, int32_t tz, float *r_value) { evaluate_texel(tx, tz, r_value[0], r_value[1]); }, texel);
+        r_biome = texel[0];
+        r_dist_edge = texel[1];
+        return;
+    }
+    const float texel_u = width > 0 ? 1.0f / (float)width : 0.0f;
+    const float texel_v = height > 0 ? 1.0f / (float)height : 0.0f;
+    sample(world_x / world_size + 0.5f + offset_x * texel_u, world_z / world_size + 0.5f + offset_z * texel_v, r_biome, r_dist_edge);
+}
+
+void CpuBiomeMap::sample(float u, float v, float &r_biome, float &r_dist_edge) const {
+    if (texels.empty()) {
+        r_biome = 0.0f;
+        r_dist_edge = 0.0f;
+        return;
+    }
+
+    float x = u * (float)width - 0.5f;
+    float y = v * (float)height - 0.5f;
+    float fx = std::floor(x);
+    float fy = std::floor(y);
+    float ax = x - fx;
+    float ay = y - fy;
+
+    auto clamp_index = [](int i, int n) { return i < 0 ? 0 : (i >= n ? n - 1 : i); };
+    int x0 = clamp_index((int)fx, width);
+    int x1 = clamp_index((int)fx + 1, width);
+    int y0 = clamp_index((int)fy, height);
+    int y1 = clamp_index((int)fy + 1, height);
+
+    const float *t00 = &texels[((size_t)y0 * width + x0) * 2];
+    const float *t10 = &texels[((size_t)y0 * width + x1) * 2];
+    const float *t01 = &texels[((size_t)y1 * width + x0) * 2];
+    const float *t11 = &texels[((size_t)y1 * width + x1) * 2];
+
+    for (int c = 0; c < 2; c++) {
+        float top = t00[c] + (t10[c] - t00[c]) * ax;
+        float bottom = t01[c] + (t11[c] - t01[c]) * ax;
+        float value = top + (bottom - top) * ay;
+        if (c == 0) {
+            r_biome = value;
+        } else {
+            r_dist_edge = value;
+        }
+    }
+}
+
+void CpuTerrainSampler::generate_chunk(const CpuBiomeMap &biome_map, const Params &params, const float origin[3], int chunk_size, float voxel_step, float *r_sdf, uint32_t *r_material) {
+    const int cs = chunk_size;
+    thread_local std::vector<ColumnBiome> columns;
+    columns.resize((size_t)cs * (size_t)cs);
+
+    // Virtual map: texels are shared by neighbouring columns, so the ones under a chunk are evaluated
+    // once into a window (with a margin for the blend neighbours) unless the chunk is coarse enough
+    // that evaluating per sample is cheaper
+    thread_local std::vector<float> window;
+    int32_t window_x = 0;
+    int32_t window_z = 0;
+    int window_size = 0;
+    if (biome_map.is_virtual()) {
+        const float extent = (float)(cs - 1) * voxel_step;
+        const int32_t first_x = (int32_t)std::floor(virtual_texel_coord(origin[0], params.world_size, biome_map.texel_size, 0.0f)) - 2;
+        const int32_t first_z = (int32_t)std::floor(virtual_texel_coord(origin[2], params.world_size, biome_map.texel_size, 0.0f)) - 2;
+        const int32_t last_x = (int32_t)std::floor(virtual_texel_coord(origin[0] + extent, params.world_size, biome_map.texel_size, 0.0f)) + 3;
+        const int span = (int)(last_x - first_x + 1);
+        if (span > 0 && span * span <= cs * cs * 2) {
+            window_x = first_x;
+            window_z = first_z;
+            window_size = span;
+            window.resize((size_t)span * span * 2);
+            for (int tz = 0; tz < span; tz++) {
+                for (int tx = 0; tx < span; tx++) {
+                    float *texel = &window[((size_t)tz * span + tx) * 2];
+                    biome_map.evaluate_texel(first_x + tx, first_z + tz, texel[0], texel[1]);
+                }
+            }
+        }
+    }
+    auto sample_biome = [&](float world_x, float world_z, float offset_x, float offset_z, float &r_biome, float &r_dist_edge) {
+        if (window_size == 0) {
+            biome_map.sample_world(world_x, world_z, offset_x, offset_z, params.world_size, r_biome, r_dist_edge);
+            return;
+        }
+        float value[2];
+        filter_virtual_texels(virtual_texel_coord(world_x, params.world_size, biome_map.texel_size, offset_x),
+                virtual_texel_coord(world_z, params.world_size, biome_map.texel_size, offset_z),
+                [&](int32_t tx, int32_t tz, float *r_value) {
+                    const int32_t lx = tx - window_x;
+                    const int32_t lz = tz - window_z;
+                    if (lx < 0 || lz < 0 || lx >= window_size || lz >= window_size) {
+                        biome_map.evaluate_texel(tx, tz, r_value[0], r_value[1]);
+                        return;
+                    }
+                    const float *texel = &window[((size_t)lz * window_size + lx) * 2];
+                    r_value[0] = texel[0];
+                    r_value[1] = texel[1];
+                },
+                value);
+        r_biome = value[0];
+        r_dist_edge = value[1];
+    };
+
+    for (int z = 0; z < cs; z++) {
+        for (int x = 0; x < cs; x++) {
+            const float world_x = origin[0] + (float)x * voxel_step;
+            const float world_z = origin[2] + (float)z * voxel_step;
+
+            resolve_column(sample_biome, world_x, world_z, params.blend_dist, columns[(size_t)z * cs + x]);
+        }
+    }
+
+    const float seed_offset = (float)params.seed;
+
+    for (int z = 0; z < cs; z++) {
+        const float world_z = origin[2] + (float)z * voxel_step;
+        const ColumnBiome *column_row = &columns[(size_t)z * cs];
+
+        for (int x0 = 0; x0 < cs; x0 += LANES) {
+            // Lane setup; lanes past the chunk edge repeat the last column and are not stored
+            const int lane_count = (cs - x0) < LANES ? (cs - x0) : LANES;
+            float lane_x[LANES];
+            float lane_dist[LANES];
+            int lane_biome[LANES];
+            int lane_neighbors[4][LANES];
+            bool any_blend = false;
+            for (int l = 0; l < LANES; l++) {
+                int x = x0 + (l < lane_count ? l : lane_count - 1);
+                const ColumnBiome &column = column_row[x];
+                lane_x[l] = origin[0] + (float)x * voxel_step;
+                lane_dist[l] = column.dist_edge;
+                lane_biome[l] = column.biome_id;
+                for (int n = 0; n < 4; n++) {
+                    lane_neighbors[n][l] = column.neighbors[n];
+                }
+                any_blend = any_blend || column.dist_edge < params.blend_dist;
+            }
+            const VF px = vload(lane_x);
+            const VF dist_edge = vload(lane_dist);
+
+            for (int y = 0; y < cs; y++) {
+                const V3 p = { px, vset(origin[1] + (float)y * voxel_step), vset(world_z) };
+
+                VF raw_sdf = get_biome_sdf_lanes(lane_biome, p, params);
+                VF sdf = raw_sdf;
+
+                if (any_blend) {
+                    sdf = blend_biome_sdf(raw_sdf, lane_neighbors, dist_edge, p, params);
+                }
+                sdf = carve_caves(sdf, p, params);
+
+                // get_material(): terrain height comes from the unblended biome SDF, like the shader
+                VF depth = (p.y - raw_sdf) - p.y;
+
+                float lane_sdf[LANES];
+                float lane_depth[LANES];
+                float lane_slope[LANES] = {};
+                float lane_ore[LANES] = {};
+                vstore(lane_sdf, sdf);
+                vstore(lane_depth, depth);
+
+                // Slope and ore noise are costly: only evaluated when some lane needs them
+                bool any_surface = false;
+                bool any_deep = false;
+                for (int l = 0; l < lane_count; l++) {
+                    if (lane_sdf[l] <= 0.0f) {
+                        any_surface = any_surface || lane_depth[l] < SURFACE_THICKNESS;
+                        any_deep = any_deep || lane_depth[l] >= SURFACE_THICKNESS + DIRT_THICKNESS;
+                    }
+                }
+                if (any_surface) {
+                    vstore(lane_slope, calculate_slope(p, params));
+                }
+                if (any_deep) {
+                    VF seed_v = vset(seed_offset);
+                    VF ore_freq = vset(params.ore_frequency);
+                    V3 ore_p = { p.x * ore_freq + seed_v, p.y * ore_freq + seed_v, p.z * ore_freq + seed_v };
+                    vstore(lane_ore, fbm(ore_p, 1.2f, 3));
+                }
+
+                const size_t row = ((size_t)z * cs + (size_t)y) * cs + (size_t)x0;
+                for (int l = 0; l < lane_count; l++) {
+                    const float s = lane_sdf[l];
+                    const float d = lane_depth[l];
+                    uint32_t material;
+                    if (s > 0.0f) {
+                        material = MAT_AIR;
+                    } else if (d < SURFACE_THICKNESS) {
+                        material = get_surface_material(lane_biome[l], lane_slope[l]);
+                    } else if (d < SURFACE_THICKNESS + DIRT_THICKNESS) {
+                        material = get_subsurface_material(lane_biome[l]);
+                    } else if (s <= -params.ore_min_depth && lane_ore[l] > params.ore_threshold) {
+                        material = params.ore_material;
+                    } else {
+                        material = MAT_STONE;
+                    }
+                    r_sdf[row + l] = s;
+                    r_material[row + l] = material;
+                }
+            }
+        }
+    }
+}
+
+void CpuTerrainSampler::sample_surface(const CpuBiomeMap &biome_map, const Params &params, const float *xz, int count, int32_t *r_biome, float *r_dist_edge, float *r_height) {
+    auto sample_biome = [&](float world_x, float world_z, float offset_x, float offset_z, float &r_biome_r, float &r_dist) {
+        biome_map.sample_world(world_x, world_z, offset_x, offset_z, params.world_size, r_biome_r, r_dist);
+    };
+
+    for (int i0 = 0; i0 < count; i0 += LANES) {
+        // Lanes past the end repeat the last column and are not stored
+        const int lane_count = (count - i0) < LANES ? (count - i0) : LANES;
+        float lane_x[LANES];
+        float lane_z[LANES];
+        float lane_dist[LANES];
+        int lane_biome[LANES];
+        int lane_neighbors[4][LANES];
+        bool any_blend = false;
+        ColumnBiome column;
+        for (int l = 0; l < LANES; l++) {
+            const int i = i0 + (l < lane_count ? l : lane_count - 1);
+            if (l < lane_count) {
+                resolve_column(sample_biome, xz[(size_t)i * 2], xz[(size_t)i * 2 + 1], params.blend_dist, column);
+                r_biome[i] = column.biome_id;
+                r_dist_edge[i] = column.dist_edge;
+            }
+            lane_x[l] = xz[(size_t)i * 2];
+            lane_z[l] = xz[(size_t)i * 2 + 1];
+            lane_dist[l] = column.dist_edge;
+            lane_biome[l] = column.biome_id;
+            for (int n = 0; n < 4; n++) {
+                lane_neighbors[n][l] = column.neighbors[n];
+            }
+            any_blend = any_blend || column.dist_edge < params.blend_dist;
+        }
+        if (!r_height) {
+            continue;
+        }
+
+        const VF px = vload(lane_x);
+        const VF pz = vload(lane_z);
+        const VF dist_edge = vload(lane_dist);
+        const VF zero = vset(0.0f);
+        auto field = [&](VF y) {
+            const V3 p = { px, y, pz };
+            VF sdf = get_biome_sdf_lanes(lane_biome, p, params);
+            return any_blend ? blend_biome_sdf(sdf, lane_neighbors, dist_edge, p, params) : sdf;
+        };
+
+        // Every biome SDF is roughly y - h(p) with h varying slowly in y, so y -= sdf converges on the surface
+        VF estimate = zero;
+        for (int n = 0; n < SURFACE_ESTIMATE_STEPS; n++) {
+            estimate = estimate - field(estimate);
+        }
+
+        // Bracket the crossing (field(lo) <= 0 < field(hi)): lanes in air search down, lanes in ground up
+        const uint32_t above = vmask_bits(field(estimate) > zero);
+        VF lo = estimate;
+        VF hi = estimate;
+        VF step = vset(SURFACE_BRACKET_STEP);
+        uint32_t open = ALL_LANES;
+        for (int n = 0; n < SURFACE_BRACKET_STEPS && open != 0; n++) {
+            const VF probe = vselect(vmask_from_bits(above), hi - step, lo + step);
+            const uint32_t air = vmask_bits(field(probe) > zero);
+            lo = vselect(vmask_from_bits(open & ~air), probe, lo);
+            hi = vselect(vmask_from_bits(open & air), probe, hi);
+            open &= ~(above ^ air);
+            step = step * vset(2.0f);
+        }
+
+        for (int n = 0; n < SURFACE_BISECT_STEPS; n++) {
+            const VF mid = (lo + hi) * vset(0.5f);
+            const VM air = field(mid) > zero;
+            hi = vselect(air, mid, hi);
+            lo = vselect(air, lo, mid);
+        }
+
+        // A lane that never bracketed keeps its estimate
+        float lane_height[LANES];
+        vstore(lane_height, vselect(vmask_from_bits(open), estimate, (lo + hi) * vset(0.5f)));
+        for (int l = 0; l < lane_count; l++) {
+            r_height[i0 + l] = lane_height[l];
+        }
+    }
+}
+
+int CpuTerrainSampler::get_simd_width() {
+    return LANES;
+}
+
+const char *CpuTerrainSampler::get_simd_name() {
+    return SIMD_NAME;
+}
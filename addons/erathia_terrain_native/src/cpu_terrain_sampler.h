@@ -0,0 +1,70 @@
+#ifndef CPU_TERRAIN_SAMPLER_H
+#define CPU_TERRAIN_SAMPLER_H
+
+#include <cstdint>
+#include <vector>
+
+// CpuBiomeMap: the biome map as the CPU fallback sees it (R = biome id normalized, G = distance to edge)
+// Either the unbounded virtual map, evaluated texel by texel exactly as biome_map.compute writes its
+// tiles, or a full custom map copied from set_biome_map_texture().
+struct CpuBiomeMap {
+    // Virtual map: the values biome_map.compute reads from its push constants
+    int32_t biome_count = 0;
+    float cell_scale = 0.0f;
+    float jitter = 0.0f;
+    uint32_t seed = 0;
+    float texel_size = 0.0f;  // World units per texel
+
+    // Custom map (texels empty for the virtual map)
+    int width = 0;
+    int height = 0;
+    std::vector<float> texels;  // width * height * 2, row-major
+
+    bool is_virtual() const { return texels.empty(); }
+
+    static CpuBiomeMap make_virtual(int32_t biome_count, float cell_scale, float jitter, uint32_t seed, float texel_size);
+    // Virtual map texel (tx, tz), centred at world ((tx, tz) + 0.5) * texel_size - world_size / 2
+    void evaluate_texel(int32_t tx, int32_t tz, float &r_biome, float &r_dist_edge) const;
+    // Mirrors sample_biome() in biome_gpu_sdf.compute: the map at world XZ, shifted by an offset in texels
+    void sample_world(float world_x, float world_z, float offset_x, float offset_z, float world_size, float &r_biome, float &r_dist_edge) const;
+    // Custom map: linear filtering with clamp-to-edge addressing, like the SDF shader's sampler
+    void sample(float u, float v, float &r_biome, float &r_dist_edge) const;
+};
+
+// CpuTerrainSampler: CPU implementation of biome_gpu_sdf.compute (SDF + material per voxel)
+// Uses the shader's hash/noise/biome functions, evaluated SIMD-wide along X (AVX2, SSE2 or NEON,
+// picked at compile time). Output is in GPU texel order (x fastest, then y, then z), so it feeds
+// the same VoxelBuffer bulk-write path as a GPU readback.
+// Matches the GPU within float tolerance rather than bit-exactly: the shader's sin() precision and
+// FMA contraction are driver-defined, and fract(sin(x) * 43758.5453) amplifies any difference.
+class CpuTerrainSampler {
+public:
+    // Push constants of biome_gpu_sdf.compute that affect the field
+    struct Params {
+        float world_size;
+        float sea_level;
+        float blend_dist;
+        uint32_t seed;
+        float ore_frequency;
+        float ore_threshold;
+        float ore_min_depth;
+        uint32_t ore_material;
+        bool caves_enabled;
+        float cave_frequency;
+        float cave_threshold;
+        float cave_min_depth;
+    };
+
+    // voxel_step = world units between samples, 1 << lod (chunk_origins[i].w in the shader)
+    static void generate_chunk(const CpuBiomeMap &biome_map, const Params &params, const float origin[3], int chunk_size, float voxel_step, float *r_sdf, uint32_t *r_material);
+    // Per column at world XZ (xz = count interleaved x, z pairs): biome id, distance to the biome edge
+    // and, unless r_height is null, the height where the blended SDF crosses zero. The crossing found
+    // is the one nearest the heightfield estimate, so an overhang can hide a higher surface. Caves are
+    // not carved: the height is that of the biome surface.
+    static void sample_surface(const CpuBiomeMap &biome_map, const Params &params, const float *xz, int count, int32_t *r_biome, float *r_dist_edge, float *r_height);
+
+    static int get_simd_width();
+    static const char *get_simd_name();
+};
+
+#endif // CPU_TERRAIN_SAMPLER_H
@@ -0,0 +1,500 @@
+#include "gpu_context.h"
+#include "trace_recorder.h"
+
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+#include <godot_cpp/classes/rd_sampler_state.hpp>
+#include <godot_cpp/classes/rd_shader_source.hpp>
+#include <godot_cpp/classes/rd_shader_spirv.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+using namespace godot;
+
+// The context is created by the first client and destroyed with the last one
+static std::mutex singleton_mutex;
+static NativeGPUContext *singleton = nullptr;
+static int singleton_refs = 0;
+
+// SPIR-V by cache key; outlives the context so re-created generators (editor, scene reloads) skip the compile
+static std::mutex spirv_cache_mutex;
+static std::unordered_map<uint64_t, PackedByteArray> spirv_cache;
+// Process-wide like the cache itself: the renderer's device compiles through it too
+static std::atomic<uint64_t> shader_memory_hits(0);
+static std::atomic<uint64_t> shader_disk_hits(0);
+static std::atomic<uint64_t> shader_compiles(0);
+static std::atomic<uint64_t> shader_compile_time_us(0);  // GLSL -> SPIR-V on cache misses
+static std::atomic<uint64_t> shader_create_time_us(0);  // shader_create_from_spirv(), every shader
+
+// On-disk entry: this header, then the bytecode
+struct SpirvCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t bytecode_size;
+    uint32_t reserved;
+};
+
+static const uint32_t SPIRV_CACHE_MAGIC = 0x56505345;  // "ESPV"
+// Bump when the key or file layout changes
+static const uint32_t SPIRV_CACHE_VERSION = 1;
+static const uint32_t SPIRV_MAGIC = 0x07230203;
+
+static uint64_t hash_string(uint64_t h, const String &value) {
+    // FNV-1a over UTF-8
+    const CharString utf8 = value.utf8();
+    const char *bytes = utf8.get_data();
+    for (int i = 0; i < utf8.length(); i++) {
+        h ^= (uint8_t)bytes[i];
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
+NativeGPUContext::NativeGPUContext() {
+    rd = nullptr;
+    device_available = false;
+    device_thread_id = 0;
+    running = false;
+    accepting_tasks = false;
+    chunk_texture_provider = nullptr;
+    chunk_texture_provider_set = false;
+    client_count = 0;
+    tasks_run = 0;
+    wakes = 0;
+    shared_texture_lookups = 0;
+    device_memory_bytes = 0;
+    device_memory_peak_bytes = 0;
+
+    work_semaphore.instantiate();
+    init_semaphore.instantiate();
+    task_mutex.instantiate();
+    client_mutex.instantiate();
+    biome_mutex.instantiate();
+}
+
+NativeGPUContext::~NativeGPUContext() {
+    shutdown();
+}
+
+NativeGPUContext *NativeGPUContext::acquire() {
+    std::lock_guard<std::mutex> lock(singleton_mutex);
+    if (!singleton) {
+        singleton = memnew(NativeGPUContext);
+        singleton->start();
+    }
+    singleton_refs++;
+    return singleton;
+}
+
+void NativeGPUContext::release(NativeGPUContext *context) {
+    NativeGPUContext *to_delete = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(singleton_mutex);
+        if (!context || context != singleton) {
+            return;
+        }
+        singleton_refs--;
+        if (singleton_refs == 0) {
+            to_delete = singleton;
+            singleton = nullptr;
+        }
+    }
+    // Joined outside the lock: a new acquire() meanwhile simply builds a fresh context
+    if (to_delete) {
+        memdelete(to_delete);
+    }
+}
+
+void NativeGPUContext::start() {
+    task_mutex->lock();
+    accepting_tasks = true;
+    task_mutex->unlock();
+
+    running = true;
+    device_thread.instantiate();
+    device_thread->start(callable_mp(this, &NativeGPUContext::device_loop));
+
+    // The device thread posts once device creation finished (or failed)
+    init_semaphore->wait();
+}
+
+void NativeGPUContext::shutdown() {
+    task_mutex->lock();
+    accepting_tasks = false;
+    task_mutex->unlock();
+
+    running = false;
+    work_semaphore->post();  // Wake the device thread so it can observe the stop flag
+    if (device_thread.is_valid() && device_thread->is_started()) {
+        device_thread->wait_to_finish();
+    }
+}
+
+bool NativeGPUContext::is_device_thread() const {
+    return device_thread_id != 0 && OS::get_singleton()->get_thread_caller_id() == device_thread_id;
+}
+
+void NativeGPUContext::device_loop() {
+    device_thread_id = OS::get_singleton()->get_thread_caller_id();
+    TraceRecorder::set_thread_name("NativeGPUContext");
+
+    RenderingServer *rs = RenderingServer::get_singleton();
+    if (rs) {
+        rd = rs->create_local_rendering_device();
+    }
+    if (!rd) {
+        UtilityFunctions::printerr("[NativeGPUContext] Failed to create RenderingDevice (compatibility renderer or headless mode?)");
+    }
+    device_available = rd != nullptr;
+    init_semaphore->post();
+
+    while (true) {
+        work_semaphore->wait();
+        wakes++;
+
+        // Blocking callers first, even when stopping: nobody is left waiting on a promise
+        run_tasks();
+        if (!running) {
+            break;
+        }
+        if (!rd) {
+            continue;
+        }
+
+        bool more = false;
+        client_mutex->lock();
+        for (Client *client : clients) {
+            more = client->process_gpu_work() || more;
+        }
+        client_mutex->unlock();
+
+        const uint64_t memory = rd->get_memory_usage(RenderingDevice::MEMORY_TOTAL);
+        device_memory_bytes = memory;
+        if (memory > device_memory_peak_bytes) {
+            device_memory_peak_bytes = memory;
+        }
+
+        // Work beyond one batch: go again without waiting for another wake
+        if (more) {
+            work_semaphore->post();
+        }
+    }
+    run_tasks();
+
+    if (rd) {
+        for (const SamplerSlot &slot : samplers) {
+            if (slot.sampler.is_valid()) {
+                rd->free_rid(slot.sampler);
+            }
+        }
+        samplers.clear();
+        memdelete(rd);
+        rd = nullptr;
+    }
+    device_available = false;
+}
+
+bool NativeGPUContext::run(const std::function<void()> &task) {
+    if (!device_available) {
+        return false;
+    }
+    if (is_device_thread()) {
+        task();
+        tasks_run++;
+        return true;
+    }
+
+    std::promise<bool> done;
+    std::future<bool> finished = done.get_future();
+
+    task_mutex->lock();
+    if (!accepting_tasks) {
+        task_mutex->unlock();
+        return false;
+    }
+    tasks.push_back({ task, &done });
+    task_mutex->unlock();
+
+    work_semaphore->post();
+    return finished.get();
+}
+
+void NativeGPUContext::run_tasks() {
+    std::deque<Task> pending;
+    task_mutex->lock();
+    pending.swap(tasks);
+    task_mutex->unlock();
+
+    for (Task &task : pending) {
+        bool ran = rd != nullptr;
+        if (ran) {
+            task.run();
+            tasks_run++;
+        }
+        task.done->set_value(ran);
+    }
+}
+
+void NativeGPUContext::wake() {
+    work_semaphore->post();
+}
+
+void NativeGPUContext::register_client(Client *client) {
+    client_mutex->lock();
+    if (std::find(clients.begin(), clients.end(), client) == clients.end()) {
+        clients.push_back(client);
+    }
+    client_count = (int)clients.size();
+    client_mutex->unlock();
+    work_semaphore->post();
+}
+
+void NativeGPUContext::unregister_client(Client *client) {
+    // client_mutex is held for a whole pass over the clients, so this waits out a running one
+    client_mutex->lock();
+    clients.erase(std::remove(clients.begin(), clients.end(), client), clients.end());
+    client_count = (int)clients.size();
+    client_mutex->unlock();
+}
+
+static uint64_t get_shader_cache_key(RenderingDevice *device, const String &source) {
+    // SPIR-V is device independent, but the compiler ships with the engine and the request that
+    // produced it named this device: a driver or engine update simply misses once
+    uint64_t h = 0xCBF29CE484222325ull;
+    h = hash_string(h, source);
+    h = hash_string(h, device->get_device_vendor_name());
+    h = hash_string(h, device->get_device_name());
+    h = hash_string(h, Engine::get_singleton()->get_version_info().get("string", ""));
+    h ^= SPIRV_CACHE_VERSION;
+    h *= 0x100000001B3ull;
+    return h;
+}
+
+static String get_spirv_cache_file(uint64_t key, const String &name) {
+    return String(NativeGPUContext::SHADER_CACHE_DIR).path_join(name + "_" + String::num_uint64(key, 16) + ".spv");
+}
+
+static bool load_cached_spirv(uint64_t key, const String &name, PackedByteArray &r_bytecode) {
+    {
+        std::lock_guard<std::mutex> lock(spirv_cache_mutex);
+        auto it = spirv_cache.find(key);
+        if (it != spirv_cache.end()) {
+            r_bytecode = it->second;
+            shader_memory_hits++;
+            return true;
+        }
+    }
+
+    const String path = get_spirv_cache_file(key, name);
+    if (!FileAccess::file_exists(path)) {
+        return false;
+    }
+    PackedByteArray blob = FileAccess::get_file_as_bytes(path);
+    SpirvCacheHeader header;
+    if (blob.size() < (int64_t)sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, blob.ptr(), sizeof(header));
+    // A truncated or foreign file is recompiled and overwritten
+    if (header.magic != SPIRV_CACHE_MAGIC || header.version != SPIRV_CACHE_VERSION || header.key != key ||
+            header.bytecode_size < sizeof(uint32_t) || blob.size() != (int64_t)(sizeof(header) + header.bytecode_size)) {
+        return false;
+    }
+    r_bytecode = blob.slice(sizeof(header));
+    uint32_t spirv_magic;
+    std::memcpy(&spirv_magic, r_bytecode.ptr(), sizeof(spirv_magic));
+    if (spirv_magic != SPIRV_MAGIC) {
+        r_bytecode = PackedByteArray();
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(spirv_cache_mutex);
+    spirv_cache[key] = r_bytecode;
+    shader_disk_hits++;
+    return true;
+}
+
+static void store_cached_spirv(uint64_t key, const String &name, const PackedByteArray &bytecode) {
+    {
+        std::lock_guard<std::mutex> lock(spirv_cache_mutex);
+        spirv_cache[key] = bytecode;
+    }
+
+    // Best effort: without a writable user:// the next run compiles again
+    if (DirAccess::make_dir_recursive_absolute(NativeGPUContext::SHADER_CACHE_DIR) != OK) {
+        return;
+    }
+    Ref<FileAccess> file = FileAccess::open(get_spirv_cache_file(key, name), FileAccess::WRITE);
+    if (file.is_null()) {
+        return;
+    }
+    SpirvCacheHeader header = { SPIRV_CACHE_MAGIC, SPIRV_CACHE_VERSION, key, (uint32_t)bytecode.size(), 0 };
+    PackedByteArray header_bytes;
+    header_bytes.resize(sizeof(header));
+    std::memcpy(header_bytes.ptrw(), &header, sizeof(header));
+    file->store_buffer(header_bytes);
+    file->store_buffer(bytecode);
+}
+
+String NativeGPUContext::insert_shader_defines(const String &source, const String &defines) {
+    if (defines.is_empty()) {
+        return source;
+    }
+    int version_end = source.find("\n");
+    if (source.begins_with("#version") && version_end >= 0) {
+        return source.substr(0, version_end + 1) + defines + source.substr(version_end + 1);
+    }
+    return defines + source;
+}
+
+RID NativeGPUContext::create_compute_shader(const String &source, const String &name, String &r_error) {
+    return create_compute_shader(rd, source, name, r_error);
+}
+
+RID NativeGPUContext::create_compute_shader(RenderingDevice *device, const String &source, const String &name, String &r_error) {
+    if (!device) {
+        r_error = "No RenderingDevice";
+        return RID();
+    }
+
+    const uint64_t key = get_shader_cache_key(device, source);
+    PackedByteArray bytecode;
+    bool cached = load_cached_spirv(key, name, bytecode);
+    if (!cached) {
+        const uint64_t compile_start_us = Time::get_singleton()->get_ticks_usec();
+        Ref<RDShaderSource> shader_source;
+        shader_source.instantiate();
+        shader_source->set_stage_source(RenderingDevice::SHADER_STAGE_COMPUTE, source);
+        shader_source->set_language(RenderingDevice::SHADER_LANGUAGE_GLSL);
+        Ref<RDShaderSPIRV> compiled = device->shader_compile_spirv_from_source(shader_source);
+        shader_compile_time_us += Time::get_singleton()->get_ticks_usec() - compile_start_us;
+        shader_compiles++;
+
+        if (!compiled.is_valid()) {
+            r_error = "Invalid SPIRV";
+            return RID();
+        }
+        r_error = compiled->get_stage_compile_error(RenderingDevice::SHADER_STAGE_COMPUTE);
+        if (r_error != "") {
+            return RID();
+        }
+        bytecode = compiled->get_stage_bytecode(RenderingDevice::SHADER_STAGE_COMPUTE);
+    }
+
+    const uint64_t create_start_us = Time::get_singleton()->get_ticks_usec();
+    Ref<RDShaderSPIRV> spirv;
+    spirv.instantiate();
+    spirv->set_stage_bytecode(RenderingDevice::SHADER_STAGE_COMPUTE, bytecode);
+    RID shader = device->shader_create_from_spirv(spirv, name);
+    shader_create_time_us += Time::get_singleton()->get_ticks_usec() - create_start_us;
+
+    if (!shader.is_valid() && cached) {
+        // The cached bytecode was rejected: drop it and compile from source once
+        {
+            std::lock_guard<std::mutex> lock(spirv_cache_mutex);
+            spirv_cache.erase(key);
+        }
+        DirAccess::remove_absolute(get_spirv_cache_file(key, name));
+        return create_compute_shader(device, source, name, r_error);
+    }
+    if (!shader.is_valid()) {
+        r_error = "Failed to create shader from SPIRV";
+        return RID();
+    }
+    if (!cached) {
+        store_cached_spirv(key, name, bytecode);
+    }
+    r_error = String();
+    return shader;
+}
+
+RID NativeGPUContext::get_sampler(RenderingDevice::SamplerFilter filter, RenderingDevice::SamplerRepeatMode repeat) {
+    for (const SamplerSlot &slot : samplers) {
+        if (slot.filter == filter && slot.repeat == repeat) {
+            return slot.sampler;
+        }
+    }
+    if (!rd) {
+        return RID();
+    }
+
+    Ref<RDSamplerState> sampler_state;
+    sampler_state.instantiate();
+    sampler_state->set_min_filter(filter);
+    sampler_state->set_mag_filter(filter);
+    sampler_state->set_repeat_u(repeat);
+    sampler_state->set_repeat_v(repeat);
+    sampler_state->set_repeat_w(repeat);
+
+    RID sampler = rd->sampler_create(sampler_state);
+    if (sampler.is_valid()) {
+        samplers.push_back({ filter, repeat, sampler });
+    }
+    return sampler;
+}
+
+void NativeGPUContext::set_biome_map_texture(RID texture) {
+    biome_mutex->lock();
+    biome_map_texture = texture;
+    biome_mutex->unlock();
+}
+
+RID NativeGPUContext::get_biome_map_texture() const {
+    biome_mutex->lock();
+    RID texture = biome_map_texture;
+    biome_mutex->unlock();
+    return texture;
+}
+
+void NativeGPUContext::set_chunk_texture_provider(ChunkTextureProvider *provider) {
+    chunk_texture_provider = provider;
+    chunk_texture_provider_set = provider != nullptr;
+}
+
+void NativeGPUContext::clear_chunk_texture_provider(ChunkTextureProvider *provider) {
+    if (chunk_texture_provider == provider) {
+        chunk_texture_provider = nullptr;
+        chunk_texture_provider_set = false;
+    }
+}
+
+RID NativeGPUContext::get_chunk_sdf_texture(const Vector3i &chunk_origin, int chunk_size) {
+    // Textures of another chunk size would be sampled with the wrong extent
+    if (!chunk_texture_provider || chunk_texture_provider->get_chunk_texture_size() != chunk_size) {
+        return RID();
+    }
+    shared_texture_lookups++;
+    return chunk_texture_provider->get_chunk_sdf_texture(chunk_origin);
+}
+
+Dictionary NativeGPUContext::get_telemetry() const {
+    Dictionary stats;
+    stats["device_available"] = device_available.load();
+    stats["tasks_run"] = (int64_t)tasks_run.load();
+    stats["wakes"] = (int64_t)wakes.load();
+    stats["shared_texture_lookups"] = (int64_t)shared_texture_lookups.load();
+    stats["has_chunk_texture_provider"] = chunk_texture_provider_set.load();
+    stats["has_biome_map"] = get_biome_map_texture().is_valid();
+    stats["clients"] = client_count.load();
+    stats["device_memory_bytes"] = (int64_t)device_memory_bytes.load();
+    stats["device_memory_peak_bytes"] = (int64_t)device_memory_peak_bytes.load();
+    stats["shader_cache_memory_hits"] = (int64_t)shader_memory_hits.load();
+    stats["shader_cache_disk_hits"] = (int64_t)shader_disk_hits.load();
+    stats["shader_compiles"] = (int64_t)shader_compiles.load();
+    stats["shader_compile_ms"] = (float)shader_compile_time_us.load() / 1000.0f;
+    stats["shader_create_ms"] = (float)shader_create_time_us.load() / 1000.0f;
+    return stats;
+}
+
+void NativeGPUContext::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("get_telemetry"), &NativeGPUContext::get_telemetry);
+}
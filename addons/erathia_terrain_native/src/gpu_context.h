@@ -0,0 +1,151 @@
+#ifndef GPU_CONTEXT_H
+#define GPU_CONTEXT_H
+
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/classes/rendering_device.hpp>
+#include <godot_cpp/classes/mutex.hpp>
+#include <godot_cpp/classes/semaphore.hpp>
+#include <godot_cpp/classes/thread.hpp>
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/rid.hpp>
+#include <godot_cpp/variant/vector3i.hpp>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <vector>
+
+using namespace godot;
+
+// NativeGPUContext: the one local RenderingDevice shared by NativeTerrainGenerator and
+// NativeVegetationDispatcher. Its device thread creates the device and is the only thread that
+// records, submits, syncs or reads back: clients hand it blocking tasks through run() and do their
+// streaming work in Client::process_gpu_work(), which it calls after every wake. Because every
+// client runs on that thread, a texture one client creates can be bound by another as-is.
+// Reference counted through acquire()/release(); the device lives while any client holds it.
+class NativeGPUContext : public Object {
+    GDCLASS(NativeGPUContext, Object)
+
+public:
+    class Client {
+    public:
+        virtual ~Client() {}
+        // Device thread; returns true when work is left so the thread goes again without a wake
+        virtual bool process_gpu_work() = 0;
+    };
+
+    // Typed access to generated chunk textures, implemented by NativeTerrainGenerator
+    class ChunkTextureProvider {
+    public:
+        virtual ~ChunkTextureProvider() {}
+        // Device thread; invalid RID for chunks that are not cached or carry no texture (uniform).
+        // The texture stays valid until the provider's next process_gpu_work().
+        virtual RID get_chunk_sdf_texture(const Vector3i &chunk_origin) = 0;
+        virtual int get_chunk_texture_size() const = 0;
+    };
+
+    // Starts the device thread on first use and waits for device creation; never null
+    static NativeGPUContext *acquire();
+    // The last release frees the shared resources and the device
+    static void release(NativeGPUContext *context);
+
+    bool is_device_available() const { return device_available; }
+    bool is_device_thread() const;
+    RenderingDevice *get_device() const { return rd; }  // Device thread only
+
+    // Blocks until the device thread has run the task (runs inline on the device thread).
+    // Returns false, without running it, when there is no device or the context is shutting down.
+    bool run(const std::function<void()> &task);
+    void wake();
+
+    void register_client(Client *client);
+    // Returns once the device thread is no longer inside the client's process_gpu_work()
+    void unregister_client(Client *client);
+
+    // Shader variants: defines go right after the #version line
+    static String insert_shader_defines(const String &source, const String &defines);
+    // Creates a compute shader from GLSL source, skipping the GLSL -> SPIR-V compile when the same
+    // source was compiled before on this device: SPIR-V is cached in memory for the process and under
+    // SHADER_CACHE_DIR across runs, keyed by a hash of the source, the device and the engine version.
+    // Call it on the thread that owns device (the renderer's device on the render thread). Returns an
+    // invalid RID and sets r_error when compilation fails; the caller owns the shader.
+    static RID create_compute_shader(RenderingDevice *device, const String &source, const String &name, String &r_error);
+    // Device thread only: the above on this context's device
+    RID create_compute_shader(const String &source, const String &name, String &r_error);
+
+    // Device thread only: one sampler per filter/repeat combination, freed with the device
+    RID get_sampler(RenderingDevice::SamplerFilter filter, RenderingDevice::SamplerRepeatMode repeat);
+
+    // World-space biome map published by the terrain generator (invalid while it uses the virtual
+    // map); readable from any thread, bind only on the device thread
+    void set_biome_map_texture(RID texture);
+    RID get_biome_map_texture() const;
+
+    // Device thread only. clear_*() leaves a provider registered by someone else in place.
+    void set_chunk_texture_provider(ChunkTextureProvider *provider);
+    void clear_chunk_texture_provider(ChunkTextureProvider *provider);
+    bool has_chunk_texture_provider() const { return chunk_texture_provider_set; }
+    RID get_chunk_sdf_texture(const Vector3i &chunk_origin, int chunk_size);
+
+    Dictionary get_telemetry() const;
+
+    static constexpr const char *SHADER_CACHE_DIR = "user://shader_cache";
+
+    NativeGPUContext();
+    ~NativeGPUContext();
+
+protected:
+    static void _bind_methods();
+
+private:
+    struct Task {
+        std::function<void()> run;
+        std::promise<bool> *done;
+    };
+
+    struct SamplerSlot {
+        RenderingDevice::SamplerFilter filter;
+        RenderingDevice::SamplerRepeatMode repeat;
+        RID sampler;
+    };
+
+    RenderingDevice *rd;  // Created, used and freed on device_thread only
+    std::atomic<bool> device_available;
+    std::atomic<uint64_t> device_thread_id;
+
+    Ref<Thread> device_thread;
+    std::atomic<bool> running;
+    Ref<Semaphore> work_semaphore;
+    Ref<Semaphore> init_semaphore;
+
+    Ref<Mutex> task_mutex;
+    std::deque<Task> tasks;  // Guarded by task_mutex
+    bool accepting_tasks;
+
+    Ref<Mutex> client_mutex;  // Held by the device thread while it runs the clients
+    std::vector<Client *> clients;
+    std::atomic<int> client_count;  // Telemetry must not wait for a pass to finish
+
+    std::vector<SamplerSlot> samplers;  // Device thread only
+    ChunkTextureProvider *chunk_texture_provider;  // Device thread only
+    std::atomic<bool> chunk_texture_provider_set;
+    mutable Ref<Mutex> biome_mutex;
+    RID biome_map_texture;
+
+    std::atomic<uint64_t> tasks_run;
+    std::atomic<uint64_t> wakes;
+    std::atomic<uint64_t> shared_texture_lookups;
+    // Sampled by the device thread after every pass (RenderingDevice::MEMORY_TOTAL)
+    std::atomic<uint64_t> device_memory_bytes;
+    std::atomic<uint64_t> device_memory_peak_bytes;
+    void start();
+    void shutdown();
+    void device_loop();
+    void run_tasks();
+};
+
+#endif // GPU_CONTEXT_H
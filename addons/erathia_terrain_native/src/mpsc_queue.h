@@ -0,0 +1,59 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+
+// MPSCQueue: unbounded lock-free multi-producer / single-consumer queue (Vyukov's node-based design)
+// push() is a single atomic exchange and never blocks producers on each other or on the consumer.
+// pop() must only be called from one consumer thread; it can briefly report empty while a concurrent
+// push() is between its exchange and its link, so consumers wake on a semaphore and drain until empty.
+template <typename T>
+class MPSCQueue {
+public:
+    MPSCQueue() {
+        Node *stub = new Node();
+        head.store(stub, std::memory_order_relaxed);
+        tail = stub;
+    }
+
+    ~MPSCQueue() {
+        T value;
+        while (pop(value)) {
+        }
+        delete tail;
+    }
+
+    MPSCQueue(const MPSCQueue &) = delete;
+    MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+    void push(T value) {
+        Node *node = new Node();
+        node->value = std::move(value);
+        Node *prev = head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    bool pop(T &r_value) {
+        Node *next = tail->next.load(std::memory_order_acquire);
+        if (!next) {
+            return false;
+        }
+        // next becomes the new stub; its value is moved out and the old stub is freed
+        r_value = std::move(next->value);
+        delete tail;
+        tail = next;
+        return true;
+    }
+
+private:
+    struct Node {
+        std::atomic<Node *> next{ nullptr };
+        T value;
+    };
+
+    std::atomic<Node *> head;  // Producers
+    Node *tail;  // Consumer only
+};
+
+#endif // MPSC_QUEUE_H
@@ -1,51 +1,170 @@
 #include "native_terrain_generator.h"
-#include <godot_cpp/classes/rendering_server.hpp>
+#include "voxel_bulk_copy.h"
+#include "trace_recorder.h"
 #include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/classes/rd_shader_file.hpp>
-#include <godot_cpp/classes/rd_shader_source.hpp>
-#include <godot_cpp/classes/rd_shader_spirv.hpp>
 #include <godot_cpp/classes/rd_uniform.hpp>
-#include <godot_cpp/classes/rd_sampler_state.hpp>
 #include <godot_cpp/classes/rd_texture_format.hpp>
 #include <godot_cpp/classes/rd_texture_view.hpp>
 #include <godot_cpp/classes/os.hpp>
 #include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
 #include <godot_cpp/core/class_db.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Inverse of encode_ordered_float() in biome_gpu_sdf.compute
+static float decode_ordered_float(uint32_t key) {
+    uint32_t bits = (key & 0x80000000u) != 0 ? (key & 0x7FFFFFFFu) : ~key;
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Raw layout of a region cache blob (ZSTD-compressed on disk): this header, then the SDF and
+// material texels in GPU order. Uniform chunks store the header only.
+struct RegionChunkHeader {
+    uint32_t version;
+    int32_t origin[3];
+    int32_t lod;
+    int32_t chunk_size;
+    uint32_t storage_mode;
+    uint32_t uniform;
+    float uniform_sdf;
+    uint32_t uniform_material;
+    uint32_t sdf_bytes;
+    uint32_t mat_bytes;
+};
+
+// Bump when biome_gpu_sdf.compute or CpuTerrainSampler output changes: stored chunks move to a new directory
+static const uint32_t REGION_CHUNK_VERSION = 2;
+
+static int32_t floor_div(int32_t value, int32_t divisor) {
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+static uint64_t hash_bytes(uint64_t h, const void *data, size_t size) {
+    // FNV-1a
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; i++) {
+        h ^= bytes[i];
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
 NativeTerrainGenerator::NativeTerrainGenerator() {
+    gpu_context = nullptr;
     rd = nullptr;
     world_seed = 0;
     chunk_size = 32;
     world_size = 16000.0f;
     sea_level = 0.0f;
     blend_dist = 0.2f;
+    biome_map_texel_size = DEFAULT_BIOME_MAP_TEXEL_SIZE;
+    ore_frequency = 0.07f;
+    ore_threshold = 0.6f;
+    ore_min_depth = 10.0f;
+    ore_material_id = 3;  // MAT_IRON_ORE
+    caves_enabled = false;
+    cave_frequency = 0.02f;
+    cave_threshold = 0.35f;
+    cave_min_depth = 8.0f;
+    biome_tiles_signature = 0;
+    biome_tiles_resident = 0;
+    biome_tile_hits = 0;
+    biome_tiles_generated = 0;
+    biome_tile_evictions = 0;
+    biome_tiles_unplaced = 0;
     gpu_initialized = false;
     gpu_status_message = "Not initialized";
+    cpu_fallback_active = false;
+    cpu_biome_map_is_custom = false;
+    cpu_biome_map_seed = 0;
+    cpu_biome_map_texel_size = 0.0f;
+    cpu_chunks_generated = 0;
+    avg_cpu_chunk_time_us = 0;
+    custom_biome_map_hash = 0;
+    surface_points_queried = 0;
+    region_store_signature = 0;
+    region_hits = 0;
+    region_misses = 0;
+    region_writes = 0;
     player_position = Vector3(0, 0, 0);  // Initialize player position
+    view_direction = Vector3(0, 0, 0);
+    view_weight = 1.0f;
+    max_request_distance = 0.0f;
+    requests_deduplicated = 0;
+    requests_cancelled = 0;
+    requests_dropped = 0;
+    dispatch_wait_next = 0;
+    first_request_time_us = 0;
+    first_chunk_latency_us = 0;
+    prewarm_total = 0;
+    prewarm_done = 0;
+    prewarm_failed = 0;
+    prewarm_reported = 0;
+    prewarm_start_us = 0;
     
     cache_mutex.instantiate();
     queue_mutex.instantiate();
+    init_mutex.instantiate();
+    pool_mutex.instantiate();
+    cpu_mutex.instantiate();
+    surface_query_mutex.instantiate();
+    region_mutex.instantiate();
     
     // Async GPU infrastructure initialization
-    readback_thread_running = false;
+    gpu_client_active = false;
+    next_fence = 1;
+    completed_fence = 0;
+    sync_requests_total = 0;
+    sync_batches_submitted = 0;
+    last_sync_batch_size = 0;
     frame_gpu_budget_us = 8000;  // 8ms budget
     current_frame_gpu_time_us = 0;
+    avg_chunk_gpu_time_us = 0;
     chunks_dispatched_this_frame = 0;
     chunks_completed_this_frame = 0;
     total_gpu_time_us = 0;
     total_chunks_generated = 0;
+    chunks_completed_since_poll = 0;
+    last_batch_gpu_time_us = 0;
+    last_batch_size = 0;
+    gpu_timestamps_available = false;
+    uniform_chunks_skipped = 0;
+    sdf_edits_applied = 0;
+    sdf_edit_chunk_patches = 0;
+    chunks_invalidated = 0;
+    texture_pool_chunk_size = 0;
+    cache_budget_mb = 512;
+    storage_mode = STORAGE_FULL;
+    texture_pairs_created = 0;
+    texture_pairs_reused = 0;
+    collision_buffers_chunk_size = 0;
+    collision_only = false;
+    collision_meshes_built = 0;
+    collision_overflows = 0;
+    collision_bytes_read = 0;
+    collision_readback_bytes_saved = 0;
     
     // Initialize GPU immediately to ensure availability checks work
-    initialize_gpu();
-    
-    // Start background readback thread
-    start_readback_thread();
+    // (joins the shared GPU context, whose device thread owns the RenderingDevice).
+    // Editor instances (inspector previews, scene loads) wait for generate_block(), which initializes on demand.
+    if (!Engine::get_singleton()->is_editor_hint()) {
+        initialize_gpu();
+    }
 }
 
 NativeTerrainGenerator::~NativeTerrainGenerator() {
-    stop_readback_thread();
     cleanup_gpu();
 }
 
@@ -54,14 +173,43 @@ bool NativeTerrainGenerator::initialize_gpu() {
         return true;
     }
 
-    RenderingServer *rs = RenderingServer::get_singleton();
-    if (!rs) {
-        gpu_status_message = "RenderingServer not available";
-        UtilityFunctions::printerr("[NativeTerrainGenerator] RenderingServer not available");
-        return false;
+    init_mutex->lock();
+    if (!gpu_initialized) {
+        // Drop a context left over from a failed attempt before retrying
+        detach_gpu_context();
+        gpu_context = NativeGPUContext::acquire();
+
+        // Shader compilation and the biome map run on the device thread, like every later submit
+        bool ok = false;
+        if (!gpu_context->run([this, &ok]() { ok = initialize_gpu_on_worker(); })) {
+            gpu_status_message = "Failed to create RenderingDevice (compatibility renderer or headless mode?)";
+        }
+        if (ok) {
+            gpu_initialized = true;
+            gpu_client_active = true;
+            gpu_context->register_client(this);
+        } else {
+            gpu_context->run([this]() { release_gpu_resources(); });
+            NativeGPUContext::release(gpu_context);
+            gpu_context = nullptr;
+        }
+
+        // generate_block() stops retrying and switches to the CPU sampler until initialize_gpu() succeeds
+        bool fallback = !gpu_initialized;
+        if (fallback && !cpu_fallback_active) {
+            UtilityFunctions::print("[NativeTerrainGenerator] GPU unavailable, generating terrain on the CPU (",
+                CpuTerrainSampler::get_simd_name(), ")");
+        }
+        cpu_fallback_active = fallback;
     }
+    init_mutex->unlock();
+
+    return gpu_initialized;
+}
 
-    rd = rs->create_local_rendering_device();
+bool NativeTerrainGenerator::initialize_gpu_on_worker() {
+    // The shared device; the context created it on this thread, which every submit/sync/readback uses
+    rd = gpu_context->get_device();
     if (!rd) {
         gpu_status_message = "Failed to create RenderingDevice (compatibility renderer or headless mode?)";
         UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create RenderingDevice");
@@ -78,18 +226,53 @@ bool NativeTerrainGenerator::initialize_gpu() {
         return false;
     }
 
-    gpu_initialized = true;
+    // Optional: without it edits only reach the textures of chunks generated after them
+    compile_sdf_edit_shader();
+    // Optional: without it collision-only mode reads chunks back in full
+    compile_collision_shader();
+
+    if (!create_biome_atlas()) {
+        return false;
+    }
+
+    // A custom map outlives GPU rebuilds (storage mode changes): upload it again
+    cpu_mutex->lock();
+    std::shared_ptr<const CpuBiomeMap> custom_map = cpu_biome_map_is_custom ? cpu_biome_map : nullptr;
+    cpu_mutex->unlock();
+    if (custom_map && !biome_map_texture.is_valid()) {
+        biome_map_texture = create_custom_biome_map_texture(*custom_map);
+    }
+
+    // Other clients of the device (vegetation placement) bind these directly. Only a world-space map
+    // is published: the virtual map's tile atlas is meaningless without its page table.
+    gpu_context->set_biome_map_texture(biome_map_texture);
+    gpu_context->set_chunk_texture_provider(this);
+
     gpu_status_message = "GPU initialized successfully (biome map + SDF pipelines)";
     UtilityFunctions::print("[NativeTerrainGenerator] GPU initialized successfully with both pipelines");
     return true;
 }
 
 void NativeTerrainGenerator::cleanup_gpu() {
+    // Device resources are released on the device thread; the device itself outlives this client
+    init_mutex->lock();
+    detach_gpu_context();
+    init_mutex->unlock();
+}
+
+void NativeTerrainGenerator::release_gpu_resources() {
     if (!rd) {
         return;
     }
 
-    // Free all in-flight chunk textures and fences
+    // Unpublish before freeing: other clients must not bind textures that are about to go away
+    gpu_context->clear_chunk_texture_provider(this);
+    RID published_biome_map = gpu_context->get_biome_map_texture();
+    if (published_biome_map.is_valid() && published_biome_map == biome_map_texture) {
+        gpu_context->set_biome_map_texture(RID());
+    }
+
+    // Free all in-flight chunk textures
     queue_mutex->lock();
     for (auto& pair : chunk_gpu_states) {
         if (pair.second.sdf_texture.is_valid()) {
@@ -98,32 +281,26 @@ void NativeTerrainGenerator::cleanup_gpu() {
         if (pair.second.material_texture.is_valid()) {
             rd->free_rid(pair.second.material_texture);
         }
-        if (pair.second.fence.is_valid()) {
-            rd->free_rid(pair.second.fence);
-        }
     }
     chunk_gpu_states.clear();
+    pending_batches.clear();
     queue_mutex->unlock();
 
+    std::vector<ChunkCache::Entry> cached_entries;
     cache_mutex->lock();
-    Array keys = sdf_cache.keys();
-    for (int i = 0; i < keys.size(); i++) {
-        Dictionary textures = sdf_cache[keys[i]];
-        if (textures.has("sdf")) {
-            RID sdf_rid = textures["sdf"];
-            if (sdf_rid.is_valid()) {
-                rd->free_rid(sdf_rid);
-            }
+    chunk_cache.clear(cached_entries);
+    cache_mutex->unlock();
+
+    for (const ChunkCache::Entry &entry : cached_entries) {
+        if (entry.sdf_texture.is_valid()) {
+            rd->free_rid(entry.sdf_texture);
         }
-        if (textures.has("material")) {
-            RID mat_rid = textures["material"];
-            if (mat_rid.is_valid()) {
-                rd->free_rid(mat_rid);
-            }
+        if (entry.material_texture.is_valid()) {
+            rd->free_rid(entry.material_texture);
         }
     }
-    sdf_cache.clear();
-    cache_mutex->unlock();
+
+    free_texture_pool();
 
     // Free all tracked samplers
     for (size_t i = 0; i < sampler_rids.size(); i++) {
@@ -132,11 +309,41 @@ void NativeTerrainGenerator::cleanup_gpu() {
         }
     }
     sampler_rids.clear();
-    
-    if (cached_sampler.is_valid()) {
-        rd->free_rid(cached_sampler);
-        cached_sampler = RID();
+
+    if (sdf_batch_origin_buffer.is_valid()) {
+        rd->free_rid(sdf_batch_origin_buffer);
+        sdf_batch_origin_buffer = RID();
+    }
+    if (sdf_batch_summary_buffer.is_valid()) {
+        rd->free_rid(sdf_batch_summary_buffer);
+        sdf_batch_summary_buffer = RID();
+    }
+
+    queue_mutex->lock();
+    pending_sdf_edits.clear();
+    queue_mutex->unlock();
+    if (sdf_edit_pipeline.is_valid()) {
+        rd->free_rid(sdf_edit_pipeline);
+        sdf_edit_pipeline = RID();
+    }
+    if (sdf_edit_shader.is_valid()) {
+        rd->free_rid(sdf_edit_shader);
+        sdf_edit_shader = RID();
+    }
+
+    RID *collision_rids[] = { &collision_pipeline, &collision_shader, &collision_apron_pipeline, &collision_apron_shader,
+        &collision_origin_buffer, &collision_count_buffer, &collision_cell_buffer, &collision_vertex_buffer, &collision_index_buffer };
+    for (RID *collision_rid : collision_rids) {
+        if (collision_rid->is_valid()) {
+            rd->free_rid(*collision_rid);
+            *collision_rid = RID();
+        }
     }
+    for (const RID &apron_texture : collision_apron_textures) {
+        rd->free_rid(apron_texture);
+    }
+    collision_apron_textures.clear();
+    collision_buffers_chunk_size = 0;
 
     if (sdf_pipeline.is_valid()) {
         rd->free_rid(sdf_pipeline);
@@ -161,6 +368,26 @@ void NativeTerrainGenerator::cleanup_gpu() {
         biome_map_texture = RID();
     }
 
+    if (biome_tile_uniform_set.is_valid()) {
+        rd->free_rid(biome_tile_uniform_set);
+        biome_tile_uniform_set = RID();
+    }
+    if (biome_atlas_texture.is_valid()) {
+        rd->free_rid(biome_atlas_texture);
+        biome_atlas_texture = RID();
+    }
+    if (biome_page_table_buffer.is_valid()) {
+        rd->free_rid(biome_page_table_buffer);
+        biome_page_table_buffer = RID();
+    }
+    if (biome_tile_list_buffer.is_valid()) {
+        rd->free_rid(biome_tile_list_buffer);
+        biome_tile_list_buffer = RID();
+    }
+    biome_tiles.clear();
+    biome_tiles_signature = 0;
+    biome_tiles_resident = 0;
+
     rd = nullptr;
     gpu_initialized = false;
     gpu_status_message = "GPU cleaned up";
@@ -180,31 +407,132 @@ RID NativeTerrainGenerator::create_3d_texture(RenderingDevice::DataFormat format
         RenderingDevice::TEXTURE_USAGE_SAMPLING_BIT
     );
 
-    PackedByteArray empty_data;
-    int bytes_per_pixel = (format == RenderingDevice::DATA_FORMAT_R32_SFLOAT) ? 4 : 4;
-    empty_data.resize(chunk_size * chunk_size * chunk_size * bytes_per_pixel);
-    empty_data.fill(0);
+    // No initial upload: biome_gpu_sdf.compute writes every texel before anything reads it
+    return rd->texture_create(tex_format, Ref<RDTextureView>(), TypedArray<PackedByteArray>());
+}
 
-    TypedArray<PackedByteArray> data_array;
-    data_array.push_back(empty_data);
+bool NativeTerrainGenerator::acquire_chunk_textures(RID &r_sdf_texture, RID &r_material_texture) {
+    pool_mutex->lock();
+    if (texture_pool_chunk_size != chunk_size) {
+        // Chunk size changed: pooled textures have the wrong extent
+        for (const ChunkTexturePair &pair : texture_pool) {
+            rd->free_rid(pair.sdf);
+            rd->free_rid(pair.material);
+        }
+        texture_pool.clear();
+        texture_pool_chunk_size = chunk_size;
+    }
+    if (!texture_pool.empty()) {
+        ChunkTexturePair pair = texture_pool.back();
+        texture_pool.pop_back();
+        pool_mutex->unlock();
+
+        r_sdf_texture = pair.sdf;
+        r_material_texture = pair.material;
+        texture_pairs_reused++;
+        return true;
+    }
+    pool_mutex->unlock();
 
-    return rd->texture_create(tex_format, Ref<RDTextureView>(), data_array);
+    RID sdf_texture = create_3d_texture(get_sdf_data_format(storage_mode));
+    RID material_texture = create_3d_texture(get_material_data_format(storage_mode));
+
+    if (!sdf_texture.is_valid() || !material_texture.is_valid()) {
+        if (sdf_texture.is_valid()) {
+            rd->free_rid(sdf_texture);
+        }
+        if (material_texture.is_valid()) {
+            rd->free_rid(material_texture);
+        }
+        return false;
+    }
+
+    r_sdf_texture = sdf_texture;
+    r_material_texture = material_texture;
+    texture_pairs_created++;
+    return true;
 }
 
-RID NativeTerrainGenerator::get_or_create_sampler() {
-    if (cached_sampler.is_valid()) {
-        return cached_sampler;
+void NativeTerrainGenerator::release_chunk_textures(RID sdf_texture, RID material_texture) {
+    if (!rd || !sdf_texture.is_valid() || !material_texture.is_valid()) {
+        if (rd && sdf_texture.is_valid()) {
+            rd->free_rid(sdf_texture);
+        }
+        if (rd && material_texture.is_valid()) {
+            rd->free_rid(material_texture);
+        }
+        return;
     }
-    
-    Ref<RDSamplerState> sampler_state;
-    sampler_state.instantiate();
-    sampler_state->set_min_filter(RenderingDevice::SAMPLER_FILTER_LINEAR);
-    sampler_state->set_mag_filter(RenderingDevice::SAMPLER_FILTER_LINEAR);
-    sampler_state->set_repeat_u(RenderingDevice::SAMPLER_REPEAT_MODE_CLAMP_TO_EDGE);
-    sampler_state->set_repeat_v(RenderingDevice::SAMPLER_REPEAT_MODE_CLAMP_TO_EDGE);
-    
-    cached_sampler = rd->sampler_create(sampler_state);
-    return cached_sampler;
+
+    pool_mutex->lock();
+    if (texture_pool_chunk_size == chunk_size && (int)texture_pool.size() < MAX_POOLED_TEXTURE_PAIRS) {
+        ChunkTexturePair pair;
+        pair.sdf = sdf_texture;
+        pair.material = material_texture;
+        texture_pool.push_back(pair);
+        pool_mutex->unlock();
+        return;
+    }
+    pool_mutex->unlock();
+
+    rd->free_rid(sdf_texture);
+    rd->free_rid(material_texture);
+}
+
+void NativeTerrainGenerator::release_cache_entries(const std::vector<ChunkCache::Entry> &entries) {
+    // Another client of the shared device may be binding these in a running pass: free them on its thread
+    if (gpu_context && !gpu_context->is_device_thread() &&
+            gpu_context->run([this, &entries]() { release_cache_entries(entries); })) {
+        return;
+    }
+
+    // Called without cache_mutex held: returning textures to the pool takes pool_mutex
+    for (const ChunkCache::Entry &entry : entries) {
+        release_chunk_textures(entry.sdf_texture, entry.material_texture);
+    }
+}
+
+uint64_t NativeTerrainGenerator::get_chunk_texture_bytes() const {
+    uint64_t voxels = (uint64_t)chunk_size * (uint64_t)chunk_size * (uint64_t)chunk_size;
+    return voxels * (uint64_t)(get_sdf_bytes_per_voxel(storage_mode) + get_material_bytes_per_voxel(storage_mode));
+}
+
+RenderingDevice::DataFormat NativeTerrainGenerator::get_sdf_data_format(StorageMode mode) {
+    switch (mode) {
+        case STORAGE_HALF:
+            return RenderingDevice::DATA_FORMAT_R16_SFLOAT;
+        case STORAGE_SNORM16:
+            return RenderingDevice::DATA_FORMAT_R16_SNORM;
+        default:
+            return RenderingDevice::DATA_FORMAT_R32_SFLOAT;
+    }
+}
+
+RenderingDevice::DataFormat NativeTerrainGenerator::get_material_data_format(StorageMode mode) {
+    return mode == STORAGE_FULL ? RenderingDevice::DATA_FORMAT_R32_UINT : RenderingDevice::DATA_FORMAT_R8_UINT;
+}
+
+int NativeTerrainGenerator::get_sdf_bytes_per_voxel(StorageMode mode) {
+    return mode == STORAGE_FULL ? 4 : 2;
+}
+
+int NativeTerrainGenerator::get_material_bytes_per_voxel(StorageMode mode) {
+    return mode == STORAGE_FULL ? 4 : 1;
+}
+
+void NativeTerrainGenerator::free_texture_pool() {
+    pool_mutex->lock();
+    for (const ChunkTexturePair &pair : texture_pool) {
+        rd->free_rid(pair.sdf);
+        rd->free_rid(pair.material);
+    }
+    texture_pool.clear();
+    pool_mutex->unlock();
+}
+
+RID NativeTerrainGenerator::get_or_create_sampler() {
+    // Owned by the shared context and freed with the device
+    return gpu_context->get_sampler(RenderingDevice::SAMPLER_FILTER_LINEAR, RenderingDevice::SAMPLER_REPEAT_MODE_CLAMP_TO_EDGE);
 }
 
 Dictionary NativeTerrainGenerator::create_sampler_uniform(int binding, RID texture) {
@@ -234,6 +562,34 @@ Dictionary NativeTerrainGenerator::create_image_uniform(int binding, RID texture
     return result;
 }
 
+Dictionary NativeTerrainGenerator::create_image_array_uniform(int binding, const std::vector<RID> &textures, int array_size) {
+    Ref<RDUniform> uniform;
+    uniform.instantiate();
+    uniform->set_uniform_type(RenderingDevice::UNIFORM_TYPE_IMAGE);
+    uniform->set_binding(binding);
+
+    // The shader declares a fixed-size array; pad unused slots with the first texture
+    for (int i = 0; i < array_size; i++) {
+        uniform->add_id(i < (int)textures.size() ? textures[i] : textures[0]);
+    }
+
+    Dictionary result;
+    result["uniform"] = uniform;
+    return result;
+}
+
+Dictionary NativeTerrainGenerator::create_storage_buffer_uniform(int binding, RID buffer) {
+    Ref<RDUniform> uniform;
+    uniform.instantiate();
+    uniform->set_uniform_type(RenderingDevice::UNIFORM_TYPE_STORAGE_BUFFER);
+    uniform->set_binding(binding);
+    uniform->add_id(buffer);
+
+    Dictionary result;
+    result["uniform"] = uniform;
+    return result;
+}
+
 bool NativeTerrainGenerator::compile_biome_map_shader() {
     String shader_path = "res://_engine/terrain/biome_map.compute";
     if (!FileAccess::file_exists(shader_path)) {
@@ -249,24 +605,12 @@ bool NativeTerrainGenerator::compile_biome_map_shader() {
         return false;
     }
 
-    Ref<RDShaderSource> shader_src;
-    shader_src.instantiate();
-    shader_src->set_stage_source(RenderingDevice::SHADER_STAGE_COMPUTE, shader_source);
-    shader_src->set_language(RenderingDevice::SHADER_LANGUAGE_GLSL);
-    
-    Ref<RDShaderSPIRV> shader_spirv = rd->shader_compile_spirv_from_source(shader_src);
-
-    if (!shader_spirv.is_valid() || shader_spirv->get_stage_compile_error(RenderingDevice::SHADER_STAGE_COMPUTE) != "") {
-        gpu_status_message = "Biome map shader compilation failed: " + shader_spirv->get_stage_compile_error(RenderingDevice::SHADER_STAGE_COMPUTE);
-        UtilityFunctions::printerr("[NativeTerrainGenerator] Biome map shader compilation failed: ", 
-            shader_spirv->get_stage_compile_error(RenderingDevice::SHADER_STAGE_COMPUTE));
-        return false;
-    }
-
-    biome_map_shader = rd->shader_create_from_spirv(shader_spirv);
+    // The tile writer variant; without the define the shader fills one full map (BiomeMapGenerator)
+    String error;
+    biome_map_shader = gpu_context->create_compute_shader(NativeGPUContext::insert_shader_defines(shader_source, "#define BIOME_MAP_TILES\n"), "biome_map", error);
     if (!biome_map_shader.is_valid()) {
-        gpu_status_message = "Failed to create biome map shader from SPIRV";
-        UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create biome map shader from SPIRV");
+        gpu_status_message = "Biome map shader compilation failed: " + error;
+        UtilityFunctions::printerr("[NativeTerrainGenerator] Biome map shader compilation failed: ", error);
         return false;
     }
 
@@ -296,24 +640,12 @@ bool NativeTerrainGenerator::compile_sdf_shader() {
         return false;
     }
 
-    Ref<RDShaderSource> shader_src;
-    shader_src.instantiate();
-    shader_src->set_stage_source(RenderingDevice::SHADER_STAGE_COMPUTE, shader_source);
-    shader_src->set_language(RenderingDevice::SHADER_LANGUAGE_GLSL);
-    
-    Ref<RDShaderSPIRV> shader_spirv = rd->shader_compile_spirv_from_source(shader_src);
-
-    if (!shader_spirv.is_valid() || shader_spirv->get_stage_compile_error(RenderingDevice::SHADER_STAGE_COMPUTE) != "") {
-        gpu_status_message = "SDF shader compilation failed: " + shader_spirv->get_stage_compile_error(RenderingDevice::SHADER_STAGE_COMPUTE);
-        UtilityFunctions::printerr("[NativeTerrainGenerator] SDF shader compilation failed: ", 
-            shader_spirv->get_stage_compile_error(RenderingDevice::SHADER_STAGE_COMPUTE));
-        return false;
-    }
-
-    sdf_shader = rd->shader_create_from_spirv(shader_spirv);
+    // Each storage mode is its own source, hence its own cache entry
+    String error;
+    sdf_shader = gpu_context->create_compute_shader(inject_storage_defines(shader_source), "biome_gpu_sdf", error);
     if (!sdf_shader.is_valid()) {
-        gpu_status_message = "Failed to create SDF shader from SPIRV";
-        UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create SDF shader from SPIRV");
+        gpu_status_message = "SDF shader compilation failed: " + error;
+        UtilityFunctions::printerr("[NativeTerrainGenerator] SDF shader compilation failed: ", error);
         return false;
     }
 
@@ -328,326 +660,1096 @@ bool NativeTerrainGenerator::compile_sdf_shader() {
     return true;
 }
 
-void NativeTerrainGenerator::generate_biome_map_if_needed() {
-    if (biome_map_texture.is_valid()) {
-        return; // Already generated
+String NativeTerrainGenerator::inject_storage_defines(const String &shader_source) const {
+    // Narrow storage modes compile a variant: image formats and SDF scale are injected after #version
+    String defines;
+    if (storage_mode == STORAGE_HALF) {
+        defines = "#define SDF_IMAGE_FORMAT r16f\n#define MATERIAL_IMAGE_FORMAT r8ui\n";
+    } else if (storage_mode == STORAGE_SNORM16) {
+        defines = "#define SDF_IMAGE_FORMAT r16_snorm\n#define MATERIAL_IMAGE_FORMAT r8ui\n#define SDF_STORE_SCALE " + String::num(SNORM16_SDF_SCALE) + "\n";
     }
+    return NativeGPUContext::insert_shader_defines(shader_source, defines);
+}
 
-    if (!gpu_initialized || !rd || !biome_map_pipeline.is_valid()) {
-        UtilityFunctions::push_warning("[NativeTerrainGenerator] Cannot generate biome map: GPU not initialized");
-        return;
+bool NativeTerrainGenerator::compile_sdf_edit_shader() {
+    String shader_path = "res://_engine/terrain/sdf_edit.compute";
+    String shader_source = FileAccess::file_exists(shader_path) ? FileAccess::get_file_as_string(shader_path) : String();
+    if (shader_source.is_empty()) {
+        UtilityFunctions::printerr("[NativeTerrainGenerator] SDF edit shader not found, edits will not patch cached chunks: ", shader_path);
+        return false;
+    }
+
+    String error;
+    sdf_edit_shader = gpu_context->create_compute_shader(inject_storage_defines(shader_source), "sdf_edit", error);
+    if (!sdf_edit_shader.is_valid()) {
+        UtilityFunctions::printerr("[NativeTerrainGenerator] SDF edit shader compilation failed: ", error);
+        return false;
+    }
+    sdf_edit_pipeline = rd->compute_pipeline_create(sdf_edit_shader);
+    if (!sdf_edit_pipeline.is_valid()) {
+        UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create SDF edit compute pipeline");
+        return false;
+    }
+    return true;
+}
+
+bool NativeTerrainGenerator::compile_collision_shader() {
+    String shader_path = "res://_engine/terrain/collision_mesh.compute";
+    String shader_source = FileAccess::file_exists(shader_path) ? FileAccess::get_file_as_string(shader_path) : String();
+    String sdf_path = "res://_engine/terrain/biome_gpu_sdf.compute";
+    String sdf_source = FileAccess::file_exists(sdf_path) ? FileAccess::get_file_as_string(sdf_path) : String();
+    if (shader_source.is_empty() || sdf_source.is_empty()) {
+        UtilityFunctions::printerr("[NativeTerrainGenerator] Collision mesh shader not found, collision-only mode will read chunks back: ", shader_path);
+        return false;
+    }
+
+    // The SDF one voxel around each chunk, so meshes of neighbouring chunks meet
+    String error;
+    collision_apron_shader = gpu_context->create_compute_shader(NativeGPUContext::insert_shader_defines(inject_storage_defines(sdf_source), "#define COLLISION_APRON\n"), "biome_gpu_sdf_apron", error);
+    if (!collision_apron_shader.is_valid()) {
+        UtilityFunctions::printerr("[NativeTerrainGenerator] Collision apron shader compilation failed: ", error);
+        return false;
+    }
+    collision_apron_pipeline = rd->compute_pipeline_create(collision_apron_shader);
+    if (!collision_apron_pipeline.is_valid()) {
+        UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create collision apron compute pipeline");
+        return false;
     }
 
-    // Create biome map texture (2D, RG32F format)
-    int map_size = 2048; // 2K resolution biome map
+    collision_shader = gpu_context->create_compute_shader(inject_storage_defines(shader_source), "collision_mesh", error);
+    if (!collision_shader.is_valid()) {
+        UtilityFunctions::printerr("[NativeTerrainGenerator] Collision mesh shader compilation failed: ", error);
+        return false;
+    }
+    collision_pipeline = rd->compute_pipeline_create(collision_shader);
+    if (!collision_pipeline.is_valid()) {
+        UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create collision mesh compute pipeline");
+        return false;
+    }
+    return true;
+}
+
+void NativeTerrainGenerator::get_biome_map_hash_params(int32_t &r_biome_count, uint32_t &r_seed) const {
+    // biome_map.compute reads biome_count and seed as int/uint from slots the map was historically
+    // given as floats; they keep those bit patterns so the biome layout stays the same
+    float count_value = BIOME_MAP_BIOME_COUNT;
+    float seed_value = static_cast<float>(world_seed);
+    std::memcpy(&r_biome_count, &count_value, sizeof(r_biome_count));
+    std::memcpy(&r_seed, &seed_value, sizeof(r_seed));
+}
+
+uint64_t NativeTerrainGenerator::get_biome_tiles_signature() const {
+    uint64_t h = 0xCBF29CE484222325ull;
+    h = hash_bytes(h, &world_seed, sizeof(world_seed));
+    h = hash_bytes(h, &world_size, sizeof(world_size));
+    h = hash_bytes(h, &biome_map_texel_size, sizeof(biome_map_texel_size));
+    return h;
+}
+
+bool NativeTerrainGenerator::create_biome_atlas() {
+    // Runs on the GPU thread during initialization, before gpu_initialized is published.
+    // Fixed size whatever the world size: tiles are written on demand, so nothing is uploaded here.
     Ref<RDTextureFormat> tex_format;
     tex_format.instantiate();
     tex_format->set_format(RenderingDevice::DATA_FORMAT_R32G32_SFLOAT);
-    tex_format->set_width(map_size);
-    tex_format->set_height(map_size);
+    tex_format->set_width(BiomeTileCache::ATLAS_TEXELS);
+    tex_format->set_height(BiomeTileCache::ATLAS_TEXELS);
     tex_format->set_texture_type(RenderingDevice::TEXTURE_TYPE_2D);
     tex_format->set_usage_bits(
         RenderingDevice::TEXTURE_USAGE_STORAGE_BIT |
-        RenderingDevice::TEXTURE_USAGE_CAN_COPY_FROM_BIT |
         RenderingDevice::TEXTURE_USAGE_SAMPLING_BIT
     );
-
-    PackedByteArray empty_data;
-    empty_data.resize(map_size * map_size * 8); // RG32F = 8 bytes per pixel
-    empty_data.fill(0);
-
-    TypedArray<PackedByteArray> data_array;
-    data_array.push_back(empty_data);
-
-    biome_map_texture = rd->texture_create(tex_format, Ref<RDTextureView>(), data_array);
-    if (!biome_map_texture.is_valid()) {
-        UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create biome map texture");
-        return;
+    biome_atlas_texture = rd->texture_create(tex_format, Ref<RDTextureView>(), TypedArray<PackedByteArray>());
+
+    PackedByteArray page_table_bytes;
+    page_table_bytes.resize((int64_t)biome_tiles.get_page_table().size() * sizeof(BiomeTileCache::PageEntry));
+    page_table_bytes.fill(0);
+    biome_page_table_buffer = rd->storage_buffer_create(page_table_bytes.size(), page_table_bytes);
+    biome_tile_list_buffer = rd->storage_buffer_create(BiomeTileCache::MAX_SLOTS * 4 * sizeof(int32_t));
+    if (!biome_atlas_texture.is_valid() || !biome_page_table_buffer.is_valid() || !biome_tile_list_buffer.is_valid()) {
+        gpu_status_message = "Failed to create biome map atlas";
+        UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create biome map atlas");
+        return false;
     }
+    biome_tiles.clear();
+    biome_tiles.mark_page_table_clean();  // Matches the zeroed buffer
+    biome_tiles_signature = get_biome_tiles_signature();
 
-    // Create uniform for output image
     TypedArray<RDUniform> uniforms;
-    Dictionary img_dict = create_image_uniform(1, biome_map_texture);
+    Dictionary img_dict = create_image_uniform(1, biome_atlas_texture);
     uniforms.push_back(img_dict["uniform"]);
-
-    RID uniform_set = rd->uniform_set_create(uniforms, biome_map_shader, 0);
-    if (!uniform_set.is_valid()) {
-        rd->free_rid(biome_map_texture);
-        biome_map_texture = RID();
+    Dictionary tiles_dict = create_storage_buffer_uniform(2, biome_tile_list_buffer);
+    uniforms.push_back(tiles_dict["uniform"]);
+    biome_tile_uniform_set = rd->uniform_set_create(uniforms, biome_map_shader, 0);
+    if (!biome_tile_uniform_set.is_valid()) {
+        gpu_status_message = "Failed to create biome map uniform set";
         UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create biome map uniform set");
-        return;
+        return false;
     }
 
-    // Push constants: biome_count, world_size, cell_scale, jitter, seed
-    PackedFloat32Array push_constants;
-    push_constants.push_back(17.0f); // biome_count
-    push_constants.push_back(world_size);
-    push_constants.push_back(2000.0f); // cell_scale (2km cells)
-    push_constants.push_back(0.8f); // jitter
-    push_constants.push_back(static_cast<float>(world_seed));
+    UtilityFunctions::print("[NativeTerrainGenerator] Biome map atlas created (", BiomeTileCache::MAX_SLOTS, " tiles of ",
+        BiomeTileCache::TILE_TEXELS, "x", BiomeTileCache::TILE_TEXELS, " texels)");
+    return true;
+}
 
-    PackedByteArray push_constant_bytes = push_constants.to_byte_array();
+RID NativeTerrainGenerator::create_custom_biome_map_texture(const CpuBiomeMap &map) {
+    Ref<RDTextureFormat> tex_format;
+    tex_format.instantiate();
+    tex_format->set_format(RenderingDevice::DATA_FORMAT_R32G32_SFLOAT);
+    tex_format->set_width(map.width);
+    tex_format->set_height(map.height);
+    tex_format->set_texture_type(RenderingDevice::TEXTURE_TYPE_2D);
+    tex_format->set_usage_bits(
+        RenderingDevice::TEXTURE_USAGE_SAMPLING_BIT |
+        RenderingDevice::TEXTURE_USAGE_CAN_UPDATE_BIT
+    );
 
-    // Dispatch biome map generation
-    int64_t compute_list = rd->compute_list_begin();
-    rd->compute_list_bind_compute_pipeline(compute_list, biome_map_pipeline);
-    rd->compute_list_bind_uniform_set(compute_list, uniform_set, 0);
-    rd->compute_list_set_push_constant(compute_list, push_constant_bytes, push_constant_bytes.size());
-    
-    int workgroups = map_size / 8; // local_size_x = 8, local_size_y = 8
-    rd->compute_list_dispatch(compute_list, workgroups, workgroups, 1);
-    rd->compute_list_end();
-    
-    // COMMENT 2 FIX: Use barrier() to ensure GPU work completes
-    rd->submit();
-    rd->barrier(RenderingDevice::BARRIER_MASK_TRANSFER);
+    PackedByteArray texel_bytes;
+    texel_bytes.resize((int64_t)map.texels.size() * sizeof(float));
+    std::memcpy(texel_bytes.ptrw(), map.texels.data(), map.texels.size() * sizeof(float));
+    TypedArray<PackedByteArray> data_array;
+    data_array.push_back(texel_bytes);
+    return rd->texture_create(tex_format, Ref<RDTextureView>(), data_array);
+}
 
-    rd->free_rid(uniform_set);
+int NativeTerrainGenerator::prepare_biome_tiles(const GPUBatch &batch) {
+    // Seed, world size or resolution changed since the resident tiles were written
+    const uint64_t signature = get_biome_tiles_signature();
+    if (signature != biome_tiles_signature) {
+        biome_tiles.clear();
+        biome_tiles_signature = signature;
+    }
+
+    // Tiles under every chunk's columns, widened by one texel for the blend neighbours; the
+    // bilinear tap's second texel is always in the same slot (SLOT_TEXELS)
+    const float texel_size = biome_map_texel_size;
+    auto base_texel = [this, texel_size](float world) {
+        return (int32_t)std::floor((world + 0.5f * world_size) / texel_size - 0.5f);
+    };
+    std::vector<BiomeTileCache::TileCoord> tiles;
+    std::unordered_set<BiomeTileCache::TileCoord, BiomeTileCache::TileCoordHash> seen;
+    for (const ChunkKey &key : batch.keys) {
+        const float extent = (float)(chunk_size - 1) * get_voxel_step(key.lod);
+        const int32_t x0 = floor_div(base_texel((float)key.origin.x) - 1, BiomeTileCache::TILE_TEXELS);
+        const int32_t x1 = floor_div(base_texel((float)key.origin.x + extent) + 1, BiomeTileCache::TILE_TEXELS);
+        const int32_t z0 = floor_div(base_texel((float)key.origin.z) - 1, BiomeTileCache::TILE_TEXELS);
+        const int32_t z1 = floor_div(base_texel((float)key.origin.z + extent) + 1, BiomeTileCache::TILE_TEXELS);
+        // Coarse LODs would thrash the atlas for a few samples per texel: their biomes are evaluated in the shader
+        if ((int64_t)(x1 - x0 + 1) * (int64_t)(z1 - z0 + 1) > MAX_BIOME_TILES_PER_CHUNK) {
+            continue;
+        }
+        for (int32_t tz = z0; tz <= z1; tz++) {
+            for (int32_t tx = x0; tx <= x1; tx++) {
+                BiomeTileCache::TileCoord tile = { tx, tz };
+                if (seen.insert(tile).second) {
+                    tiles.push_back(tile);
+                }
+            }
+        }
+    }
+
+    std::vector<BiomeTileCache::Upload> uploads;
+    biome_tiles.request(tiles, uploads);
+
+    // Both updates are ordered before the compute list that writes and samples the tiles
+    if (biome_tiles.is_page_table_dirty()) {
+        const std::vector<BiomeTileCache::PageEntry> &page_table = biome_tiles.get_page_table();
+        PackedByteArray page_bytes;
+        page_bytes.resize((int64_t)page_table.size() * sizeof(BiomeTileCache::PageEntry));
+        std::memcpy(page_bytes.ptrw(), page_table.data(), page_table.size() * sizeof(BiomeTileCache::PageEntry));
+        rd->buffer_update(biome_page_table_buffer, 0, page_bytes.size(), page_bytes);
+        biome_tiles.mark_page_table_clean();
+    }
+    if (!uploads.empty()) {
+        PackedByteArray tile_bytes;
+        tile_bytes.resize((int64_t)uploads.size() * 4 * sizeof(int32_t));
+        int32_t *tile_words = reinterpret_cast<int32_t *>(tile_bytes.ptrw());
+        for (size_t i = 0; i < uploads.size(); i++) {
+            tile_words[i * 4 + 0] = uploads[i].tile.x * BiomeTileCache::TILE_TEXELS;
+            tile_words[i * 4 + 1] = uploads[i].tile.z * BiomeTileCache::TILE_TEXELS;
+            tile_words[i * 4 + 2] = BiomeTileCache::get_slot_origin_x(uploads[i].slot);
+            tile_words[i * 4 + 3] = BiomeTileCache::get_slot_origin_y(uploads[i].slot);
+        }
+        rd->buffer_update(biome_tile_list_buffer, 0, tile_bytes.size(), tile_bytes);
+    }
 
-    UtilityFunctions::print("[NativeTerrainGenerator] Biome map generated (", map_size, "x", map_size, ")");
+    biome_tiles_resident = biome_tiles.get_resident_count();
+    biome_tile_hits = biome_tiles.get_hits();
+    biome_tiles_generated = biome_tiles.get_generated();
+    biome_tile_evictions = biome_tiles.get_evictions();
+    biome_tiles_unplaced = biome_tiles.get_unplaced();
+    return (int)uploads.size();
 }
 
-Dictionary NativeTerrainGenerator::generate_chunk_sdf(Vector3i chunk_origin) {
+int NativeTerrainGenerator::prepare_gpu_batch(const std::vector<ChunkRequest> &requests, GPUBatch &batch) {
     if (!gpu_initialized || !rd || !sdf_pipeline.is_valid()) {
         UtilityFunctions::printerr("[NativeTerrainGenerator] GPU not initialized");
-        return Dictionary();
+        return 0;
     }
-    
-    // Generate biome map if not already done
-    generate_biome_map_if_needed();
 
+    if (!biome_map_texture.is_valid() && !biome_atlas_texture.is_valid()) {
+        UtilityFunctions::push_warning("[NativeTerrainGenerator] Biome map texture not available");
+        return 0;
+    }
+
+    // Drop chunks that are already cached, in flight, or duplicated within this batch
+    std::vector<ChunkRequest> batch_requests;
+    batch_requests.reserve(std::min((int)requests.size(), MAX_BATCH_CHUNKS));
+
+    queue_mutex->lock();
     cache_mutex->lock();
-    if (sdf_cache.has(chunk_origin)) {
-        Dictionary cached = sdf_cache[chunk_origin];
-        cache_mutex->unlock();
-        return cached;
+    for (const ChunkRequest &request : requests) {
+        if ((int)batch_requests.size() >= MAX_BATCH_CHUNKS) {
+            break;
+        }
+        ChunkKey key = { request.origin, request.lod };
+        if (chunk_cache.contains(key) || chunk_gpu_states.find(key) != chunk_gpu_states.end()) {
+            continue;
+        }
+        bool duplicate = false;
+        for (const ChunkRequest &other : batch_requests) {
+            if (other.origin == request.origin && other.lod == request.lod) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (!duplicate) {
+            batch_requests.push_back(request);
+        }
     }
     cache_mutex->unlock();
+    queue_mutex->unlock();
 
-    RID sdf_texture = create_3d_texture(RenderingDevice::DATA_FORMAT_R32_SFLOAT);
-    if (!sdf_texture.is_valid()) {
-        UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create SDF texture");
-        return Dictionary();
+    if (batch_requests.empty()) {
+        return 0;
     }
 
-    RID material_texture = create_3d_texture(RenderingDevice::DATA_FORMAT_R32_UINT);
-    if (!material_texture.is_valid()) {
-        rd->free_rid(sdf_texture);
-        UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create material texture");
-        return Dictionary();
-    }
+    const int batch_size = (int)batch_requests.size();
 
-    TypedArray<RDUniform> uniforms;
-    
-    if (biome_map_texture.is_valid()) {
-        Dictionary sampler_dict = create_sampler_uniform(0, biome_map_texture);
-        uniforms.push_back(sampler_dict["uniform"]);
-    } else {
-        UtilityFunctions::push_warning("[NativeTerrainGenerator] Biome map texture not available");
-        return Dictionary();
+    batch.keys.reserve(batch_size);
+    batch.sdf_textures.reserve(batch_size);
+    batch.material_textures.reserve(batch_size);
+
+    // Device thread only: acquiring may create textures or free a pool made for another chunk_size
+    for (int i = 0; i < batch_size; i++) {
+        RID sdf_texture;
+        RID material_texture;
+
+        if (!acquire_chunk_textures(sdf_texture, material_texture)) {
+            for (int j = 0; j < (int)batch.sdf_textures.size(); j++) {
+                release_chunk_textures(batch.sdf_textures[j], batch.material_textures[j]);
+            }
+            UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create chunk textures for batch");
+            return 0;
+        }
+
+        batch.keys.push_back({ batch_requests[i].origin, batch_requests[i].lod });
+        batch.sdf_textures.push_back(sdf_texture);
+        batch.material_textures.push_back(material_texture);
     }
 
-    Dictionary sdf_dict = create_image_uniform(1, sdf_texture);
-    uniforms.push_back(sdf_dict["uniform"]);
+    uint64_t dispatch_time_us = Time::get_singleton()->get_ticks_usec();
 
-    Dictionary mat_dict = create_image_uniform(2, material_texture);
-    uniforms.push_back(mat_dict["uniform"]);
+    queue_mutex->lock();
+    batch.fence = next_fence++;
+    for (int i = 0; i < batch_size; i++) {
+        ChunkGPUState state;
+        state.sdf_texture = batch.sdf_textures[i];
+        state.material_texture = batch.material_textures[i];
+        state.fence = batch.fence;
+        state.dispatch_time_us = dispatch_time_us;
+        state.completion_time_us = 0;  // Set by the GPU thread when sync() on this batch returns
+        state.gpu_time_us = 0;
+        state.gpu_complete = false;
+        state.cpu_readback_complete = false;
+        state.lod = batch_requests[i].lod;
+        // Only LOD 0 needs physics collision data (gates CPU readback), unless the request asks for it
+        state.physics_needed = (batch_requests[i].lod == 0) || batch_requests[i].readback;
+        // Collision-only mode: async LOD 0 chunks take the collision mesh instead
+        state.collision = collision_only && collision_pipeline.is_valid() && batch_requests[i].lod == 0 && !batch_requests[i].readback;
+        if (state.collision) {
+            state.physics_needed = false;
+        }
+        batch.collision.push_back(state.collision);
 
-    RID uniform_set = rd->uniform_set_create(uniforms, sdf_shader, 0);
-    if (!uniform_set.is_valid()) {
-        rd->free_rid(sdf_texture);
-        rd->free_rid(material_texture);
-        UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create uniform set");
-        return Dictionary();
+        chunk_gpu_states[batch.keys[i]] = state;
     }
+    queue_mutex->unlock();
 
-    PackedFloat32Array push_constants;
-    push_constants.push_back(static_cast<float>(chunk_origin.x));
-    push_constants.push_back(static_cast<float>(chunk_origin.y));
-    push_constants.push_back(static_cast<float>(chunk_origin.z));
-    push_constants.push_back(world_size);
-    push_constants.push_back(sea_level);
-    push_constants.push_back(blend_dist);
-    push_constants.push_back(static_cast<float>(chunk_size));
-    push_constants.push_back(static_cast<float>(world_seed));
+    return batch_size;
+}
 
-    PackedByteArray push_constant_bytes = push_constants.to_byte_array();
+int NativeTerrainGenerator::generate_chunk_sdf_batch(const std::vector<ChunkRequest> &requests) {
+    // Textures are acquired when the device thread prepares the batch, never on the caller's thread
+    if (requests.empty() || !gpu_client_active) {
+        return 0;
+    }
 
-    int64_t compute_list = rd->compute_list_begin();
-    rd->compute_list_bind_compute_pipeline(compute_list, sdf_pipeline);
-    rd->compute_list_bind_uniform_set(compute_list, uniform_set, 0);
-    rd->compute_list_set_push_constant(compute_list, push_constant_bytes, push_constant_bytes.size());
-    
-    int workgroups = chunk_size / 4;
-    rd->compute_list_dispatch(compute_list, workgroups, workgroups, workgroups);
-    rd->compute_list_end();
-    
-    // COMMENT 1 FIX: Submit GPU work without blocking
-    // Background thread will use barrier() to check completion
-    rd->submit();
-    
-    rd->free_rid(uniform_set);
-    
-    // COMMENT 1 FIX: Store GPU state for async completion tracking
-    // Background thread will mark gpu_complete after barrier()
     queue_mutex->lock();
-    ChunkGPUState state;
-    state.sdf_texture = sdf_texture;
-    state.material_texture = material_texture;
-    state.fence = RID();  // Not using fences - Godot 4.5 doesn't support them
-    state.dispatch_time_us = Time::get_singleton()->get_ticks_usec();
-    state.completion_time_us = 0;  // Will be set when GPU work completes
-    state.gpu_complete = false;  // Will be set true by background thread after barrier()
-    state.cpu_readback_complete = false;
-    state.physics_needed = false;  // Will be set to true by physics requests or LOD 0
-    state.lod = 0;  // Default LOD, will be updated by dispatch_chunk_async
-    
-    chunk_gpu_states[chunk_origin] = state;
+    pending_batches.push_back(requests);
     queue_mutex->unlock();
 
-    // COMMENT 2 FIX: Do NOT cache until fence completes
-    // Return empty dictionary - caller must poll get_chunk_gpu_textures() for readiness
-    Dictionary result;
-    result["sdf"] = sdf_texture;
-    result["material"] = material_texture;
-    result["ready"] = false;  // Not ready until fence completes
+    gpu_context->wake();
 
-    return result;
+    return (int)std::min(requests.size(), (size_t)MAX_BATCH_CHUNKS);
 }
 
-void NativeTerrainGenerator::write_gpu_data_to_buffer_bulk(zylann::voxel::VoxelBuffer &voxel_buffer, RID sdf_texture, RID material_texture, int chunk_size) {
-    if (!rd) {
-        UtilityFunctions::printerr("[NativeTerrainGenerator] Invalid RenderingDevice");
+bool NativeTerrainGenerator::request_chunk_sync(const ChunkKey &key, ChunkCache::Entry &r_entry) {
+    if (!gpu_client_active) {
+        return false;
+    }
+    TraceSpan span("terrain", "sync_request_wait", key.origin, key.lod);
+
+    uint64_t expected = 0;
+    first_request_time_us.compare_exchange_strong(expected, Time::get_singleton()->get_ticks_usec());
+
+    // Lock-free hand-off to the GPU thread; concurrent workers end up in the same batch
+    SyncChunkRequest request;
+    request.key = key;
+    std::future<ChunkResult> future = request.promise.get_future();
+    sync_requests.push(std::move(request));
+    sync_requests_total++;
+    gpu_context->wake();
+
+    if (future.wait_for(std::chrono::milliseconds(SYNC_REQUEST_TIMEOUT_MS)) != std::future_status::ready) {
+        UtilityFunctions::printerr("[NativeTerrainGenerator] Timed out waiting for chunk readback");
+        return false;
+    }
+
+    ChunkResult result = future.get();
+    if (!result.ok) {
+        return false;
+    }
+    r_entry = result.entry;
+    return true;
+}
+
+void NativeTerrainGenerator::process_sync_requests() {
+    // GPU thread: collect every request queued since the last wake, answer cache hits directly
+    std::vector<ChunkRequest> requests;
+    uint64_t now_us = Time::get_singleton()->get_ticks_usec();
+
+    SyncChunkRequest request;
+    while (sync_requests.pop(request)) {
+        cache_mutex->lock();
+        const ChunkCache::Entry *cached = chunk_cache.peek(request.key);
+        if (cached && (cached->uniform || cached->has_cpu_data())) {
+            ChunkResult result;
+            result.ok = true;
+            result.entry = *cached;
+            cache_mutex->unlock();
+            request.promise.set_value(result);
+            continue;
+        }
+        const bool textures_only = cached && cached->sdf_texture.is_valid();
+        cache_mutex->unlock();
+
+        // Cached without a CPU copy (async LOD > 0, collision-only): read its textures back now
+        if (textures_only) {
+            ChunkResult result;
+            if (read_back_cached_entry(request.key, result.entry)) {
+                result.ok = true;
+                request.promise.set_value(result);
+                continue;
+            }
+        }
+
+        auto waiters = sync_waiters.find(request.key);
+        if (waiters != sync_waiters.end()) {
+            // Same chunk already requested: share its result
+            waiters->second.push_back(std::move(request.promise));
+            continue;
+        }
+        sync_waiters[request.key].push_back(std::move(request.promise));
+
+        ChunkRequest chunk_request;
+        chunk_request.origin = request.key.origin;
+        chunk_request.lod = request.key.lod;
+        chunk_request.priority = 0.0f;
+        chunk_request.request_time_us = now_us;
+        chunk_request.readback = true;
+        requests.push_back(chunk_request);
+    }
+
+    // Blocking requests go ahead of queued async batches; prepare_gpu_batch() skips chunks already in flight
+    for (size_t start = 0; start < requests.size(); start += MAX_BATCH_CHUNKS) {
+        size_t end = std::min(requests.size(), start + (size_t)MAX_BATCH_CHUNKS);
+        std::vector<ChunkRequest> slice(requests.begin() + start, requests.begin() + end);
+
+        GPUBatch batch;
+        int batch_size = prepare_gpu_batch(slice, batch);
+        if (batch_size > 0) {
+            sync_batches_submitted++;
+            last_sync_batch_size = batch_size;
+            submit_and_sync_batch(batch);
+        }
+    }
+}
+
+void NativeTerrainGenerator::resolve_sync_waiters(const ChunkKey &key, const ChunkCache::Entry *entry) {
+    auto waiters = sync_waiters.find(key);
+    if (waiters == sync_waiters.end()) {
         return;
     }
 
-    // Read GPU textures to CPU
-    PackedByteArray sdf_data = rd->texture_get_data(sdf_texture, 0);
-    PackedByteArray mat_data = rd->texture_get_data(material_texture, 0);
+    ChunkResult result;
+    result.ok = entry && (entry->uniform || entry->has_cpu_data());
+    if (result.ok) {
+        result.entry = *entry;
+    }
+    for (std::promise<ChunkResult> &promise : waiters->second) {
+        promise.set_value(result);
+    }
+    sync_waiters.erase(waiters);
+}
+
+void NativeTerrainGenerator::fail_orphaned_sync_waiters() {
+    // Waiters whose chunk is neither in flight nor produced (failed batch, shutdown) must not hang
+    std::vector<ChunkKey> orphaned;
+    queue_mutex->lock();
+    for (const auto &pair : sync_waiters) {
+        if (chunk_gpu_states.find(pair.first) == chunk_gpu_states.end()) {
+            orphaned.push_back(pair.first);
+        }
+    }
+    queue_mutex->unlock();
+
+    for (const ChunkKey &key : orphaned) {
+        cache_mutex->lock();
+        const ChunkCache::Entry *cached = chunk_cache.peek(key);
+        ChunkCache::Entry entry;
+        bool found = cached != nullptr;
+        if (found) {
+            entry = *cached;
+        }
+        cache_mutex->unlock();
+        resolve_sync_waiters(key, found ? &entry : nullptr);
+    }
+}
+
+void NativeTerrainGenerator::write_cache_entry_to_buffer(zylann::voxel::VoxelBuffer &voxel_buffer, const ChunkCache::Entry &entry) {
+    TraceSpan span("terrain", "voxel_buffer_write");
+    if (entry.uniform) {
+        // Uniform chunk: both channels stay compressed, nothing was read back
+        voxel_buffer.clear_channel_f(zylann::voxel::VoxelBuffer::CHANNEL_SDF, entry.uniform_sdf);
+        voxel_buffer.clear_channel(zylann::voxel::VoxelBuffer::CHANNEL_INDICES, entry.uniform_material);
+        return;
+    }
+    write_gpu_data_to_buffer_bulk(voxel_buffer, entry.sdf_data, entry.mat_data, chunk_size);
+}
 
-    int total_voxels = chunk_size * chunk_size * chunk_size;
-    int expected_size = total_voxels * 4;
+void NativeTerrainGenerator::write_gpu_data_to_buffer_bulk(zylann::voxel::VoxelBuffer &voxel_buffer, const PackedByteArray &sdf_data, const PackedByteArray &mat_data, int chunk_size) {
+    // Data comes from the GPU thread's readback; the caller's thread never touches the RenderingDevice
+    const int64_t total_voxels = (int64_t)chunk_size * chunk_size * chunk_size;
+    const StorageMode mode = storage_mode;
 
-    if (sdf_data.size() < expected_size || mat_data.size() < expected_size) {
+    if (sdf_data.size() < total_voxels * get_sdf_bytes_per_voxel(mode) ||
+            mat_data.size() < total_voxels * get_material_bytes_per_voxel(mode)) {
         UtilityFunctions::printerr("[NativeTerrainGenerator] Data size mismatch in buffer write");
         return;
     }
 
-    // BULK TRANSFER: Use VoxelBuffer API for direct bulk memory write
+    // BULK TRANSFER: convert straight into channel storage; only odd buffer sizes take the per-voxel path
+    if (voxel_buffer.get_size() != Vector3i(chunk_size, chunk_size, chunk_size)) {
+        write_voxels_per_voxel(voxel_buffer, sdf_data.ptr(), mat_data.ptr(), mode, chunk_size);
+        return;
+    }
+
+    if (!write_sdf_channel_bulk(voxel_buffer, sdf_data.ptr(), mode, chunk_size) ||
+            !write_indices_channel_bulk(voxel_buffer, mat_data.ptr(), mode, chunk_size)) {
+        write_voxels_per_voxel(voxel_buffer, sdf_data.ptr(), mat_data.ptr(), mode, chunk_size);
+    }
+}
+
+const float *NativeTerrainGenerator::decode_sdf_to_float(const uint8_t *sdf_src, StorageMode mode, int chunk_size) {
+    if (mode == STORAGE_FULL) {
+        return reinterpret_cast<const float *>(sdf_src);
+    }
+
+    // Narrow storage: widen into a per-thread scratch, keeping GPU texel order
+    const int count = chunk_size * chunk_size * chunk_size;
+    thread_local std::vector<float> decoded;
+    decoded.resize(count);
+    if (mode == STORAGE_HALF) {
+        VoxelBulkCopy::decode_f16(reinterpret_cast<const uint16_t *>(sdf_src), decoded.data(), count);
+    } else {
+        VoxelBulkCopy::decode_snorm16(reinterpret_cast<const int16_t *>(sdf_src), decoded.data(), count, 1.0f / SNORM16_SDF_SCALE);
+    }
+    return decoded.data();
+}
+
+bool NativeTerrainGenerator::write_sdf_channel_bulk(zylann::voxel::VoxelBuffer &voxel_buffer, const uint8_t *sdf_src, StorageMode mode, int chunk_size) {
+    using zylann::voxel::VoxelBuffer;
+    const unsigned int channel = VoxelBuffer::CHANNEL_SDF;
+    const VoxelBuffer::Depth depth = voxel_buffer.get_channel_depth(channel);
+    const size_t voxel_count = (size_t)chunk_size * chunk_size * chunk_size;
+
+    if (depth == VoxelBuffer::DEPTH_64_BIT) {
+        return false;
+    }
+
+    voxel_buffer.decompress_channel(channel);
+    zylann::Span<uint8_t> bytes;
+    if (!voxel_buffer.get_channel_as_bytes(channel, bytes)) {
+        return false;
+    }
+
+    bool uniform = false;
+    uint64_t uniform_raw = 0;
+
+    switch (depth) {
+        case VoxelBuffer::DEPTH_8_BIT: {
+            if (bytes.size() < voxel_count) {
+                return false;
+            }
+            int8_t *dst = reinterpret_cast<int8_t *>(bytes.data());
+            const float *src = decode_sdf_to_float(sdf_src, mode, chunk_size);
+            uniform = VoxelBulkCopy::quantize_sdf_s8(src, dst, chunk_size, VoxelBuffer::get_sdf_quantization_scale(depth));
+            uniform_raw = (uint8_t)dst[0];
+        } break;
+        case VoxelBuffer::DEPTH_16_BIT: {
+            if (bytes.size() < voxel_count * 2) {
+                return false;
+            }
+            int16_t *dst = reinterpret_cast<int16_t *>(bytes.data());
+            const float scale = VoxelBuffer::get_sdf_quantization_scale(depth);
+            if (mode == STORAGE_SNORM16 && scale == SNORM16_SDF_SCALE) {
+                // SNORM16 texels already use the buffer's 16-bit SDF encoding: reorder only
+                uniform = VoxelBulkCopy::copy_sdf_s16(reinterpret_cast<const int16_t *>(sdf_src), dst, chunk_size);
+            } else {
+                const float *src = decode_sdf_to_float(sdf_src, mode, chunk_size);
+                uniform = VoxelBulkCopy::quantize_sdf_s16(src, dst, chunk_size, scale);
+            }
+            uniform_raw = (uint16_t)dst[0];
+        } break;
+        case VoxelBuffer::DEPTH_32_BIT: {
+            if (bytes.size() < voxel_count * 4) {
+                return false;
+            }
+            float *dst = reinterpret_cast<float *>(bytes.data());
+            const float *src = decode_sdf_to_float(sdf_src, mode, chunk_size);
+            uniform = VoxelBulkCopy::copy_sdf_f32(src, dst, chunk_size);
+            uint32_t bits;
+            std::memcpy(&bits, dst, sizeof(bits));
+            uniform_raw = bits;
+        } break;
+        default:
+            return false;
+    }
+
+    // All-air / all-solid chunks go back to a single compressed value
+    if (uniform) {
+        voxel_buffer.clear_channel(channel, uniform_raw);
+    }
+    return true;
+}
+
+bool NativeTerrainGenerator::write_indices_channel_bulk(zylann::voxel::VoxelBuffer &voxel_buffer, const uint8_t *mat_src, StorageMode mode, int chunk_size) {
+    using zylann::voxel::VoxelBuffer;
+    const unsigned int channel = VoxelBuffer::CHANNEL_INDICES;
+    const VoxelBuffer::Depth depth = voxel_buffer.get_channel_depth(channel);
+    const size_t voxel_count = (size_t)chunk_size * chunk_size * chunk_size;
+
+    if (depth == VoxelBuffer::DEPTH_64_BIT) {
+        return false;
+    }
+
+    voxel_buffer.decompress_channel(channel);
+    zylann::Span<uint8_t> bytes;
+    if (!voxel_buffer.get_channel_as_bytes(channel, bytes)) {
+        return false;
+    }
+
+    // R8UI in the narrow modes, R32UI in STORAGE_FULL
+    const bool narrow_source = get_material_bytes_per_voxel(mode) == 1;
+    const uint32_t *src32 = reinterpret_cast<const uint32_t *>(mat_src);
+
+    bool uniform = false;
+    uint64_t uniform_raw = 0;
+
+    switch (depth) {
+        case VoxelBuffer::DEPTH_8_BIT: {
+            if (bytes.size() < voxel_count) {
+                return false;
+            }
+            uint8_t *dst = bytes.data();
+            uniform = narrow_source
+                ? VoxelBulkCopy::copy_indices_u8(mat_src, dst, chunk_size)
+                : VoxelBulkCopy::narrow_indices_u8(src32, dst, chunk_size);
+            uniform_raw = dst[0];
+        } break;
+        case VoxelBuffer::DEPTH_16_BIT: {
+            if (bytes.size() < voxel_count * 2) {
+                return false;
+            }
+            uint16_t *dst = reinterpret_cast<uint16_t *>(bytes.data());
+            uniform = narrow_source
+                ? VoxelBulkCopy::widen_indices_u16(mat_src, dst, chunk_size)
+                : VoxelBulkCopy::narrow_indices_u16(src32, dst, chunk_size);
+            uniform_raw = dst[0];
+        } break;
+        case VoxelBuffer::DEPTH_32_BIT: {
+            if (bytes.size() < voxel_count * 4) {
+                return false;
+            }
+            uint32_t *dst = reinterpret_cast<uint32_t *>(bytes.data());
+            uniform = narrow_source
+                ? VoxelBulkCopy::widen_indices_u32(mat_src, dst, chunk_size)
+                : VoxelBulkCopy::copy_indices_u32(src32, dst, chunk_size);
+            uniform_raw = dst[0];
+        } break;
+        default:
+            return false;
+    }
+
+    if (uniform) {
+        voxel_buffer.clear_channel(channel, uniform_raw);
+    }
+    return true;
+}
+
+void NativeTerrainGenerator::write_voxels_per_voxel(zylann::voxel::VoxelBuffer &voxel_buffer, const uint8_t *sdf_src, const uint8_t *mat_src, StorageMode mode, int chunk_size) {
     const int CHANNEL_SDF = zylann::voxel::VoxelBuffer::CHANNEL_SDF;
     const int CHANNEL_INDICES = zylann::voxel::VoxelBuffer::CHANNEL_INDICES;
-    
+
+    const float *sdf_values = decode_sdf_to_float(sdf_src, mode, chunk_size);
+    const bool narrow_material = get_material_bytes_per_voxel(mode) == 1;
+
     // Clear channels first
     voxel_buffer.clear_channel_f(CHANNEL_SDF, 1.0f);
     voxel_buffer.clear_channel(CHANNEL_INDICES, 0);
-    
-    // Write data using voxel_cpp API
-    const uint8_t* sdf_ptr = sdf_data.ptr();
-    const uint8_t* mat_ptr = mat_data.ptr();
-    
-    for (int z = 0; z < chunk_size; z++) {
-        for (int y = 0; y < chunk_size; y++) {
-            for (int x = 0; x < chunk_size; x++) {
-                int idx = (z * chunk_size * chunk_size + y * chunk_size + x) * 4;
-                float sdf_value;
-                std::memcpy(&sdf_value, &sdf_ptr[idx], sizeof(float));
-                uint32_t mat_value;
-                std::memcpy(&mat_value, &mat_ptr[idx], sizeof(uint32_t));
-                voxel_buffer.set_voxel_f(sdf_value, x, y, z, CHANNEL_SDF);
-                voxel_buffer.set_voxel(mat_value, x, y, z, CHANNEL_INDICES);
+
+    const Vector3i size = voxel_buffer.get_size();
+    const int sx = std::min(size.x, chunk_size);
+    const int sy = std::min(size.y, chunk_size);
+    const int sz = std::min(size.z, chunk_size);
+
+    for (int z = 0; z < sz; z++) {
+        for (int y = 0; y < sy; y++) {
+            for (int x = 0; x < sx; x++) {
+                int idx = z * chunk_size * chunk_size + y * chunk_size + x;
+                uint32_t material = narrow_material ? mat_src[idx] : reinterpret_cast<const uint32_t *>(mat_src)[idx];
+                voxel_buffer.set_voxel_f(sdf_values[idx], x, y, z, CHANNEL_SDF);
+                voxel_buffer.set_voxel(material, x, y, z, CHANNEL_INDICES);
             }
         }
     }
 }
 
 
-int NativeTerrainGenerator::sample_biome_at_chunk(Vector3i chunk_origin) {
-    Vector3i center = chunk_origin + Vector3i(chunk_size / 2, chunk_size / 2, chunk_size / 2);
-    
-    float norm_x = static_cast<float>(center.x) / world_size;
-    float norm_z = static_cast<float>(center.z) / world_size;
-    
-    int biome_id = static_cast<int>((norm_x + norm_z) * 10.0f) % 17;
-    
-    return biome_id;
+std::shared_ptr<const CpuBiomeMap> NativeTerrainGenerator::get_cpu_biome_map() {
+    cpu_mutex->lock();
+    bool stale = !cpu_biome_map || (!cpu_biome_map_is_custom &&
+            (cpu_biome_map_seed != world_seed || cpu_biome_map_texel_size != biome_map_texel_size));
+    if (stale) {
+        // The virtual map is evaluated per texel, so there is nothing to build up front
+        int32_t biome_count;
+        uint32_t seed;
+        get_biome_map_hash_params(biome_count, seed);
+        cpu_biome_map = std::make_shared<const CpuBiomeMap>(CpuBiomeMap::make_virtual(
+            biome_count, BIOME_MAP_CELL_SCALE, BIOME_MAP_JITTER, seed, biome_map_texel_size));
+        cpu_biome_map_seed = world_seed;
+        cpu_biome_map_texel_size = biome_map_texel_size;
+    }
+    std::shared_ptr<const CpuBiomeMap> map = cpu_biome_map;
+    cpu_mutex->unlock();
+    return map;
+}
+
+CpuTerrainSampler::Params NativeTerrainGenerator::get_cpu_sampler_params() const {
+    // Mirrors the SDFBatchParams push constants recorded in submit_and_sync_batch()
+    CpuTerrainSampler::Params params;
+    params.world_size = world_size;
+    params.sea_level = sea_level;
+    params.blend_dist = blend_dist;
+    params.seed = static_cast<uint32_t>(world_seed);
+    params.ore_frequency = ore_frequency;
+    params.ore_threshold = ore_threshold;
+    params.ore_min_depth = ore_min_depth;
+    params.ore_material = static_cast<uint32_t>(ore_material_id);
+    params.caves_enabled = caves_enabled;
+    params.cave_frequency = cave_frequency;
+    params.cave_threshold = cave_threshold;
+    params.cave_min_depth = cave_min_depth;
+    return params;
+}
+
+Dictionary NativeTerrainGenerator::sample_surface(PackedVector2Array positions, bool include_height) {
+    const int count = (int)positions.size();
+    PackedInt32Array biome_ids;
+    PackedFloat32Array edge_distances;
+    PackedFloat32Array heights;
+    biome_ids.resize(count);
+    edge_distances.resize(count);
+    if (include_height) {
+        heights.resize(count);
+    }
+
+    if (count > 0) {
+        TraceSpan span("terrain", "surface_query");
+        span.set_count(count);
+
+        surface_query_mutex->lock();
+        SurfaceQuery &query = surface_query;
+        query.biome_map = get_cpu_biome_map();
+        query.params = get_cpu_sampler_params();
+        query.xz.resize((size_t)count * 2);
+        const Vector2 *src = positions.ptr();
+        for (int i = 0; i < count; i++) {
+            query.xz[(size_t)i * 2] = (float)src[i].x;
+            query.xz[(size_t)i * 2 + 1] = (float)src[i].y;
+        }
+        query.count = count;
+        query.biome_ids = biome_ids.ptrw();
+        query.edge_distances = edge_distances.ptrw();
+        query.heights = include_height ? heights.ptrw() : nullptr;
+
+        const int blocks = (count + SURFACE_QUERY_BLOCK - 1) / SURFACE_QUERY_BLOCK;
+        if (blocks > 1) {
+            WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+            int64_t group = pool->add_group_task(callable_mp(this, &NativeTerrainGenerator::surface_query_job),
+                    blocks, -1, true, "Terrain surface queries");
+            pool->wait_for_group_task_completion(group);
+        } else {
+            surface_query_job(0);
+        }
+
+        query.biome_map.reset();
+        query.biome_ids = nullptr;
+        query.edge_distances = nullptr;
+        query.heights = nullptr;
+        surface_query_mutex->unlock();
+        surface_points_queried += (uint64_t)count;
+    }
+
+    Dictionary result;
+    result["biome_ids"] = biome_ids;
+    result["edge_distances"] = edge_distances;
+    result["heights"] = heights;
+    return result;
+}
+
+void NativeTerrainGenerator::surface_query_job(uint32_t block) {
+    const SurfaceQuery &query = surface_query;
+    const int first = (int)block * SURFACE_QUERY_BLOCK;
+    const int count = std::min(SURFACE_QUERY_BLOCK, query.count - first);
+    CpuTerrainSampler::sample_surface(*query.biome_map, query.params, &query.xz[(size_t)first * 2], count,
+            query.biome_ids + first, query.edge_distances + first, query.heights ? query.heights + first : nullptr);
+}
+
+void NativeTerrainGenerator::generate_block_cpu(zylann::voxel::VoxelBuffer &voxel_buffer, Vector3i origin, int lod) {
+    TraceSpan span("terrain", "cpu_generate_block", origin, lod);
+    uint64_t start_us = Time::get_singleton()->get_ticks_usec();
+    std::shared_ptr<const CpuBiomeMap> map = get_cpu_biome_map();
+
+    const int cs = chunk_size;
+    const size_t total_voxels = (size_t)cs * cs * cs;
+    thread_local std::vector<float> sdf_values;
+    thread_local std::vector<uint32_t> material_values;
+    sdf_values.resize(total_voxels);
+    material_values.resize(total_voxels);
+
+    const float chunk_origin[3] = { (float)origin.x, (float)origin.y, (float)origin.z };
+    CpuTerrainSampler::generate_chunk(*map, get_cpu_sampler_params(), chunk_origin, cs, get_voxel_step(lod), sdf_values.data(), material_values.data());
+
+    // Same layout as a STORAGE_FULL readback, so the bulk channel writers apply unchanged
+    const uint8_t *sdf_bytes = reinterpret_cast<const uint8_t *>(sdf_values.data());
+    const uint8_t *mat_bytes = reinterpret_cast<const uint8_t *>(material_values.data());
+    if (voxel_buffer.get_size() != Vector3i(cs, cs, cs) ||
+            !write_sdf_channel_bulk(voxel_buffer, sdf_bytes, STORAGE_FULL, cs) ||
+            !write_indices_channel_bulk(voxel_buffer, mat_bytes, STORAGE_FULL, cs)) {
+        write_voxels_per_voxel(voxel_buffer, sdf_bytes, mat_bytes, STORAGE_FULL, cs);
+    }
+
+    uint64_t elapsed_us = Time::get_singleton()->get_ticks_usec() - start_us;
+
+    if (get_region_store()) {
+        ChunkCache::Entry entry;
+        entry.sdf_data.resize((int64_t)total_voxels * sizeof(float));
+        entry.mat_data.resize((int64_t)total_voxels * sizeof(uint32_t));
+        std::memcpy(entry.sdf_data.ptrw(), sdf_bytes, total_voxels * sizeof(float));
+        std::memcpy(entry.mat_data.ptrw(), mat_bytes, total_voxels * sizeof(uint32_t));
+        store_chunk_in_region({ origin, lod }, entry, STORAGE_FULL);
+    }
+    uint64_t avg = avg_cpu_chunk_time_us.load();
+    avg_cpu_chunk_time_us = avg == 0 ? elapsed_us : (avg * 7 + elapsed_us) / 8;
+    cpu_chunks_generated++;
+}
+
+uint64_t NativeTerrainGenerator::get_terrain_signature() {
+    // Everything generated chunks depend on; storage_mode is recorded per blob instead
+    cpu_mutex->lock();
+    uint64_t biome_map_hash = cpu_biome_map_is_custom ? custom_biome_map_hash : 0;
+    cpu_mutex->unlock();
+
+    uint64_t h = 0xCBF29CE484222325ull;
+    h = hash_bytes(h, &REGION_CHUNK_VERSION, sizeof(REGION_CHUNK_VERSION));
+    h = hash_bytes(h, &world_seed, sizeof(world_seed));
+    h = hash_bytes(h, &chunk_size, sizeof(chunk_size));
+    h = hash_bytes(h, &world_size, sizeof(world_size));
+    h = hash_bytes(h, &sea_level, sizeof(sea_level));
+    h = hash_bytes(h, &blend_dist, sizeof(blend_dist));
+    h = hash_bytes(h, &biome_map_texel_size, sizeof(biome_map_texel_size));
+    h = hash_bytes(h, &biome_map_hash, sizeof(biome_map_hash));
+    h = hash_bytes(h, &ore_frequency, sizeof(ore_frequency));
+    h = hash_bytes(h, &ore_threshold, sizeof(ore_threshold));
+    h = hash_bytes(h, &ore_min_depth, sizeof(ore_min_depth));
+    h = hash_bytes(h, &ore_material_id, sizeof(ore_material_id));
+    // Without caves their parameters do not affect the terrain
+    if (caves_enabled) {
+        h = hash_bytes(h, &cave_frequency, sizeof(cave_frequency));
+        h = hash_bytes(h, &cave_threshold, sizeof(cave_threshold));
+        h = hash_bytes(h, &cave_min_depth, sizeof(cave_min_depth));
+    }
+    return h;
+}
+
+std::shared_ptr<RegionStore> NativeTerrainGenerator::get_region_store() {
+    region_mutex->lock();
+    if (region_cache_dir.empty()) {
+        region_mutex->unlock();
+        return nullptr;
+    }
+
+    uint64_t signature = get_terrain_signature();
+    if (!region_store || signature != region_store_signature) {
+        char name[17];
+        snprintf(name, sizeof(name), "%016llx", (unsigned long long)signature);
+        String directory = String::utf8(region_cache_dir.c_str()).path_join(name);
+
+        region_store.reset();
+        if (DirAccess::make_dir_recursive_absolute(directory) == OK) {
+            region_store = std::make_shared<RegionStore>(std::string(directory.utf8().get_data()));
+            region_store_signature = signature;
+        } else {
+            // Disable instead of retrying on every block
+            UtilityFunctions::printerr("[NativeTerrainGenerator] Cannot create region cache directory: ", directory);
+            region_cache_dir.clear();
+        }
+    }
+    std::shared_ptr<RegionStore> store = region_store;
+    region_mutex->unlock();
+    return store;
+}
+
+bool NativeTerrainGenerator::read_region_chunk(const ChunkKey &key, PackedByteArray &r_raw) {
+    std::shared_ptr<RegionStore> store = get_region_store();
+    if (!store) {
+        return false;
+    }
+    TraceSpan span("terrain", "region_load", key.origin, key.lod);
+
+    const int cs = chunk_size;
+    const int32_t cx = floor_div(key.origin.x, cs);
+    const int32_t cy = floor_div(key.origin.y, cs);
+    const int32_t cz = floor_div(key.origin.z, cs);
+
+    std::vector<uint8_t> blob;
+    uint32_t raw_size = 0;
+    if (!store->read(cx, cy, cz, key.lod, blob, raw_size)) {
+        region_misses++;
+        return false;
+    }
+
+    PackedByteArray compressed;
+    compressed.resize((int64_t)blob.size());
+    std::memcpy(compressed.ptrw(), blob.data(), blob.size());
+    PackedByteArray raw = compressed.decompress(raw_size, FileAccess::COMPRESSION_ZSTD);
+
+    RegionChunkHeader header = {};
+    bool valid = raw.size() >= (int64_t)sizeof(header);
+    if (valid) {
+        std::memcpy(&header, raw.ptr(), sizeof(header));
+        valid = header.version == REGION_CHUNK_VERSION &&
+                header.origin[0] == key.origin.x && header.origin[1] == key.origin.y && header.origin[2] == key.origin.z &&
+                header.lod == key.lod && header.chunk_size == cs && header.storage_mode <= STORAGE_SNORM16;
+    }
+
+    const StorageMode mode = (StorageMode)header.storage_mode;
+    const int64_t total_voxels = (int64_t)cs * cs * cs;
+    if (valid && !header.uniform) {
+        valid = header.sdf_bytes == total_voxels * get_sdf_bytes_per_voxel(mode) &&
+                header.mat_bytes == total_voxels * get_material_bytes_per_voxel(mode) &&
+                raw.size() >= (int64_t)sizeof(header) + header.sdf_bytes + header.mat_bytes;
+    }
+
+    if (!valid) {
+        // Truncated or foreign blob: drop it so the regenerated chunk is stored again
+        store->erase(cx, cy, cz, key.lod);
+        region_misses++;
+        return false;
+    }
+
+    r_raw = raw;
+    region_hits++;
+    return true;
+}
+
+bool NativeTerrainGenerator::load_chunk_from_region(const ChunkKey &key, zylann::voxel::VoxelBuffer &voxel_buffer) {
+    PackedByteArray raw;
+    if (!read_region_chunk(key, raw)) {
+        return false;
+    }
+    RegionChunkHeader header = {};
+    std::memcpy(&header, raw.ptr(), sizeof(header));
+    const StorageMode mode = (StorageMode)header.storage_mode;
+    const int cs = chunk_size;
+
+    if (header.uniform) {
+        voxel_buffer.clear_channel_f(zylann::voxel::VoxelBuffer::CHANNEL_SDF, header.uniform_sdf);
+        voxel_buffer.clear_channel(zylann::voxel::VoxelBuffer::CHANNEL_INDICES, header.uniform_material);
+    } else {
+        // Decoded with the blob's own storage mode, so chunks stored under another mode stay readable
+        const uint8_t *sdf_src = raw.ptr() + sizeof(header);
+        const uint8_t *mat_src = sdf_src + header.sdf_bytes;
+        if (voxel_buffer.get_size() != Vector3i(cs, cs, cs) ||
+                !write_sdf_channel_bulk(voxel_buffer, sdf_src, mode, cs) ||
+                !write_indices_channel_bulk(voxel_buffer, mat_src, mode, cs)) {
+            write_voxels_per_voxel(voxel_buffer, sdf_src, mat_src, mode, cs);
+        }
+    }
+    return true;
+}
+
+bool NativeTerrainGenerator::load_region_chunk_into_cache(const ChunkKey &key) {
+    // Cached CPU copies are decoded with the current storage_mode: blobs stored under another mode
+    // are left to generate_block(), which decodes them with their own
+    PackedByteArray raw;
+    if (!read_region_chunk(key, raw)) {
+        return false;
+    }
+    RegionChunkHeader header = {};
+    std::memcpy(&header, raw.ptr(), sizeof(header));
+
+    ChunkCache::Entry entry;
+    if (header.uniform) {
+        entry.uniform = true;
+        entry.uniform_sdf = header.uniform_sdf;
+        entry.uniform_material = header.uniform_material;
+    } else if ((StorageMode)header.storage_mode == storage_mode) {
+        // CPU copy only, like a uniform chunk: no textures for GPU clients or SDF edits to patch
+        entry.sdf_data = raw.slice(sizeof(header), sizeof(header) + header.sdf_bytes);
+        entry.mat_data = raw.slice(sizeof(header) + header.sdf_bytes, sizeof(header) + header.sdf_bytes + header.mat_bytes);
+    } else {
+        return false;
+    }
+
+    std::vector<ChunkCache::Entry> released;
+    cache_mutex->lock();
+    chunk_cache.insert(key, entry, released);
+    cache_mutex->unlock();
+    release_cache_entries(released);
+    return true;
+}
+
+void NativeTerrainGenerator::store_chunk_in_region(const ChunkKey &key, const ChunkCache::Entry &entry, StorageMode mode) {
+    // Chunks without a CPU copy (async LOD > 0 with textures only) are not stored
+    if (!entry.uniform && !entry.has_cpu_data()) {
+        return;
+    }
+    std::shared_ptr<RegionStore> store = get_region_store();
+    if (!store) {
+        return;
+    }
+    TraceSpan span("terrain", "region_store", key.origin, key.lod);
+
+    const int cs = chunk_size;
+    // Off-grid origins would alias a grid chunk's slot
+    if (key.origin.x % cs != 0 || key.origin.y % cs != 0 || key.origin.z % cs != 0) {
+        return;
+    }
+    const int32_t cx = floor_div(key.origin.x, cs);
+    const int32_t cy = floor_div(key.origin.y, cs);
+    const int32_t cz = floor_div(key.origin.z, cs);
+
+    // Regions are append-only: don't grow them with chunks that are already stored
+    if (store->contains(cx, cy, cz, key.lod)) {
+        return;
+    }
+
+    RegionChunkHeader header = {};
+    header.version = REGION_CHUNK_VERSION;
+    header.origin[0] = key.origin.x;
+    header.origin[1] = key.origin.y;
+    header.origin[2] = key.origin.z;
+    header.lod = key.lod;
+    header.chunk_size = cs;
+    header.storage_mode = (uint32_t)mode;
+    header.uniform = entry.uniform ? 1 : 0;
+    header.uniform_sdf = entry.uniform_sdf;
+    header.uniform_material = entry.uniform_material;
+    header.sdf_bytes = entry.uniform ? 0 : (uint32_t)entry.sdf_data.size();
+    header.mat_bytes = entry.uniform ? 0 : (uint32_t)entry.mat_data.size();
+
+    PackedByteArray raw;
+    raw.resize((int64_t)sizeof(header) + header.sdf_bytes + header.mat_bytes);
+    uint8_t *dst = raw.ptrw();
+    std::memcpy(dst, &header, sizeof(header));
+    if (!entry.uniform) {
+        std::memcpy(dst + sizeof(header), entry.sdf_data.ptr(), header.sdf_bytes);
+        std::memcpy(dst + sizeof(header) + header.sdf_bytes, entry.mat_data.ptr(), header.mat_bytes);
+    }
+
+    PackedByteArray compressed = raw.compress(FileAccess::COMPRESSION_ZSTD);
+    if (compressed.is_empty()) {
+        return;
+    }
+    if (store->write(cx, cy, cz, key.lod, compressed.ptr(), (uint32_t)compressed.size(), (uint32_t)raw.size())) {
+        region_writes++;
+    } else {
+        UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to write chunk ", key.origin, " to the region cache");
+    }
 }
 
 NativeTerrainGenerator::Result NativeTerrainGenerator::generate_block(VoxelQueryData input) {
     Result result;
     result.max_lod_hint = false;
     
-    if (!gpu_initialized) {
-        if (!initialize_gpu()) {
-            UtilityFunctions::printerr("[NativeTerrainGenerator] GPU initialization failed");
-            return result;
-        }
+    if (!gpu_initialized && !cpu_fallback_active) {
+        initialize_gpu();
     }
 
     Vector3i origin_in_voxels = input.origin_in_voxels;
     int lod = input.lod;
     zylann::voxel::VoxelBuffer &out_buffer = input.voxel_buffer;
 
-    // Check cache first
-    String cache_key = String("{0}_{1}_{2}_{3}").format(Array::make(origin_in_voxels.x, origin_in_voxels.y, origin_in_voxels.z, lod));
+    // Check cache first (same (origin, lod) key as the GPU thread inserts)
+    ChunkKey cache_key = { origin_in_voxels, lod };
     
     cache_mutex->lock();
-    if (sdf_cache.has(cache_key)) {
-        Dictionary cached = sdf_cache[cache_key];
-        if (cached.has("sdf_data") && cached.has("mat_data")) {
-            PackedByteArray sdf_data = cached["sdf_data"];
-            PackedByteArray mat_data = cached["mat_data"];
+    const ChunkCache::Entry *cached = chunk_cache.find(cache_key);
+    if (cached) {
+        if (cached->uniform || cached->has_cpu_data()) {
+            ChunkCache::Entry entry = *cached;
             cache_mutex->unlock();
             
-            const int CHANNEL_SDF = zylann::voxel::VoxelBuffer::CHANNEL_SDF;
-            const int CHANNEL_INDICES = zylann::voxel::VoxelBuffer::CHANNEL_INDICES;
-            
-            // Write cached data to buffer
-            const uint8_t* sdf_ptr = sdf_data.ptr();
-            const uint8_t* mat_ptr = mat_data.ptr();
-            
-            for (int z = 0; z < chunk_size; z++) {
-                for (int y = 0; y < chunk_size; y++) {
-                    for (int x = 0; x < chunk_size; x++) {
-                        int idx = (z * chunk_size * chunk_size + y * chunk_size + x) * 4;
-                        float sdf_value;
-                        std::memcpy(&sdf_value, &sdf_ptr[idx], sizeof(float));
-                        uint32_t mat_value;
-                        std::memcpy(&mat_value, &mat_ptr[idx], sizeof(uint32_t));
-                        out_buffer.set_voxel_f(sdf_value, x, y, z, CHANNEL_SDF);
-                        out_buffer.set_voxel(mat_value, x, y, z, CHANNEL_INDICES);
-                    }
-                }
-            }
+            write_cache_entry_to_buffer(out_buffer, entry);
             result.max_lod_hint = true;
             return result;
         }
     }
     cache_mutex->unlock();
-    
-    // Async GPU path: enqueue request
-    if (lod > 0) {
-        enqueue_chunk_request(origin_in_voxels, lod, player_position);
+
+    // Explored chunks come back from the region cache before the GPU or the CPU sampler is involved
+    if (load_chunk_from_region(cache_key, out_buffer)) {
+        result.max_lod_hint = true;
+        return result;
+    }
+
+    if (!gpu_initialized) {
+        // No RenderingDevice: generate on this voxel thread instead of leaving the world empty
+        generate_block_cpu(out_buffer, origin_in_voxels, lod);
+        result.max_lod_hint = true;
         return result;
     }
     
-    // LOD 0: synchronous generation
-    Dictionary gpu_result = generate_chunk_sdf(origin_in_voxels);
-    if (gpu_result.has("sdf_texture") && gpu_result.has("material_texture")) {
-        RID sdf_tex = gpu_result["sdf_texture"];
-        RID mat_tex = gpu_result["material_texture"];
-        
-        write_gpu_data_to_buffer_bulk(out_buffer, sdf_tex, mat_tex, chunk_size);
-        
-        // Cache for future requests
-        cache_mutex->lock();
-        PackedByteArray sdf_data = rd->texture_get_data(sdf_tex, 0);
-        PackedByteArray mat_data = rd->texture_get_data(mat_tex, 0);
-        Dictionary cache_entry;
-        cache_entry["sdf_data"] = sdf_data;
-        cache_entry["mat_data"] = mat_data;
-        sdf_cache[cache_key] = cache_entry;
-        cache_mutex->unlock();
-        
+    // Every LOD is generated synchronously: a block at LOD n covers 2^n times the extent with the same
+    // chunk_size^3 samples, so distant blocks cost as much as near ones.
+    // The chunk rides the next GPU batch together with every other worker's request; this worker blocks
+    // on its own future until that batch has synced and been read back (and cached under cache_key)
+    ChunkCache::Entry entry;
+    if (request_chunk_sync(cache_key, entry)) {
+        write_cache_entry_to_buffer(out_buffer, entry);
         result.max_lod_hint = true;
         return result;
     }
@@ -662,7 +1764,9 @@ int NativeTerrainGenerator::get_used_channels_mask() const {
 }
 
 void NativeTerrainGenerator::set_world_seed(int seed) {
+    const uint64_t previous_signature = get_terrain_signature();
     world_seed = seed;
+    drop_cache_on_signature_change(previous_signature);
 }
 
 int NativeTerrainGenerator::get_world_seed() const {
@@ -670,7 +1774,9 @@ int NativeTerrainGenerator::get_world_seed() const {
 }
 
 void NativeTerrainGenerator::set_chunk_size(int size) {
+    const uint64_t previous_signature = get_terrain_signature();
     chunk_size = size;
+    drop_cache_on_signature_change(previous_signature);
 }
 
 int NativeTerrainGenerator::get_chunk_size() const {
@@ -678,7 +1784,9 @@ int NativeTerrainGenerator::get_chunk_size() const {
 }
 
 void NativeTerrainGenerator::set_world_size(float size) {
+    const uint64_t previous_signature = get_terrain_signature();
     world_size = size;
+    drop_cache_on_signature_change(previous_signature);
 }
 
 float NativeTerrainGenerator::get_world_size() const {
@@ -686,7 +1794,9 @@ float NativeTerrainGenerator::get_world_size() const {
 }
 
 void NativeTerrainGenerator::set_sea_level(float level) {
+    const uint64_t previous_signature = get_terrain_signature();
     sea_level = level;
+    drop_cache_on_signature_change(previous_signature);
 }
 
 float NativeTerrainGenerator::get_sea_level() const {
@@ -694,80 +1804,332 @@ float NativeTerrainGenerator::get_sea_level() const {
 }
 
 void NativeTerrainGenerator::set_blend_dist(float dist) {
+    const uint64_t previous_signature = get_terrain_signature();
     blend_dist = dist;
+    drop_cache_on_signature_change(previous_signature);
 }
 
 float NativeTerrainGenerator::get_blend_dist() const {
     return blend_dist;
 }
 
-void NativeTerrainGenerator::set_biome_map_texture(Ref<Image> texture) {
-    if (!texture.is_valid()) {
-        UtilityFunctions::push_warning("[NativeTerrainGenerator] Invalid biome map texture provided");
-        return;
-    }
+void NativeTerrainGenerator::set_biome_map_texel_size(float size) {
+    // Resident tiles are dropped on the device thread's next batch (get_biome_tiles_signature())
+    const uint64_t previous_signature = get_terrain_signature();
+    biome_map_texel_size = size > 0.25f ? size : 0.25f;
+    drop_cache_on_signature_change(previous_signature);
+}
 
-    if (!rd) {
-        if (!initialize_gpu()) {
-            UtilityFunctions::printerr("[NativeTerrainGenerator] Cannot set biome map: GPU not initialized");
-            return;
-        }
-    }
+float NativeTerrainGenerator::get_biome_map_texel_size() const {
+    return biome_map_texel_size;
+}
 
-    Ref<Image> processed_texture = texture->duplicate();
-    
-    if (processed_texture->is_compressed()) {
-        processed_texture->decompress();
+void NativeTerrainGenerator::drop_cache_on_signature_change(uint64_t previous_signature) {
+    // Cached chunks are keyed by origin and LOD only, so they would outlive the settings they were
+    // generated with; chunks in flight finish and are cached as generated, as with invalidate_*()
+    if (get_terrain_signature() != previous_signature) {
+        clear_cache();
     }
+}
 
-    // CRITICAL: Preserve RG32F format for biome_id (R) and dist_edge (G) channels
-    // The compute shader expects: R=biome_id (0-1), G=dist_edge (0-1)
-    // Do NOT convert to RGBA8 as it drops the float precision needed for dist_edge
-    RenderingDevice::DataFormat gpu_format;
-    Image::Format target_format;
-    
-    // Check if the image is already in a compatible float format
-    if (processed_texture->get_format() == Image::FORMAT_RGF || 
-        processed_texture->get_format() == Image::FORMAT_RGBAF) {
-        // Already in float format, use RG32F
-        target_format = Image::FORMAT_RGF;
-        gpu_format = RenderingDevice::DATA_FORMAT_R32G32_SFLOAT;
-    } else {
-        // Convert to RGF to preserve the two-channel float data
-        target_format = Image::FORMAT_RGF;
-        gpu_format = RenderingDevice::DATA_FORMAT_R32G32_SFLOAT;
-    }
-    
-    if (processed_texture->get_format() != target_format) {
-        processed_texture->convert(target_format);
-    }
+void NativeTerrainGenerator::set_ore_frequency(float frequency) {
+    const uint64_t previous_signature = get_terrain_signature();
+    ore_frequency = frequency > 0.0001f ? frequency : 0.0001f;
+    drop_cache_on_signature_change(previous_signature);
+}
 
-    Ref<RDTextureFormat> tex_format;
-    tex_format.instantiate();
-    tex_format->set_format(gpu_format);
-    tex_format->set_width(processed_texture->get_width());
-    tex_format->set_height(processed_texture->get_height());
-    tex_format->set_texture_type(RenderingDevice::TEXTURE_TYPE_2D);
-    tex_format->set_usage_bits(
-        RenderingDevice::TEXTURE_USAGE_SAMPLING_BIT |
-        RenderingDevice::TEXTURE_USAGE_CAN_UPDATE_BIT
-    );
+float NativeTerrainGenerator::get_ore_frequency() const {
+    return ore_frequency;
+}
 
-    TypedArray<PackedByteArray> data_array;
-    data_array.push_back(processed_texture->get_data());
+void NativeTerrainGenerator::set_ore_threshold(float threshold) {
+    const uint64_t previous_signature = get_terrain_signature();
+    ore_threshold = threshold;
+    drop_cache_on_signature_change(previous_signature);
+}
 
-    if (biome_map_texture.is_valid()) {
-        rd->free_rid(biome_map_texture);
+float NativeTerrainGenerator::get_ore_threshold() const {
+    return ore_threshold;
+}
+
+void NativeTerrainGenerator::set_ore_min_depth(float depth) {
+    const uint64_t previous_signature = get_terrain_signature();
+    ore_min_depth = depth > 0.0f ? depth : 0.0f;
+    drop_cache_on_signature_change(previous_signature);
+}
+
+float NativeTerrainGenerator::get_ore_min_depth() const {
+    return ore_min_depth;
+}
+
+void NativeTerrainGenerator::set_ore_material_id(int material_id) {
+    const uint64_t previous_signature = get_terrain_signature();
+    // Narrow storage modes keep materials in R8UI
+    ore_material_id = material_id < 0 ? 0 : (material_id > 255 ? 255 : material_id);
+    drop_cache_on_signature_change(previous_signature);
+}
+
+int NativeTerrainGenerator::get_ore_material_id() const {
+    return ore_material_id;
+}
+
+void NativeTerrainGenerator::set_caves_enabled(bool enabled) {
+    const uint64_t previous_signature = get_terrain_signature();
+    caves_enabled = enabled;
+    drop_cache_on_signature_change(previous_signature);
+}
+
+bool NativeTerrainGenerator::is_caves_enabled() const {
+    return caves_enabled;
+}
+
+void NativeTerrainGenerator::set_cave_frequency(float frequency) {
+    const uint64_t previous_signature = get_terrain_signature();
+    cave_frequency = frequency > 0.0001f ? frequency : 0.0001f;
+    drop_cache_on_signature_change(previous_signature);
+}
+
+float NativeTerrainGenerator::get_cave_frequency() const {
+    return cave_frequency;
+}
+
+void NativeTerrainGenerator::set_cave_threshold(float threshold) {
+    const uint64_t previous_signature = get_terrain_signature();
+    cave_threshold = threshold;
+    drop_cache_on_signature_change(previous_signature);
+}
+
+float NativeTerrainGenerator::get_cave_threshold() const {
+    return cave_threshold;
+}
+
+void NativeTerrainGenerator::set_cave_min_depth(float depth) {
+    const uint64_t previous_signature = get_terrain_signature();
+    cave_min_depth = depth > 0.0f ? depth : 0.0f;
+    drop_cache_on_signature_change(previous_signature);
+}
+
+float NativeTerrainGenerator::get_cave_min_depth() const {
+    return cave_min_depth;
+}
+
+void NativeTerrainGenerator::set_cache_budget_mb(int budget_mb) {
+    cache_budget_mb = budget_mb > 0 ? budget_mb : 1;
+
+    std::vector<ChunkCache::Entry> evicted;
+    cache_mutex->lock();
+    chunk_cache.set_byte_budget((uint64_t)cache_budget_mb * 1024ull * 1024ull, evicted);
+    cache_mutex->unlock();
+
+    release_cache_entries(evicted);
+}
+
+int NativeTerrainGenerator::get_cache_budget_mb() const {
+    return cache_budget_mb;
+}
+
+void NativeTerrainGenerator::set_storage_mode(int mode) {
+    StorageMode new_mode = (mode == STORAGE_HALF || mode == STORAGE_SNORM16) ? (StorageMode)mode : STORAGE_FULL;
+    if (new_mode == storage_mode) {
+        return;
+    }
+
+    // Textures, cached readback and the SDF pipeline all depend on the format: rebuild the GPU side
+    bool was_initialized = gpu_initialized;
+    if (was_initialized) {
+        cleanup_gpu();
+    }
+    storage_mode = new_mode;
+    if (was_initialized) {
+        initialize_gpu();
+    }
+}
+
+int NativeTerrainGenerator::get_storage_mode() const {
+    return storage_mode;
+}
+
+void NativeTerrainGenerator::set_region_cache_path(const String &path) {
+    region_mutex->lock();
+    region_cache_path = path;
+    region_cache_dir.clear();
+    region_store.reset();  // Blocks holding the previous store finish with it
+    if (!path.is_empty()) {
+        String absolute = ProjectSettings::get_singleton()->globalize_path(path);
+        region_cache_dir = absolute.utf8().get_data();
+    }
+    region_mutex->unlock();
+}
+
+String NativeTerrainGenerator::get_region_cache_path() const {
+    return region_cache_path;
+}
+
+void NativeTerrainGenerator::set_collision_only(bool enabled) {
+    // Takes effect for chunks dispatched from now on; cached chunks keep what they were built with
+    collision_only = enabled;
+}
+
+bool NativeTerrainGenerator::is_collision_only() const {
+    return collision_only;
+}
+
+bool NativeTerrainGenerator::has_collision_mesh(Vector3i origin) const {
+    ChunkKey key = { origin, 0 };
+    cache_mutex->lock();
+    const ChunkCache::Entry *cached = chunk_cache.peek(key);
+    bool has_collision = cached && cached->has_collision;
+    cache_mutex->unlock();
+    return has_collision;
+}
+
+PackedVector3Array NativeTerrainGenerator::get_collision_faces(Vector3i origin) const {
+    ChunkKey key = { origin, 0 };
+    PackedFloat32Array vertices;
+    PackedInt32Array indices;
+    cache_mutex->lock();
+    const ChunkCache::Entry *cached = chunk_cache.peek(key);
+    if (cached && cached->has_collision) {
+        vertices = cached->collision_vertices;  // Copy-on-write: no copy is made here
+        indices = cached->collision_indices;
+    }
+    cache_mutex->unlock();
+
+    PackedVector3Array faces;
+    const int64_t vertex_count = vertices.size() / 3;
+    faces.resize(indices.size());
+    const float *src = vertices.ptr();
+    const int32_t *index_ptr = indices.ptr();
+    Vector3 *dst = faces.ptrw();
+    for (int64_t i = 0; i < indices.size(); i++) {
+        const int64_t v = index_ptr[i];
+        dst[i] = (v >= 0 && v < vertex_count) ? Vector3(src[v * 3 + 0], src[v * 3 + 1], src[v * 3 + 2]) : Vector3();
+    }
+    return faces;
+}
+
+void NativeTerrainGenerator::set_biome_map_texture(Ref<Image> texture) {
+    if (!texture.is_valid()) {
+        UtilityFunctions::push_warning("[NativeTerrainGenerator] Invalid biome map texture provided");
+        return;
     }
 
-    biome_map_texture = rd->texture_create(tex_format, Ref<RDTextureView>(), data_array);
+    Ref<Image> processed_texture = texture->duplicate();
     
-    if (biome_map_texture.is_valid()) {
-        UtilityFunctions::print("[NativeTerrainGenerator] Biome map texture set successfully (", 
-            processed_texture->get_width(), "x", processed_texture->get_height(), ") in RG32F format");
+    if (processed_texture->is_compressed()) {
+        processed_texture->decompress();
+    }
+
+    // CRITICAL: Preserve RG32F format for biome_id (R) and dist_edge (G) channels
+    // The compute shader expects: R=biome_id (0-1), G=dist_edge (0-1)
+    // Do NOT convert to RGBA8 as it drops the float precision needed for dist_edge
+    if (processed_texture->get_format() != Image::FORMAT_RGF) {
+        processed_texture->convert(Image::FORMAT_RGF);
+    }
+
+    // The CPU fallback samples the same map, and GPU rebuilds upload it again from this copy
+    PackedByteArray texel_bytes = processed_texture->get_data();
+    std::shared_ptr<CpuBiomeMap> cpu_map = std::make_shared<CpuBiomeMap>();
+    cpu_map->width = processed_texture->get_width();
+    cpu_map->height = processed_texture->get_height();
+    cpu_map->texels.resize((size_t)cpu_map->width * (size_t)cpu_map->height * 2);
+    if (cpu_map->texels.empty() || (int64_t)cpu_map->texels.size() * (int64_t)sizeof(float) > texel_bytes.size()) {
+        UtilityFunctions::push_warning("[NativeTerrainGenerator] Biome map texture has no RG32F data");
+        return;
+    }
+    std::memcpy(cpu_map->texels.data(), texel_bytes.ptr(), cpu_map->texels.size() * sizeof(float));
+    // Stored region chunks are keyed by the map contents too
+    uint64_t map_hash = hash_bytes(0xCBF29CE484222325ull, cpu_map->texels.data(), cpu_map->texels.size() * sizeof(float));
+    // Chunks cached with the previous map are dropped once this one is in place
+    const uint64_t previous_signature = get_terrain_signature();
+    cpu_mutex->lock();
+    cpu_biome_map = cpu_map;
+    cpu_biome_map_is_custom = true;
+    custom_biome_map_hash = map_hash;
+    cpu_mutex->unlock();
+
+    if (!rd) {
+        // initialize_gpu() uploads the custom map with the rest of the GPU side
+        if (!initialize_gpu()) {
+            UtilityFunctions::print("[NativeTerrainGenerator] Biome map set for the CPU fallback only (GPU not initialized)");
+        }
+        drop_cache_on_signature_change(previous_signature);
+        return;
+    }
+
+    // The old map may be bound by a pass in flight: swap it on the device thread
+    gpu_context->run([&]() {
+        if (biome_map_texture.is_valid()) {
+            rd->free_rid(biome_map_texture);
+        }
+
+        biome_map_texture = create_custom_biome_map_texture(*cpu_map);
+        gpu_context->set_biome_map_texture(biome_map_texture);
+
+        if (biome_map_texture.is_valid()) {
+            UtilityFunctions::print("[NativeTerrainGenerator] Biome map texture set successfully (", 
+                cpu_map->width, "x", cpu_map->height, ") in RG32F format");
+        } else {
+            UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create biome map texture, keeping the virtual map");
+        }
+    });
+    drop_cache_on_signature_change(previous_signature);
+}
+
+bool NativeTerrainGenerator::is_cpu_fallback_active() const {
+    return cpu_fallback_active;
+}
+
+Dictionary NativeTerrainGenerator::generate_chunk_data(Vector3i origin, bool use_cpu, int lod) {
+    Dictionary result;
+    const int cs = chunk_size;
+    const int total_voxels = cs * cs * cs;
+
+    PackedFloat32Array sdf_values;
+    PackedInt32Array material_values;
+    sdf_values.resize(total_voxels);
+    material_values.resize(total_voxels);
+
+    if (use_cpu) {
+        std::shared_ptr<const CpuBiomeMap> map = get_cpu_biome_map();
+        std::vector<uint32_t> materials(total_voxels);
+        const float chunk_origin[3] = { (float)origin.x, (float)origin.y, (float)origin.z };
+        CpuTerrainSampler::generate_chunk(*map, get_cpu_sampler_params(), chunk_origin, cs, get_voxel_step(lod), sdf_values.ptrw(), materials.data());
+        int32_t *mat_dst = material_values.ptrw();
+        for (int i = 0; i < total_voxels; i++) {
+            mat_dst[i] = (int32_t)materials[i];
+        }
     } else {
-        UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create biome map texture");
+        if (!gpu_initialized) {
+            UtilityFunctions::printerr("[NativeTerrainGenerator] generate_chunk_data: GPU not initialized");
+            return result;
+        }
+
+        ChunkKey key = { origin, lod };
+        ChunkCache::Entry entry;
+        if (!request_chunk_sync(key, entry)) {
+            return result;
+        }
+
+        if (entry.uniform) {
+            sdf_values.fill(entry.uniform_sdf);
+            material_values.fill((int32_t)entry.uniform_material);
+        } else {
+            const float *sdf_src = decode_sdf_to_float(entry.sdf_data.ptr(), storage_mode, cs);
+            std::memcpy(sdf_values.ptrw(), sdf_src, (size_t)total_voxels * sizeof(float));
+            const uint8_t *mat_src = entry.mat_data.ptr();
+            const bool narrow_material = get_material_bytes_per_voxel(storage_mode) == 1;
+            int32_t *mat_dst = material_values.ptrw();
+            for (int i = 0; i < total_voxels; i++) {
+                mat_dst[i] = narrow_material ? (int32_t)mat_src[i] : (int32_t)reinterpret_cast<const uint32_t *>(mat_src)[i];
+            }
+        }
     }
+
+    result["sdf"] = sdf_values;
+    result["material"] = material_values;
+    result["source"] = use_cpu ? "cpu" : "gpu";
+    return result;
 }
 
 bool NativeTerrainGenerator::is_gpu_available() const {
@@ -786,12 +2148,11 @@ void NativeTerrainGenerator::_notification(int p_what) {
 
 // Async GPU Methods Implementation
 
-bool NativeTerrainGenerator::poll_gpu_completion(Vector3i origin) {
-    // COMMENT 1 FIX: Check gpu_complete flag set by background thread
-    // Background thread uses barrier() to ensure GPU work is done before setting flag
+bool NativeTerrainGenerator::poll_gpu_completion(const ChunkKey &key) {
+    // gpu_complete is set by the GPU thread after sync() on the chunk's batch returns
     queue_mutex->lock();
     
-    auto it = chunk_gpu_states.find(origin);
+    auto it = chunk_gpu_states.find(key);
     if (it == chunk_gpu_states.end()) {
         queue_mutex->unlock();
         return false;
@@ -803,6 +2164,10 @@ bool NativeTerrainGenerator::poll_gpu_completion(Vector3i origin) {
 }
 
 void NativeTerrainGenerator::enqueue_chunk_request(Vector3i origin, int lod, Vector3 player_pos) {
+    const uint64_t now_us = Time::get_singleton()->get_ticks_usec();
+    uint64_t expected = 0;
+    first_request_time_us.compare_exchange_strong(expected, now_us);
+
     queue_mutex->lock();
     
     // COMMENT 4 FIX: Use real player position for priority calculation
@@ -811,274 +2176,1595 @@ void NativeTerrainGenerator::enqueue_chunk_request(Vector3i origin, int lod, Vec
         player_position = player_pos;
     }
     
-    // Calculate priority (distance from player)
-    Vector3 chunk_center = Vector3(origin.x + chunk_size/2, origin.y + chunk_size/2, origin.z + chunk_size/2);
-    float distance = chunk_center.distance_to(player_position);
-    
-    ChunkRequest request;
-    request.origin = origin;
-    request.lod = lod;
-    request.priority = distance;  // Lower distance = higher priority
-    request.request_time_us = Time::get_singleton()->get_ticks_usec();
-    
-    chunk_request_queue.push(request);
+    // Priority is not fixed here: process_chunk_queue() scores every pending request against the
+    // view it sees. Requests already queued or in flight are dropped.
+    ChunkKey key = { origin, lod };
+    if (chunk_gpu_states.find(key) != chunk_gpu_states.end() || !chunk_scheduler.push(key, now_us)) {
+        requests_deduplicated++;
+    }
     
     queue_mutex->unlock();
 }
 
+bool NativeTerrainGenerator::cancel_chunk_request(Vector3i origin, int lod) {
+    queue_mutex->lock();
+    bool cancelled = chunk_scheduler.cancel({ origin, lod });
+    queue_mutex->unlock();
+    if (cancelled) {
+        requests_cancelled++;
+    }
+    return cancelled;
+}
+
 void NativeTerrainGenerator::process_chunk_queue(float delta) {
     reset_frame_budget();
     chunks_dispatched_this_frame = 0;
-    chunks_completed_this_frame = 0;
-    
-    // COMMENT 3 FIX: Poll all in-flight chunks first to get accurate GPU time measurements
-    std::vector<Vector3i> to_check;
+    poll_prewarm();
+
+    // Completions are reported by the GPU thread when sync() on a batch returns
+    chunks_completed_this_frame = chunks_completed_since_poll.exchange(0);
+
+    // Dispatch new chunks only while the measured per-chunk GPU cost fits the frame budget
+    // All chunks admitted this frame are recorded into a single batch (one compute list, one submit)
+    uint64_t avg_measured_time = avg_chunk_gpu_time_us.load();
+    if (avg_measured_time == 0) {
+        avg_measured_time = 2000;  // 2ms conservative default until the first batch is measured
+    }
+    const int admissible = (int)std::min<uint64_t>(MAX_BATCH_CHUNKS, std::max<uint64_t>(1, frame_gpu_budget_us / avg_measured_time));
+
+    std::vector<ChunkRequest> batch;
+    batch.reserve(MAX_BATCH_CHUNKS);
+
     queue_mutex->lock();
-    for (auto& pair : chunk_gpu_states) {
-        to_check.push_back(pair.first);
+
+    // Back-pressure: the GPU thread syncs each batch, so do not queue work faster than it drains
+    if ((int)pending_batches.size() >= MAX_PENDING_BATCHES) {
+        queue_mutex->unlock();
+        return;
     }
-    queue_mutex->unlock();
-    
-    for (Vector3i origin : to_check) {
-        if (poll_gpu_completion(origin)) {
-            // COMMENT 3 FIX: Add measured GPU time to current frame budget
-            queue_mutex->lock();
-            auto it = chunk_gpu_states.find(origin);
-            if (it != chunk_gpu_states.end() && it->second.completion_time_us > 0) {
-                uint64_t measured_time = it->second.completion_time_us - it->second.dispatch_time_us;
-                current_frame_gpu_time_us += measured_time;
+
+    ChunkScheduler::View view;
+    view.position = player_position;
+    view.forward = view_direction;
+    view.chunk_size = chunk_size;
+    view.view_weight = view_weight;
+    view.max_distance = max_request_distance;
+
+    const uint64_t now_us = Time::get_singleton()->get_ticks_usec();
+    std::vector<ChunkScheduler::Request> selected;
+    while ((int)batch.size() < admissible && chunk_scheduler.get_size() > 0) {
+        selected.clear();
+        requests_dropped += chunk_scheduler.select(view, now_us, admissible - (int)batch.size(), selected);
+
+        for (const ChunkScheduler::Request &candidate : selected) {
+            // Skip if already in cache or being processed
+            cache_mutex->lock();
+            bool in_cache = chunk_cache.contains(candidate.key);
+            cache_mutex->unlock();
+            
+            if (in_cache || chunk_gpu_states.find(candidate.key) != chunk_gpu_states.end()) {
+                continue;
             }
-            queue_mutex->unlock();
-        }
-    }
-    
-    // COMMENT 3 FIX: Dispatch new chunks only if measured GPU time is under budget
-    queue_mutex->lock();
-    
-    while (!chunk_request_queue.empty() && current_frame_gpu_time_us < frame_gpu_budget_us) {
-        ChunkRequest request = chunk_request_queue.top();
-        chunk_request_queue.pop();
-        
-        // Skip if already in cache or being processed
-        cache_mutex->lock();
-        bool in_cache = sdf_cache.has(request.origin);
-        cache_mutex->unlock();
-        
-        if (in_cache || chunk_gpu_states.find(request.origin) != chunk_gpu_states.end()) {
-            continue;
+            
+            ChunkRequest request;
+            request.origin = candidate.key.origin;
+            request.lod = candidate.key.lod;
+            request.priority = candidate.score;
+            request.request_time_us = candidate.enqueue_time_us;
+            batch.push_back(request);
+            current_frame_gpu_time_us += avg_measured_time;
+
+            const uint64_t wait_us = now_us > candidate.enqueue_time_us ? now_us - candidate.enqueue_time_us : 0;
+            if ((int)dispatch_wait_samples.size() < DISPATCH_WAIT_SAMPLES) {
+                dispatch_wait_samples.push_back(wait_us);
+            } else {
+                dispatch_wait_samples[dispatch_wait_next] = wait_us;
+            }
+            dispatch_wait_next = (dispatch_wait_next + 1) % DISPATCH_WAIT_SAMPLES;
+            TraceRecorder::record("terrain", "chunk_queue_wait", candidate.enqueue_time_us, now_us, request.origin, request.lod);
         }
-        
-        queue_mutex->unlock();
-        dispatch_chunk_async(request.origin, request.lod);
-        queue_mutex->lock();
-        
-        chunks_dispatched_this_frame++;
-        
-        // COMMENT 3 FIX: Use measured average GPU time for budget estimation
-        // Only dispatch if we have headroom based on actual measurements
-        uint64_t avg_measured_time = total_chunks_generated > 0 
-            ? total_gpu_time_us / total_chunks_generated 
-            : 2000;  // 2ms conservative default
-        current_frame_gpu_time_us += avg_measured_time;
     }
     
     queue_mutex->unlock();
+
+    if (!batch.empty()) {
+        dispatch_chunk_batch_async(batch);
+    }
 }
 
 void NativeTerrainGenerator::dispatch_chunk_async(Vector3i origin, int lod) {
-    // This is essentially generate_chunk_sdf but without cache check
-    generate_chunk_sdf(origin);
-    
-    // Update LOD and physics_needed flag
+    ChunkRequest request;
+    request.origin = origin;
+    request.lod = lod;
+    request.priority = 0.0f;
+    request.request_time_us = Time::get_singleton()->get_ticks_usec();
+
+    std::vector<ChunkRequest> requests;
+    requests.push_back(request);
+    dispatch_chunk_batch_async(requests);
+}
+
+void NativeTerrainGenerator::dispatch_chunk_batch_async(const std::vector<ChunkRequest> &requests) {
+    int dispatched = generate_chunk_sdf_batch(requests);
+    chunks_dispatched_this_frame += dispatched;
+}
+
+bool NativeTerrainGenerator::process_gpu_work() {
+    // Workers blocked in generate_block() first
+    process_sync_requests();
+    apply_pending_sdf_edits();
+
     queue_mutex->lock();
-    auto it = chunk_gpu_states.find(origin);
-    if (it != chunk_gpu_states.end()) {
-        it->second.lod = lod;
-        // Only LOD 0 needs physics collision data
-        it->second.physics_needed = (lod == 0);
+    bool have_batch = !pending_batches.empty();
+    std::vector<ChunkRequest> requests;
+    if (have_batch) {
+        requests = std::move(pending_batches.front());
+        pending_batches.pop_front();
     }
+    bool more = !pending_batches.empty();
     queue_mutex->unlock();
-}
 
-void NativeTerrainGenerator::start_readback_thread() {
-    if (readback_thread.is_valid() && readback_thread->is_started()) {
-        return;
-    }
-    
-    readback_thread_running = true;
-    readback_thread.instantiate();
-    readback_thread->start(callable_mp(this, &NativeTerrainGenerator::readback_worker_loop));
-}
-
-void NativeTerrainGenerator::readback_worker_loop() {
-    while (readback_thread_running) {
-        // COMMENT 1 FIX: Use barrier() in background thread to mark GPU completion
-        // This avoids stalling the main thread while still ensuring GPU work is done
-        std::vector<Vector3i> to_complete;
-        std::vector<Vector3i> to_readback;
-        
-        queue_mutex->lock();
-        for (auto& pair : chunk_gpu_states) {
-            if (!pair.second.gpu_complete) {
-                // Chunk needs GPU completion check
-                to_complete.push_back(pair.first);
-            } else if (!pair.second.cpu_readback_complete) {
-                // GPU complete, needs CPU readback
-                to_readback.push_back(pair.first);
-            }
-        }
-        queue_mutex->unlock();
-        
-        // COMMENT 1 FIX: Use barrier() in background thread only (not main thread)
-        // This ensures GPU work is complete before marking chunks ready
-        if (!to_complete.empty() && rd) {
-            rd->barrier(RenderingDevice::BARRIER_MASK_TRANSFER);
-            
-            // Mark all pending chunks as GPU complete
-            queue_mutex->lock();
-            for (Vector3i origin : to_complete) {
-                auto it = chunk_gpu_states.find(origin);
-                if (it != chunk_gpu_states.end() && !it->second.gpu_complete) {
-                    it->second.gpu_complete = true;
-                    it->second.completion_time_us = Time::get_singleton()->get_ticks_usec();
-                    uint64_t measured_time = it->second.completion_time_us - it->second.dispatch_time_us;
-                    total_gpu_time_us += measured_time;
-                    total_chunks_generated++;
-                    
-                    // Add to readback queue
-                    to_readback.push_back(origin);
-                }
-            }
-            queue_mutex->unlock();
-        }
-        
-        // COMMENT 2 FIX: Perform readback only for physics-needed (LOD 0) chunks
-        for (Vector3i origin : to_readback) {
-            queue_mutex->lock();
-            auto it = chunk_gpu_states.find(origin);
-            if (it == chunk_gpu_states.end()) {
-                queue_mutex->unlock();
-                continue;
-            }
-            
-            // COMMENT 2 FIX: Check physics_needed flag - skip readback for non-physics LODs
-            bool needs_physics = it->second.physics_needed;
-            RID sdf_tex = it->second.sdf_texture;
-            RID mat_tex = it->second.material_texture;
-            queue_mutex->unlock();
-            
-            PackedByteArray sdf_data;
-            PackedByteArray mat_data;
-            
-            // COMMENT 2 FIX: Only perform CPU readback if physics is needed (LOD 0)
-            if (needs_physics) {
-                sdf_data = rd->texture_get_data(sdf_tex, 0);
-                mat_data = rd->texture_get_data(mat_tex, 0);
-            }
-            
-            // COMMENT 2 FIX: Move to cache - store CPU data only if physics_needed
-            queue_mutex->lock();
-            it = chunk_gpu_states.find(origin);
-            if (it != chunk_gpu_states.end()) {
-                it->second.sdf_data = sdf_data;
-                it->second.mat_data = mat_data;
-                it->second.cpu_readback_complete = needs_physics;  // Only complete if we did readback
-                
-                cache_mutex->lock();
-                Dictionary cache_entry;
-                cache_entry["sdf"] = it->second.sdf_texture;
-                cache_entry["material"] = it->second.material_texture;
-                cache_entry["gpu_complete"] = true;  // GPU work is complete
-                
-                // COMMENT 2 FIX: Only store CPU data if physics was needed
-                if (needs_physics && !sdf_data.is_empty() && !mat_data.is_empty()) {
-                    cache_entry["sdf_data"] = sdf_data;
-                    cache_entry["mat_data"] = mat_data;
-                }
-                
-                sdf_cache[origin] = cache_entry;
-                cache_mutex->unlock();
-                
-                chunk_gpu_states.erase(it);
-            }
-            queue_mutex->unlock();
-        }
-        
-        // Sleep to avoid busy-waiting
-        OS *os = OS::get_singleton();
-        if (os) {
-            os->delay_usec(1000);  // 1ms sleep
-        }
+    // Chunks cached or put in flight since the request was queued are skipped here
+    GPUBatch batch;
+    if (have_batch && prepare_gpu_batch(requests, batch) > 0) {
+        submit_and_sync_batch(batch);
     }
-}
 
-void NativeTerrainGenerator::stop_readback_thread() {
-    readback_thread_running = false;
-    if (readback_thread.is_valid() && readback_thread->is_started()) {
-        readback_thread->wait_to_finish();
+    // One prewarm batch per pass, so blocking requests arriving meanwhile wait at most one batch
+    more = process_prewarm_batch() || more;
+
+    if (!sync_waiters.empty()) {
+        fail_orphaned_sync_waiters();
     }
+    return more;
 }
 
-Dictionary NativeTerrainGenerator::get_telemetry() const {
-    Dictionary stats;
-    stats["chunks_dispatched_this_frame"] = chunks_dispatched_this_frame.load();
-    stats["chunks_completed_this_frame"] = chunks_completed_this_frame.load();
-    stats["total_chunks_generated"] = total_chunks_generated.load();
-    stats["average_gpu_time_ms"] = total_chunks_generated > 0 
-        ? (float)total_gpu_time_us / (float)total_chunks_generated / 1000.0f 
-        : 0.0f;
-    stats["queue_size"] = (int)chunk_request_queue.size();
-    stats["in_flight_chunks"] = (int)chunk_gpu_states.size();
-    
+RID NativeTerrainGenerator::get_chunk_sdf_texture(const Vector3i &chunk_origin) {
+    // Edits queued since the last pass land first, so the caller never samples pre-edit terrain
+    apply_pending_sdf_edits();
+
+    // Runs on the device thread, so the texture cannot be recycled before the caller's submit
     cache_mutex->lock();
-    stats["cached_chunks"] = sdf_cache.size();
+    const ChunkCache::Entry *cached = chunk_cache.peek({ chunk_origin, 0 });
+    RID texture = cached ? cached->sdf_texture : RID();
     cache_mutex->unlock();
-    
-    stats["current_frame_gpu_time_ms"] = (float)current_frame_gpu_time_us / 1000.0f;
-    stats["frame_budget_ms"] = (float)frame_gpu_budget_us / 1000.0f;
-    return stats;
+    return texture;
 }
 
-void NativeTerrainGenerator::reset_frame_budget() {
-    current_frame_gpu_time_us = 0;
+int NativeTerrainGenerator::get_chunk_texture_size() const {
+    return chunk_size;
 }
 
-void NativeTerrainGenerator::set_player_position(Vector3 position) {
-    player_position = position;
+float NativeTerrainGenerator::get_voxel_step(int lod) {
+    return (float)(1 << std::max(lod, 0));
 }
 
-Vector3 NativeTerrainGenerator::get_player_position() const {
-    return player_position;
+AABB NativeTerrainGenerator::get_chunk_bounds(const ChunkKey &key) const {
+    // biome_gpu_sdf.compute samples get_voxel_step(lod) world units per texel
+    const float extent = (float)chunk_size * get_voxel_step(key.lod);
+    return AABB(Vector3(key.origin), Vector3(extent, extent, extent));
 }
 
-Dictionary NativeTerrainGenerator::get_chunk_gpu_textures(Vector3i origin) const {
-    Dictionary result;
-    
-    // COMMENT 3 FIX: GPU mesher interface - non-blocking GPU texture path
-    // Returns GPU textures after fence completion, bypassing CPU readback for rendering
-    
-    // Check cache first (with proper locking)
+int NativeTerrainGenerator::apply_sdf_edit(Vector3 center, float radius, int shape, int operation) {
+    // Smoothing depends on the neighbourhood VoxelTool sees; there is no cheap delta for it
+    if (!gpu_client_active || radius <= 0.0f || operation == EDIT_SMOOTH) {
+        return 0;
+    }
+
+    SdfEdit edit;
+    edit.center = center;
+    edit.radius = radius;
+    edit.shape = shape;
+    edit.operation = operation;
+    // Capsule: vertical segment of 2 * radius swept with 0.8 * radius (TerrainEditSystem's sphere chain).
+    // One voxel of margin covers the trilinear footprint of samplers reading the edge texels.
+    Vector3 half_extent = shape == EDIT_SHAPE_CAPSULE ? Vector3(radius * 0.8f, radius * 1.8f, radius * 0.8f) : Vector3(radius, radius, radius);
+    half_extent += Vector3(1.0f, 1.0f, 1.0f);
+    edit.bounds = AABB(center - half_extent, half_extent * 2.0f);
+
+    int touched = 0;
+    std::vector<ChunkKey> keys;
     cache_mutex->lock();
-    if (sdf_cache.has(origin)) {
-        Dictionary cached = sdf_cache[origin];
-        // Only report ready if GPU work is complete (fence checked)
-        if (cached.has("sdf") && cached.has("material") && cached.has("gpu_complete")) {
-            bool gpu_complete = cached["gpu_complete"];
-            if (gpu_complete) {
-                result["sdf"] = cached["sdf"];
-                result["material"] = cached["material"];
-                result["ready"] = true;
-                result["has_cpu_data"] = cached.has("sdf_data") && cached.has("mat_data");
-                cache_mutex->unlock();
-                return result;
+    chunk_cache.collect_keys(keys);
+    for (const ChunkKey &key : keys) {
+        const ChunkCache::Entry *entry = chunk_cache.peek(key);
+        if (entry && entry->sdf_texture.is_valid() && get_chunk_bounds(key).intersects(edit.bounds)) {
+            touched++;
+        }
+    }
+    cache_mutex->unlock();
+    if (touched == 0) {
+        return 0;
+    }
+
+    queue_mutex->lock();
+    pending_sdf_edits.push_back(edit);
+    queue_mutex->unlock();
+    gpu_context->wake();
+    return touched;
+}
+
+void NativeTerrainGenerator::apply_pending_sdf_edits() {
+    std::vector<SdfEdit> edits;
+    queue_mutex->lock();
+    edits.swap(pending_sdf_edits);
+    queue_mutex->unlock();
+    if (edits.empty() || !sdf_edit_pipeline.is_valid()) {
+        return;
+    }
+    TraceSpan span("terrain", "sdf_edit_apply");
+    span.set_count((int)edits.size());
+
+    // Uniform chunks carry no texture and in-flight chunks are not cached yet: both keep their
+    // generated field, which the voxel engine's own edit data overrides for meshing
+    struct EditTarget {
+        ChunkKey key;
+        RID sdf_texture;
+        bool has_cpu_data;
+        std::vector<int> edits;
+        RID uniform_set;
+    };
+    std::vector<EditTarget> targets;
+    // Collision meshes also read the texels next to their chunk (the apron): one voxel more reach
+    std::vector<ChunkKey> collision_keys;
+    std::vector<RID> collision_textures;
+    std::vector<ChunkKey> keys;
+    cache_mutex->lock();
+    chunk_cache.collect_keys(keys);
+    for (const ChunkKey &key : keys) {
+        const ChunkCache::Entry *entry = chunk_cache.peek(key);
+        if (!entry || !entry->sdf_texture.is_valid()) {
+            continue;
+        }
+        const AABB bounds = get_chunk_bounds(key);
+        if (entry->has_collision) {
+            const AABB apron_bounds = bounds.grow(get_voxel_step(key.lod));
+            for (const SdfEdit &edit : edits) {
+                if (apron_bounds.intersects(edit.bounds)) {
+                    collision_keys.push_back(key);
+                    collision_textures.push_back(entry->sdf_texture);
+                    break;
+                }
+            }
+        }
+        EditTarget target;
+        for (int i = 0; i < (int)edits.size(); i++) {
+            if (bounds.intersects(edits[i].bounds)) {
+                target.edits.push_back(i);
             }
         }
+        if (target.edits.empty()) {
+            continue;
+        }
+        target.key = key;
+        target.sdf_texture = entry->sdf_texture;
+        target.has_cpu_data = entry->has_cpu_data();
+        targets.push_back(target);
+    }
+    cache_mutex->unlock();
+
+    sdf_edits_applied += (int)edits.size();
+    if (targets.empty()) {
+        return;
+    }
+
+    const int workgroups = (chunk_size + 3) / 4;
+    PackedByteArray push_constant_bytes;
+    push_constant_bytes.resize(sizeof(SDFEditParams));
+
+    int64_t compute_list = rd->compute_list_begin();
+    rd->compute_list_bind_compute_pipeline(compute_list, sdf_edit_pipeline);
+    int dispatches = 0;
+    for (EditTarget &target : targets) {
+        TypedArray<RDUniform> uniforms;
+        Dictionary sdf_dict = create_image_uniform(0, target.sdf_texture);
+        uniforms.push_back(sdf_dict["uniform"]);
+        target.uniform_set = rd->uniform_set_create(uniforms, sdf_edit_shader, 0);
+        if (!target.uniform_set.is_valid()) {
+            continue;
+        }
+
+        rd->compute_list_bind_uniform_set(compute_list, target.uniform_set, 0);
+        for (size_t i = 0; i < target.edits.size(); i++) {
+            const SdfEdit &edit = edits[target.edits[i]];
+            // Edits of one chunk read each other's results: keep them in order
+            if (i > 0) {
+                rd->compute_list_add_barrier(compute_list);
+            }
+
+            SDFEditParams params = {};
+            params.chunk_origin[0] = static_cast<float>(target.key.origin.x);
+            params.chunk_origin[1] = static_cast<float>(target.key.origin.y);
+            params.chunk_origin[2] = static_cast<float>(target.key.origin.z);
+            params.chunk_origin[3] = get_chunk_bounds(target.key).size.x / static_cast<float>(chunk_size);
+            params.center_radius[0] = edit.center.x;
+            params.center_radius[1] = edit.center.y;
+            params.center_radius[2] = edit.center.z;
+            params.center_radius[3] = edit.radius;
+            params.shape = edit.shape;
+            params.operation = edit.operation;
+            params.chunk_size = chunk_size;
+            std::memcpy(push_constant_bytes.ptrw(), &params, sizeof(SDFEditParams));
+
+            rd->compute_list_set_push_constant(compute_list, push_constant_bytes, push_constant_bytes.size());
+            rd->compute_list_dispatch(compute_list, workgroups, workgroups, workgroups);
+            dispatches++;
+        }
+    }
+    rd->compute_list_end();
+
+    if (dispatches > 0) {
+        rd->submit();
+        rd->sync();
+    }
+    sdf_edit_chunk_patches += dispatches;
+
+    for (const EditTarget &target : targets) {
+        if (!target.uniform_set.is_valid()) {
+            continue;
+        }
+        rd->free_rid(target.uniform_set);
+
+        // Chunks with a physics copy hand it to generate_block(): keep it equal to the texture
+        PackedByteArray sdf_data;
+        if (target.has_cpu_data) {
+            sdf_data = rd->texture_get_data(target.sdf_texture, 0);
+        }
+        cache_mutex->lock();
+        ChunkCache::Entry *entry = chunk_cache.peek(target.key);
+        if (entry && entry->sdf_texture == target.sdf_texture) {
+            entry->sdf_edited = true;
+            if (target.has_cpu_data && sdf_data.size() == entry->sdf_data.size()) {
+                entry->sdf_data = sdf_data;
+            }
+        }
+        cache_mutex->unlock();
+    }
+
+    if (!collision_keys.empty()) {
+        rebuild_collision(collision_keys, collision_textures);
+    }
+}
+
+int NativeTerrainGenerator::invalidate_region(AABB region) {
+    return invalidate_matching([&](const ChunkKey &key) {
+        return get_chunk_bounds(key).intersects(region);
+    });
+}
+
+int NativeTerrainGenerator::invalidate_chunks(Array chunk_origins) {
+    std::vector<Vector3i> origins;
+    origins.reserve(chunk_origins.size());
+    for (int64_t i = 0; i < chunk_origins.size(); i++) {
+        origins.push_back(chunk_origins[i]);
+    }
+    return invalidate_matching([&](const ChunkKey &key) {
+        return std::find(origins.begin(), origins.end(), key.origin) != origins.end();
+    });
+}
+
+int NativeTerrainGenerator::invalidate_matching(const std::function<bool(const ChunkKey &)> &touches) {
+    // Every LOD of a touched origin goes; chunks in flight finish and are cached as generated
+    std::vector<ChunkKey> keys;
+    std::vector<ChunkCache::Entry> removed;
+    cache_mutex->lock();
+    chunk_cache.collect_keys(keys);
+    for (const ChunkKey &key : keys) {
+        ChunkCache::Entry entry;
+        if (touches(key) && chunk_cache.erase(key, entry)) {
+            removed.push_back(entry);
+        }
+    }
+    cache_mutex->unlock();
+
+    release_cache_entries(removed);
+    chunks_invalidated += (int)removed.size();
+    return (int)removed.size();
+}
+
+bool NativeTerrainGenerator::ensure_collision_buffers() {
+    if (collision_buffers_chunk_size == chunk_size && collision_cell_buffer.is_valid() && !collision_apron_textures.empty()) {
+        return true;
+    }
+    // The cell and apron scratch scale with chunk_size; everything else is sized for the batch limit once
+    if (collision_cell_buffer.is_valid()) {
+        rd->free_rid(collision_cell_buffer);
+        collision_cell_buffer = RID();
+    }
+    for (const RID &apron_texture : collision_apron_textures) {
+        rd->free_rid(apron_texture);
+    }
+    collision_apron_textures.clear();
+
+    const uint64_t cells = (uint64_t)(chunk_size + 1) * (uint64_t)(chunk_size + 1) * (uint64_t)(chunk_size + 1);
+    collision_cell_buffer = rd->storage_buffer_create(MAX_BATCH_CHUNKS * cells * sizeof(uint32_t));
+    if (!collision_origin_buffer.is_valid()) {
+        collision_origin_buffer = rd->storage_buffer_create(MAX_BATCH_CHUNKS * 4 * sizeof(float));
+    }
+    if (!collision_count_buffer.is_valid()) {
+        collision_count_buffer = rd->storage_buffer_create(MAX_BATCH_CHUNKS * 4 * sizeof(uint32_t));
+    }
+    if (!collision_vertex_buffer.is_valid()) {
+        collision_vertex_buffer = rd->storage_buffer_create((uint64_t)MAX_BATCH_CHUNKS * MAX_COLLISION_VERTICES * 3 * sizeof(float));
+    }
+    if (!collision_index_buffer.is_valid()) {
+        collision_index_buffer = rd->storage_buffer_create((uint64_t)MAX_BATCH_CHUNKS * MAX_COLLISION_INDICES * sizeof(uint32_t));
+    }
+
+    // Same format as the chunk textures, which copy_collision_apron() copies into the interior
+    Ref<RDTextureFormat> tex_format;
+    tex_format.instantiate();
+    tex_format->set_format(get_sdf_data_format(storage_mode));
+    tex_format->set_width(chunk_size + 2);
+    tex_format->set_height(chunk_size + 2);
+    tex_format->set_depth(chunk_size + 2);
+    tex_format->set_texture_type(RenderingDevice::TEXTURE_TYPE_3D);
+    tex_format->set_usage_bits(
+        RenderingDevice::TEXTURE_USAGE_STORAGE_BIT |
+        RenderingDevice::TEXTURE_USAGE_CAN_COPY_TO_BIT
+    );
+    bool aprons_valid = true;
+    for (int i = 0; i < MAX_BATCH_CHUNKS; i++) {
+        RID apron_texture = rd->texture_create(tex_format, Ref<RDTextureView>(), TypedArray<PackedByteArray>());
+        aprons_valid = aprons_valid && apron_texture.is_valid();
+        if (apron_texture.is_valid()) {
+            collision_apron_textures.push_back(apron_texture);
+        }
+    }
+
+    if (!collision_cell_buffer.is_valid() || !collision_origin_buffer.is_valid() || !collision_count_buffer.is_valid() ||
+            !collision_vertex_buffer.is_valid() || !collision_index_buffer.is_valid() || !aprons_valid) {
+        UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create collision mesh buffers");
+        for (const RID &apron_texture : collision_apron_textures) {
+            rd->free_rid(apron_texture);
+        }
+        collision_apron_textures.clear();
+        return false;
+    }
+    collision_buffers_chunk_size = chunk_size;
+    return true;
+}
+
+void NativeTerrainGenerator::fill_sdf_batch_params(SDFBatchParams &r_params, int chunk_count, bool biome_tiled) const {
+    r_params = {};
+    r_params.world_size = world_size;
+    r_params.sea_level = sea_level;
+    r_params.blend_dist = blend_dist;
+    r_params.chunk_size = chunk_size;
+    r_params.seed = static_cast<uint32_t>(world_seed);
+    r_params.chunk_count = chunk_count;
+    r_params.biome_tiled = biome_tiled ? 1 : 0;
+    r_params.biome_texel_size = biome_map_texel_size;
+    get_biome_map_hash_params(r_params.biome_count, r_params.biome_seed);
+    r_params.biome_cell_scale = BIOME_MAP_CELL_SCALE;
+    r_params.biome_jitter = BIOME_MAP_JITTER;
+    r_params.ore_frequency = ore_frequency;
+    r_params.ore_threshold = ore_threshold;
+    r_params.ore_min_depth = ore_min_depth;
+    r_params.ore_material = static_cast<uint32_t>(ore_material_id);
+    r_params.caves_enabled = caves_enabled ? 1 : 0;
+    r_params.cave_frequency = cave_frequency;
+    r_params.cave_threshold = cave_threshold;
+    r_params.cave_min_depth = cave_min_depth;
+}
+
+bool NativeTerrainGenerator::prepare_collision_pass(const std::vector<ChunkKey> &keys, const std::vector<RID> &sdf_textures, CollisionPass &r_pass) {
+    // Buffer updates cannot go into an open compute list: call before compute_list_begin()
+    const int layers = (int)keys.size();
+    if (layers == 0 || layers > MAX_BATCH_CHUNKS || !collision_pipeline.is_valid() || !collision_apron_pipeline.is_valid() || !ensure_collision_buffers()) {
+        return false;
+    }
+    r_pass.keys = keys;
+    r_pass.sdf_textures = sdf_textures;
+
+    PackedFloat32Array origin_data;
+    origin_data.resize(layers * 4);
+    float *origin_ptr = origin_data.ptrw();
+    for (int i = 0; i < layers; i++) {
+        origin_ptr[i * 4 + 0] = static_cast<float>(keys[i].origin.x);
+        origin_ptr[i * 4 + 1] = static_cast<float>(keys[i].origin.y);
+        origin_ptr[i * 4 + 2] = static_cast<float>(keys[i].origin.z);
+        origin_ptr[i * 4 + 3] = get_voxel_step(keys[i].lod);
+    }
+    PackedByteArray origin_bytes = origin_data.to_byte_array();
+    rd->buffer_update(collision_origin_buffer, 0, origin_bytes.size(), origin_bytes);
+    rd->buffer_clear(collision_count_buffer, 0, layers * 4 * sizeof(uint32_t));
+
+    // The apron pass evaluates the generator at the layers' origins (binding 3 has the same layout)
+    const bool biome_tiled = !biome_map_texture.is_valid();
+    SDFBatchParams params;
+    fill_sdf_batch_params(params, layers, biome_tiled);
+    r_pass.apron_push_constant.resize(sizeof(SDFBatchParams));
+    std::memcpy(r_pass.apron_push_constant.ptrw(), &params, sizeof(SDFBatchParams));
+
+    TypedArray<RDUniform> apron_uniforms;
+    Dictionary sampler_dict = create_sampler_uniform(0, biome_tiled ? biome_atlas_texture : biome_map_texture);
+    apron_uniforms.push_back(sampler_dict["uniform"]);
+    Dictionary apron_dict = create_image_array_uniform(1, collision_apron_textures, MAX_BATCH_CHUNKS);
+    apron_uniforms.push_back(apron_dict["uniform"]);
+    Dictionary origins_dict = create_storage_buffer_uniform(3, collision_origin_buffer);
+    apron_uniforms.push_back(origins_dict["uniform"]);
+    Dictionary pages_dict = create_storage_buffer_uniform(5, biome_page_table_buffer);
+    apron_uniforms.push_back(pages_dict["uniform"]);
+    r_pass.apron_uniform_set = rd->uniform_set_create(apron_uniforms, collision_apron_shader, 0);
+
+    TypedArray<RDUniform> uniforms;
+    Dictionary sdf_dict = create_image_array_uniform(0, collision_apron_textures, MAX_BATCH_CHUNKS);
+    uniforms.push_back(sdf_dict["uniform"]);
+    RID buffers[] = { collision_origin_buffer, collision_count_buffer, collision_cell_buffer, collision_vertex_buffer, collision_index_buffer };
+    for (int i = 0; i < 5; i++) {
+        Dictionary buffer_dict = create_storage_buffer_uniform(i + 1, buffers[i]);
+        uniforms.push_back(buffer_dict["uniform"]);
+    }
+    r_pass.uniform_set = rd->uniform_set_create(uniforms, collision_shader, 0);
+
+    if (!r_pass.apron_uniform_set.is_valid() || !r_pass.uniform_set.is_valid()) {
+        free_collision_pass(r_pass);
+        return false;
+    }
+    return true;
+}
+
+void NativeTerrainGenerator::record_collision_apron(int64_t compute_list, const CollisionPass &pass) {
+    // Padded layers stacked along Z; only the shell is evaluated, the rest of the groups return at once
+    const int workgroups = (chunk_size + 2 + 3) / 4;
+    rd->compute_list_bind_compute_pipeline(compute_list, collision_apron_pipeline);
+    rd->compute_list_bind_uniform_set(compute_list, pass.apron_uniform_set, 0);
+    rd->compute_list_set_push_constant(compute_list, pass.apron_push_constant, pass.apron_push_constant.size());
+    rd->compute_list_dispatch(compute_list, workgroups, workgroups, workgroups * (int)pass.keys.size());
+}
+
+void NativeTerrainGenerator::copy_collision_apron(const CollisionPass &pass) {
+    // Between compute lists, after the SDF pass: the chunk into the interior, then the border texels of
+    // edited neighbours over the evaluated apron. Unedited neighbours hold exactly the evaluated field,
+    // and neighbours that are not cached are generated with it.
+    struct ApronCopy {
+        RID from;
+        RID to;
+        Vector3 from_pos;
+        Vector3 to_pos;
+        Vector3 size;
+    };
+    const float extent = (float)chunk_size;
+    std::vector<ApronCopy> copies;
+    cache_mutex->lock();
+    for (size_t i = 0; i < pass.keys.size(); i++) {
+        const ChunkKey &key = pass.keys[i];
+        copies.push_back({ pass.sdf_textures[i], collision_apron_textures[i], Vector3(), Vector3(1, 1, 1), Vector3(extent, extent, extent) });
+        const int stride = chunk_size * (int)get_voxel_step(key.lod);
+        for (int n = 0; n < 27; n++) {
+            const Vector3i offset(n % 3 - 1, (n / 3) % 3 - 1, n / 9 - 1);
+            if (offset == Vector3i()) {
+                continue;
+            }
+            const ChunkCache::Entry *neighbour = chunk_cache.peek(ChunkKey{ key.origin + offset * stride, key.lod });
+            if (!neighbour || !neighbour->sdf_edited || !neighbour->sdf_texture.is_valid()) {
+                continue;
+            }
+            // Per axis: the neighbour's last texel into apron texel 0, its first into chunk_size + 1,
+            // or the whole extent into the interior
+            ApronCopy copy = { neighbour->sdf_texture, collision_apron_textures[i], Vector3(), Vector3(), Vector3() };
+            for (int axis = 0; axis < 3; axis++) {
+                copy.from_pos[axis] = offset[axis] < 0 ? extent - 1.0f : 0.0f;
+                copy.to_pos[axis] = offset[axis] < 0 ? 0.0f : (offset[axis] > 0 ? extent + 1.0f : 1.0f);
+                copy.size[axis] = offset[axis] == 0 ? extent : 1.0f;
+            }
+            copies.push_back(copy);
+        }
+    }
+    cache_mutex->unlock();
+
+    // Released textures are freed or pooled on this (the device) thread, so these stay valid here
+    for (const ApronCopy &copy : copies) {
+        rd->texture_copy(copy.from, copy.to, copy.from_pos, copy.to_pos, copy.size, 0, 0, 0, 0);
+    }
+}
+
+void NativeTerrainGenerator::record_collision_pass(int64_t compute_list, const CollisionPass &pass) {
+    // Pass 0 writes the cell vertices pass 1 connects: a barrier in between, layers stacked along Z
+    // with the extent of pass 0 (chunk_size + 1 cells per axis)
+    const int workgroups = (chunk_size + 1 + 3) / 4;
+    CollisionParams params = {};
+    params.chunk_size = chunk_size;
+    params.max_vertices = MAX_COLLISION_VERTICES;
+    params.max_indices = MAX_COLLISION_INDICES;
+    PackedByteArray push_constant_bytes;
+    push_constant_bytes.resize(sizeof(CollisionParams));
+
+    rd->compute_list_bind_compute_pipeline(compute_list, collision_pipeline);
+    rd->compute_list_bind_uniform_set(compute_list, pass.uniform_set, 0);
+    for (int pass_index = 0; pass_index < 2; pass_index++) {
+        if (pass_index > 0) {
+            rd->compute_list_add_barrier(compute_list);
+        }
+        params.pass_index = pass_index;
+        std::memcpy(push_constant_bytes.ptrw(), &params, sizeof(CollisionParams));
+        rd->compute_list_set_push_constant(compute_list, push_constant_bytes, push_constant_bytes.size());
+        rd->compute_list_dispatch(compute_list, workgroups, workgroups, workgroups * (int)pass.keys.size());
+    }
+}
+
+void NativeTerrainGenerator::free_collision_pass(CollisionPass &pass) {
+    if (pass.apron_uniform_set.is_valid()) {
+        rd->free_rid(pass.apron_uniform_set);
+        pass.apron_uniform_set = RID();
+    }
+    if (pass.uniform_set.is_valid()) {
+        rd->free_rid(pass.uniform_set);
+        pass.uniform_set = RID();
+    }
+}
+
+void NativeTerrainGenerator::read_collision_pass(int layers, std::vector<CollisionMesh> &r_meshes) {
+    // After sync(): the counts first, then only the used part of each layer's lists
+    TraceSpan span("terrain", "collision_readback");
+    span.set_count(layers);
+    r_meshes.assign(layers, CollisionMesh());
+    PackedByteArray count_bytes = rd->buffer_get_data(collision_count_buffer, 0, layers * 4 * sizeof(uint32_t));
+    if (count_bytes.size() < (int64_t)(layers * 4 * sizeof(uint32_t))) {
+        return;
+    }
+    const uint32_t *counts = reinterpret_cast<const uint32_t *>(count_bytes.ptr());
+    uint64_t bytes_read = count_bytes.size();
+
+    for (int i = 0; i < layers; i++) {
+        const uint32_t vertex_count = counts[i * 4 + 0];
+        const uint32_t index_count = counts[i * 4 + 1];
+        if (counts[i * 4 + 2] != 0 || vertex_count > (uint32_t)MAX_COLLISION_VERTICES || index_count > (uint32_t)MAX_COLLISION_INDICES) {
+            collision_overflows++;
+            continue;
+        }
+        CollisionMesh &mesh = r_meshes[i];
+        mesh.ok = true;
+        if (index_count == 0) {
+            continue;  // Vertices without faces sit on the chunk border only
+        }
+        PackedByteArray vertex_bytes = rd->buffer_get_data(collision_vertex_buffer,
+                (uint64_t)i * MAX_COLLISION_VERTICES * 3 * sizeof(float), vertex_count * 3 * sizeof(float));
+        PackedByteArray index_bytes = rd->buffer_get_data(collision_index_buffer,
+                (uint64_t)i * MAX_COLLISION_INDICES * sizeof(uint32_t), index_count * sizeof(uint32_t));
+        if (vertex_bytes.size() < (int64_t)(vertex_count * 3 * sizeof(float)) || index_bytes.size() < (int64_t)(index_count * sizeof(uint32_t))) {
+            mesh.ok = false;
+            continue;
+        }
+        mesh.vertices = vertex_bytes.to_float32_array();
+        mesh.indices = index_bytes.to_int32_array();
+        bytes_read += vertex_bytes.size() + index_bytes.size();
+    }
+    collision_bytes_read += bytes_read;
+}
+
+void NativeTerrainGenerator::rebuild_collision(const std::vector<ChunkKey> &keys, const std::vector<RID> &sdf_textures) {
+    // Device thread, after SDF edits: cached collision meshes follow their patched textures and those of
+    // their neighbours, read through the apron
+    if (!collision_pipeline.is_valid()) {
+        return;
+    }
+    for (size_t start = 0; start < keys.size(); start += MAX_BATCH_CHUNKS) {
+        const size_t end = std::min(keys.size(), start + (size_t)MAX_BATCH_CHUNKS);
+        std::vector<ChunkKey> slice_keys(keys.begin() + start, keys.begin() + end);
+        std::vector<RID> slice_textures(sdf_textures.begin() + start, sdf_textures.begin() + end);
+        const int layers = (int)slice_keys.size();
+
+        CollisionPass collision_pass;
+        if (!prepare_collision_pass(slice_keys, slice_textures, collision_pass)) {
+            UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create uniform set for collision rebuild");
+            return;
+        }
+        int64_t compute_list = rd->compute_list_begin();
+        record_collision_apron(compute_list, collision_pass);
+        rd->compute_list_end();
+        copy_collision_apron(collision_pass);
+        compute_list = rd->compute_list_begin();
+        record_collision_pass(compute_list, collision_pass);
+        rd->compute_list_end();
+        rd->submit();
+        rd->sync();
+        free_collision_pass(collision_pass);
+
+        std::vector<CollisionMesh> meshes;
+        read_collision_pass(layers, meshes);
+
+        // Meshes that no longer fit: the chunk goes back to a full CPU copy, as in complete_batch()
+        std::vector<PackedByteArray> sdf_data(layers);
+        std::vector<PackedByteArray> mat_data(layers);
+        for (int i = 0; i < layers; i++) {
+            if (!meshes[i].ok) {
+                cache_mutex->lock();
+                const ChunkCache::Entry *cached = chunk_cache.peek(slice_keys[i]);
+                RID material_texture = cached && cached->sdf_texture == slice_textures[i] ? cached->material_texture : RID();
+                cache_mutex->unlock();
+                if (material_texture.is_valid()) {
+                    sdf_data[i] = rd->texture_get_data(slice_textures[i], 0);
+                    mat_data[i] = rd->texture_get_data(material_texture, 0);
+                }
+            }
+        }
+
+        // The entry changes size: take it out and insert it again so the cache's byte count holds
+        std::vector<ChunkCache::Entry> released;
+        cache_mutex->lock();
+        for (int i = 0; i < layers; i++) {
+            const ChunkCache::Entry *cached = chunk_cache.peek(slice_keys[i]);
+            ChunkCache::Entry entry;
+            if (!cached || cached->sdf_texture != slice_textures[i] || !chunk_cache.erase(slice_keys[i], entry)) {
+                continue;
+            }
+            entry.has_collision = meshes[i].ok;
+            entry.collision_vertices = meshes[i].vertices;
+            entry.collision_indices = meshes[i].indices;
+            if (meshes[i].ok) {
+                collision_meshes_built++;
+            } else if (!sdf_data[i].is_empty() && !mat_data[i].is_empty()) {
+                entry.sdf_data = sdf_data[i];
+                entry.mat_data = mat_data[i];
+            }
+            chunk_cache.insert(slice_keys[i], entry, released);
+        }
+        cache_mutex->unlock();
+        release_cache_entries(released);
+    }
+}
+
+bool NativeTerrainGenerator::read_back_cached_entry(const ChunkKey &key, ChunkCache::Entry &r_entry) {
+    // Device thread: chunks cached with textures only (async LOD > 0, collision-only) for a blocking request
+    cache_mutex->lock();
+    const ChunkCache::Entry *cached = chunk_cache.peek(key);
+    RID sdf_texture = cached ? cached->sdf_texture : RID();
+    RID material_texture = cached ? cached->material_texture : RID();
+    cache_mutex->unlock();
+    if (!sdf_texture.is_valid() || !material_texture.is_valid()) {
+        return false;
+    }
+
+    TraceSpan span("terrain", "chunk_readback", key.origin, key.lod);
+    PackedByteArray sdf_data = rd->texture_get_data(sdf_texture, 0);
+    PackedByteArray mat_data = rd->texture_get_data(material_texture, 0);
+    if (sdf_data.is_empty() || mat_data.is_empty()) {
+        return false;
+    }
+
+    std::vector<ChunkCache::Entry> released;
+    bool ok = false;
+    cache_mutex->lock();
+    cached = chunk_cache.peek(key);
+    ChunkCache::Entry entry;
+    if (cached && cached->sdf_texture == sdf_texture && chunk_cache.erase(key, entry)) {
+        entry.sdf_data = sdf_data;
+        entry.mat_data = mat_data;
+        chunk_cache.insert(key, entry, released);
+        r_entry = entry;
+        ok = true;
+    }
+    cache_mutex->unlock();
+    release_cache_entries(released);
+    return ok;
+}
+
+void NativeTerrainGenerator::submit_and_sync_batch(GPUBatch &batch) {
+    const int batch_size = (int)batch.keys.size();
+    TraceSpan span("terrain", "sdf_batch");
+    span.set_count(batch_size);
+
+    // Per-chunk origins go through a persistent storage buffer so one uniform set covers the batch
+    if (!sdf_batch_origin_buffer.is_valid()) {
+        sdf_batch_origin_buffer = rd->storage_buffer_create(MAX_BATCH_CHUNKS * 4 * sizeof(float));
+    }
+    if (!sdf_batch_summary_buffer.is_valid()) {
+        sdf_batch_summary_buffer = rd->storage_buffer_create(MAX_BATCH_CHUNKS * 4 * sizeof(uint32_t));
+    }
+
+    // A custom map replaces the virtual one; otherwise the tiles under this batch are made resident
+    const bool biome_tiled = !biome_map_texture.is_valid();
+    const int biome_tile_uploads = biome_tiled ? prepare_biome_tiles(batch) : 0;
+
+    RID uniform_set;
+    if (sdf_batch_origin_buffer.is_valid() && sdf_batch_summary_buffer.is_valid()) {
+        PackedFloat32Array origin_data;
+        origin_data.resize(batch_size * 4);
+        float *origin_ptr = origin_data.ptrw();
+        for (int i = 0; i < batch_size; i++) {
+            origin_ptr[i * 4 + 0] = static_cast<float>(batch.keys[i].origin.x);
+            origin_ptr[i * 4 + 1] = static_cast<float>(batch.keys[i].origin.y);
+            origin_ptr[i * 4 + 2] = static_cast<float>(batch.keys[i].origin.z);
+            origin_ptr[i * 4 + 3] = get_voxel_step(batch.keys[i].lod);
+        }
+        PackedByteArray origin_bytes = origin_data.to_byte_array();
+        rd->buffer_update(sdf_batch_origin_buffer, 0, origin_bytes.size(), origin_bytes);
+
+        // Identity values for the shader's atomicMin/atomicMax reduction
+        PackedByteArray summary_init;
+        summary_init.resize(batch_size * 4 * sizeof(uint32_t));
+        uint32_t *summary_ptr = reinterpret_cast<uint32_t *>(summary_init.ptrw());
+        for (int i = 0; i < batch_size; i++) {
+            summary_ptr[i * 4 + 0] = 0xFFFFFFFFu;
+            summary_ptr[i * 4 + 1] = 0u;
+            summary_ptr[i * 4 + 2] = 0xFFFFFFFFu;
+            summary_ptr[i * 4 + 3] = 0u;
+        }
+        rd->buffer_update(sdf_batch_summary_buffer, 0, summary_init.size(), summary_init);
+
+        TypedArray<RDUniform> uniforms;
+
+        Dictionary sampler_dict = create_sampler_uniform(0, biome_tiled ? biome_atlas_texture : biome_map_texture);
+        uniforms.push_back(sampler_dict["uniform"]);
+
+        Dictionary sdf_dict = create_image_array_uniform(1, batch.sdf_textures, MAX_BATCH_CHUNKS);
+        uniforms.push_back(sdf_dict["uniform"]);
+
+        Dictionary mat_dict = create_image_array_uniform(2, batch.material_textures, MAX_BATCH_CHUNKS);
+        uniforms.push_back(mat_dict["uniform"]);
+
+        Dictionary origins_dict = create_storage_buffer_uniform(3, sdf_batch_origin_buffer);
+        uniforms.push_back(origins_dict["uniform"]);
+
+        Dictionary summary_dict = create_storage_buffer_uniform(4, sdf_batch_summary_buffer);
+        uniforms.push_back(summary_dict["uniform"]);
+
+        Dictionary pages_dict = create_storage_buffer_uniform(5, biome_page_table_buffer);
+        uniforms.push_back(pages_dict["uniform"]);
+
+        uniform_set = rd->uniform_set_create(uniforms, sdf_shader, 0);
+    }
+
+    if (!uniform_set.is_valid()) {
+        UtilityFunctions::printerr("[NativeTerrainGenerator] Failed to create uniform set for batch");
+        if (biome_tile_uploads > 0) {
+            biome_tiles.clear();  // Assigned tiles were never written
+        }
+        // Drop the batch so waiters and the scheduler do not see it as in flight forever
+        queue_mutex->lock();
+        for (int i = 0; i < batch_size; i++) {
+            chunk_gpu_states.erase(batch.keys[i]);
+            release_chunk_textures(batch.sdf_textures[i], batch.material_textures[i]);
+        }
+        queue_mutex->unlock();
+        if (batch.fence > completed_fence) {
+            completed_fence = batch.fence;
+        }
+        return;
+    }
+
+    SDFBatchParams params;
+    fill_sdf_batch_params(params, batch_size, biome_tiled);
+
+    PackedByteArray push_constant_bytes;
+    push_constant_bytes.resize(sizeof(SDFBatchParams));
+    std::memcpy(push_constant_bytes.ptrw(), &params, sizeof(SDFBatchParams));
+
+    PackedByteArray tile_push_constant_bytes;
+    if (biome_tile_uploads > 0) {
+        BiomeTileParams tile_params = {};
+        get_biome_map_hash_params(tile_params.biome_count, tile_params.seed);
+        tile_params.world_size = world_size;
+        tile_params.cell_scale = BIOME_MAP_CELL_SCALE;
+        tile_params.jitter = BIOME_MAP_JITTER;
+        tile_params.texel_size = biome_map_texel_size;
+        tile_params.tile_count = biome_tile_uploads;
+        tile_push_constant_bytes.resize(sizeof(BiomeTileParams));
+        std::memcpy(tile_push_constant_bytes.ptrw(), &tile_params, sizeof(BiomeTileParams));
+    }
+
+    // Timestamp names carry the fence so results from an older submission are never mistaken for this one
+    String begin_name = String("sdf_batch_begin_") + String::num_uint64(batch.fence);
+    String end_name = String("sdf_batch_end_") + String::num_uint64(batch.fence);
+
+    // Collision-only chunks get their surface mesh in the same submission, from the fresh textures
+    std::vector<int> collision_slots;
+    std::vector<ChunkKey> collision_keys;
+    std::vector<RID> collision_textures;
+    for (int i = 0; i < batch_size; i++) {
+        if (i < (int)batch.collision.size() && batch.collision[i]) {
+            collision_slots.push_back(i);
+            collision_keys.push_back(batch.keys[i]);
+            collision_textures.push_back(batch.sdf_textures[i]);
+        }
+    }
+    // Without the pass these chunks fall back to the full readback in complete_batch()
+    CollisionPass collision_pass;
+    const bool build_collision = !collision_slots.empty() && prepare_collision_pass(collision_keys, collision_textures, collision_pass);
+
+    // One compute list, one dispatch: chunks are stacked along Z in workgroup space
+    int workgroups = (chunk_size + 3) / 4;
+
+    rd->capture_timestamp(begin_name);
+    int64_t compute_list = rd->compute_list_begin();
+    if (biome_tile_uploads > 0) {
+        // Newly resident biome tiles first, in the same submission as the chunks that sample them
+        const int tile_groups = (BiomeTileCache::SLOT_TEXELS + 7) / 8;
+        rd->compute_list_bind_compute_pipeline(compute_list, biome_map_pipeline);
+        rd->compute_list_bind_uniform_set(compute_list, biome_tile_uniform_set, 0);
+        rd->compute_list_set_push_constant(compute_list, tile_push_constant_bytes, tile_push_constant_bytes.size());
+        rd->compute_list_dispatch(compute_list, tile_groups, tile_groups, biome_tile_uploads);
+        rd->compute_list_add_barrier(compute_list);
+    }
+    rd->compute_list_bind_compute_pipeline(compute_list, sdf_pipeline);
+    rd->compute_list_bind_uniform_set(compute_list, uniform_set, 0);
+    rd->compute_list_set_push_constant(compute_list, push_constant_bytes, push_constant_bytes.size());
+    rd->compute_list_dispatch(compute_list, workgroups, workgroups, workgroups * batch_size);
+    if (build_collision) {
+        record_collision_apron(compute_list, collision_pass);
+    }
+    rd->compute_list_end();
+    if (build_collision) {
+        // The fresh textures go into the padded scratch, which the mesh passes read
+        copy_collision_apron(collision_pass);
+        compute_list = rd->compute_list_begin();
+        record_collision_pass(compute_list, collision_pass);
+        rd->compute_list_end();
+    }
+    rd->capture_timestamp(end_name);
+
+    uint64_t submit_time_us = Time::get_singleton()->get_ticks_usec();
+    rd->submit();
+    // Blocks until the GPU has finished this submission: this is the real completion point
+    rd->sync();
+    uint64_t completion_time_us = Time::get_singleton()->get_ticks_usec();
+    TraceRecorder::record("terrain", "sdf_batch_gpu", submit_time_us, completion_time_us, Vector3i(), -1, batch_size);
+
+    // Prefer GPU timestamp queries; fall back to submit->sync wall time when the driver lacks them
+    uint64_t batch_gpu_time_us = completion_time_us - submit_time_us;
+    bool have_begin = false;
+    bool have_end = false;
+    uint64_t begin_us = 0;
+    uint64_t end_us = 0;
+    uint32_t timestamp_count = rd->get_captured_timestamps_count();
+    for (uint32_t i = 0; i < timestamp_count; i++) {
+        String name = rd->get_captured_timestamp_name(i);
+        if (name == begin_name) {
+            begin_us = rd->get_captured_timestamp_gpu_time(i);
+            have_begin = true;
+        } else if (name == end_name) {
+            end_us = rd->get_captured_timestamp_gpu_time(i);
+            have_end = true;
+        }
+    }
+    bool timestamps_valid = have_begin && have_end && end_us >= begin_us;
+    if (timestamps_valid) {
+        batch_gpu_time_us = end_us - begin_us;
+    }
+    gpu_timestamps_available = timestamps_valid;
+
+    rd->free_rid(uniform_set);
+
+    std::vector<CollisionMesh> collision_meshes(batch_size);
+    if (build_collision) {
+        free_collision_pass(collision_pass);
+        std::vector<CollisionMesh> layer_meshes;
+        read_collision_pass((int)collision_slots.size(), layer_meshes);
+        for (size_t i = 0; i < collision_slots.size(); i++) {
+            collision_meshes[collision_slots[i]] = layer_meshes[i];
+        }
+    }
+
+    // 16 bytes per chunk: lets complete_batch() skip the full readback for uniform chunks
+    std::vector<ChunkSummary> summaries(batch_size);
+    PackedByteArray summary_bytes = rd->buffer_get_data(sdf_batch_summary_buffer, 0, batch_size * 4 * sizeof(uint32_t));
+    const bool summary_valid = summary_bytes.size() >= (int64_t)(batch_size * 4 * sizeof(uint32_t));
+    const uint32_t *summary_words = summary_valid ? reinterpret_cast<const uint32_t *>(summary_bytes.ptr()) : nullptr;
+    for (int i = 0; i < batch_size; i++) {
+        ChunkSummary &summary = summaries[i];
+        summary.valid = summary_valid;
+        summary.sdf_min = 0.0f;
+        summary.sdf_max = 0.0f;
+        summary.material_min = 0;
+        summary.material_max = 0;
+        if (!summary_valid) {
+            continue;
+        }
+        summary.sdf_min = decode_ordered_float(summary_words[i * 4 + 0]);
+        summary.sdf_max = decode_ordered_float(summary_words[i * 4 + 1]);
+        summary.material_min = summary_words[i * 4 + 2];
+        summary.material_max = summary_words[i * 4 + 3];
+    }
+
+    complete_batch(batch, summaries, collision_meshes, completion_time_us, batch_gpu_time_us);
+}
+
+void NativeTerrainGenerator::complete_batch(const GPUBatch &batch, const std::vector<ChunkSummary> &summaries, const std::vector<CollisionMesh> &collision_meshes, uint64_t completion_time_us, uint64_t batch_gpu_time_us) {
+    const int batch_size = (int)batch.keys.size();
+    uint64_t per_chunk_us = batch_size > 0 ? batch_gpu_time_us / batch_size : 0;
+
+    std::vector<bool> needs_physics(batch_size, false);
+
+    queue_mutex->lock();
+    for (int i = 0; i < batch_size; i++) {
+        auto it = chunk_gpu_states.find(batch.keys[i]);
+        if (it == chunk_gpu_states.end() || it->second.fence != batch.fence) {
+            continue;
+        }
+        it->second.gpu_complete = true;
+        it->second.completion_time_us = completion_time_us;
+        it->second.gpu_time_us = per_chunk_us;
+        TraceRecorder::record("terrain", "chunk_dispatch_to_complete", it->second.dispatch_time_us, completion_time_us, batch.keys[i].origin, batch.keys[i].lod);
+        // Blocking requests for LOD > 0 blocks need the data as much as physics does
+        needs_physics[i] = it->second.physics_needed || sync_waiters.find(batch.keys[i]) != sync_waiters.end();
+    }
+    queue_mutex->unlock();
+
+    // Blocking batches can overtake queued async ones, so batches complete out of id order
+    if (batch.fence > completed_fence) {
+        completed_fence = batch.fence;
+    }
+    total_gpu_time_us += batch_gpu_time_us;
+    total_chunks_generated += batch_size;
+    last_batch_gpu_time_us = batch_gpu_time_us;
+    last_batch_size = batch_size;
+    chunks_completed_since_poll += batch_size;
+    const uint64_t first_request_us = first_request_time_us.load();
+    if (first_request_us != 0 && first_chunk_latency_us.load() == 0 && completion_time_us > first_request_us) {
+        first_chunk_latency_us = completion_time_us - first_request_us;
+    }
+
+    // Exponential moving average (1/8) so the admission estimate tracks the current workload
+    uint64_t avg = avg_chunk_gpu_time_us.load();
+    avg_chunk_gpu_time_us = avg == 0 ? per_chunk_us : (avg * 7 + per_chunk_us) / 8;
+
+    // Readback only for physics-needed (LOD 0) chunks; the batch is already synced so this never stalls on work
+    std::vector<ChunkCache::Entry> released;
+    const uint64_t texture_bytes = get_chunk_texture_bytes();
+    const bool region_store_enabled = get_region_store() != nullptr;
+
+    for (int i = 0; i < batch_size; i++) {
+        const ChunkKey &key = batch.keys[i];
+        const ChunkSummary &summary = summaries[i];
+
+        // All air or all solid (one material, clear of the surface): no readback, textures return to the pool
+        // The margin is in voxels, so it widens with the LOD's voxel spacing
+        const float margin = UNIFORM_SDF_MARGIN * get_voxel_step(key.lod);
+        const bool uniform = summary.valid &&
+            summary.material_min == summary.material_max &&
+            (summary.sdf_min > margin || summary.sdf_max < -margin);
+
+        // Collision-only chunks whose mesh overflowed (or was never built) are read back in full instead
+        const bool collision = i < (int)batch.collision.size() && batch.collision[i];
+        const CollisionMesh *mesh = collision && i < (int)collision_meshes.size() && collision_meshes[i].ok ? &collision_meshes[i] : nullptr;
+        const bool read_back = (needs_physics[i] || (collision && !mesh)) && !uniform;
+
+        PackedByteArray sdf_data;
+        PackedByteArray mat_data;
+        if (read_back) {
+            TraceSpan readback_span("terrain", "chunk_readback", key.origin, key.lod);
+            sdf_data = rd->texture_get_data(batch.sdf_textures[i], 0);
+            mat_data = rd->texture_get_data(batch.material_textures[i], 0);
+        }
+
+        queue_mutex->lock();
+        auto it = chunk_gpu_states.find(key);
+        if (it != chunk_gpu_states.end() && it->second.fence == batch.fence) {
+            it->second.cpu_readback_complete = read_back;
+
+            ChunkCache::Entry entry;
+            if (uniform) {
+                // Keep the extremum nearest the surface so neighbouring blocks interpolate sensibly
+                entry.uniform = true;
+                entry.uniform_sdf = summary.sdf_min > margin ? summary.sdf_min : summary.sdf_max;
+                entry.uniform_material = summary.material_min;
+                released.push_back(ChunkCache::Entry());
+                released.back().sdf_texture = it->second.sdf_texture;
+                released.back().material_texture = it->second.material_texture;
+                uniform_chunks_skipped++;
+                entry.has_collision = collision;  // No surface: an empty mesh
+            } else {
+                entry.sdf_texture = it->second.sdf_texture;
+                entry.material_texture = it->second.material_texture;
+                entry.gpu_bytes = texture_bytes;
+                if (read_back && !sdf_data.is_empty() && !mat_data.is_empty()) {
+                    entry.sdf_data = sdf_data;
+                    entry.mat_data = mat_data;
+                }
+                if (mesh) {
+                    entry.has_collision = true;
+                    entry.collision_vertices = mesh->vertices;
+                    entry.collision_indices = mesh->indices;
+                    collision_meshes_built++;
+                    if (!read_back) {
+                        const uint64_t mesh_bytes = (uint64_t)mesh->vertices.size() * sizeof(float) + (uint64_t)mesh->indices.size() * sizeof(int32_t);
+                        collision_readback_bytes_saved += texture_bytes > mesh_bytes ? texture_bytes - mesh_bytes : 0;
+                    }
+                }
+            }
+
+            const uint64_t insert_start_us = TraceRecorder::is_enabled() ? TraceRecorder::now_us() : 0;
+            cache_mutex->lock();
+            chunk_cache.insert(key, entry, released);
+            cache_mutex->unlock();
+            if (insert_start_us != 0) {
+                TraceRecorder::record("terrain", "chunk_cache_insert", insert_start_us, TraceRecorder::now_us(), key.origin, key.lod);
+            }
+
+            chunk_gpu_states.erase(it);
+            if (prewarm_pending.erase(key) > 0) {
+                prewarm_done++;
+            }
+            queue_mutex->unlock();
+
+            // complete_batch() runs on the GPU thread, the only owner of sync_waiters
+            resolve_sync_waiters(key, &entry);
+            if (region_store_enabled) {
+                region_store_jobs.emplace_back(key, entry);
+            }
+            continue;
+        }
+        queue_mutex->unlock();
+    }
+
+    release_cache_entries(released);
+
+    // Compression dominates a region write: spread a batch's chunks over the worker pool
+    if (region_store_jobs.size() > 1) {
+        WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+        int64_t group = pool->add_group_task(callable_mp(this, &NativeTerrainGenerator::store_region_job),
+                (int)region_store_jobs.size(), -1, true, "Terrain region cache writes");
+        pool->wait_for_group_task_completion(group);
+    } else if (region_store_jobs.size() == 1) {
+        store_region_job(0);
+    }
+    region_store_jobs.clear();
+}
+
+void NativeTerrainGenerator::store_region_job(uint32_t index) {
+    const std::pair<ChunkKey, ChunkCache::Entry> &job = region_store_jobs[index];
+    store_chunk_in_region(job.first, job.second, storage_mode);
+}
+
+void NativeTerrainGenerator::detach_gpu_context() {
+    if (!gpu_context) {
+        return;
+    }
+
+    // After this the device thread no longer calls process_gpu_work() for this generator
+    gpu_client_active = false;
+    gpu_context->unregister_client(this);
+
+    gpu_context->run([this]() {
+        // Answer anything still queued so no worker waits out its timeout on shutdown
+        SyncChunkRequest request;
+        while (sync_requests.pop(request)) {
+            request.promise.set_value(ChunkResult());
+        }
+        for (auto &pair : sync_waiters) {
+            for (std::promise<ChunkResult> &promise : pair.second) {
+                promise.set_value(ChunkResult());
+            }
+        }
+        sync_waiters.clear();
+
+        // A prewarm still in progress completes with its remaining chunks failed
+        queue_mutex->lock();
+        prewarm_done += (int)prewarm_pending.size();
+        prewarm_failed += (int)prewarm_pending.size();
+        prewarm_pending.clear();
+        prewarm_queue.clear();
+        queue_mutex->unlock();
+
+        release_gpu_resources();
+    });
+
+    NativeGPUContext::release(gpu_context);
+    gpu_context = nullptr;
+    rd = nullptr;
+    gpu_initialized = false;
+}
+
+Dictionary NativeTerrainGenerator::get_telemetry() const {
+    Dictionary stats;
+    stats["gpu_context"] = gpu_context ? gpu_context->get_telemetry() : Dictionary();
+    stats["sdf_edits_applied"] = sdf_edits_applied.load();
+    stats["sdf_edit_chunk_patches"] = sdf_edit_chunk_patches.load();
+    stats["chunks_invalidated"] = chunks_invalidated.load();
+    stats["chunks_dispatched_this_frame"] = chunks_dispatched_this_frame.load();
+    stats["chunks_completed_this_frame"] = chunks_completed_this_frame.load();
+    stats["total_chunks_generated"] = total_chunks_generated.load();
+    stats["average_gpu_time_ms"] = total_chunks_generated > 0 
+        ? (float)total_gpu_time_us / (float)total_chunks_generated / 1000.0f 
+        : 0.0f;
+    stats["last_batch_gpu_time_ms"] = (float)last_batch_gpu_time_us / 1000.0f;
+    stats["last_batch_size"] = last_batch_size.load();
+    stats["gpu_timestamps_available"] = gpu_timestamps_available.load();
+    stats["uniform_chunks_skipped"] = uniform_chunks_skipped.load();
+    stats["collision_only"] = collision_only.load();
+    stats["collision_meshes_built"] = collision_meshes_built.load();
+    stats["collision_overflows"] = collision_overflows.load();
+    stats["collision_bytes_read"] = (int64_t)collision_bytes_read.load();
+    stats["collision_readback_bytes_saved"] = (int64_t)collision_readback_bytes_saved.load();
+    stats["sync_requests_total"] = sync_requests_total.load();
+    stats["sync_batches_submitted"] = sync_batches_submitted.load();
+    stats["last_sync_batch_size"] = last_sync_batch_size.load();
+    stats["cpu_fallback_active"] = cpu_fallback_active.load();
+    stats["cpu_chunks_generated"] = cpu_chunks_generated.load();
+    stats["surface_points_queried"] = (int64_t)surface_points_queried.load();
+    stats["avg_cpu_chunk_time_ms"] = (float)avg_cpu_chunk_time_us.load() / 1000.0f;
+    stats["cpu_simd"] = String(CpuTerrainSampler::get_simd_name());
+    stats["completed_fence"] = (int64_t)completed_fence.load();
+    stats["region_hits"] = region_hits.load();
+    stats["region_misses"] = region_misses.load();
+    stats["region_writes"] = region_writes.load();
+    std::shared_ptr<RegionStore> store;
+    region_mutex->lock();
+    store = region_store;
+    bool region_enabled = !region_cache_dir.empty();
+    region_mutex->unlock();
+    stats["region_cache_enabled"] = region_enabled;
+    stats["region_bytes_written"] = (int64_t)(store ? store->get_bytes_written() : 0);
+    cpu_mutex->lock();
+    stats["biome_map_virtual"] = !cpu_biome_map_is_custom;
+    cpu_mutex->unlock();
+    stats["biome_tiles_resident"] = biome_tiles_resident.load();
+    stats["biome_tile_capacity"] = BiomeTileCache::MAX_SLOTS;
+    stats["biome_tile_hits"] = (int64_t)biome_tile_hits.load();
+    stats["biome_tiles_generated"] = (int64_t)biome_tiles_generated.load();
+    stats["biome_tile_evictions"] = (int64_t)biome_tile_evictions.load();
+    stats["biome_tiles_unplaced"] = (int64_t)biome_tiles_unplaced.load();
+
+    queue_mutex->lock();
+    stats["queue_size"] = chunk_scheduler.get_size();
+    stats["in_flight_chunks"] = (int)chunk_gpu_states.size();
+    stats["pending_batches"] = (int)pending_batches.size();
+    stats["prewarm_queued"] = (int)prewarm_queue.size();
+    // Ages of what is still queued, as of the last process_chunk_queue()
+    const ChunkScheduler::AgeStats &ages = chunk_scheduler.get_age_stats();
+    stats["queue_age_p50_ms"] = (float)ages.p50_us / 1000.0f;
+    stats["queue_age_p95_ms"] = (float)ages.p95_us / 1000.0f;
+    stats["queue_age_p99_ms"] = (float)ages.p99_us / 1000.0f;
+    stats["queue_age_max_ms"] = (float)ages.max_us / 1000.0f;
+    std::vector<uint64_t> waits = dispatch_wait_samples;
+    queue_mutex->unlock();
+
+    // Enqueue-to-dispatch wait of recently admitted requests
+    std::sort(waits.begin(), waits.end());
+    auto wait_percentile = [&waits](double fraction) {
+        if (waits.empty()) {
+            return 0.0f;
+        }
+        size_t rank = std::min(waits.size() - 1, (size_t)(fraction * (double)(waits.size() - 1) + 0.5));
+        return (float)waits[rank] / 1000.0f;
+    };
+    stats["dispatch_wait_p50_ms"] = wait_percentile(0.50);
+    stats["dispatch_wait_p95_ms"] = wait_percentile(0.95);
+    stats["dispatch_wait_p99_ms"] = wait_percentile(0.99);
+    stats["requests_deduplicated"] = requests_deduplicated.load();
+    stats["requests_cancelled"] = requests_cancelled.load();
+    stats["requests_dropped"] = requests_dropped.load();
+    stats["time_to_first_chunk_ms"] = (float)first_chunk_latency_us.load() / 1000.0f;
+    
+    cache_mutex->lock();
+    stats["cached_chunks"] = chunk_cache.get_entry_count();
+    stats["cache_bytes"] = (int64_t)chunk_cache.get_size_bytes();
+    stats["cache_budget_bytes"] = (int64_t)chunk_cache.get_byte_budget();
+    stats["cache_hits"] = (int64_t)chunk_cache.get_hits();
+    stats["cache_misses"] = (int64_t)chunk_cache.get_misses();
+    stats["cache_evictions"] = (int64_t)chunk_cache.get_evictions();
+    cache_mutex->unlock();
+    
+    pool_mutex->lock();
+    stats["texture_pool_free"] = (int)texture_pool.size();
+    pool_mutex->unlock();
+    stats["texture_pairs_created"] = texture_pairs_created.load();
+    stats["texture_pairs_reused"] = texture_pairs_reused.load();
+
+    stats["current_frame_gpu_time_ms"] = (float)current_frame_gpu_time_us / 1000.0f;
+    stats["frame_budget_ms"] = (float)frame_gpu_budget_us / 1000.0f;
+    return stats;
+}
+
+void NativeTerrainGenerator::clear_cache() {
+    // Drop every completed chunk; their texture pairs go back to the pool for the next batches
+    std::vector<ChunkCache::Entry> removed;
+
+    cache_mutex->lock();
+    chunk_cache.clear(removed);
+    cache_mutex->unlock();
+
+    release_cache_entries(removed);
+
+    // The next request starts a new time-to-first-chunk measurement (e.g. after a teleport)
+    first_request_time_us = 0;
+    first_chunk_latency_us = 0;
+}
+
+void NativeTerrainGenerator::reset_frame_budget() {
+    current_frame_gpu_time_us = 0;
+}
+
+void NativeTerrainGenerator::set_player_position(Vector3 position) {
+    player_position = position;
+}
+
+Vector3 NativeTerrainGenerator::get_player_position() const {
+    return player_position;
+}
+
+void NativeTerrainGenerator::set_view_direction(Vector3 direction) {
+    queue_mutex->lock();
+    view_direction = direction;
+    queue_mutex->unlock();
+}
+
+Vector3 NativeTerrainGenerator::get_view_direction() const {
+    return view_direction;
+}
+
+void NativeTerrainGenerator::set_view_weight(float weight) {
+    queue_mutex->lock();
+    view_weight = std::max(weight, 0.0f);
+    queue_mutex->unlock();
+}
+
+float NativeTerrainGenerator::get_view_weight() const {
+    return view_weight;
+}
+
+void NativeTerrainGenerator::set_max_request_distance(float distance) {
+    queue_mutex->lock();
+    max_request_distance = std::max(distance, 0.0f);
+    queue_mutex->unlock();
+}
+
+float NativeTerrainGenerator::get_max_request_distance() const {
+    return max_request_distance;
+}
+
+int NativeTerrainGenerator::prewarm_region(Vector3 center, float radius, PackedFloat32Array lod_profile) {
+    if (!gpu_initialized && !cpu_fallback_active) {
+        initialize_gpu();
+    }
+    if (!gpu_client_active || radius <= 0.0f) {
+        return 0;
+    }
+    if (lod_profile.is_empty()) {
+        lod_profile.push_back(1.0f);
+    }
+
+    // Every chunk whose bounds intersect the LOD's sphere, closest (in its own extent) first
+    ChunkScheduler::View view;
+    view.position = center;
+    view.chunk_size = chunk_size;
+    std::vector<std::pair<float, ChunkKey>> chunks;
+    for (int lod = 0; lod < (int)lod_profile.size(); lod++) {
+        const float lod_radius = radius * lod_profile[lod];
+        if (lod_radius <= 0.0f) {
+            continue;
+        }
+        const int32_t extent = chunk_size << lod;
+        const Vector3i lo(
+                floor_div((int32_t)std::floor(center.x - lod_radius), extent),
+                floor_div((int32_t)std::floor(center.y - lod_radius), extent),
+                floor_div((int32_t)std::floor(center.z - lod_radius), extent));
+        const Vector3i hi(
+                floor_div((int32_t)std::floor(center.x + lod_radius), extent),
+                floor_div((int32_t)std::floor(center.y + lod_radius), extent),
+                floor_div((int32_t)std::floor(center.z + lod_radius), extent));
+        for (int32_t z = lo.z; z <= hi.z; z++) {
+            for (int32_t y = lo.y; y <= hi.y; y++) {
+                for (int32_t x = lo.x; x <= hi.x; x++) {
+                    ChunkKey key = { Vector3i(x * extent, y * extent, z * extent), lod };
+                    const AABB bounds = get_chunk_bounds(key);
+                    const Vector3 closest = center.clamp(bounds.position, bounds.position + bounds.size);
+                    if (closest.distance_to(center) <= lod_radius) {
+                        chunks.emplace_back(ChunkScheduler::score_request(key, view), key);
+                    }
+                }
+            }
+        }
+    }
+    std::sort(chunks.begin(), chunks.end(), [](const std::pair<float, ChunkKey> &a, const std::pair<float, ChunkKey> &b) {
+        return a.first < b.first;
+    });
+    if ((int)chunks.size() > MAX_PREWARM_CHUNKS) {
+        UtilityFunctions::printerr("[NativeTerrainGenerator] prewarm_region: ", (int64_t)chunks.size(), " chunks requested, keeping the closest ", MAX_PREWARM_CHUNKS);
+        chunks.resize(MAX_PREWARM_CHUNKS);
+    }
+
+    // Chunks the region cache already holds are loaded from disk by the GPU thread instead of generated
+    queue_mutex->lock();
+    // A finished prewarm is reported by poll_prewarm() first; until then new chunks join it
+    if (prewarm_total == 0) {
+        prewarm_done = 0;
+        prewarm_failed = 0;
+        prewarm_start_us = Time::get_singleton()->get_ticks_usec();
+    }
+    int scheduled = 0;
+    for (const std::pair<float, ChunkKey> &chunk : chunks) {
+        const ChunkKey &key = chunk.second;
+        if (prewarm_pending.find(key) != prewarm_pending.end()) {
+            continue;
+        }
+        prewarm_pending.insert(key);
+        prewarm_queue.push_back(key);
+        scheduled++;
+    }
+    prewarm_total += scheduled;
+    queue_mutex->unlock();
+
+    if (scheduled > 0) {
+        gpu_context->wake();
+    }
+    return scheduled;
+}
+
+bool NativeTerrainGenerator::process_prewarm_batch() {
+    // GPU thread: the next full batch of prewarm chunks, read back so blocking requests hit the cache
+    std::vector<ChunkRequest> requests;
+    const uint64_t now_us = Time::get_singleton()->get_ticks_usec();
+
+    queue_mutex->lock();
+    cache_mutex->lock();
+    while (!prewarm_queue.empty() && (int)requests.size() < MAX_BATCH_CHUNKS) {
+        ChunkKey key = prewarm_queue.front();
+        prewarm_queue.pop_front();
+        if (chunk_gpu_states.find(key) != chunk_gpu_states.end()) {
+            continue;  // In flight: counted when its batch completes
+        }
+        if (chunk_cache.contains(key)) {
+            prewarm_pending.erase(key);
+            prewarm_done++;
+            continue;
+        }
+        ChunkRequest request;
+        request.origin = key.origin;
+        request.lod = key.lod;
+        request.priority = 0.0f;
+        request.request_time_us = now_us;
+        request.readback = true;
+        requests.push_back(request);
+    }
+    bool more = !prewarm_queue.empty();
+    cache_mutex->unlock();
+    queue_mutex->unlock();
+
+    // Chunks the region cache holds are loaded into the chunk cache; only the others are generated
+    std::shared_ptr<RegionStore> store = get_region_store();
+    if (store) {
+        const int cs = chunk_size;
+        std::vector<ChunkRequest> to_generate;
+        for (const ChunkRequest &request : requests) {
+            ChunkKey key = { request.origin, request.lod };
+            if (store->contains(floor_div(key.origin.x, cs), floor_div(key.origin.y, cs), floor_div(key.origin.z, cs), key.lod) &&
+                    load_region_chunk_into_cache(key)) {
+                queue_mutex->lock();
+                if (prewarm_pending.erase(key) > 0) {
+                    prewarm_done++;
+                }
+                queue_mutex->unlock();
+                continue;
+            }
+            to_generate.push_back(request);
+        }
+        requests.swap(to_generate);
+    }
+
+    if (requests.empty()) {
+        return more;
+    }
+
+    GPUBatch batch;
+    if (prepare_gpu_batch(requests, batch) > 0) {
+        submit_and_sync_batch(batch);
+    }
+
+    // Chunks that did not make it (texture allocation or submission failed) must not stall the prewarm
+    queue_mutex->lock();
+    cache_mutex->lock();
+    for (const ChunkRequest &request : requests) {
+        ChunkKey key = { request.origin, request.lod };
+        if (prewarm_pending.find(key) == prewarm_pending.end() || chunk_gpu_states.find(key) != chunk_gpu_states.end()) {
+            continue;
+        }
+        prewarm_pending.erase(key);
+        prewarm_done++;
+        if (!chunk_cache.contains(key)) {
+            prewarm_failed++;
+        }
+    }
+    cache_mutex->unlock();
+    queue_mutex->unlock();
+    return more;
+}
+
+void NativeTerrainGenerator::poll_prewarm() {
+    queue_mutex->lock();
+    const int total = prewarm_total;
+    const int done = prewarm_done;
+    const int failed = prewarm_failed;
+    const uint64_t start_us = prewarm_start_us;
+    const bool finished = total > 0 && done >= total;
+    if (finished) {
+        prewarm_total = 0;
+    }
+    queue_mutex->unlock();
+
+    if (total == 0) {
+        return;
+    }
+    // Emitted here, on the polling thread, never from the GPU thread
+    if (done != prewarm_reported) {
+        prewarm_reported = done;
+        emit_signal("prewarm_progress", done, total);
+    }
+    if (finished) {
+        prewarm_reported = 0;
+        const float elapsed_ms = (float)(Time::get_singleton()->get_ticks_usec() - start_us) / 1000.0f;
+        if (failed > 0) {
+            UtilityFunctions::printerr("[NativeTerrainGenerator] prewarm_region: ", failed, " of ", total, " chunks failed to generate");
+        }
+        emit_signal("prewarm_completed", total, failed, elapsed_ms);
+    }
+}
+
+Dictionary NativeTerrainGenerator::get_prewarm_progress() const {
+    Dictionary progress;
+    queue_mutex->lock();
+    progress["total"] = prewarm_total;
+    progress["done"] = prewarm_done;
+    progress["failed"] = prewarm_failed;
+    progress["queued"] = (int)prewarm_queue.size();
+    progress["elapsed_ms"] = prewarm_total > 0 ? (float)(Time::get_singleton()->get_ticks_usec() - prewarm_start_us) / 1000.0f : 0.0f;
+    queue_mutex->unlock();
+    return progress;
+}
+
+void NativeTerrainGenerator::set_tracing_enabled(bool enabled) {
+    TraceRecorder::set_enabled(enabled);
+}
+
+bool NativeTerrainGenerator::is_tracing_enabled() const {
+    return TraceRecorder::is_enabled();
+}
+
+String NativeTerrainGenerator::export_trace(const String &path) {
+    const std::string json = TraceRecorder::export_chrome_json();
+    String trace = String::utf8(json.c_str(), (int64_t)json.size());
+    if (!path.is_empty()) {
+        Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+        if (file.is_null()) {
+            UtilityFunctions::printerr("[NativeTerrainGenerator] Could not write trace to ", path);
+        } else {
+            file->store_string(trace);
+        }
+    }
+    return trace;
+}
+
+void NativeTerrainGenerator::clear_trace() {
+    TraceRecorder::clear();
+}
+
+int NativeTerrainGenerator::get_trace_event_count() const {
+    return TraceRecorder::get_event_count();
+}
+
+Dictionary NativeTerrainGenerator::get_chunk_gpu_textures(Vector3i origin, int lod) const {
+    Dictionary result;
+    ChunkKey key = { origin, lod };
+    
+    // COMMENT 3 FIX: GPU mesher interface - non-blocking GPU texture path
+    // Returns GPU textures after fence completion, bypassing CPU readback for rendering
+    
+    // Check cache first (with proper locking)
+    // Only completed chunks (batch fence reached) are ever inserted into the cache
+    cache_mutex->lock();
+    const ChunkCache::Entry *cached = chunk_cache.peek(key);
+    if (cached) {
+        result["sdf"] = cached->sdf_texture;
+        result["material"] = cached->material_texture;
+        result["ready"] = true;
+        result["has_cpu_data"] = cached->has_cpu_data();
+        result["storage_mode"] = (int)storage_mode;
+        // Uniform chunks carry no textures: consumers use the constant SDF/material instead
+        result["uniform"] = cached->uniform;
+        if (cached->uniform) {
+            result["uniform_sdf"] = cached->uniform_sdf;
+            result["uniform_material"] = (int64_t)cached->uniform_material;
+        }
+        cache_mutex->unlock();
+        return result;
     }
     cache_mutex->unlock();
     
     // Check in-flight chunks - gpu_complete flag set by fence polling
     queue_mutex->lock();
-    auto it = chunk_gpu_states.find(origin);
+    auto it = chunk_gpu_states.find(key);
     if (it != chunk_gpu_states.end()) {
         // Only return ready=true if fence is complete
         if (it->second.gpu_complete) {
@@ -1111,25 +3797,110 @@ void NativeTerrainGenerator::_bind_methods() {
     ClassDB::bind_method(D_METHOD("get_sea_level"), &NativeTerrainGenerator::get_sea_level);
     ClassDB::bind_method(D_METHOD("set_blend_dist", "dist"), &NativeTerrainGenerator::set_blend_dist);
     ClassDB::bind_method(D_METHOD("get_blend_dist"), &NativeTerrainGenerator::get_blend_dist);
+    ClassDB::bind_method(D_METHOD("set_biome_map_texel_size", "size"), &NativeTerrainGenerator::set_biome_map_texel_size);
+    ClassDB::bind_method(D_METHOD("get_biome_map_texel_size"), &NativeTerrainGenerator::get_biome_map_texel_size);
+    ClassDB::bind_method(D_METHOD("set_ore_frequency", "frequency"), &NativeTerrainGenerator::set_ore_frequency);
+    ClassDB::bind_method(D_METHOD("get_ore_frequency"), &NativeTerrainGenerator::get_ore_frequency);
+    ClassDB::bind_method(D_METHOD("set_ore_threshold", "threshold"), &NativeTerrainGenerator::set_ore_threshold);
+    ClassDB::bind_method(D_METHOD("get_ore_threshold"), &NativeTerrainGenerator::get_ore_threshold);
+    ClassDB::bind_method(D_METHOD("set_ore_min_depth", "depth"), &NativeTerrainGenerator::set_ore_min_depth);
+    ClassDB::bind_method(D_METHOD("get_ore_min_depth"), &NativeTerrainGenerator::get_ore_min_depth);
+    ClassDB::bind_method(D_METHOD("set_ore_material_id", "material_id"), &NativeTerrainGenerator::set_ore_material_id);
+    ClassDB::bind_method(D_METHOD("get_ore_material_id"), &NativeTerrainGenerator::get_ore_material_id);
+    ClassDB::bind_method(D_METHOD("set_caves_enabled", "enabled"), &NativeTerrainGenerator::set_caves_enabled);
+    ClassDB::bind_method(D_METHOD("is_caves_enabled"), &NativeTerrainGenerator::is_caves_enabled);
+    ClassDB::bind_method(D_METHOD("set_cave_frequency", "frequency"), &NativeTerrainGenerator::set_cave_frequency);
+    ClassDB::bind_method(D_METHOD("get_cave_frequency"), &NativeTerrainGenerator::get_cave_frequency);
+    ClassDB::bind_method(D_METHOD("set_cave_threshold", "threshold"), &NativeTerrainGenerator::set_cave_threshold);
+    ClassDB::bind_method(D_METHOD("get_cave_threshold"), &NativeTerrainGenerator::get_cave_threshold);
+    ClassDB::bind_method(D_METHOD("set_cave_min_depth", "depth"), &NativeTerrainGenerator::set_cave_min_depth);
+    ClassDB::bind_method(D_METHOD("get_cave_min_depth"), &NativeTerrainGenerator::get_cave_min_depth);
+    ClassDB::bind_method(D_METHOD("set_cache_budget_mb", "budget_mb"), &NativeTerrainGenerator::set_cache_budget_mb);
+    ClassDB::bind_method(D_METHOD("get_cache_budget_mb"), &NativeTerrainGenerator::get_cache_budget_mb);
+    ClassDB::bind_method(D_METHOD("set_storage_mode", "mode"), &NativeTerrainGenerator::set_storage_mode);
+    ClassDB::bind_method(D_METHOD("get_storage_mode"), &NativeTerrainGenerator::get_storage_mode);
+    ClassDB::bind_method(D_METHOD("set_region_cache_path", "path"), &NativeTerrainGenerator::set_region_cache_path);
+    ClassDB::bind_method(D_METHOD("get_region_cache_path"), &NativeTerrainGenerator::get_region_cache_path);
+    ClassDB::bind_method(D_METHOD("set_collision_only", "enabled"), &NativeTerrainGenerator::set_collision_only);
+    ClassDB::bind_method(D_METHOD("is_collision_only"), &NativeTerrainGenerator::is_collision_only);
+    ClassDB::bind_method(D_METHOD("has_collision_mesh", "origin"), &NativeTerrainGenerator::has_collision_mesh);
+    ClassDB::bind_method(D_METHOD("get_collision_faces", "origin"), &NativeTerrainGenerator::get_collision_faces);
     ClassDB::bind_method(D_METHOD("set_biome_map_texture", "texture"), &NativeTerrainGenerator::set_biome_map_texture);
     ClassDB::bind_method(D_METHOD("is_gpu_available"), &NativeTerrainGenerator::is_gpu_available);
     ClassDB::bind_method(D_METHOD("get_gpu_status"), &NativeTerrainGenerator::get_gpu_status);
+    ClassDB::bind_method(D_METHOD("is_cpu_fallback_active"), &NativeTerrainGenerator::is_cpu_fallback_active);
+    ClassDB::bind_method(D_METHOD("generate_chunk_data", "origin", "use_cpu", "lod"), &NativeTerrainGenerator::generate_chunk_data, DEFVAL(0));
+    ClassDB::bind_method(D_METHOD("sample_surface", "positions", "include_height"), &NativeTerrainGenerator::sample_surface, DEFVAL(true));
     
     // Async GPU methods
     ClassDB::bind_method(D_METHOD("process_chunk_queue", "delta"), &NativeTerrainGenerator::process_chunk_queue);
     ClassDB::bind_method(D_METHOD("get_telemetry"), &NativeTerrainGenerator::get_telemetry);
+    ClassDB::bind_method(D_METHOD("clear_cache"), &NativeTerrainGenerator::clear_cache);
     ClassDB::bind_method(D_METHOD("enqueue_chunk_request", "origin", "lod", "player_position"), &NativeTerrainGenerator::enqueue_chunk_request);
     ClassDB::bind_method(D_METHOD("set_player_position", "position"), &NativeTerrainGenerator::set_player_position);
     ClassDB::bind_method(D_METHOD("get_player_position"), &NativeTerrainGenerator::get_player_position);
-    ClassDB::bind_method(D_METHOD("get_chunk_gpu_textures", "origin"), &NativeTerrainGenerator::get_chunk_gpu_textures);
+    ClassDB::bind_method(D_METHOD("cancel_chunk_request", "origin", "lod"), &NativeTerrainGenerator::cancel_chunk_request, DEFVAL(0));
+    ClassDB::bind_method(D_METHOD("prewarm_region", "center", "radius", "lod_profile"), &NativeTerrainGenerator::prewarm_region, DEFVAL(PackedFloat32Array()));
+    ClassDB::bind_method(D_METHOD("poll_prewarm"), &NativeTerrainGenerator::poll_prewarm);
+    ClassDB::bind_method(D_METHOD("get_prewarm_progress"), &NativeTerrainGenerator::get_prewarm_progress);
+    ClassDB::bind_method(D_METHOD("set_tracing_enabled", "enabled"), &NativeTerrainGenerator::set_tracing_enabled);
+    ClassDB::bind_method(D_METHOD("is_tracing_enabled"), &NativeTerrainGenerator::is_tracing_enabled);
+    ClassDB::bind_method(D_METHOD("export_trace", "path"), &NativeTerrainGenerator::export_trace, DEFVAL(String()));
+    ClassDB::bind_method(D_METHOD("clear_trace"), &NativeTerrainGenerator::clear_trace);
+    ClassDB::bind_method(D_METHOD("get_trace_event_count"), &NativeTerrainGenerator::get_trace_event_count);
+    ClassDB::bind_method(D_METHOD("set_view_direction", "direction"), &NativeTerrainGenerator::set_view_direction);
+    ClassDB::bind_method(D_METHOD("get_view_direction"), &NativeTerrainGenerator::get_view_direction);
+    ClassDB::bind_method(D_METHOD("set_view_weight", "weight"), &NativeTerrainGenerator::set_view_weight);
+    ClassDB::bind_method(D_METHOD("get_view_weight"), &NativeTerrainGenerator::get_view_weight);
+    ClassDB::bind_method(D_METHOD("set_max_request_distance", "distance"), &NativeTerrainGenerator::set_max_request_distance);
+    ClassDB::bind_method(D_METHOD("get_max_request_distance"), &NativeTerrainGenerator::get_max_request_distance);
+    ClassDB::bind_method(D_METHOD("get_chunk_gpu_textures", "origin", "lod"), &NativeTerrainGenerator::get_chunk_gpu_textures, DEFVAL(0));
+
+    // Terrain edits
+    ClassDB::bind_method(D_METHOD("apply_sdf_edit", "center", "radius", "shape", "operation"), &NativeTerrainGenerator::apply_sdf_edit);
+    ClassDB::bind_method(D_METHOD("invalidate_region", "region"), &NativeTerrainGenerator::invalidate_region);
+    ClassDB::bind_method(D_METHOD("invalidate_chunks", "chunk_origins"), &NativeTerrainGenerator::invalidate_chunks);
 
     ADD_PROPERTY(PropertyInfo(Variant::INT, "world_seed"), "set_world_seed", "get_world_seed");
     ADD_PROPERTY(PropertyInfo(Variant::INT, "chunk_size"), "set_chunk_size", "get_chunk_size");
     ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "world_size"), "set_world_size", "get_world_size");
     ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "sea_level"), "set_sea_level", "get_sea_level");
     ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "blend_dist"), "set_blend_dist", "get_blend_dist");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "biome_map_texel_size", PROPERTY_HINT_RANGE, "0.25,64,0.25,suffix:m"), "set_biome_map_texel_size", "get_biome_map_texel_size");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "ore_frequency", PROPERTY_HINT_RANGE, "0.001,1,0.001"), "set_ore_frequency", "get_ore_frequency");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "ore_threshold", PROPERTY_HINT_RANGE, "-1,1,0.01"), "set_ore_threshold", "get_ore_threshold");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "ore_min_depth", PROPERTY_HINT_RANGE, "0,256,0.5,suffix:m"), "set_ore_min_depth", "get_ore_min_depth");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "ore_material_id", PROPERTY_HINT_RANGE, "0,255"), "set_ore_material_id", "get_ore_material_id");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "caves_enabled"), "set_caves_enabled", "is_caves_enabled");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cave_frequency", PROPERTY_HINT_RANGE, "0.001,1,0.001"), "set_cave_frequency", "get_cave_frequency");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cave_threshold", PROPERTY_HINT_RANGE, "-1,1,0.01"), "set_cave_threshold", "get_cave_threshold");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cave_min_depth", PROPERTY_HINT_RANGE, "0,256,0.5,suffix:m"), "set_cave_min_depth", "get_cave_min_depth");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "cache_budget_mb"), "set_cache_budget_mb", "get_cache_budget_mb");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "storage_mode", PROPERTY_HINT_ENUM, "Full (R32F + R32UI),Half (R16F + R8UI),SNORM16 (R16 SNORM + R8UI)"), "set_storage_mode", "get_storage_mode");
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "region_cache_path", PROPERTY_HINT_DIR), "set_region_cache_path", "get_region_cache_path");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "collision_only"), "set_collision_only", "is_collision_only");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "view_weight"), "set_view_weight", "get_view_weight");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_request_distance"), "set_max_request_distance", "get_max_request_distance");
+
+    BIND_ENUM_CONSTANT(STORAGE_FULL);
+    BIND_ENUM_CONSTANT(STORAGE_HALF);
+    BIND_ENUM_CONSTANT(STORAGE_SNORM16);
+
+    BIND_ENUM_CONSTANT(EDIT_SHAPE_SPHERE);
+    BIND_ENUM_CONSTANT(EDIT_SHAPE_CAPSULE);
+    BIND_ENUM_CONSTANT(EDIT_SHAPE_BOX);
+    BIND_ENUM_CONSTANT(EDIT_SUBTRACT);
+    BIND_ENUM_CONSTANT(EDIT_ADD);
+    BIND_ENUM_CONSTANT(EDIT_SMOOTH);
 
     ADD_SIGNAL(MethodInfo("chunk_generated", 
         PropertyInfo(Variant::VECTOR3I, "origin"), 
         PropertyInfo(Variant::INT, "biome_id")));
+    ADD_SIGNAL(MethodInfo("prewarm_progress",
+        PropertyInfo(Variant::INT, "completed"),
+        PropertyInfo(Variant::INT, "total")));
+    ADD_SIGNAL(MethodInfo("prewarm_completed",
+        PropertyInfo(Variant::INT, "total"),
+        PropertyInfo(Variant::INT, "failed"),
+        PropertyInfo(Variant::FLOAT, "elapsed_ms")));
 }
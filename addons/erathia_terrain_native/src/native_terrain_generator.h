@@ -4,69 +4,206 @@
 #include <godot_cpp/classes/rendering_device.hpp>
 #include <godot_cpp/classes/image.hpp>
 #include <godot_cpp/classes/mutex.hpp>
+#include <godot_cpp/classes/semaphore.hpp>
 #include <godot_cpp/classes/thread.hpp>
 #include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/variant/aabb.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/vector3i.hpp>
 #include <godot_cpp/variant/rid.hpp>
 #include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
 #include <godot_cpp/classes/ref.hpp>
 #include <godot_cpp/core/class_db.hpp>
 #include <vector>
+#include <deque>
 #include <queue>
 #include <unordered_map>
+#include <unordered_set>
 #include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
 
 // godot_voxel_cpp headers
 #include "generators/voxel_generator.h"
 #include "storage/voxel_buffer.h"
 #include "storage/voxel_buffer_gd.h"
 
-using namespace godot;
+#include "biome_tile_cache.h"
+#include "chunk_cache.h"
+#include "chunk_scheduler.h"
+#include "cpu_terrain_sampler.h"
+#include "gpu_context.h"
+#include "mpsc_queue.h"
+#include "region_store.h"
 
-// Hash specialization for Vector3i to use in unordered_map
-struct Vector3iHash {
-    std::size_t operator()(const Vector3i& v) const {
-        // Combine hash of x, y, z using prime numbers to reduce collisions
-        std::size_t h1 = std::hash<int>{}(v.x);
-        std::size_t h2 = std::hash<int>{}(v.y);
-        std::size_t h3 = std::hash<int>{}(v.z);
-        return h1 ^ (h2 << 1) ^ (h3 << 2);
-    }
-};
+using namespace godot;
 
 // NativeTerrainGenerator: Optimized terrain generator with GPU compute + direct bulk memory writes
 // Achieves <5ms/chunk by using VoxelBuffer API for direct bulk transfer
-class NativeTerrainGenerator : public zylann::voxel::VoxelGenerator {
+// Runs its GPU work on the shared NativeGPUContext device thread and serves its cached chunk
+// SDF textures to other clients of that device (vegetation placement)
+class NativeTerrainGenerator : public zylann::voxel::VoxelGenerator,
+        public NativeGPUContext::Client,
+        public NativeGPUContext::ChunkTextureProvider {
     GDCLASS(NativeTerrainGenerator, zylann::voxel::VoxelGenerator)
 
+public:
+    // Chunk texture formats. Narrow modes cut texture memory and readback bandwidth;
+    // they require storage-image support for R16F / R16_SNORM / R8UI on the device.
+    enum StorageMode {
+        STORAGE_FULL = 0,  // R32F SDF + R32UI material (8 bytes/voxel)
+        STORAGE_HALF = 1,  // R16F SDF + R8UI material (3 bytes/voxel)
+        STORAGE_SNORM16 = 2,  // R16_SNORM SDF scaled by SNORM16_SDF_SCALE + R8UI material (3 bytes/voxel)
+    };
+
+    // Brush shapes and operations accepted by apply_sdf_edit(); match TerrainEditSystem.BrushType / Operation
+    enum EditShape {
+        EDIT_SHAPE_SPHERE = 0,
+        EDIT_SHAPE_CAPSULE = 1,  // Vertical, as TerrainEditSystem's sphere chain
+        EDIT_SHAPE_BOX = 2,
+    };
+    enum EditOperation {
+        EDIT_SUBTRACT = 0,
+        EDIT_ADD = 1,
+        EDIT_SMOOTH = 2,  // No texture delta: the cached field is left as generated
+    };
+
+    // SNORM16 SDF scale; equal to VoxelBuffer's 16-bit SDF quantization so texels copy without requantizing
+    static constexpr float SNORM16_SDF_SCALE = 0.002f;
+
 private:
-    RenderingDevice* rd;
+    NativeGPUContext* gpu_context;  // Held from a successful initialize_gpu() until cleanup_gpu()
+    RenderingDevice* rd;  // The shared device; used on the context's device thread only
     
-    // Biome map pipeline
+    // Biome map pipeline: biome_map.compute built with BIOME_MAP_TILES writes virtual map tiles
     RID biome_map_shader;
     RID biome_map_pipeline;
-    RID biome_map_texture;
+    RID biome_map_texture;  // Full map from set_biome_map_texture(); invalid while the virtual map is used
+
+    // Virtual biome map: the tiles under each batch are generated into the atlas on demand
+    RID biome_atlas_texture;  // BiomeTileCache::ATLAS_TEXELS^2 RG32F, one slot per resident tile
+    RID biome_page_table_buffer;  // BiomeTileCache page table, read by biome_gpu_sdf.compute (binding 5)
+    RID biome_tile_list_buffer;  // ivec4 per tile written by one biome_map.compute dispatch
+    RID biome_tile_uniform_set;  // Atlas + tile list, bound by every tile dispatch
+    BiomeTileCache biome_tiles;  // Device thread only
+    uint64_t biome_tiles_signature;  // Device thread only: map parameters the resident tiles were made with
+    std::atomic<int> biome_tiles_resident;
+    std::atomic<uint64_t> biome_tile_hits;
+    std::atomic<uint64_t> biome_tiles_generated;
+    std::atomic<uint64_t> biome_tile_evictions;
+    std::atomic<uint64_t> biome_tiles_unplaced;  // Evaluated in the SDF shader instead (see prepare_biome_tiles())
     
     // SDF generation pipeline
     RID sdf_shader;
     RID sdf_pipeline;
+    RID sdf_batch_origin_buffer;  // vec4 per chunk, read by biome_gpu_sdf.compute (binding 3)
+    RID sdf_batch_summary_buffer;  // 4 uints per chunk (SDF/material min-max), written at binding 4
+
+    // Terrain edit deltas (sdf_edit.compute): brushes are applied in place to cached chunk textures
+    RID sdf_edit_shader;
+    RID sdf_edit_pipeline;
+
+    // Collision-only mode (collision_mesh.compute): LOD 0 chunks read back a surface mesh, not their textures
+    RID collision_shader;
+    RID collision_pipeline;
+    RID collision_apron_shader;  // biome_gpu_sdf.compute with COLLISION_APRON
+    RID collision_apron_pipeline;
+    std::vector<RID> collision_apron_textures;  // Padded (chunk_size + 2)^3 SDF per layer (binding 0)
+    RID collision_origin_buffer;  // vec4 per layer (binding 1)
+    RID collision_count_buffer;  // uvec4 per layer: vertices, indices, overflow (binding 2)
+    RID collision_cell_buffer;  // Per-cell vertex index scratch (binding 3)
+    RID collision_vertex_buffer;  // MAX_COLLISION_VERTICES xyz per layer (binding 4)
+    RID collision_index_buffer;  // MAX_COLLISION_INDICES per layer (binding 5)
+    int collision_buffers_chunk_size;  // Extent the cell and apron scratch were sized for
+    std::atomic<bool> collision_only;
+    std::atomic<int> collision_meshes_built;
+    std::atomic<int> collision_overflows;  // Chunks whose mesh did not fit and were read back in full
+    std::atomic<uint64_t> collision_bytes_read;
+    std::atomic<uint64_t> collision_readback_bytes_saved;
     
     // Resource tracking for leak prevention
     std::vector<RID> sampler_rids;
-    RID cached_sampler;
     
-    Dictionary sdf_cache;
+    // Completed chunks keyed by (origin, lod), bounded by cache_budget_mb; guarded by cache_mutex
+    ChunkCache chunk_cache;
     Ref<Mutex> cache_mutex;
+    int cache_budget_mb;
+    StorageMode storage_mode;  // Config-time: changing it rebuilds the GPU side
+
+    // Recycled SDF/material 3D texture pairs; chunks evicted from chunk_cache return theirs here
+    struct ChunkTexturePair {
+        RID sdf;
+        RID material;
+    };
+    std::vector<ChunkTexturePair> texture_pool;  // Guarded by pool_mutex
+    int texture_pool_chunk_size;  // Extent the pooled textures were created with
+    Ref<Mutex> pool_mutex;
+    std::atomic<int> texture_pairs_created;
+    std::atomic<int> texture_pairs_reused;
     
     int world_seed;
     int chunk_size;
     float world_size;
     float sea_level;
     float blend_dist;
+    float biome_map_texel_size;  // World units per virtual biome map texel
+    // Subsurface stages of biome_gpu_sdf.compute (and CpuTerrainSampler): ore veins into the material
+    // channel, caves carved from the SDF
+    float ore_frequency;
+    float ore_threshold;
+    float ore_min_depth;
+    int ore_material_id;
+    bool caves_enabled;
+    float cave_frequency;
+    float cave_threshold;
+    float cave_min_depth;
     
-    bool gpu_initialized;
+    std::atomic<bool> gpu_initialized;
     String gpu_status_message;
+    Ref<Mutex> init_mutex;
+
+    // CPU fallback when no RenderingDevice can be created (headless servers, compatibility renderer):
+    // generate_block() runs CpuTerrainSampler on the calling voxel thread
+    std::atomic<bool> cpu_fallback_active;
+    std::shared_ptr<const CpuBiomeMap> cpu_biome_map;  // Guarded by cpu_mutex; immutable once published
+    bool cpu_biome_map_is_custom;  // Set from set_biome_map_texture(), never rebuilt
+    int cpu_biome_map_seed;  // world_seed / texel size the virtual map was set up with
+    float cpu_biome_map_texel_size;
+    Ref<Mutex> cpu_mutex;
+    std::atomic<int> cpu_chunks_generated;
+    std::atomic<uint64_t> avg_cpu_chunk_time_us;
+    uint64_t custom_biome_map_hash;  // Content hash of the set_biome_map_texture() map, 0 when generated
+
+    // sample_surface(): one query at a time, split into SURFACE_QUERY_BLOCK points per pool task
+    struct SurfaceQuery {
+        std::shared_ptr<const CpuBiomeMap> biome_map;
+        CpuTerrainSampler::Params params;
+        std::vector<float> xz;
+        int count = 0;
+        int32_t *biome_ids = nullptr;
+        float *edge_distances = nullptr;
+        float *heights = nullptr;  // Null when heights were not requested
+    };
+    SurfaceQuery surface_query;  // Guarded by surface_query_mutex
+    Ref<Mutex> surface_query_mutex;
+    std::atomic<uint64_t> surface_points_queried;
+
+    // Optional on-disk chunk store (region_cache_path, empty = disabled). Each terrain configuration
+    // gets its own subdirectory, so seed or parameter changes never read stale chunks.
+    String region_cache_path;
+    std::string region_cache_dir;  // Globalized region_cache_path
+    std::shared_ptr<RegionStore> region_store;  // Guarded by region_mutex
+    uint64_t region_store_signature;
+    Ref<Mutex> region_mutex;
+    std::atomic<int> region_hits;
+    std::atomic<int> region_misses;
+    std::atomic<int> region_writes;
 
     // Async GPU compute infrastructure
     struct ChunkRequest {
@@ -74,6 +211,7 @@ private:
         int lod;
         float priority;  // Distance from player (lower = higher priority)
         uint64_t request_time_us;
+        bool readback = false;  // Read back to the CPU whatever the LOD (prewarm, blocking requests)
         
         bool operator<(const ChunkRequest& other) const {
             return priority > other.priority;  // Min-heap (lower priority value = higher priority)
@@ -83,57 +221,302 @@ private:
     struct ChunkGPUState {
         RID sdf_texture;
         RID material_texture;
-        RID fence;  // GPU fence for async completion tracking
-        uint64_t dispatch_time_us;  // CPU time when dispatch started
-        uint64_t completion_time_us;  // CPU time when GPU work completed (measured via fence)
+        uint64_t fence;  // Id of the batch carrying this chunk
+        uint64_t dispatch_time_us;  // CPU time when the chunk was queued for dispatch
+        uint64_t completion_time_us;  // CPU time when sync() on its batch returned
+        uint64_t gpu_time_us;  // Measured GPU time of its batch, amortized per chunk
         bool gpu_complete;
         bool cpu_readback_complete;
         bool physics_needed;  // Flag to gate CPU readback (only for LOD 0 or physics requests)
+        bool collision;  // Collision-only mode: build a collision mesh instead of the readback
         int lod;  // Store LOD level to determine physics needs
         PackedByteArray sdf_data;  // CPU copy for physics (deferred)
         PackedByteArray mat_data;
     };
 
-    std::priority_queue<ChunkRequest> chunk_request_queue;
-    std::unordered_map<Vector3i, ChunkGPUState, Vector3iHash> chunk_gpu_states;
+    // One submission to the GPU thread: recorded into one compute list (two with collision-only chunks),
+    // submitted, then synced
+    struct GPUBatch {
+        uint64_t fence;
+        std::vector<ChunkKey> keys;
+        std::vector<RID> sdf_textures;
+        std::vector<RID> material_textures;
+        std::vector<bool> collision;
+    };
+
+    // Collision meshes of up to MAX_BATCH_CHUNKS chunks: record_collision_apron() into a compute list (the
+    // batch's SDF list), copy_collision_apron() once that list has ended and the chunk textures are
+    // written, then record_collision_pass() into a new list
+    struct CollisionPass {
+        std::vector<ChunkKey> keys;
+        std::vector<RID> sdf_textures;
+        RID apron_uniform_set;
+        RID uniform_set;
+        PackedByteArray apron_push_constant;
+    };
+
+    // Readback of collision_mesh.compute for one chunk; not ok when its lists overflowed
+    struct CollisionMesh {
+        bool ok = false;
+        PackedFloat32Array vertices;
+        PackedInt32Array indices;
+    };
+
+    // Async requests, re-scored against the player's position and view on every process_chunk_queue()
+    ChunkScheduler chunk_scheduler;  // Guarded by queue_mutex
+    std::unordered_map<ChunkKey, ChunkGPUState, ChunkKeyHash> chunk_gpu_states;
     Ref<Mutex> queue_mutex;
     Vector3 player_position;  // Track player position for priority calculation
-    Ref<Thread> readback_thread;
-    std::atomic<bool> readback_thread_running;
+    Vector3 view_direction;  // Camera forward; zero scores by distance only
+    float view_weight;
+    float max_request_distance;  // Pending requests beyond this are dropped (0 = keep all)
+    std::atomic<int> requests_deduplicated;
+    std::atomic<int> requests_cancelled;
+    std::atomic<int> requests_dropped;
+    // Enqueue-to-dispatch wait of the last DISPATCH_WAIT_SAMPLES admitted requests (ring)
+    std::vector<uint64_t> dispatch_wait_samples;  // Guarded by queue_mutex
+    size_t dispatch_wait_next;
+    // First request (async or blocking) to first completed chunk, since startup or clear_cache()
+    std::atomic<uint64_t> first_request_time_us;
+    std::atomic<uint64_t> first_chunk_latency_us;
+
+    // Submit/readback pipeline: the shared context's device thread turns each queued request list into
+    // a GPUBatch in process_gpu_work() (acquiring its textures there), records and submits it, then
+    // blocks in sync() to observe its real completion
+    std::atomic<bool> gpu_client_active;  // Registered with gpu_context and accepting sync requests
+    std::deque<std::vector<ChunkRequest>> pending_batches;  // Guarded by queue_mutex
+    uint64_t next_fence;  // Guarded by queue_mutex
+    std::atomic<uint64_t> completed_fence;  // Highest batch id completed so far
+
+    // Blocking generate_block() requests: voxel workers push onto a lock-free queue and wait on a
+    // per-request future; the GPU thread drains everything queued since its last wake into one batch
+    struct ChunkResult {
+        bool ok = false;
+        ChunkCache::Entry entry;
+    };
+    struct SyncChunkRequest {
+        ChunkKey key;
+        std::promise<ChunkResult> promise;
+    };
+    MPSCQueue<SyncChunkRequest> sync_requests;
+    // GPU thread only: promises waiting for a chunk that is queued or in flight
+    std::unordered_map<ChunkKey, std::vector<std::promise<ChunkResult>>, ChunkKeyHash> sync_waiters;
+    std::atomic<int> sync_requests_total;
+    std::atomic<int> sync_batches_submitted;
+    std::atomic<int> last_sync_batch_size;
+
+    // prewarm_region(): chunks waiting for the GPU thread, which loads them from the region cache or
+    // drains them in full batches between blocking requests. A chunk stays in prewarm_pending until it
+    // lands in the cache.
+    std::deque<ChunkKey> prewarm_queue;  // Guarded by queue_mutex
+    std::unordered_set<ChunkKey, ChunkKeyHash> prewarm_pending;  // Guarded by queue_mutex
+    int prewarm_total;  // Guarded by queue_mutex
+    int prewarm_done;  // Guarded by queue_mutex
+    int prewarm_failed;  // Guarded by queue_mutex
+    int prewarm_reported;  // Main thread: progress last emitted by poll_prewarm()
+    uint64_t prewarm_start_us;  // Guarded by queue_mutex
+    // GPU thread only: region-cache writes of one completed batch, compressed on the WorkerThreadPool
+    std::vector<std::pair<ChunkKey, ChunkCache::Entry>> region_store_jobs;
 
     // Frame budget tracking
     uint64_t frame_gpu_budget_us;  // 8000 microseconds (8ms)
     uint64_t current_frame_gpu_time_us;
+    std::atomic<uint64_t> avg_chunk_gpu_time_us;  // Moving average of measured per-chunk GPU time
 
     // Telemetry
     std::atomic<int> chunks_dispatched_this_frame;
     std::atomic<int> chunks_completed_this_frame;
     std::atomic<uint64_t> total_gpu_time_us;
     std::atomic<int> total_chunks_generated;
+    std::atomic<int> chunks_completed_since_poll;
+    std::atomic<uint64_t> last_batch_gpu_time_us;
+    std::atomic<int> last_batch_size;
+    std::atomic<bool> gpu_timestamps_available;
+    std::atomic<int> uniform_chunks_skipped;  // Chunks whose textures were recycled without readback
+    std::atomic<int> sdf_edits_applied;
+    std::atomic<int> sdf_edit_chunk_patches;  // (edit, chunk) dispatches of sdf_edit.compute
+    std::atomic<int> chunks_invalidated;
+
+    // One TerrainEditSystem brush, queued by apply_sdf_edit() for the device thread
+    struct SdfEdit {
+        Vector3 center;
+        float radius;
+        int shape;  // TerrainEditSystem.BrushType
+        int operation;  // TerrainEditSystem.Operation
+        AABB bounds;
+    };
+    std::vector<SdfEdit> pending_sdf_edits;  // Guarded by queue_mutex
+
+    // Decoded per-chunk summary from biome_gpu_sdf.compute
+    struct ChunkSummary {
+        bool valid;
+        float sdf_min;
+        float sdf_max;
+        uint32_t material_min;
+        uint32_t material_max;
+    };
+
+    // Push constant block of sdf_edit.compute (std430, 48 bytes)
+    struct SDFEditParams {
+        float chunk_origin[4];  // w = world units per texel
+        float center_radius[4];
+        int32_t shape;
+        int32_t operation;
+        int32_t chunk_size;
+        int32_t _pad0;
+    };
+
+    // Push constant block of collision_mesh.compute (std430, 16 bytes)
+    struct CollisionParams {
+        int32_t chunk_size;
+        int32_t pass_index;
+        uint32_t max_vertices;
+        uint32_t max_indices;
+    };
+
+    // Push constant block of biome_gpu_sdf.compute (std430, 80 bytes)
+    struct SDFBatchParams {
+        float world_size;
+        float sea_level;
+        float blend_dist;
+        int32_t chunk_size;
+        uint32_t seed;
+        int32_t chunk_count;
+        int32_t biome_tiled;
+        float biome_texel_size;
+        int32_t biome_count;
+        float biome_cell_scale;
+        float biome_jitter;
+        uint32_t biome_seed;
+        float ore_frequency;
+        float ore_threshold;
+        float ore_min_depth;
+        uint32_t ore_material;
+        int32_t caves_enabled;
+        float cave_frequency;
+        float cave_threshold;
+        float cave_min_depth;
+    };
+
+    // Push constant block of biome_map.compute with BIOME_MAP_TILES (std430, 32 bytes)
+    struct BiomeTileParams {
+        int32_t biome_count;
+        float world_size;
+        float cell_scale;
+        float jitter;
+        uint32_t seed;
+        float texel_size;
+        int32_t tile_count;
+        int32_t _pad0;
+    };
 
     RID create_3d_texture(RenderingDevice::DataFormat format);
+    bool acquire_chunk_textures(RID &r_sdf_texture, RID &r_material_texture);
+    void release_chunk_textures(RID sdf_texture, RID material_texture);
+    void free_texture_pool();
+    void release_cache_entries(const std::vector<ChunkCache::Entry> &entries);
+    uint64_t get_chunk_texture_bytes() const;
+    static RenderingDevice::DataFormat get_sdf_data_format(StorageMode mode);
+    static RenderingDevice::DataFormat get_material_data_format(StorageMode mode);
+    static int get_sdf_bytes_per_voxel(StorageMode mode);
+    static int get_material_bytes_per_voxel(StorageMode mode);
     RID get_or_create_sampler();
     Dictionary create_sampler_uniform(int binding, RID texture);
     Dictionary create_image_uniform(int binding, RID texture);
+    Dictionary create_image_array_uniform(int binding, const std::vector<RID> &textures, int array_size);
+    Dictionary create_storage_buffer_uniform(int binding, RID buffer);
     bool compile_biome_map_shader();
     bool compile_sdf_shader();
-    void generate_biome_map_if_needed();
-    Dictionary generate_chunk_sdf(Vector3i chunk_origin);
-    void write_gpu_data_to_buffer_bulk(zylann::voxel::VoxelBuffer &voxel_buffer, RID sdf_texture, RID material_texture, int chunk_size);
-    int sample_biome_at_chunk(Vector3i chunk_origin);
+    bool compile_sdf_edit_shader();
+    bool compile_collision_shader();
+    String inject_storage_defines(const String &shader_source) const;
+    // World units between voxels of a block at this LOD (chunk_origins[i].w in biome_gpu_sdf.compute)
+    static float get_voxel_step(int lod);
+    AABB get_chunk_bounds(const ChunkKey &key) const;
+    void apply_pending_sdf_edits();
+    bool ensure_collision_buffers();
+    void fill_sdf_batch_params(SDFBatchParams &r_params, int chunk_count, bool biome_tiled) const;
+    bool prepare_collision_pass(const std::vector<ChunkKey> &keys, const std::vector<RID> &sdf_textures, CollisionPass &r_pass);
+    void record_collision_apron(int64_t compute_list, const CollisionPass &pass);
+    void copy_collision_apron(const CollisionPass &pass);
+    void record_collision_pass(int64_t compute_list, const CollisionPass &pass);
+    void free_collision_pass(CollisionPass &pass);
+    void read_collision_pass(int layers, std::vector<CollisionMesh> &r_meshes);
+    void rebuild_collision(const std::vector<ChunkKey> &keys, const std::vector<RID> &sdf_textures);
+    bool read_back_cached_entry(const ChunkKey &key, ChunkCache::Entry &r_entry);
+    int invalidate_matching(const std::function<bool(const ChunkKey &)> &touches);
+    void drop_cache_on_signature_change(uint64_t previous_signature);
+    void get_biome_map_hash_params(int32_t &r_biome_count, uint32_t &r_seed) const;
+    uint64_t get_biome_tiles_signature() const;
+    bool create_biome_atlas();
+    RID create_custom_biome_map_texture(const CpuBiomeMap &map);
+    int prepare_biome_tiles(const GPUBatch &batch);
+    int prepare_gpu_batch(const std::vector<ChunkRequest> &requests, GPUBatch &batch);
+    int generate_chunk_sdf_batch(const std::vector<ChunkRequest> &requests);
+    bool request_chunk_sync(const ChunkKey &key, ChunkCache::Entry &r_entry);
+    void process_sync_requests();
+    void resolve_sync_waiters(const ChunkKey &key, const ChunkCache::Entry *entry);
+    void fail_orphaned_sync_waiters();
+    bool process_prewarm_batch();
+    void store_region_job(uint32_t index);
+    void surface_query_job(uint32_t block);
+    void write_cache_entry_to_buffer(zylann::voxel::VoxelBuffer &voxel_buffer, const ChunkCache::Entry &entry);
+    void write_gpu_data_to_buffer_bulk(zylann::voxel::VoxelBuffer &voxel_buffer, const PackedByteArray &sdf_data, const PackedByteArray &mat_data, int chunk_size);
+    static const float *decode_sdf_to_float(const uint8_t *sdf_src, StorageMode mode, int chunk_size);
+    static bool write_sdf_channel_bulk(zylann::voxel::VoxelBuffer &voxel_buffer, const uint8_t *sdf_src, StorageMode mode, int chunk_size);
+    static bool write_indices_channel_bulk(zylann::voxel::VoxelBuffer &voxel_buffer, const uint8_t *mat_src, StorageMode mode, int chunk_size);
+    static void write_voxels_per_voxel(zylann::voxel::VoxelBuffer &voxel_buffer, const uint8_t *sdf_src, const uint8_t *mat_src, StorageMode mode, int chunk_size);
+    void generate_block_cpu(zylann::voxel::VoxelBuffer &voxel_buffer, Vector3i origin, int lod);
+    uint64_t get_terrain_signature();
+    std::shared_ptr<RegionStore> get_region_store();
+    bool read_region_chunk(const ChunkKey &key, PackedByteArray &r_raw);
+    bool load_chunk_from_region(const ChunkKey &key, zylann::voxel::VoxelBuffer &voxel_buffer);
+    bool load_region_chunk_into_cache(const ChunkKey &key);
+    void store_chunk_in_region(const ChunkKey &key, const ChunkCache::Entry &entry, StorageMode mode);
     void _notification(int p_what);
     
     // Async GPU methods
-    bool poll_gpu_completion(Vector3i origin);
+    bool poll_gpu_completion(const ChunkKey &key);
     void dispatch_chunk_async(Vector3i origin, int lod);
-    void start_readback_thread();
-    void stop_readback_thread();
-    void readback_worker_loop();
+    void dispatch_chunk_batch_async(const std::vector<ChunkRequest> &requests);
+    void detach_gpu_context();
+    bool initialize_gpu_on_worker();
+    void release_gpu_resources();
+    void submit_and_sync_batch(GPUBatch &batch);
+    void complete_batch(const GPUBatch &batch, const std::vector<ChunkSummary> &summaries, const std::vector<CollisionMesh> &collision_meshes, uint64_t completion_time_us, uint64_t batch_gpu_time_us);
 
 protected:
     static void _bind_methods();
 
 public:
+    // Max chunks recorded into one compute list / submit (must match biome_gpu_sdf.compute)
+    static constexpr int MAX_BATCH_CHUNKS = 32;
+    // How long a blocking generate_block() waits for its chunk before giving up (lost device safety net)
+    static constexpr int SYNC_REQUEST_TIMEOUT_MS = 2000;
+    // Batches queued for the GPU thread before process_chunk_queue() stops admitting more
+    static constexpr int MAX_PENDING_BATCHES = 2;
+    // Recent admissions kept for the dispatch wait percentiles in get_telemetry()
+    static constexpr int DISPATCH_WAIT_SAMPLES = 256;
+    // Upper bound on the chunks one prewarm_region() call schedules (closest first)
+    static constexpr int MAX_PREWARM_CHUNKS = 8192;
+    // Free texture pairs kept for reuse; pairs released beyond this are freed
+    static constexpr int MAX_POOLED_TEXTURE_PAIRS = 256;
+    // A chunk is stored as uniform when every SDF value is beyond this distance (voxels) from the surface
+    static constexpr float UNIFORM_SDF_MARGIN = 2.0f;
+    // Per-chunk capacity of collision_mesh.compute's lists; chunks with more surface fall back to the full
+    // readback. A flat surface at chunk_size 32 reads back ~38 KB, full lists 144 KB (textures: 256 KiB).
+    static constexpr int MAX_COLLISION_VERTICES = 4096;
+    static constexpr int MAX_COLLISION_INDICES = 24576;
+    // Points per WorkerThreadPool task of sample_surface()
+    static constexpr int SURFACE_QUERY_BLOCK = 1024;
+    // Biome map generation (biome_map.compute); the CPU fallback evaluates the same map from these
+    static constexpr float DEFAULT_BIOME_MAP_TEXEL_SIZE = 2.0f;
+    // Chunks whose biome footprint spans more tiles (coarse LODs) evaluate their biomes in the SDF shader
+    static constexpr int MAX_BIOME_TILES_PER_CHUNK = 16;
+    static constexpr float BIOME_MAP_BIOME_COUNT = 17.0f;
+    static constexpr float BIOME_MAP_CELL_SCALE = 2000.0f;  // 2km cells
+    static constexpr float BIOME_MAP_JITTER = 0.8f;
+
     NativeTerrainGenerator();
     ~NativeTerrainGenerator();
 
@@ -141,6 +524,8 @@ public:
     Result generate_block(VoxelQueryData input) override;
     int get_used_channels_mask() const override;
 
+    // A setting that changes the terrain (see get_terrain_signature()) drops the cached chunks
+    // (clear_cache()), so they are generated again with it
     void set_world_seed(int seed);
     int get_world_seed() const;
     
@@ -155,24 +540,132 @@ public:
     
     void set_blend_dist(float dist);
     float get_blend_dist() const;
+
+    // Resolution of the virtual biome map (world units per texel); finer maps sharpen biome edges at
+    // the same memory, since only the tiles under generated chunks are resident
+    void set_biome_map_texel_size(float size);
+    float get_biome_map_texel_size() const;
+
+    // Ore veins: ore_material_id replaces stone where the vein noise (frequency in 1/world units) exceeds
+    // ore_threshold and the voxel is at least ore_min_depth inside the solid
+    void set_ore_frequency(float frequency);
+    float get_ore_frequency() const;
+    void set_ore_threshold(float threshold);
+    float get_ore_threshold() const;
+    void set_ore_min_depth(float depth);
+    float get_ore_min_depth() const;
+    void set_ore_material_id(int material_id);
+    int get_ore_material_id() const;
+    // Caves carved where the cave noise exceeds cave_threshold, fading in over cave_min_depth below
+    // the surface; off by default.
+    void set_caves_enabled(bool enabled);
+    bool is_caves_enabled() const;
+    void set_cave_frequency(float frequency);
+    float get_cave_frequency() const;
+    void set_cave_threshold(float threshold);
+    float get_cave_threshold() const;
+    void set_cave_min_depth(float depth);
+    float get_cave_min_depth() const;
+
+    void set_cache_budget_mb(int budget_mb);
+    int get_cache_budget_mb() const;
+
+    void set_storage_mode(int mode);
+    int get_storage_mode() const;
+
+    void set_region_cache_path(const String &path);
+    String get_region_cache_path() const;
+
+    // Collision-only mode: async LOD 0 chunks (enqueue_chunk_request()) read back only a surface nets
+    // mesh built on the GPU in the same submission, for ConcavePolygonShape3D, instead of their
+    // SDF/material textures. Blocking generate_block() and prewarm chunks still read back in full.
+    // Chunks on the chunk_size grid tile without seams: each mesh also reads one voxel of its neighbours.
+    void set_collision_only(bool enabled);
+    bool is_collision_only() const;
+    bool has_collision_mesh(Vector3i origin) const;
+    // Triangle soup for ConcavePolygonShape3D.set_faces(); empty for chunks without surface or mesh
+    PackedVector3Array get_collision_faces(Vector3i origin) const;
     
+    // Replaces the virtual biome map with a fixed map covering world_size (GPU and CPU paths)
     void set_biome_map_texture(Ref<Image> texture);
 
     bool initialize_gpu();
     void cleanup_gpu();
     bool is_gpu_available() const;
     String get_gpu_status() const;
+    bool is_cpu_fallback_active() const;
+
+    // Generates one chunk through the GPU or the CPU path and returns it in GPU texel order
+    // ("sdf": PackedFloat32Array, "material": PackedInt32Array); used by the CPU/GPU parity test
+    Dictionary generate_chunk_data(Vector3i origin, bool use_cpu, int lod = 0);
     
+    // Batched column queries at world XZ, evaluated over the same biome map and SDF as generated terrain
+    // (CPU, SIMD, spread over the WorkerThreadPool): "biome_ids" (PackedInt32Array, the biome ids of
+    // biome_gpu_sdf.compute), "edge_distances" (PackedFloat32Array, 0 on a biome edge) and "heights"
+    // (PackedFloat32Array of generated surface heights, empty unless include_height; SDF edits are not
+    // seen). Concurrent calls run one after another.
+    Dictionary sample_surface(PackedVector2Array positions, bool include_height = true);
+    // The biome map and SDF parameters generated terrain uses, for other native passes over the same
+    // world (NativeVegetationDispatcher::prebake_atlas()); the map is immutable and safe to share
+    std::shared_ptr<const CpuBiomeMap> get_cpu_biome_map();
+    CpuTerrainSampler::Params get_cpu_sampler_params() const;
+
     // Async GPU public interface
     void enqueue_chunk_request(Vector3i origin, int lod, Vector3 player_position);
+    // O(1); for blocks the terrain no longer needs. False when the chunk was not queued.
+    bool cancel_chunk_request(Vector3i origin, int lod);
+    void set_view_direction(Vector3 direction);
+    Vector3 get_view_direction() const;
+    void set_view_weight(float weight);
+    float get_view_weight() const;
+    void set_max_request_distance(float distance);
+    float get_max_request_distance() const;
     void process_chunk_queue(float delta);
     Dictionary get_telemetry() const;
+    void clear_cache();
     void reset_frame_budget();
     void set_player_position(Vector3 position);
     Vector3 get_player_position() const;
+
+    // Generates every chunk intersecting the sphere around center into the cache, and into the region
+    // cache when enabled, in full GPU batches; chunks the region cache already holds are loaded into
+    // the cache from it instead. lod_profile[n] scales radius for LOD n; an empty profile
+    // prewarms LOD 0 only. Returns the chunks scheduled (0 without a GPU). poll_prewarm(), also run
+    // by process_chunk_queue(), emits prewarm_progress / prewarm_completed on the calling thread.
+    int prewarm_region(Vector3 center, float radius, PackedFloat32Array lod_profile);
+    void poll_prewarm();
+    Dictionary get_prewarm_progress() const;
+
+    // Hot-path spans (queue wait, batch submit/GPU, readback, cache insert, VoxelBuffer write, and
+    // NativeVegetationDispatcher's placement stages) recorded into the process-wide TraceRecorder.
+    // export_trace() returns Chrome trace JSON (chrome://tracing, ui.perfetto.dev) and also writes
+    // it to path when one is given.
+    void set_tracing_enabled(bool enabled);
+    bool is_tracing_enabled() const;
+    String export_trace(const String &path);
+    void clear_trace();
+    int get_trace_event_count() const;
     
+    // Terrain edits. apply_sdf_edit() patches the cached textures of every chunk the brush touches
+    // (shape/operation as TerrainEditSystem.BrushType/Operation; SMOOTH has no delta and is
+    // ignored; materials are kept, as TerrainEditSystem edits the SDF channel only) and returns how many chunks were queued for patching; the patch runs on the device
+    // thread before any other client samples those textures. invalidate_*() drop cached chunks so
+    // they are generated again, and return how many were dropped.
+    int apply_sdf_edit(Vector3 center, float radius, int shape, int operation);
+    int invalidate_region(AABB region);
+    int invalidate_chunks(Array chunk_origins);
+
     // GPU mesher interface (Comment 5: non-blocking GPU texture path)
-    Dictionary get_chunk_gpu_textures(Vector3i origin) const;
+    Dictionary get_chunk_gpu_textures(Vector3i origin, int lod = 0) const;
+
+    // NativeGPUContext::Client / ChunkTextureProvider (device thread)
+    bool process_gpu_work() override;
+    RID get_chunk_sdf_texture(const Vector3i &chunk_origin) override;
+    int get_chunk_texture_size() const override;
 };
 
+VARIANT_ENUM_CAST(NativeTerrainGenerator::StorageMode);
+VARIANT_ENUM_CAST(NativeTerrainGenerator::EditShape);
+VARIANT_ENUM_CAST(NativeTerrainGenerator::EditOperation);
+
 #endif // NATIVE_TERRAIN_GENERATOR_H
@@ -0,0 +1,169 @@
+#include "native_vegetation_atlas.h"
+#include "trace_recorder.h"
+
+#include <godot_cpp/classes/project_settings.hpp>
+
+#include <cmath>
+#include <cstring>
+
+using namespace godot;
+
+NativeVegetationAtlas::NativeVegetationAtlas() {
+    mutex.instantiate();
+}
+
+NativeVegetationAtlas::~NativeVegetationAtlas() {
+    close();
+}
+
+bool NativeVegetationAtlas::open(String path) {
+    String absolute = ProjectSettings::get_singleton()->globalize_path(path);
+    mutex->lock();
+    bool ok = atlas.open(std::string(absolute.utf8().get_data()));
+    mutex->unlock();
+    return ok;
+}
+
+void NativeVegetationAtlas::close() {
+    mutex->lock();
+    atlas.close();
+    mutex->unlock();
+}
+
+bool NativeVegetationAtlas::is_open() const {
+    mutex->lock();
+    bool open = atlas.is_open();
+    mutex->unlock();
+    return open;
+}
+
+int NativeVegetationAtlas::get_world_seed() const {
+    mutex->lock();
+    int seed = atlas.get_info().world_seed;
+    mutex->unlock();
+    return seed;
+}
+
+int NativeVegetationAtlas::get_chunk_size() const {
+    mutex->lock();
+    int size = atlas.get_info().chunk_size;
+    mutex->unlock();
+    return size;
+}
+
+Rect2 NativeVegetationAtlas::get_bounds() const {
+    mutex->lock();
+    const float* bounds = atlas.get_info().bounds;
+    Rect2 rect(bounds[0], bounds[1], bounds[2], bounds[3]);
+    mutex->unlock();
+    return rect;
+}
+
+int64_t NativeVegetationAtlas::get_instance_count() const {
+    mutex->lock();
+    int64_t count = (int64_t)atlas.get_instance_count();
+    mutex->unlock();
+    return count;
+}
+
+int64_t NativeVegetationAtlas::get_file_size() const {
+    mutex->lock();
+    int64_t size = (int64_t)atlas.get_file_size();
+    mutex->unlock();
+    return size;
+}
+
+Array NativeVegetationAtlas::get_groups() const {
+    Array groups;
+    mutex->lock();
+    for (int i = 0; i < atlas.get_group_count(); i++) {
+        const VegetationAtlas::Group group = atlas.get_group(i);
+        Dictionary entry;
+        entry["biome"] = group.biome;
+        entry["type"] = group.type;
+        entry["variant"] = group.variant;
+        entry["chunk_count"] = (int64_t)group.chunk_count;
+        entry["instance_count"] = (int64_t)group.instance_count;
+        groups.push_back(entry);
+    }
+    mutex->unlock();
+    return groups;
+}
+
+int NativeVegetationAtlas::get_group_instance_count(int biome, int type, int variant) const {
+    mutex->lock();
+    int index = atlas.find_group(biome, type, variant);
+    int count = index >= 0 ? (int)atlas.get_group(index).instance_count : 0;
+    mutex->unlock();
+    return count;
+}
+
+PackedFloat32Array NativeVegetationAtlas::copy_runs(const VegetationAtlas::Group& group,
+        const std::vector<std::pair<uint64_t, uint32_t>>& runs) const {
+    uint64_t instances = 0;
+    for (const auto& run : runs) {
+        instances += run.second;
+    }
+
+    PackedFloat32Array buffer;
+    buffer.resize((int64_t)(instances * VegetationAtlas::FLOATS_PER_INSTANCE));
+    float* dst = buffer.ptrw();
+    for (const auto& run : runs) {
+        const size_t floats = (size_t)run.second * VegetationAtlas::FLOATS_PER_INSTANCE;
+        std::memcpy(dst, atlas.get_transforms(group, run.first), floats * sizeof(float));
+        dst += floats;
+    }
+    return buffer;
+}
+
+PackedFloat32Array NativeVegetationAtlas::get_group_buffer(int biome, int type, int variant) const {
+    TraceSpan span("vegetation", "atlas_group_copy");
+    mutex->lock();
+    PackedFloat32Array buffer;
+    int index = atlas.find_group(biome, type, variant);
+    if (index >= 0) {
+        const VegetationAtlas::Group group = atlas.get_group(index);
+        buffer = copy_runs(group, { { 0, group.instance_count } });
+        span.set_count((int)group.instance_count);
+    }
+    mutex->unlock();
+    return buffer;
+}
+
+PackedFloat32Array NativeVegetationAtlas::get_region_buffer(int biome, int type, int variant, Rect2 region) const {
+    TraceSpan span("vegetation", "atlas_region_copy");
+    mutex->lock();
+    PackedFloat32Array buffer;
+    int index = atlas.find_group(biome, type, variant);
+    const float chunk_size = (float)atlas.get_info().chunk_size;
+    if (index >= 0 && chunk_size > 0.0f) {
+        const VegetationAtlas::Group group = atlas.get_group(index);
+        std::vector<std::pair<uint64_t, uint32_t>> runs;
+        // Chunk columns overlapping the region; an edge ending on a chunk boundary excludes the next one
+        atlas.find_runs(group,
+                (int32_t)std::floor(region.position.x / chunk_size),
+                (int32_t)std::floor(region.position.y / chunk_size),
+                (int32_t)std::ceil((region.position.x + region.size.x) / chunk_size) - 1,
+                (int32_t)std::ceil((region.position.y + region.size.y) / chunk_size) - 1,
+                runs);
+        buffer = copy_runs(group, runs);
+        span.set_count((int)(buffer.size() / VegetationAtlas::FLOATS_PER_INSTANCE));
+    }
+    mutex->unlock();
+    return buffer;
+}
+
+void NativeVegetationAtlas::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("open", "path"), &NativeVegetationAtlas::open);
+    ClassDB::bind_method(D_METHOD("close"), &NativeVegetationAtlas::close);
+    ClassDB::bind_method(D_METHOD("is_open"), &NativeVegetationAtlas::is_open);
+    ClassDB::bind_method(D_METHOD("get_world_seed"), &NativeVegetationAtlas::get_world_seed);
+    ClassDB::bind_method(D_METHOD("get_chunk_size"), &NativeVegetationAtlas::get_chunk_size);
+    ClassDB::bind_method(D_METHOD("get_bounds"), &NativeVegetationAtlas::get_bounds);
+    ClassDB::bind_method(D_METHOD("get_instance_count"), &NativeVegetationAtlas::get_instance_count);
+    ClassDB::bind_method(D_METHOD("get_file_size"), &NativeVegetationAtlas::get_file_size);
+    ClassDB::bind_method(D_METHOD("get_groups"), &NativeVegetationAtlas::get_groups);
+    ClassDB::bind_method(D_METHOD("get_group_instance_count", "biome", "type", "variant"), &NativeVegetationAtlas::get_group_instance_count);
+    ClassDB::bind_method(D_METHOD("get_group_buffer", "biome", "type", "variant"), &NativeVegetationAtlas::get_group_buffer);
+    ClassDB::bind_method(D_METHOD("get_region_buffer", "biome", "type", "variant", "region"), &NativeVegetationAtlas::get_region_buffer);
+}
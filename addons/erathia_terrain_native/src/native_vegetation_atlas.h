@@ -0,0 +1,56 @@
+#ifndef NATIVE_VEGETATION_ATLAS_H
+#define NATIVE_VEGETATION_ATLAS_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/classes/mutex.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/rect2.hpp>
+
+#include "vegetation_atlas.h"
+
+namespace godot {
+
+// Read side of a vegetation atlas written by NativeVegetationDispatcher::prebake_atlas(). The file is
+// memory-mapped; buffers are copied from the mapping straight into MultiMesh.buffer order
+// (12 floats per instance, TRANSFORM_3D), with no per-instance decoding.
+class NativeVegetationAtlas : public RefCounted {
+    GDCLASS(NativeVegetationAtlas, RefCounted)
+
+private:
+    VegetationAtlas atlas;  // Guarded by mutex
+    Ref<Mutex> mutex;
+
+    PackedFloat32Array copy_runs(const VegetationAtlas::Group& group, const std::vector<std::pair<uint64_t, uint32_t>>& runs) const;
+
+protected:
+    static void _bind_methods();
+
+public:
+    NativeVegetationAtlas();
+    ~NativeVegetationAtlas();
+
+    // False (and closed) when the file is missing, of another format version or truncated
+    bool open(String path);
+    void close();
+    bool is_open() const;
+
+    int get_world_seed() const;
+    int get_chunk_size() const;
+    Rect2 get_bounds() const;  // World XZ area that was baked
+    int64_t get_instance_count() const;
+    int64_t get_file_size() const;
+    // One {biome, type, variant, chunk_count, instance_count} per MultiMesh, sorted by biome, type, variant
+    Array get_groups() const;
+    int get_group_instance_count(int biome, int type, int variant) const;
+
+    // Every instance of the group; empty when the group is absent
+    PackedFloat32Array get_group_buffer(int biome, int type, int variant) const;
+    // Instances of the group's chunk columns overlapping region (world XZ), e.g. around the player
+    PackedFloat32Array get_region_buffer(int biome, int type, int variant, Rect2 region) const;
+};
+
+}
+
+#endif // NATIVE_VEGETATION_ATLAS_H
@@ -0,0 +1,603 @@
+#include "native_vegetation_culler.h"
+#include "gpu_context.h"
+#include "trace_recorder.h"
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/mesh.hpp>
+#include <godot_cpp/classes/multi_mesh.hpp>
+#include <godot_cpp/classes/rd_uniform.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+#include <godot_cpp/variant/plane.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace godot;
+
+namespace {
+
+const char* CULL_SHADER_PATH = "res://_engine/terrain/vegetation_cull.compute";
+const int BUCKET_PARAMS_SIZE = 64;  // BucketParams in vegetation_cull.compute
+const int FRAME_FLOATS = 28;  // 6 planes + camera position
+const int COUNTER_BUFFER_SIZE = NativeVegetationCuller::MAX_BUCKETS * NativeVegetationCuller::MAX_LODS * 4;
+const int WORKGROUP_SIZE = 64;
+
+String load_shader_source(const String& defines) {
+    Ref<FileAccess> file = FileAccess::open(CULL_SHADER_PATH, FileAccess::READ);
+    if (!file.is_valid()) {
+        return String();
+    }
+    String source = file->get_as_text();
+    file->close();
+    return NativeGPUContext::insert_shader_defines(source, defines);
+}
+
+Ref<RDUniform> make_storage_uniform(int binding, RID buffer) {
+    Ref<RDUniform> uniform;
+    uniform.instantiate();
+    uniform->set_uniform_type(RenderingDevice::UNIFORM_TYPE_STORAGE_BUFFER);
+    uniform->set_binding(binding);
+    uniform->add_id(buffer);
+    return uniform;
+}
+
+// Outside when the AABB corner nearest to the inside lies beyond the plane (normals point out)
+bool aabb_outside_frustum(const AABB& aabb, const float* planes) {
+    const Vector3 min = aabb.position;
+    const Vector3 max = aabb.position + aabb.size;
+    for (int i = 0; i < 6; i++) {
+        const float* plane = planes + i * 4;
+        const float x = plane[0] > 0.0f ? min.x : max.x;
+        const float y = plane[1] > 0.0f ? min.y : max.y;
+        const float z = plane[2] > 0.0f ? min.z : max.z;
+        if (plane[0] * x + plane[1] * y + plane[2] * z - plane[3] > 0.0f) {
+            return true;
+        }
+    }
+    return false;
+}
+
+float aabb_distance(const AABB& aabb, const Vector3& point) {
+    const Vector3 min = aabb.position;
+    const Vector3 max = aabb.position + aabb.size;
+    const float dx = std::max({ min.x - point.x, 0.0f, point.x - max.x });
+    const float dy = std::max({ min.y - point.y, 0.0f, point.y - max.y });
+    const float dz = std::max({ min.z - point.z, 0.0f, point.z - max.z });
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+} // namespace
+
+NativeVegetationCuller::NativeVegetationCuller() {
+    rd = nullptr;
+    available = false;
+    last_dispatches = 0;
+    last_chunks_visible = 0;
+    last_chunks_culled = 0;
+    last_record_time_us = 0;
+    frames_culled = 0;
+}
+
+NativeVegetationCuller::~NativeVegetationCuller() {
+    RenderingServer* rs = RenderingServer::get_singleton();
+    if (!rs || !available.load()) {
+        return;
+    }
+    // Run every call still queued for this object, then hand its resources back to the render thread
+    rs->force_sync();
+
+    Array buffers;
+    Array uniform_sets;
+    for (RenderBucket& bucket : render_buckets) {
+        for (auto& pair : bucket.chunks) {
+            uniform_sets.push_back(pair.second.uniform_set);
+            buffers.push_back(pair.second.source);
+        }
+        if (bucket.finalize_set.is_valid()) {
+            uniform_sets.push_back(bucket.finalize_set);
+        }
+    }
+    for (const RID& rid : { cull_pipeline, cull_shader, finalize_pipeline, finalize_shader,
+                 counter_buffer, frame_buffer, bucket_buffer, dummy_buffer }) {
+        if (rid.is_valid()) {
+            buffers.push_back(rid);
+        }
+    }
+    rs->call_on_render_thread(callable_mp_static(&NativeVegetationCuller::free_render_resources).bind(buffers, uniform_sets));
+}
+
+void NativeVegetationCuller::free_render_resources(Array buffers, Array uniform_sets) {
+    RenderingDevice* device = RenderingServer::get_singleton()->get_rendering_device();
+    if (!device) {
+        return;
+    }
+    // Sets may already be gone with a MultiMesh they referenced
+    for (int i = 0; i < uniform_sets.size(); i++) {
+        RID set = uniform_sets[i];
+        if (set.is_valid() && device->uniform_set_is_valid(set)) {
+            device->free_rid(set);
+        }
+    }
+    for (int i = 0; i < buffers.size(); i++) {
+        device->free_rid(buffers[i]);
+    }
+}
+
+bool NativeVegetationCuller::initialize() {
+    if (available.load()) {
+        return true;
+    }
+    RenderingServer* rs = RenderingServer::get_singleton();
+    if (!rs || !rs->get_rendering_device()) {
+        UtilityFunctions::push_warning("NativeVegetationCuller: No renderer RenderingDevice, GPU culling disabled");
+        return false;
+    }
+
+    const String cull_source = load_shader_source("");
+    const String finalize_source = load_shader_source("#define FINALIZE\n");
+    if (cull_source.is_empty()) {
+        UtilityFunctions::push_warning(String("NativeVegetationCuller: Failed to load shader file: ") + CULL_SHADER_PATH);
+        return false;
+    }
+
+    rs->call_on_render_thread(callable_mp(this, &NativeVegetationCuller::render_initialize).bind(cull_source, finalize_source));
+    // One-off wait so the result is known here when rendering runs on its own thread
+    rs->force_sync();
+    return available.load();
+}
+
+void NativeVegetationCuller::render_initialize(const String& cull_source, const String& finalize_source) {
+    rd = RenderingServer::get_singleton()->get_rendering_device();
+    if (!rd) {
+        return;
+    }
+
+    String error;
+    cull_shader = NativeGPUContext::create_compute_shader(rd, cull_source, "vegetation_cull", error);
+    if (!cull_shader.is_valid()) {
+        UtilityFunctions::push_warning("NativeVegetationCuller: Cull shader compilation failed: " + error);
+        return;
+    }
+    finalize_shader = NativeGPUContext::create_compute_shader(rd, finalize_source, "vegetation_cull_finalize", error);
+    if (!finalize_shader.is_valid()) {
+        UtilityFunctions::push_warning("NativeVegetationCuller: Finalize shader compilation failed: " + error);
+        rd->free_rid(cull_shader);
+        cull_shader = RID();
+        return;
+    }
+    cull_pipeline = rd->compute_pipeline_create(cull_shader);
+    finalize_pipeline = rd->compute_pipeline_create(finalize_shader);
+
+    PackedByteArray zeros;
+    zeros.resize(MAX_BUCKETS * BUCKET_PARAMS_SIZE);
+    zeros.fill(0);
+    counter_buffer = rd->storage_buffer_create(COUNTER_BUFFER_SIZE);
+    frame_buffer = rd->storage_buffer_create(FRAME_FLOATS * sizeof(float));
+    bucket_buffer = rd->storage_buffer_create(MAX_BUCKETS * BUCKET_PARAMS_SIZE, zeros);
+    dummy_buffer = rd->storage_buffer_create(FLOATS_PER_INSTANCE * sizeof(float));
+
+    available = cull_pipeline.is_valid() && finalize_pipeline.is_valid() && counter_buffer.is_valid() &&
+            frame_buffer.is_valid() && bucket_buffer.is_valid() && dummy_buffer.is_valid();
+    if (available.load()) {
+        UtilityFunctions::print("NativeVegetationCuller: GPU culling initialized");
+    } else {
+        UtilityFunctions::push_warning("NativeVegetationCuller: Failed to create culling pipelines or buffers");
+    }
+}
+
+bool NativeVegetationCuller::is_available() const {
+    return available.load();
+}
+
+int NativeVegetationCuller::create_bucket(Array lod_multimeshes, PackedFloat32Array lod_end_distances, int capacity,
+        float bounding_radius, float falloff_start, float min_density) {
+    if (!available.load()) {
+        return -1;
+    }
+    const int lod_count = (int)lod_multimeshes.size();
+    if (lod_count < 1 || lod_count > MAX_LODS || lod_end_distances.size() != lod_count || capacity <= 0) {
+        UtilityFunctions::printerr("[NativeVegetationCuller] create_bucket: expected 1-4 MultiMeshes with one end distance each and a positive capacity");
+        return -1;
+    }
+
+    int id = -1;
+    for (int i = 0; i < MAX_BUCKETS; i++) {
+        if (!buckets[i].used) {
+            id = i;
+            break;
+        }
+    }
+    if (id < 0) {
+        UtilityFunctions::printerr("[NativeVegetationCuller] create_bucket: all ", MAX_BUCKETS, " buckets in use");
+        return -1;
+    }
+
+    RenderingServer* rs = RenderingServer::get_singleton();
+    uint32_t surface_counts[MAX_LODS] = {};
+    Array multimesh_rids;
+    for (int i = 0; i < lod_count; i++) {
+        Ref<MultiMesh> multimesh = lod_multimeshes[i];
+        if (multimesh.is_null() || multimesh->get_mesh().is_null()) {
+            UtilityFunctions::printerr("[NativeVegetationCuller] create_bucket: LOD ", i, " has no MultiMesh or mesh");
+            return -1;
+        }
+        surface_counts[i] = (uint32_t)multimesh->get_mesh()->get_surface_count();
+        multimesh_rids.push_back(multimesh->get_rid());
+    }
+
+    Bucket& bucket = buckets[id];
+    bucket = Bucket();
+    bucket.used = true;
+    bucket.lod_count = lod_count;
+    bucket.max_distance = lod_end_distances[lod_count - 1];
+    bucket.bounding_radius = bounding_radius;
+    for (int i = 0; i < lod_count; i++) {
+        bucket.multimeshes[i] = multimesh_rids[i];
+        // Indirect: the draw counts come from the command buffer the finalize pass writes.
+        // Setting the mesh again builds that buffer for the mesh's surfaces.
+        rs->multimesh_allocate_data(bucket.multimeshes[i], capacity, RenderingServer::MULTIMESH_TRANSFORM_3D, false, false, true);
+        rs->multimesh_set_mesh(bucket.multimeshes[i], rs->multimesh_get_mesh(bucket.multimeshes[i]));
+    }
+    update_custom_aabb(id);
+
+    float lod_end[MAX_LODS];
+    for (int i = 0; i < MAX_LODS; i++) {
+        // Unused levels never match: the LOD loop stops at lod_count
+        lod_end[i] = lod_end_distances[std::min(i, lod_count - 1)];
+    }
+    const float falloff[4] = { falloff_start, std::clamp(min_density, 0.0f, 1.0f), bounding_radius, 0.0f };
+    const uint32_t counts[4] = { (uint32_t)lod_count, (uint32_t)capacity, 0, 0 };
+    PackedByteArray params;
+    params.resize(BUCKET_PARAMS_SIZE);
+    uint8_t* raw = params.ptrw();
+    std::memcpy(raw, lod_end, 16);
+    std::memcpy(raw + 16, falloff, 16);
+    std::memcpy(raw + 32, counts, 16);
+    std::memcpy(raw + 48, surface_counts, 16);
+
+    rs->call_on_render_thread(callable_mp(this, &NativeVegetationCuller::render_create_bucket)
+            .bind(id, multimesh_rids, params, lod_count, bucket.max_distance));
+    return id;
+}
+
+void NativeVegetationCuller::render_create_bucket(int bucket, Array multimeshes, PackedByteArray params, int lod_count, float max_distance) {
+    RenderBucket& render_bucket = render_buckets[bucket];
+    render_bucket = RenderBucket();
+    render_bucket.used = true;
+    render_bucket.lod_count = lod_count;
+    render_bucket.max_distance = max_distance;
+    for (int i = 0; i < lod_count; i++) {
+        render_bucket.multimeshes[i] = multimeshes[i];
+    }
+    refresh_bucket_buffers(render_bucket);
+    rd->buffer_update(bucket_buffer, bucket * BUCKET_PARAMS_SIZE, BUCKET_PARAMS_SIZE, params);
+}
+
+void NativeVegetationCuller::refresh_bucket_buffers(RenderBucket& bucket) {
+    RenderingServer* rs = RenderingServer::get_singleton();
+    for (int i = 0; i < bucket.lod_count; i++) {
+        bucket.lod_buffers[i] = rs->multimesh_get_buffer_rd_rid(bucket.multimeshes[i]);
+        bucket.command_buffers[i] = rs->multimesh_get_command_buffer_rd_rid(bucket.multimeshes[i]);
+    }
+    if (bucket.finalize_set.is_valid() && rd->uniform_set_is_valid(bucket.finalize_set)) {
+        rd->free_rid(bucket.finalize_set);
+    }
+    bucket.finalize_set = create_finalize_uniform_set(bucket);
+}
+
+RID NativeVegetationCuller::create_chunk_uniform_set(const RenderBucket& bucket, RID source) {
+    Array uniforms;
+    uniforms.push_back(make_storage_uniform(0, source));
+    uniforms.push_back(make_storage_uniform(1, counter_buffer));
+    uniforms.push_back(make_storage_uniform(2, frame_buffer));
+    uniforms.push_back(make_storage_uniform(3, bucket_buffer));
+    for (int i = 0; i < MAX_LODS; i++) {
+        const bool used = i < bucket.lod_count && bucket.lod_buffers[i].is_valid();
+        uniforms.push_back(make_storage_uniform(4 + i, used ? bucket.lod_buffers[i] : dummy_buffer));
+    }
+    return rd->uniform_set_create(uniforms, cull_shader, 0);
+}
+
+RID NativeVegetationCuller::create_finalize_uniform_set(const RenderBucket& bucket) {
+    Array uniforms;
+    uniforms.push_back(make_storage_uniform(0, counter_buffer));
+    uniforms.push_back(make_storage_uniform(1, bucket_buffer));
+    for (int i = 0; i < MAX_LODS; i++) {
+        const bool used = i < bucket.lod_count && bucket.command_buffers[i].is_valid();
+        uniforms.push_back(make_storage_uniform(2 + i, used ? bucket.command_buffers[i] : dummy_buffer));
+    }
+    return rd->uniform_set_create(uniforms, finalize_shader, 0);
+}
+
+void NativeVegetationCuller::free_bucket(int bucket) {
+    if (bucket < 0 || bucket >= MAX_BUCKETS || !buckets[bucket].used) {
+        return;
+    }
+    buckets[bucket] = Bucket();
+    RenderingServer::get_singleton()->call_on_render_thread(callable_mp(this, &NativeVegetationCuller::render_free_bucket).bind(bucket));
+}
+
+void NativeVegetationCuller::render_free_bucket(int bucket) {
+    RenderBucket& render_bucket = render_buckets[bucket];
+    while (!render_bucket.chunks.empty()) {
+        render_remove_chunk(bucket, render_bucket.chunks.begin()->first);
+    }
+    if (render_bucket.finalize_set.is_valid() && rd->uniform_set_is_valid(render_bucket.finalize_set)) {
+        rd->free_rid(render_bucket.finalize_set);
+    }
+    render_bucket = RenderBucket();
+}
+
+void NativeVegetationCuller::set_chunk(int bucket, Vector3i chunk, PackedFloat32Array transforms) {
+    if (bucket < 0 || bucket >= MAX_BUCKETS || !buckets[bucket].used) {
+        return;
+    }
+    const int count = (int)(transforms.size() / FLOATS_PER_INSTANCE);
+    if (count == 0) {
+        remove_chunk(bucket, chunk);
+        return;
+    }
+
+    // Bounds of the instance origins, grown by the mesh radius at the largest scale
+    const float* data = transforms.ptr();
+    Vector3 min(data[3], data[7], data[11]);
+    Vector3 max = min;
+    float max_scale = 0.0f;
+    for (int i = 0; i < count; i++) {
+        const float* t = data + i * FLOATS_PER_INSTANCE;
+        const Vector3 origin(t[3], t[7], t[11]);
+        min = min.min(origin);
+        max = max.max(origin);
+        max_scale = std::max(max_scale, std::sqrt(t[0] * t[0] + t[4] * t[4] + t[8] * t[8]));
+    }
+    const Vector3 margin = Vector3(1.0f, 1.0f, 1.0f) * (buckets[bucket].bounding_radius * max_scale);
+    const AABB bounds(min - margin, max - min + margin * 2.0f);
+
+    Bucket& main_bucket = buckets[bucket];
+    auto existing = main_bucket.chunk_counts.find(chunk);
+    if (existing != main_bucket.chunk_counts.end()) {
+        main_bucket.instance_count -= existing->second;
+    }
+    main_bucket.chunk_counts[chunk] = count;
+    main_bucket.chunk_bounds[chunk] = bounds;
+    main_bucket.instance_count += count;
+    update_custom_aabb(bucket);
+
+    RenderingServer::get_singleton()->call_on_render_thread(callable_mp(this, &NativeVegetationCuller::render_set_chunk)
+            .bind(bucket, chunk, transforms, bounds));
+}
+
+void NativeVegetationCuller::render_set_chunk(int bucket, Vector3i chunk, PackedFloat32Array transforms, AABB bounds) {
+    TraceSpan span("vegetation", "cull_chunk_upload");
+    render_remove_chunk(bucket, chunk);
+
+    RenderBucket& render_bucket = render_buckets[bucket];
+    RenderChunk render_chunk;
+    render_chunk.instance_count = (uint32_t)(transforms.size() / FLOATS_PER_INSTANCE);
+    render_chunk.bounds = bounds;
+    render_chunk.source = rd->storage_buffer_create(transforms.size() * sizeof(float), transforms.to_byte_array());
+    if (!render_chunk.source.is_valid()) {
+        UtilityFunctions::push_warning("NativeVegetationCuller: Failed to create chunk instance buffer");
+        return;
+    }
+    render_chunk.uniform_set = create_chunk_uniform_set(render_bucket, render_chunk.source);
+    render_bucket.chunks[chunk] = render_chunk;
+    span.set_count((int)render_chunk.instance_count);
+}
+
+void NativeVegetationCuller::remove_chunk(int bucket, Vector3i chunk) {
+    if (bucket < 0 || bucket >= MAX_BUCKETS || !buckets[bucket].used) {
+        return;
+    }
+    Bucket& main_bucket = buckets[bucket];
+    auto existing = main_bucket.chunk_counts.find(chunk);
+    if (existing == main_bucket.chunk_counts.end()) {
+        return;
+    }
+    main_bucket.instance_count -= existing->second;
+    main_bucket.chunk_counts.erase(existing);
+    main_bucket.chunk_bounds.erase(chunk);
+    update_custom_aabb(bucket);
+
+    RenderingServer::get_singleton()->call_on_render_thread(callable_mp(this, &NativeVegetationCuller::render_remove_chunk)
+            .bind(bucket, chunk));
+}
+
+void NativeVegetationCuller::render_remove_chunk(int bucket, Vector3i chunk) {
+    RenderBucket& render_bucket = render_buckets[bucket];
+    auto existing = render_bucket.chunks.find(chunk);
+    if (existing == render_bucket.chunks.end()) {
+        return;
+    }
+    if (existing->second.uniform_set.is_valid() && rd->uniform_set_is_valid(existing->second.uniform_set)) {
+        rd->free_rid(existing->second.uniform_set);
+    }
+    rd->free_rid(existing->second.source);
+    render_bucket.chunks.erase(existing);
+}
+
+void NativeVegetationCuller::remove_chunk_all(Vector3i chunk) {
+    for (int i = 0; i < MAX_BUCKETS; i++) {
+        if (buckets[i].used) {
+            remove_chunk(i, chunk);
+        }
+    }
+}
+
+void NativeVegetationCuller::clear_chunks() {
+    for (int i = 0; i < MAX_BUCKETS; i++) {
+        while (buckets[i].used && !buckets[i].chunk_counts.empty()) {
+            remove_chunk(i, buckets[i].chunk_counts.begin()->first);
+        }
+    }
+}
+
+void NativeVegetationCuller::update_custom_aabb(int bucket) {
+    // Frustum culling of the MultiMeshInstance3D nodes sees every chunk of the bucket
+    const Bucket& main_bucket = buckets[bucket];
+    AABB bounds;
+    bool first = true;
+    for (const auto& pair : main_bucket.chunk_bounds) {
+        bounds = first ? pair.second : bounds.merge(pair.second);
+        first = false;
+    }
+    RenderingServer* rs = RenderingServer::get_singleton();
+    for (int i = 0; i < main_bucket.lod_count; i++) {
+        rs->multimesh_set_custom_aabb(main_bucket.multimeshes[i], bounds);
+    }
+}
+
+void NativeVegetationCuller::cull(Camera3D* camera) {
+    if (!available.load() || !camera) {
+        return;
+    }
+
+    TypedArray<Plane> planes = camera->get_frustum();
+    if (planes.size() != 6) {
+        return;
+    }
+    PackedFloat32Array frame;
+    frame.resize(FRAME_FLOATS);
+    float* raw = frame.ptrw();
+    for (int i = 0; i < 6; i++) {
+        const Plane plane = planes[i];
+        raw[i * 4 + 0] = plane.normal.x;
+        raw[i * 4 + 1] = plane.normal.y;
+        raw[i * 4 + 2] = plane.normal.z;
+        raw[i * 4 + 3] = plane.d;
+    }
+    const Vector3 position = camera->get_global_position();
+    raw[24] = position.x;
+    raw[25] = position.y;
+    raw[26] = position.z;
+    raw[27] = 0.0f;
+
+    RenderingServer::get_singleton()->call_on_render_thread(callable_mp(this, &NativeVegetationCuller::render_cull).bind(frame));
+}
+
+void NativeVegetationCuller::render_cull(PackedFloat32Array frame) {
+    TraceSpan span("vegetation", "cull_record");
+    const uint64_t start_us = Time::get_singleton()->get_ticks_usec();
+
+    const float* planes = frame.ptr();
+    const Vector3 camera_position(planes[24], planes[25], planes[26]);
+    rd->buffer_update(frame_buffer, 0, FRAME_FLOATS * sizeof(float), frame.to_byte_array());
+    rd->buffer_clear(counter_buffer, 0, COUNTER_BUFFER_SIZE);
+
+    int dispatches = 0;
+    int chunks_visible = 0;
+    int chunks_culled = 0;
+    int64_t compute_list = rd->compute_list_begin();
+    rd->compute_list_bind_compute_pipeline(compute_list, cull_pipeline);
+    for (int b = 0; b < MAX_BUCKETS; b++) {
+        RenderBucket& bucket = render_buckets[b];
+        if (!bucket.used) {
+            continue;
+        }
+        if (!bucket.finalize_set.is_valid() || !rd->uniform_set_is_valid(bucket.finalize_set)) {
+            // A MultiMesh was reallocated or its mesh changed: its buffers are new
+            refresh_bucket_buffers(bucket);
+        }
+        for (auto& pair : bucket.chunks) {
+            RenderChunk& chunk = pair.second;
+            // Coarse test per chunk; the shader tests every instance
+            if (aabb_distance(chunk.bounds, camera_position) > bucket.max_distance ||
+                    aabb_outside_frustum(chunk.bounds, planes)) {
+                chunks_culled++;
+                continue;
+            }
+            if (!chunk.uniform_set.is_valid() || !rd->uniform_set_is_valid(chunk.uniform_set)) {
+                chunk.uniform_set = create_chunk_uniform_set(bucket, chunk.source);
+                if (!chunk.uniform_set.is_valid()) {
+                    continue;
+                }
+            }
+            const uint32_t push[4] = { chunk.instance_count, (uint32_t)b, 0, 0 };
+            PackedByteArray push_constants;
+            push_constants.resize(sizeof(push));
+            std::memcpy(push_constants.ptrw(), push, sizeof(push));
+            rd->compute_list_bind_uniform_set(compute_list, chunk.uniform_set, 0);
+            rd->compute_list_set_push_constant(compute_list, push_constants, push_constants.size());
+            rd->compute_list_dispatch(compute_list, (chunk.instance_count + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+            chunks_visible++;
+            dispatches++;
+        }
+    }
+
+    // Every bucket gets its counts written, zero included, so last frame's draws never linger
+    rd->compute_list_add_barrier(compute_list);
+    rd->compute_list_bind_compute_pipeline(compute_list, finalize_pipeline);
+    for (int b = 0; b < MAX_BUCKETS; b++) {
+        const RenderBucket& bucket = render_buckets[b];
+        if (!bucket.used || !bucket.finalize_set.is_valid()) {
+            continue;
+        }
+        const uint32_t push[4] = { (uint32_t)b, 0, 0, 0 };
+        PackedByteArray push_constants;
+        push_constants.resize(sizeof(push));
+        std::memcpy(push_constants.ptrw(), push, sizeof(push));
+        rd->compute_list_bind_uniform_set(compute_list, bucket.finalize_set, 0);
+        rd->compute_list_set_push_constant(compute_list, push_constants, push_constants.size());
+        rd->compute_list_dispatch(compute_list, 1, 1, 1);
+        dispatches++;
+    }
+    rd->compute_list_end();
+
+    span.set_count(chunks_visible);
+    last_dispatches = dispatches;
+    last_chunks_visible = chunks_visible;
+    last_chunks_culled = chunks_culled;
+    last_record_time_us = Time::get_singleton()->get_ticks_usec() - start_us;
+    frames_culled++;
+}
+
+int64_t NativeVegetationCuller::get_bucket_instance_count(int bucket) const {
+    if (bucket < 0 || bucket >= MAX_BUCKETS || !buckets[bucket].used) {
+        return 0;
+    }
+    return buckets[bucket].instance_count;
+}
+
+Dictionary NativeVegetationCuller::get_telemetry() const {
+    int bucket_count = 0;
+    int chunk_count = 0;
+    int64_t instance_count = 0;
+    for (const Bucket& bucket : buckets) {
+        if (bucket.used) {
+            bucket_count++;
+            chunk_count += (int)bucket.chunk_counts.size();
+            instance_count += bucket.instance_count;
+        }
+    }
+
+    Dictionary stats;
+    stats["available"] = available.load();
+    stats["buckets"] = bucket_count;
+    stats["chunks"] = chunk_count;
+    stats["source_instances"] = instance_count;
+    stats["frames_culled"] = frames_culled.load();
+    stats["last_dispatches"] = last_dispatches.load();
+    stats["last_chunks_visible"] = last_chunks_visible.load();
+    stats["last_chunks_culled"] = last_chunks_culled.load();
+    stats["last_record_time_ms"] = (float)last_record_time_us.load() / 1000.0f;
+    return stats;
+}
+
+void NativeVegetationCuller::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("initialize"), &NativeVegetationCuller::initialize);
+    ClassDB::bind_method(D_METHOD("is_available"), &NativeVegetationCuller::is_available);
+    ClassDB::bind_method(D_METHOD("create_bucket", "lod_multimeshes", "lod_end_distances", "capacity", "bounding_radius", "falloff_start", "min_density"),
+            &NativeVegetationCuller::create_bucket, DEFVAL(0.0f), DEFVAL(1.0f));
+    ClassDB::bind_method(D_METHOD("free_bucket", "bucket"), &NativeVegetationCuller::free_bucket);
+    ClassDB::bind_method(D_METHOD("set_chunk", "bucket", "chunk", "transforms"), &NativeVegetationCuller::set_chunk);
+    ClassDB::bind_method(D_METHOD("remove_chunk", "bucket", "chunk"), &NativeVegetationCuller::remove_chunk);
+    ClassDB::bind_method(D_METHOD("remove_chunk_all", "chunk"), &NativeVegetationCuller::remove_chunk_all);
+    ClassDB::bind_method(D_METHOD("clear_chunks"), &NativeVegetationCuller::clear_chunks);
+    ClassDB::bind_method(D_METHOD("cull", "camera"), &NativeVegetationCuller::cull);
+    ClassDB::bind_method(D_METHOD("get_bucket_instance_count", "bucket"), &NativeVegetationCuller::get_bucket_instance_count);
+    ClassDB::bind_method(D_METHOD("get_telemetry"), &NativeVegetationCuller::get_telemetry);
+}
@@ -0,0 +1,137 @@
+#ifndef NATIVE_VEGETATION_CULLER_H
+#define NATIVE_VEGETATION_CULLER_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/classes/rendering_device.hpp>
+#include <godot_cpp/classes/camera3d.hpp>
+#include <godot_cpp/variant/aabb.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/rid.hpp>
+#include <godot_cpp/variant/typed_array.hpp>
+#include <godot_cpp/variant/vector3i.hpp>
+
+#include <atomic>
+#include <map>
+
+namespace godot {
+
+// Per-frame frustum and distance culling, LOD selection and density falloff for vegetation, on the
+// renderer's RenderingDevice (vegetation_cull.compute). A bucket is one vegetation mesh with up to
+// MAX_LODS MultiMeshes, the last usually the coarsest generator LOD acting as impostor. Each frame the
+// survivors of every chunk of the bucket are appended to the MultiMesh of their LOD and the indirect
+// draw counts are written on the GPU; no instance data goes through the CPU after set_chunk().
+//
+// The main thread only records; every RenderingDevice call runs through
+// RenderingServer::call_on_render_thread(), in submission order.
+class NativeVegetationCuller : public RefCounted {
+    GDCLASS(NativeVegetationCuller, RefCounted)
+
+public:
+    static const int MAX_BUCKETS = 256;
+    static const int MAX_LODS = 4;
+    static const int FLOATS_PER_INSTANCE = 12;  // MultiMesh TRANSFORM_3D
+
+private:
+    // Main-thread view of a bucket
+    struct Bucket {
+        bool used = false;
+        int lod_count = 0;
+        RID multimeshes[MAX_LODS];  // RenderingServer MultiMesh RIDs
+        float max_distance = 0.0f;
+        float bounding_radius = 0.0f;
+        std::map<Vector3i, AABB> chunk_bounds;
+        std::map<Vector3i, int> chunk_counts;
+        int64_t instance_count = 0;
+    };
+
+    // Render-thread view
+    struct RenderChunk {
+        RID source;
+        RID uniform_set;
+        uint32_t instance_count = 0;
+        AABB bounds;
+    };
+
+    struct RenderBucket {
+        bool used = false;
+        int lod_count = 0;
+        float max_distance = 0.0f;
+        RID multimeshes[MAX_LODS];
+        RID lod_buffers[MAX_LODS];  // Owned by the MultiMeshes
+        RID command_buffers[MAX_LODS];
+        RID finalize_set;
+        std::map<Vector3i, RenderChunk> chunks;
+    };
+
+    Bucket buckets[MAX_BUCKETS];  // Main thread
+    RenderBucket render_buckets[MAX_BUCKETS];  // Render thread
+
+    // Render thread
+    RenderingDevice* rd;
+    RID cull_shader;
+    RID cull_pipeline;
+    RID finalize_shader;
+    RID finalize_pipeline;
+    RID counter_buffer;  // uint[MAX_BUCKETS * MAX_LODS], cleared every frame
+    RID frame_buffer;  // Frustum planes and camera position
+    RID bucket_buffer;  // BucketParams[MAX_BUCKETS]
+    RID dummy_buffer;  // Fills the LOD bindings a bucket does not use
+
+    std::atomic<bool> available;
+    std::atomic<int> last_dispatches;
+    std::atomic<int> last_chunks_visible;
+    std::atomic<int> last_chunks_culled;
+    std::atomic<uint64_t> last_record_time_us;
+    std::atomic<int64_t> frames_culled;
+
+    void render_initialize(const String& cull_source, const String& finalize_source);
+    void render_create_bucket(int bucket, Array multimeshes, PackedByteArray params, int lod_count, float max_distance);
+    void render_free_bucket(int bucket);
+    void render_set_chunk(int bucket, Vector3i chunk, PackedFloat32Array transforms, AABB bounds);
+    void render_remove_chunk(int bucket, Vector3i chunk);
+    void render_cull(PackedFloat32Array frame);
+
+    RID create_chunk_uniform_set(const RenderBucket& bucket, RID source);
+    RID create_finalize_uniform_set(const RenderBucket& bucket);
+    void refresh_bucket_buffers(RenderBucket& bucket);
+    void update_custom_aabb(int bucket);
+    static void free_render_resources(Array buffers, Array uniform_sets);
+
+protected:
+    static void _bind_methods();
+
+public:
+    NativeVegetationCuller();
+    ~NativeVegetationCuller();
+
+    // False without a renderer RenderingDevice (Compatibility renderer, headless) or when the shaders fail
+    bool initialize();
+    bool is_available() const;
+
+    // lod_multimeshes: MultiMesh resources, finest first, with their mesh set and instance_count left
+    // at 0 (the culler allocates them with indirect draws). lod_end_distances: ascending, one per LOD.
+    // Instances farther than falloff_start are thinned down to min_density at the last LOD's end.
+    // Returns the bucket id, or -1.
+    int create_bucket(Array lod_multimeshes, PackedFloat32Array lod_end_distances, int capacity,
+            float bounding_radius, float falloff_start = 0.0f, float min_density = 1.0f);
+    void free_bucket(int bucket);
+
+    // transforms: MultiMesh.buffer layout, e.g. from get_multimesh_buffer(); replaces the chunk's instances
+    void set_chunk(int bucket, Vector3i chunk, PackedFloat32Array transforms);
+    void remove_chunk(int bucket, Vector3i chunk);
+    void remove_chunk_all(Vector3i chunk);
+    void clear_chunks();
+
+    // Records this frame's culling for every bucket; call once per frame, before the scene is drawn
+    void cull(Camera3D* camera);
+
+    int64_t get_bucket_instance_count(int bucket) const;  // Source instances, before culling
+    Dictionary get_telemetry() const;
+};
+
+}
+
+#endif // NATIVE_VEGETATION_CULLER_H
@@ -1,59 +1,106 @@
 #include "native_vegetation_dispatcher.h"
+#include "native_terrain_generator.h"
+#include "trace_recorder.h"
+#include "vegetation_atlas.h"
 
-#include <godot_cpp/classes/rendering_server.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
 #include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
-#include <godot_cpp/classes/rd_shader_source.hpp>
-#include <godot_cpp/classes/rd_shader_spirv.hpp>
 #include <godot_cpp/classes/rd_uniform.hpp>
-#include <godot_cpp/classes/rd_sampler_state.hpp>
 #include <godot_cpp/classes/rd_texture_format.hpp>
+#include <godot_cpp/classes/rd_texture_view.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <map>
+#include <tuple>
 
 using namespace godot;
 
+// Sampling grid steps per axis for a placement pass (also sent as a push constant)
+static int get_grid_steps(float grid_spacing) {
+    return static_cast<int>(std::ceil(NativeVegetationDispatcher::CHUNK_SIZE / grid_spacing));
+}
+
 NativeVegetationDispatcher::NativeVegetationDispatcher() {
+    gpu_context = nullptr;
     rd = nullptr;
     gpu_initialized = false;
     max_cache_entries = DEFAULT_MAX_CACHE_ENTRIES;
+    max_cache_bytes = DEFAULT_MAX_CACHE_BYTES;
+    compacted_bytes_saved = 0;
     total_placement_time_us = 0;
     last_placement_time_us = 0;
     placement_call_count = 0;
     terrain_dispatcher = nullptr;
     cached_sampler_linear = RID();
+    placeholder_biome_map = RID();
     transform_shader = RID();
     transform_pipeline = RID();
+    shared_terrain_passes = 0;
+    invalidated_entries = 0;
+    edit_reruns = 0;
+    decode_calls = 0;
+    decode_time_us = 0;
+    batches_submitted = 0;
+    last_batch_size = 0;
+    last_batch_gpu_time_us = 0;
+    avg_request_latency_us = 0;
+    prebake_chunks_done = 0;
+    prebake_chunks_total = 0;
+    prebake_cancel_requested = false;
     
     cache_mutex.instantiate();
+    queue_mutex.instantiate();
+    init_mutex.instantiate();
+    prebake_mutex.instantiate();
     
-    RenderingServer* rs = RenderingServer::get_singleton();
-    if (rs) {
-        rd = rs->create_local_rendering_device();
-        if (!rd) {
-            UtilityFunctions::push_warning("NativeVegetationDispatcher: Failed to create local RenderingDevice");
-        }
-    }
+    // The shared GPU context (and its device) is joined on the first initialize_gpu()
 }
 
 NativeVegetationDispatcher::~NativeVegetationDispatcher() {
     cleanup_gpu();
-    
-    if (rd) {
-        memdelete(rd);
-        rd = nullptr;
-    }
 }
 
 bool NativeVegetationDispatcher::initialize_gpu() {
     if (gpu_initialized) {
         return true;
     }
+
+    init_mutex->lock();
+    if (!gpu_initialized) {
+        // Drop a context left over from a failed attempt before retrying
+        detach_gpu_context();
+        gpu_context = NativeGPUContext::acquire();
+
+        // Shader compilation runs on the device thread, like every later submit
+        bool ok = false;
+        gpu_context->run([this, &ok]() { ok = initialize_gpu_on_worker(); });
+        if (ok) {
+            gpu_initialized = true;
+            gpu_context->register_client(this);
+        } else {
+            gpu_context->run([this]() { release_gpu_resources(); });
+            NativeGPUContext::release(gpu_context);
+            gpu_context = nullptr;
+        }
+    }
+    init_mutex->unlock();
+
+    return gpu_initialized;
+}
+
+bool NativeVegetationDispatcher::initialize_gpu_on_worker() {
+    // The shared device, created on this thread: recording, submit(), sync() and readback all happen here
+    rd = gpu_context->get_device();
     
     if (!rd) {
-        UtilityFunctions::push_warning("NativeVegetationDispatcher: RenderingDevice not available");
+        UtilityFunctions::push_warning("NativeVegetationDispatcher: Failed to create local RenderingDevice");
         return false;
     }
     
@@ -68,23 +115,15 @@ bool NativeVegetationDispatcher::initialize_gpu() {
     String shader_source = file->get_as_text();
     file->close();
     
-    Ref<RDShaderSource> shader_src;
-    shader_src.instantiate();
-    shader_src->set_stage_source(RenderingDevice::SHADER_STAGE_COMPUTE, shader_source);
-    shader_src->set_language(RenderingDevice::SHADER_LANGUAGE_GLSL);
-    
-    Ref<RDShaderSPIRV> spirv = rd->shader_compile_spirv_from_source(shader_src);
+    // The native pipeline always builds the variant that writes indirect args (binding 3);
+    // gpu_vegetation_dispatcher.gd compiles the plain file
+    shader_source = NativeGPUContext::insert_shader_defines(shader_source, "#define INDIRECT_ARGS\n");
     
-    if (!spirv.is_valid() || spirv->get_stage_compile_error(RenderingDevice::SHADER_STAGE_COMPUTE) != "") {
-        String error = spirv.is_valid() ? spirv->get_stage_compile_error(RenderingDevice::SHADER_STAGE_COMPUTE) : "Invalid SPIRV";
-        UtilityFunctions::push_warning("NativeVegetationDispatcher: Shader compilation failed: " + error);
-        return false;
-    }
-    
-    shader = rd->shader_create_from_spirv(spirv);
+    String error;
+    shader = gpu_context->create_compute_shader(shader_source, "vegetation_placement", error);
     
     if (!shader.is_valid()) {
-        UtilityFunctions::push_warning("NativeVegetationDispatcher: Failed to create shader");
+        UtilityFunctions::push_warning("NativeVegetationDispatcher: Shader compilation failed: " + error);
         return false;
     }
     
@@ -97,12 +136,23 @@ bool NativeVegetationDispatcher::initialize_gpu() {
         return false;
     }
     
-    // Create cached sampler for reuse
-    Ref<RDSamplerState> sampler_state;
-    sampler_state.instantiate();
-    sampler_state->set_min_filter(RenderingDevice::SAMPLER_FILTER_LINEAR);
-    sampler_state->set_mag_filter(RenderingDevice::SAMPLER_FILTER_LINEAR);
-    cached_sampler_linear = rd->sampler_create(sampler_state);
+    // Shared sampler, freed with the device
+    cached_sampler_linear = gpu_context->get_sampler(RenderingDevice::SAMPLER_FILTER_LINEAR, RenderingDevice::SAMPLER_REPEAT_MODE_REPEAT);
+    
+    // Binding 1 must hold a texture even while the terrain uses the virtual biome map
+    Ref<RDTextureFormat> placeholder_format;
+    placeholder_format.instantiate();
+    placeholder_format->set_format(RenderingDevice::DATA_FORMAT_R32G32_SFLOAT);
+    placeholder_format->set_width(1);
+    placeholder_format->set_height(1);
+    placeholder_format->set_texture_type(RenderingDevice::TEXTURE_TYPE_2D);
+    placeholder_format->set_usage_bits(RenderingDevice::TEXTURE_USAGE_SAMPLING_BIT);
+    PackedByteArray placeholder_texel;
+    placeholder_texel.resize(2 * sizeof(float));
+    placeholder_texel.fill(0);
+    TypedArray<PackedByteArray> placeholder_data;
+    placeholder_data.push_back(placeholder_texel);
+    placeholder_biome_map = rd->texture_create(placeholder_format, Ref<RDTextureView>(), placeholder_data);
     
     // Load and compile transform shader
     String transform_shader_path = "res://_engine/terrain/transform_placement.compute";
@@ -112,44 +162,45 @@ bool NativeVegetationDispatcher::initialize_gpu() {
         String transform_shader_source = transform_file->get_as_text();
         transform_file->close();
         
-        Ref<RDShaderSource> transform_shader_src;
-        transform_shader_src.instantiate();
-        transform_shader_src->set_stage_source(RenderingDevice::SHADER_STAGE_COMPUTE, transform_shader_source);
-        transform_shader_src->set_language(RenderingDevice::SHADER_LANGUAGE_GLSL);
-        
-        Ref<RDShaderSPIRV> transform_spirv = rd->shader_compile_spirv_from_source(transform_shader_src);
+        String transform_error;
+        transform_shader = gpu_context->create_compute_shader(transform_shader_source, "transform_placement", transform_error);
         
-        if (transform_spirv.is_valid() && transform_spirv->get_stage_compile_error(RenderingDevice::SHADER_STAGE_COMPUTE) == "") {
-            transform_shader = rd->shader_create_from_spirv(transform_spirv);
+        if (transform_shader.is_valid()) {
+            transform_pipeline = rd->compute_pipeline_create(transform_shader);
             
-            if (transform_shader.is_valid()) {
-                transform_pipeline = rd->compute_pipeline_create(transform_shader);
-                
-                if (transform_pipeline.is_valid()) {
-                    UtilityFunctions::print("NativeVegetationDispatcher: Transform shader initialized successfully");
-                } else {
-                    UtilityFunctions::push_warning("NativeVegetationDispatcher: Failed to create transform pipeline");
-                }
+            if (transform_pipeline.is_valid()) {
+                UtilityFunctions::print("NativeVegetationDispatcher: Transform shader initialized successfully");
             } else {
-                UtilityFunctions::push_warning("NativeVegetationDispatcher: Failed to create transform shader");
+                UtilityFunctions::push_warning("NativeVegetationDispatcher: Failed to create transform pipeline");
             }
         } else {
-            String error = transform_spirv.is_valid() ? transform_spirv->get_stage_compile_error(RenderingDevice::SHADER_STAGE_COMPUTE) : "Invalid SPIRV";
-            UtilityFunctions::push_warning("NativeVegetationDispatcher: Transform shader compilation failed: " + error);
+            UtilityFunctions::push_warning("NativeVegetationDispatcher: Transform shader compilation failed: " + transform_error);
         }
     } else {
         UtilityFunctions::push_warning("NativeVegetationDispatcher: Transform shader file not found: " + transform_shader_path);
     }
     
-    gpu_initialized = true;
     UtilityFunctions::print("NativeVegetationDispatcher: GPU initialized successfully");
     return true;
 }
 
 void NativeVegetationDispatcher::cleanup_gpu() {
-    if (cached_sampler_linear.is_valid()) {
-        rd->free_rid(cached_sampler_linear);
-        cached_sampler_linear = RID();
+    // Device resources are released on the device thread; the device itself outlives this client
+    init_mutex->lock();
+    detach_gpu_context();
+    init_mutex->unlock();
+}
+
+void NativeVegetationDispatcher::release_gpu_resources() {
+    if (!rd) {
+        return;
+    }
+    
+    cached_sampler_linear = RID();
+    
+    if (placeholder_biome_map.is_valid()) {
+        rd->free_rid(placeholder_biome_map);
+        placeholder_biome_map = RID();
     }
     
     if (transform_pipeline.is_valid()) {
@@ -172,90 +223,125 @@ void NativeVegetationDispatcher::cleanup_gpu() {
         shader = RID();
     }
     
-    cache_mutex->lock();
-    for (auto& chunk_pair : buffer_cache) {
-        for (auto& type_pair : chunk_pair.second) {
-            if (type_pair.second.is_valid()) {
-                rd->free_rid(type_pair.second);
-            }
-        }
-    }
-    for (auto& chunk_pair : transform_buffer_cache) {
-        for (auto& type_pair : chunk_pair.second) {
-            if (type_pair.second.is_valid()) {
-                rd->free_rid(type_pair.second);
-            }
-        }
-    }
-    buffer_cache.clear();
-    transform_buffer_cache.clear();
-    placement_cache.clear();
-    lru_list.clear();
-    lru_map.clear();
-    cache_mutex->unlock();
+    clear_cache_on_worker();
+    free_retired_buffers(true);
+    free_scratch_buffers();
     
-    gpu_initialized = false;
+    rd = nullptr;
 }
 
-void NativeVegetationDispatcher::update_lru_access(const Vector3i& chunk, int type) {
-    ChunkTypePair key{chunk, type};
-    
-    auto it = lru_map.find(key);
-    if (it != lru_map.end()) {
-        lru_list.erase(it->second);
+void NativeVegetationDispatcher::detach_gpu_context() {
+    if (!gpu_context) {
+        return;
     }
     
-    lru_list.push_front(key);
-    lru_map[key] = lru_list.begin();
+    // After this the device thread no longer calls process_gpu_work() for this dispatcher
+    gpu_initialized = false;
+    gpu_context->unregister_client(this);
+    gpu_context->run([this]() { release_gpu_resources(); });
+    
+    queue_mutex->lock();
+    request_queue = std::priority_queue<PlacementRequest>();
+    pending_keys.clear();
+    queue_mutex->unlock();
+    
+    NativeGPUContext::release(gpu_context);
+    gpu_context = nullptr;
+    rd = nullptr;
 }
 
-void NativeVegetationDispatcher::evict_lru_entry() {
-    if (lru_list.empty()) {
-        return;
+bool NativeVegetationDispatcher::process_gpu_work() {
+    std::vector<PlacementRequest> batch;
+    queue_mutex->lock();
+    while (!request_queue.empty() && (int)batch.size() < MAX_BATCH_REQUESTS) {
+        batch.push_back(request_queue.top());
+        request_queue.pop();
     }
+    bool more = !request_queue.empty();
+    queue_mutex->unlock();
     
-    ChunkTypePair oldest = lru_list.back();
-    lru_list.pop_back();
-    lru_map.erase(oldest);
-    
-    placement_cache[oldest.chunk].erase(oldest.type);
-    if (placement_cache[oldest.chunk].empty()) {
-        placement_cache.erase(oldest.chunk);
+    if (!batch.empty()) {
+        run_placement_batch(batch);
     }
     
-    auto buffer_it = buffer_cache.find(oldest.chunk);
-    if (buffer_it != buffer_cache.end()) {
-        auto type_it = buffer_it->second.find(oldest.type);
-        if (type_it != buffer_it->second.end()) {
-            if (type_it->second.is_valid()) {
-                rd->free_rid(type_it->second);
-            }
-            buffer_it->second.erase(type_it);
-            if (buffer_it->second.empty()) {
-                buffer_cache.erase(buffer_it);
+    // Requests beyond one batch: the device thread goes again without waiting for another enqueue
+    return more;
+}
+
+bool NativeVegetationDispatcher::run_on_worker(const std::function<void()>& task) {
+    // Blocking hand-off to the device thread (runs inline when already on it)
+    if (!gpu_context) {
+        return false;
+    }
+    return gpu_context->run([this, &task]() {
+        if (rd) {
+            task();
+        }
+    });
+}
+
+void NativeVegetationDispatcher::retire_entries(const std::vector<PlacementCache::Entry>& entries) {
+    // Every list that wrote these buffers was synced before its results were published, so the
+    // delay only covers RIDs callers may still hold
+    const int batch = batches_submitted.load();
+    for (const PlacementCache::Entry& entry : entries) {
+        const RID buffers[3] = { entry.placement_buffer, entry.transform_buffer, entry.args_buffer };
+        for (const RID& buffer : buffers) {
+            if (buffer.is_valid()) {
+                retired_buffers.push_back({ buffer, batch });
             }
         }
     }
+}
+
+void NativeVegetationDispatcher::free_retired_buffers(bool all) {
+    const int batch = batches_submitted.load();
+    while (!retired_buffers.empty() && (all || batch - retired_buffers.front().retired_at_batch >= RETIRE_DELAY_BATCHES)) {
+        rd->free_rid(retired_buffers.front().buffer);
+        retired_buffers.pop_front();
+    }
+}
+
+bool NativeVegetationDispatcher::ensure_scratch_buffers() {
+    if (!scratch_placement_buffers.empty()) {
+        return true;
+    }
     
-    auto transform_it = transform_buffer_cache.find(oldest.chunk);
-    if (transform_it != transform_buffer_cache.end()) {
-        auto type_it = transform_it->second.find(oldest.type);
-        if (type_it != transform_it->second.end()) {
-            if (type_it->second.is_valid()) {
-                rd->free_rid(type_it->second);
-            }
-            transform_it->second.erase(type_it);
-            if (transform_it->second.empty()) {
-                transform_buffer_cache.erase(transform_it);
-            }
+    // No initial data: run_placement_batch clears each header before use
+    const uint32_t placement_bytes = PLACEMENT_HEADER_SIZE + MAX_PLACEMENTS * sizeof(PlacementData);
+    const uint32_t transform_bytes = MAX_PLACEMENTS * 12 * sizeof(float);
+    for (int i = 0; i < MAX_BATCH_REQUESTS; i++) {
+        RID placement_buffer = rd->storage_buffer_create(placement_bytes);
+        RID transform_buffer = rd->storage_buffer_create(transform_bytes);
+        scratch_placement_buffers.push_back(placement_buffer);
+        scratch_transform_buffers.push_back(transform_buffer);
+        if (!placement_buffer.is_valid() || !transform_buffer.is_valid()) {
+            free_scratch_buffers();
+            return false;
+        }
+    }
+    return true;
+}
+
+void NativeVegetationDispatcher::free_scratch_buffers() {
+    for (const RID& buffer : scratch_placement_buffers) {
+        if (buffer.is_valid()) {
+            rd->free_rid(buffer);
+        }
+    }
+    for (const RID& buffer : scratch_transform_buffers) {
+        if (buffer.is_valid()) {
+            rd->free_rid(buffer);
         }
     }
+    scratch_placement_buffers.clear();
+    scratch_transform_buffers.clear();
 }
 
 Array NativeVegetationDispatcher::decode_placements(const PackedByteArray& buffer_data) {
     Array result;
     
-    if (buffer_data.size() < 4) {
+    if (buffer_data.size() < PLACEMENT_HEADER_SIZE) {
         return result;
     }
     
@@ -267,7 +353,7 @@ Array NativeVegetationDispatcher::decode_placements(const PackedByteArray& buffe
         placement_count = MAX_PLACEMENTS;
     }
     
-    size_t offset = 4;
+    size_t offset = PLACEMENT_HEADER_SIZE;
     const size_t stride = sizeof(PlacementData);
     
     for (uint32_t i = 0; i < placement_count; i++) {
@@ -293,109 +379,219 @@ Array NativeVegetationDispatcher::decode_placements(const PackedByteArray& buffe
     return result;
 }
 
-Array NativeVegetationDispatcher::generate_placements(
-    Vector3i chunk_origin,
-    int veg_type,
-    float density,
-    float grid_spacing,
-    float noise_frequency,
-    float slope_max,
-    Dictionary height_range,
-    int world_seed,
-    RID biome_map_texture,
-    bool cpu_fallback
-) {
-    if (!gpu_initialized) {
-        if (!initialize_gpu()) {
-            return Array();
-        }
-    }
+PackedPlacements NativeVegetationDispatcher::decode_placements_packed(const PackedByteArray& buffer_data) {
+    PackedPlacements packed;
     
-    cache_mutex->lock();
-    auto chunk_it = placement_cache.find(chunk_origin);
-    if (chunk_it != placement_cache.end()) {
-        auto type_it = chunk_it->second.find(veg_type);
-        if (type_it != chunk_it->second.end()) {
-            update_lru_access(chunk_origin, veg_type);
-            Array cached = type_it->second;
-            cache_mutex->unlock();
-            return cached;
-        }
+    if (buffer_data.size() < PLACEMENT_HEADER_SIZE) {
+        return packed;
     }
-    cache_mutex->unlock();
     
-    if (!biome_map_texture.is_valid()) {
-        UtilityFunctions::push_warning("NativeVegetationDispatcher: Invalid biome map texture");
-        return Array();
-    }
+    const uint8_t* data = buffer_data.ptr();
+    uint32_t placement_count;
+    memcpy(&placement_count, data, sizeof(uint32_t));
     
-    RID terrain_sdf_texture;
-    if (terrain_dispatcher) {
-        terrain_sdf_texture = terrain_dispatcher->call("get_sdf_texture_for_chunk", chunk_origin);
+    // Whatever the header says, only whole records that were read back are decoded
+    const size_t stride = sizeof(PlacementData);
+    const size_t available = (buffer_data.size() - PLACEMENT_HEADER_SIZE) / stride;
+    const int count = (int)std::min<size_t>(std::min<uint32_t>(placement_count, MAX_PLACEMENTS), available);
+    
+    packed.positions.resize(count);
+    packed.normals.resize(count);
+    packed.scales.resize(count);
+    packed.rotations.resize(count);
+    packed.variants.resize(count);
+    packed.seeds.resize(count);
+    
+    Vector3* positions = packed.positions.ptrw();
+    Vector3* normals = packed.normals.ptrw();
+    float* scales = packed.scales.ptrw();
+    float* rotations = packed.rotations.ptrw();
+    int32_t* variants = packed.variants.ptrw();
+    int32_t* seeds = packed.seeds.ptrw();
+    
+    for (int i = 0; i < count; i++) {
+        PlacementData pd;
+        memcpy(&pd, data + PLACEMENT_HEADER_SIZE + i * stride, stride);
+        positions[i] = pd.position;
+        normals[i] = pd.normal;
+        scales[i] = pd.scale;
+        rotations[i] = pd.rotation_y;
+        variants[i] = (int32_t)pd.variant_index;
+        seeds[i] = (int32_t)pd.instance_seed;
     }
     
-    if (!terrain_sdf_texture.is_valid()) {
-        return Array();
+    return packed;
+}
+
+Dictionary NativeVegetationDispatcher::packed_to_dictionary(const PackedPlacements& packed) {
+    // Packed arrays are copy-on-write: no per-instance data is copied here
+    Dictionary result;
+    result["positions"] = packed.positions;
+    result["normals"] = packed.normals;
+    result["scales"] = packed.scales;
+    result["rotations"] = packed.rotations;
+    result["variants"] = packed.variants;
+    result["seeds"] = packed.seeds;
+    return result;
+}
+
+PackedFloat32Array NativeVegetationDispatcher::build_multimesh_buffer(const PackedPlacements& packed) {
+    // Same 3x4 row-major matrix as transform_placement.compute
+    const int count = packed.positions.size();
+    PackedFloat32Array buffer;
+    buffer.resize(count * 12);
+    float* transforms = buffer.ptrw();
+    const Vector3* positions = packed.positions.ptr();
+    const float* scales = packed.scales.ptr();
+    const float* rotations = packed.rotations.ptr();
+    
+    for (int i = 0; i < count; i++) {
+        float cos_y = std::cos(rotations[i]);
+        float sin_y = std::sin(rotations[i]);
+        float scale = scales[i];
+        float* t = transforms + i * 12;
+        
+        t[0] = cos_y * scale;
+        t[1] = 0.0f;
+        t[2] = sin_y * scale;
+        t[3] = positions[i].x;
+        
+        t[4] = 0.0f;
+        t[5] = scale;
+        t[6] = 0.0f;
+        t[7] = positions[i].y;
+        
+        t[8] = -sin_y * scale;
+        t[9] = 0.0f;
+        t[10] = cos_y * scale;
+        t[11] = positions[i].z;
     }
     
-    int grid_steps = static_cast<int>(std::ceil(CHUNK_SIZE / grid_spacing));
-    int workgroups = static_cast<int>(std::ceil(grid_steps / 8.0));
-    
-    int buffer_size = 4 + (MAX_PLACEMENTS * sizeof(PlacementData));
-    PackedByteArray initial_data;
-    initial_data.resize(buffer_size);
-    memset(initial_data.ptrw(), 0, buffer_size);
+    return buffer;
+}
+
+bool NativeVegetationDispatcher::find_packed_placements(const Vector3i& chunk, int type, PackedPlacements& r_packed) {
+    // Cached arrays first; otherwise one readback of the compacted buffer, cached for next time.
+    // An entry whose count is 0 has no buffer and yields empty arrays.
+    const ChunkTypePair key{chunk, type};
+    cache_mutex->lock();
+    PlacementCache::Entry* entry = placement_cache.find(key);
+    bool known = entry != nullptr;
+    bool ready = known && (entry->has_packed || entry->placement_count == 0);
+    if (ready) {
+        r_packed = entry->has_packed ? entry->packed : PackedPlacements();
+    }
+    cache_mutex->unlock();
     
-    RID storage_buffer = rd->storage_buffer_create(buffer_size, initial_data);
+    if (!known) {
+        return false;
+    }
+    if (ready) {
+        return true;
+    }
     
-    Array uniforms;
+    bool found = false;
+    run_on_worker([&]() {
+        cache_mutex->lock();
+        // Looked up again on the worker: the pair may have been evicted meanwhile
+        const PlacementCache::Entry* current = placement_cache.peek(key);
+        RID placement_buffer = current ? current->placement_buffer : RID();
+        cache_mutex->unlock();
+        
+        if (!placement_buffer.is_valid()) {
+            return;
+        }
+        
+        PackedByteArray data = rd->buffer_get_data(placement_buffer);
+        uint64_t decode_start_us = Time::get_singleton()->get_ticks_usec();
+        PackedPlacements decoded = decode_placements_packed(data);
+        const uint64_t decode_end_us = Time::get_singleton()->get_ticks_usec();
+        decode_time_us += decode_end_us - decode_start_us;
+        TraceRecorder::record("vegetation", "placement_decode", decode_start_us, decode_end_us, chunk, 0, (int)decoded.positions.size());
+        decode_calls++;
+        
+        // Only the worker replaces entries, so the buffer read above is still the cached one
+        cache_mutex->lock();
+        PlacementCache::Entry* target = placement_cache.peek(key);
+        if (target) {
+            target->packed = decoded;
+            target->has_packed = true;
+        }
+        cache_mutex->unlock();
+        
+        r_packed = decoded;
+        found = true;
+    });
     
-    {
-        Ref<RDUniform> uniform;
-        uniform.instantiate();
-        uniform->set_uniform_type(RenderingDevice::UNIFORM_TYPE_SAMPLER_WITH_TEXTURE);
-        uniform->set_binding(0);
-        uniform->add_id(cached_sampler_linear);
-        uniform->add_id(terrain_sdf_texture);
-        uniforms.push_back(uniform);
+    return found;
+}
+
+bool NativeVegetationDispatcher::needs_replacement(const ChunkTypePair& key) {
+    // Dirty entries keep being served while their replacement is queued or in flight
+    queue_mutex->lock();
+    bool pending = pending_keys.find(key) != pending_keys.end();
+    queue_mutex->unlock();
+    if (pending) {
+        return false;
     }
     
-    {
-        Ref<RDUniform> uniform;
-        uniform.instantiate();
-        uniform->set_uniform_type(RenderingDevice::UNIFORM_TYPE_SAMPLER_WITH_TEXTURE);
-        uniform->set_binding(1);
-        uniform->add_id(cached_sampler_linear);
-        uniform->add_id(biome_map_texture);
-        uniforms.push_back(uniform);
-    }
+    cache_mutex->lock();
+    const PlacementCache::Entry* entry = placement_cache.peek(key);
+    bool dirty = entry && entry->dirty;
+    cache_mutex->unlock();
+    return dirty;
+}
+
+bool NativeVegetationDispatcher::make_placement_request(PlacementRequest& r_request, Vector3i chunk_origin, int veg_type, float density,
+        float grid_spacing, float noise_frequency, float slope_max, const Dictionary& height_range,
+        int world_seed, RID biome_map_texture) {
+    PlacementParams params;
+    params.density = density;
+    params.grid_spacing = grid_spacing;
+    params.noise_frequency = noise_frequency;
+    params.slope_max = slope_max;
+    // Comment 4 fix: Align defaults with GDScript dispatcher
+    params.height_min = height_range.get("min", -100.0f);
+    params.height_max = height_range.get("max", 500.0f);
+    params.world_seed = world_seed;
+    params.biome_map_texture = biome_map_texture;
+    return make_placement_request(r_request, ChunkTypePair{chunk_origin, veg_type}, params);
+}
+
+bool NativeVegetationDispatcher::make_placement_request(PlacementRequest& r_request, const ChunkTypePair& key, const PlacementParams& params) {
+    // A terrain generator on the shared device provides both textures when the batch runs
+    // Without a biome map (caller's or shared), the placeholder fills binding 1 when the batch runs
+    const bool shared_terrain = gpu_context && gpu_context->has_chunk_texture_provider();
     
-    {
-        Ref<RDUniform> uniform;
-        uniform.instantiate();
-        uniform->set_uniform_type(RenderingDevice::UNIFORM_TYPE_STORAGE_BUFFER);
-        uniform->set_binding(2);
-        uniform->add_id(storage_buffer);
-        uniforms.push_back(uniform);
+    // Otherwise resolved here, on the caller's thread: the terrain dispatcher is a script object
+    RID terrain_sdf_texture;
+    if (!shared_terrain && terrain_dispatcher) {
+        terrain_sdf_texture = terrain_dispatcher->call("get_sdf_texture_for_chunk", key.chunk);
     }
     
-    RID uniform_set = rd->uniform_set_create(uniforms, shader, 0);
-    
-    if (!uniform_set.is_valid()) {
-        UtilityFunctions::push_warning("NativeVegetationDispatcher: Failed to create uniform set");
-        rd->free_rid(storage_buffer);
-        return Array();
+    if (!terrain_sdf_texture.is_valid() && !shared_terrain) {
+        return false;
     }
     
+    r_request.key = key;
+    r_request.params = params;
+    r_request.terrain_sdf_texture = terrain_sdf_texture;
+    r_request.notify = false;
+    r_request.priority = 0.0f;
+    r_request.request_time_us = Time::get_singleton()->get_ticks_usec();
+    return true;
+}
+
+PackedByteArray NativeVegetationDispatcher::build_push_constants(const PlacementRequest& request) const {
     PackedByteArray push_constants;
     push_constants.resize(56);
     uint8_t* pc_data = push_constants.ptrw();
     size_t pc_offset = 0;
     
     // Convert chunk_origin ints to floats for shader (Comment 1 fix)
-    float chunk_x = static_cast<float>(chunk_origin.x);
-    float chunk_y = static_cast<float>(chunk_origin.y);
-    float chunk_z = static_cast<float>(chunk_origin.z);
+    float chunk_x = static_cast<float>(request.key.chunk.x);
+    float chunk_y = static_cast<float>(request.key.chunk.y);
+    float chunk_z = static_cast<float>(request.key.chunk.z);
     
     memcpy(pc_data + pc_offset, &chunk_x, sizeof(float));
     pc_offset += sizeof(float);
@@ -403,259 +599,458 @@ Array NativeVegetationDispatcher::generate_placements(
     pc_offset += sizeof(float);
     memcpy(pc_data + pc_offset, &chunk_z, sizeof(float));
     pc_offset += sizeof(float);
-    memcpy(pc_data + pc_offset, &grid_spacing, sizeof(float));
+    memcpy(pc_data + pc_offset, &request.params.grid_spacing, sizeof(float));
     pc_offset += sizeof(float);
     
     int chunk_size = CHUNK_SIZE;
+    int grid_steps = get_grid_steps(request.params.grid_spacing);
     memcpy(pc_data + pc_offset, &chunk_size, sizeof(int));
     pc_offset += sizeof(int);
     memcpy(pc_data + pc_offset, &grid_steps, sizeof(int));
     pc_offset += sizeof(int);
-    uint32_t seed_u32 = static_cast<uint32_t>(world_seed);
+    uint32_t seed_u32 = static_cast<uint32_t>(request.params.world_seed);
     memcpy(pc_data + pc_offset, &seed_u32, sizeof(uint32_t));
     pc_offset += sizeof(uint32_t);
-    memcpy(pc_data + pc_offset, &veg_type, sizeof(int));
+    memcpy(pc_data + pc_offset, &request.key.type, sizeof(int));
     pc_offset += sizeof(int);
     
-    memcpy(pc_data + pc_offset, &density, sizeof(float));
+    memcpy(pc_data + pc_offset, &request.params.density, sizeof(float));
     pc_offset += sizeof(float);
-    memcpy(pc_data + pc_offset, &noise_frequency, sizeof(float));
+    memcpy(pc_data + pc_offset, &request.params.noise_frequency, sizeof(float));
     pc_offset += sizeof(float);
-    memcpy(pc_data + pc_offset, &slope_max, sizeof(float));
+    memcpy(pc_data + pc_offset, &request.params.slope_max, sizeof(float));
     pc_offset += sizeof(float);
     
-    // Comment 4 fix: Align defaults with GDScript dispatcher
-    float height_min = height_range.get("min", -100.0f);
-    float height_max = height_range.get("max", 500.0f);
-    memcpy(pc_data + pc_offset, &height_min, sizeof(float));
+    memcpy(pc_data + pc_offset, &request.params.height_min, sizeof(float));
     pc_offset += sizeof(float);
-    memcpy(pc_data + pc_offset, &height_max, sizeof(float));
+    memcpy(pc_data + pc_offset, &request.params.height_max, sizeof(float));
     pc_offset += sizeof(float);
     
-    uint64_t start_time = Time::get_singleton()->get_ticks_usec();
-    
-    int64_t compute_list = rd->compute_list_begin();
-    rd->compute_list_bind_compute_pipeline(compute_list, pipeline);
-    rd->compute_list_bind_uniform_set(compute_list, uniform_set, 0);
-    rd->compute_list_set_push_constant(compute_list, push_constants, push_constants.size());
-    rd->compute_list_dispatch(compute_list, workgroups, 1, workgroups);
-    rd->compute_list_end();
-    
-    rd->submit();
-    rd->sync();
-    
-    uint64_t end_time = Time::get_singleton()->get_ticks_usec();
-    uint64_t elapsed_us = end_time - start_time;
-    
-    last_placement_time_us = elapsed_us;
-    total_placement_time_us += elapsed_us;
-    placement_call_count++;
-    
-    if (!timing_per_type.has(veg_type)) {
-        Dictionary type_stats;
-        type_stats["total_ms"] = 0.0;
-        type_stats["count"] = 0;
-        type_stats["avg_ms"] = 0.0;
-        timing_per_type[veg_type] = type_stats;
+    return push_constants;
+}
+
+bool NativeVegetationDispatcher::resolve_request_textures(PlacementRequest& r_request) {
+    // Device thread, while the batch is recorded: the generator cannot recycle these textures
+    // before this batch's sync. The shared biome map wins over the caller's, which cannot live on
+    // this device anyway.
+    RID shared_sdf = gpu_context->get_chunk_sdf_texture(r_request.key.chunk, CHUNK_SIZE);
+    if (shared_sdf.is_valid()) {
+        r_request.terrain_sdf_texture = shared_sdf;
+        shared_terrain_passes++;
     }
-    
-    Dictionary type_stats = timing_per_type[veg_type];
-    double total_ms = type_stats["total_ms"];
-    int count = type_stats["count"];
-    
-    total_ms += elapsed_us / 1000.0;
-    count++;
-    
-    type_stats["total_ms"] = total_ms;
-    type_stats["count"] = count;
-    type_stats["avg_ms"] = total_ms / count;
-    timing_per_type[veg_type] = type_stats;
-    
-    // GPU-only mode optimization: skip CPU readback when cpu_fallback is false
-    Array placements;
-    
-    cache_mutex->lock();
-    
-    // Always cache the buffer RID for GPU path
-    buffer_cache[chunk_origin][veg_type] = storage_buffer;
-    
-    // Only perform CPU readback if cpu_fallback is true
-    if (cpu_fallback) {
-        PackedByteArray buffer_data = rd->buffer_get_data(storage_buffer);
-        placements = decode_placements(buffer_data);
-        placement_cache[chunk_origin][veg_type] = placements;
-    } else {
-        // GPU-only mode: cache empty array to signal GPU mode
-        placement_cache[chunk_origin][veg_type] = Array();
+    RID shared_biome = gpu_context->get_biome_map_texture();
+    if (shared_biome.is_valid()) {
+        r_request.params.biome_map_texture = shared_biome;
+    } else if (!r_request.params.biome_map_texture.is_valid()) {
+        r_request.params.biome_map_texture = placeholder_biome_map;
     }
+    return r_request.terrain_sdf_texture.is_valid() && r_request.params.biome_map_texture.is_valid();
+}
+
+RID NativeVegetationDispatcher::create_placement_uniform_set(const PlacementRequest& request, RID storage_buffer, RID args_buffer) {
+    Array uniforms;
     
-    update_lru_access(chunk_origin, veg_type);
-    
-    int cache_size = 0;
-    for (const auto& chunk_pair : placement_cache) {
-        cache_size += chunk_pair.second.size();
+    {
+        Ref<RDUniform> uniform;
+        uniform.instantiate();
+        uniform->set_uniform_type(RenderingDevice::UNIFORM_TYPE_SAMPLER_WITH_TEXTURE);
+        uniform->set_binding(0);
+        uniform->add_id(cached_sampler_linear);
+        uniform->add_id(request.terrain_sdf_texture);
+        uniforms.push_back(uniform);
     }
     
-    while (cache_size > max_cache_entries) {
-        evict_lru_entry();
-        cache_size--;
+    {
+        Ref<RDUniform> uniform;
+        uniform.instantiate();
+        uniform->set_uniform_type(RenderingDevice::UNIFORM_TYPE_SAMPLER_WITH_TEXTURE);
+        uniform->set_binding(1);
+        uniform->add_id(cached_sampler_linear);
+        uniform->add_id(request.params.biome_map_texture);
+        uniforms.push_back(uniform);
     }
     
-    cache_mutex->unlock();
-    
-    rd->free_rid(uniform_set);
-    
-    return placements;
-}
-
-bool NativeVegetationDispatcher::is_chunk_ready(Vector3i chunk_origin, int veg_type) {
-    cache_mutex->lock();
-    bool ready = false;
+    {
+        Ref<RDUniform> uniform;
+        uniform.instantiate();
+        uniform->set_uniform_type(RenderingDevice::UNIFORM_TYPE_STORAGE_BUFFER);
+        uniform->set_binding(2);
+        uniform->add_id(storage_buffer);
+        uniforms.push_back(uniform);
+    }
     
-    auto chunk_it = placement_cache.find(chunk_origin);
-    if (chunk_it != placement_cache.end()) {
-        ready = chunk_it->second.find(veg_type) != chunk_it->second.end();
+    {
+        Ref<RDUniform> uniform;
+        uniform.instantiate();
+        uniform->set_uniform_type(RenderingDevice::UNIFORM_TYPE_STORAGE_BUFFER);
+        uniform->set_binding(3);
+        uniform->add_id(args_buffer);
+        uniforms.push_back(uniform);
     }
     
-    cache_mutex->unlock();
-    return ready;
+    return rd->uniform_set_create(uniforms, shader, 0);
 }
 
-bool NativeVegetationDispatcher::is_gpu_ready(Vector3i chunk_origin, int veg_type) {
-    cache_mutex->lock();
-    bool ready = false;
-    
-    // Check if both placement buffer and transform buffer exist
-    auto buffer_it = buffer_cache.find(chunk_origin);
-    if (buffer_it != buffer_cache.end()) {
-        auto type_it = buffer_it->second.find(veg_type);
-        if (type_it != buffer_it->second.end() && type_it->second.is_valid()) {
-            auto transform_it = transform_buffer_cache.find(chunk_origin);
-            if (transform_it != transform_buffer_cache.end()) {
-                auto transform_type_it = transform_it->second.find(veg_type);
-                ready = transform_type_it != transform_it->second.end() && transform_type_it->second.is_valid();
+void NativeVegetationDispatcher::run_placement_batch(const std::vector<PlacementRequest>& requests) {
+    const int request_count = (int)requests.size();
+    TraceSpan span("vegetation", "placement_batch");
+    span.set_count(request_count);
+    
+    if (!ensure_scratch_buffers()) {
+        UtilityFunctions::push_warning("NativeVegetationDispatcher: Failed to create scratch buffers");
+        queue_mutex->lock();
+        for (const PlacementRequest& request : requests) {
+            pending_keys.erase(request.key);
+            if (request.notify) {
+                ready_placements.push_back({ request.key, -1 });
             }
         }
+        queue_mutex->unlock();
+        return;
     }
     
-    cache_mutex->unlock();
-    return ready;
-}
-
-void NativeVegetationDispatcher::clear_cache() {
-    cache_mutex->lock();
+    // Indirect args start as an empty dispatch: (0, 1, 1) workgroups, 0 instances
+    PackedByteArray initial_args;
+    initial_args.resize(INDIRECT_ARGS_SIZE);
+    const uint32_t args_init[4] = { 0, 1, 1, 0 };
+    memcpy(initial_args.ptrw(), args_init, INDIRECT_ARGS_SIZE);
     
-    for (auto& chunk_pair : buffer_cache) {
-        for (auto& type_pair : chunk_pair.second) {
-            if (type_pair.second.is_valid()) {
-                rd->free_rid(type_pair.second);
-            }
-        }
-    }
+    std::vector<RID> args_buffers(request_count);
+    std::vector<RID> uniform_sets(request_count);
+    std::vector<bool> valid(request_count, false);
+    int dispatched = 0;
     
-    for (auto& chunk_pair : transform_buffer_cache) {
-        for (auto& type_pair : chunk_pair.second) {
-            if (type_pair.second.is_valid()) {
-                rd->free_rid(type_pair.second);
-            }
-        }
+    uint64_t start_time = Time::get_singleton()->get_ticks_usec();
+    
+    // Scratch slot i serves request i. Only the header needs resetting (placement_count = 0):
+    // the pass never reads slots past the count it reserves
+    for (int i = 0; i < request_count; i++) {
+        rd->buffer_clear(scratch_placement_buffers[i], 0, PLACEMENT_HEADER_SIZE);
     }
     
-    placement_cache.clear();
-    buffer_cache.clear();
-    transform_buffer_cache.clear();
-    lru_list.clear();
-    lru_map.clear();
+    // Textures are resolved before recording: the generator applies pending terrain edits to a
+    // chunk's texture when it is looked up, which needs the device outside a compute list
+    std::vector<PlacementRequest> resolved(requests);
+    std::vector<bool> has_textures(request_count, false);
+    for (int i = 0; i < request_count; i++) {
+        has_textures[i] = resolve_request_textures(resolved[i]);
+    }
     
-    cache_mutex->unlock();
-}
-
-RID NativeVegetationDispatcher::get_placement_buffer_rid(Vector3i chunk_origin, int veg_type) {
-    cache_mutex->lock();
-    
-    auto chunk_it = buffer_cache.find(chunk_origin);
-    if (chunk_it != buffer_cache.end()) {
-        auto type_it = chunk_it->second.find(veg_type);
-        if (type_it != chunk_it->second.end()) {
-            RID buffer = type_it->second;
-            cache_mutex->unlock();
-            return buffer;
+    // Every request of the batch goes into one compute list and one submit
+    int64_t compute_list = rd->compute_list_begin();
+    rd->compute_list_bind_compute_pipeline(compute_list, pipeline);
+    for (int i = 0; i < request_count; i++) {
+        // Chunks the generator has no texture for (not cached, or uniform air/solid) produce nothing
+        if (!has_textures[i]) {
+            continue;
+        }
+        const PlacementRequest& request = resolved[i];
+        
+        args_buffers[i] = rd->storage_buffer_create(INDIRECT_ARGS_SIZE, initial_args, RenderingDevice::STORAGE_BUFFER_USAGE_DISPATCH_INDIRECT);
+        if (args_buffers[i].is_valid()) {
+            uniform_sets[i] = create_placement_uniform_set(request, scratch_placement_buffers[i], args_buffers[i]);
+        }
+        if (!uniform_sets[i].is_valid()) {
+            UtilityFunctions::push_warning("NativeVegetationDispatcher: Failed to create uniform set");
+            if (args_buffers[i].is_valid()) {
+                rd->free_rid(args_buffers[i]);
+            }
+            args_buffers[i] = RID();
+            continue;
         }
+        valid[i] = true;
+        
+        PackedByteArray push_constants = build_push_constants(request);
+        int workgroups = static_cast<int>(std::ceil(get_grid_steps(request.params.grid_spacing) / 8.0));
+        
+        rd->compute_list_bind_uniform_set(compute_list, uniform_sets[i], 0);
+        rd->compute_list_set_push_constant(compute_list, push_constants, push_constants.size());
+        rd->compute_list_dispatch(compute_list, workgroups, 1, workgroups);
+        dispatched++;
     }
     
-    cache_mutex->unlock();
-    return RID();
-}
-
-int NativeVegetationDispatcher::get_placement_count(Vector3i chunk_origin, int veg_type) {
-    RID buffer = get_placement_buffer_rid(chunk_origin, veg_type);
-    
-    if (!buffer.is_valid()) {
-        return 0;
+    // Transforms follow in the same list, sized by the args the placement dispatches just wrote:
+    // no sync or count readback between the two passes
+    std::vector<int> transform_owners;
+    std::vector<RID> transform_sets;
+    std::vector<bool> has_scratch_transforms(request_count, false);
+    if (transform_pipeline.is_valid()) {
+        std::vector<RID> transform_sources;
+        std::vector<RID> transform_args;
+        std::vector<RID> transform_targets;
+        for (int i = 0; i < request_count; i++) {
+            if (requests[i].params.build_transforms && valid[i]) {
+                transform_sources.push_back(scratch_placement_buffers[i]);
+                transform_args.push_back(args_buffers[i]);
+                transform_targets.push_back(scratch_transform_buffers[i]);
+                transform_owners.push_back(i);
+            }
+        }
+        if (!transform_sources.empty()) {
+            rd->compute_list_add_barrier(compute_list);
+            record_transform_dispatches(compute_list, transform_sources, transform_args, transform_targets, transform_sets);
+            for (size_t t = 0; t < transform_owners.size(); t++) {
+                has_scratch_transforms[transform_owners[t]] = transform_sets[t].is_valid();
+            }
+        }
     }
+    rd->compute_list_end();
     
-    PackedByteArray count_data = rd->buffer_get_data(buffer, 0, 4);
+    // This is the device thread: the wait only holds back other passes on the shared device
+    if (dispatched > 0) {
+        TraceSpan gpu_span("vegetation", "placement_batch_gpu");
+        gpu_span.set_count(dispatched);
+        rd->submit();
+        rd->sync();
+    }
     
-    if (count_data.size() < 4) {
-        return 0;
+    for (int i = 0; i < request_count; i++) {
+        if (uniform_sets[i].is_valid()) {
+            rd->free_rid(uniform_sets[i]);
+        }
+    }
+    for (const RID& set : transform_sets) {
+        if (set.is_valid()) {
+            rd->free_rid(set);
+        }
     }
     
-    uint32_t count;
-    memcpy(&count, count_data.ptr(), sizeof(uint32_t));
+    // The device is already synced: the count comes from the 16-byte args buffer, then
+    // cpu_readback reads only the occupied part of the scratch buffer
+    std::vector<uint32_t> counts(request_count, 0);
+    std::vector<Array> placements(request_count);
+    std::vector<PackedPlacements> packed(request_count);
     
-    return static_cast<int>(count);
-}
-
-RID NativeVegetationDispatcher::get_transform_buffer_rid(Vector3i chunk_origin, int veg_type) {
-    cache_mutex->lock();
+    for (int i = 0; i < request_count; i++) {
+        if (!valid[i]) {
+            continue;
+        }
+        
+        PackedByteArray args = rd->buffer_get_data(args_buffers[i]);
+        if (args.size() >= INDIRECT_ARGS_SIZE) {
+            memcpy(&counts[i], args.ptr() + 12, sizeof(uint32_t));
+        }
+        counts[i] = std::min<uint32_t>(counts[i], MAX_PLACEMENTS);
+        
+        if ((requests[i].params.cpu_readback || requests[i].params.packed_readback) && counts[i] > 0) {
+            TraceSpan readback_span("vegetation", "placement_readback", requests[i].key.chunk, 0);
+            readback_span.set_count((int)counts[i]);
+            PackedByteArray data = rd->buffer_get_data(scratch_placement_buffers[i], 0, PLACEMENT_HEADER_SIZE + counts[i] * sizeof(PlacementData));
+            uint64_t decode_start_us = Time::get_singleton()->get_ticks_usec();
+            if (requests[i].params.cpu_readback) {
+                placements[i] = decode_placements(data);
+            }
+            if (requests[i].params.packed_readback) {
+                packed[i] = decode_placements_packed(data);
+            }
+            const uint64_t decode_end_us = Time::get_singleton()->get_ticks_usec();
+            decode_time_us += decode_end_us - decode_start_us;
+            TraceRecorder::record("vegetation", "placement_decode", decode_start_us, decode_end_us, requests[i].key.chunk, 0, (int)counts[i]);
+            decode_calls++;
+        }
+    }
     
-    // Check if transform buffer already exists
-    auto chunk_it = transform_buffer_cache.find(chunk_origin);
-    if (chunk_it != transform_buffer_cache.end()) {
-        auto type_it = chunk_it->second.find(veg_type);
-        if (type_it != chunk_it->second.end()) {
-            RID buffer = type_it->second;
-            cache_mutex->unlock();
-            return buffer;
+    // Compaction: results move out of the scratch slots into buffers of exactly the occupied size,
+    // so a sparse desert chunk holds a few KiB instead of a full 192 KiB slot. Empty results keep
+    // only their count.
+    std::vector<RID> placement_buffers(request_count);
+    std::vector<RID> transform_buffers(request_count);
+    std::vector<uint64_t> entry_bytes(request_count, 0);
+    int copies = 0;
+    const uint64_t compaction_start_us = TraceRecorder::is_enabled() ? TraceRecorder::now_us() : 0;
+    
+    for (int i = 0; i < request_count; i++) {
+        if (!valid[i] || counts[i] == 0) {
+            continue;
         }
+        
+        const uint32_t placement_bytes = PLACEMENT_HEADER_SIZE + counts[i] * sizeof(PlacementData);
+        placement_buffers[i] = rd->storage_buffer_create(placement_bytes);
+        if (!placement_buffers[i].is_valid()) {
+            UtilityFunctions::push_warning("NativeVegetationDispatcher: Failed to create compact placement buffer");
+            valid[i] = false;
+            continue;
+        }
+        rd->buffer_copy(scratch_placement_buffers[i], placement_buffers[i], 0, 0, placement_bytes);
+        entry_bytes[i] += placement_bytes;
+        copies++;
+        
+        if (has_scratch_transforms[i]) {
+            const uint32_t transform_bytes = counts[i] * 12 * sizeof(float);
+            transform_buffers[i] = rd->storage_buffer_create(transform_bytes);
+            if (transform_buffers[i].is_valid()) {
+                rd->buffer_copy(scratch_transform_buffers[i], transform_buffers[i], 0, 0, transform_bytes);
+                entry_bytes[i] += transform_bytes;
+            }
+        }
+        
+        compacted_bytes_saved += (uint64_t)(PLACEMENT_HEADER_SIZE + MAX_PLACEMENTS * sizeof(PlacementData)) - placement_bytes;
     }
     
-    cache_mutex->unlock();
+    // The copies go out together; the scratch slots are free again once this returns
+    if (copies > 0) {
+        rd->submit();
+        rd->sync();
+    }
+    if (compaction_start_us != 0) {
+        TraceRecorder::record("vegetation", "placement_compaction", compaction_start_us, TraceRecorder::now_us(), Vector3i(), -1, copies);
+    }
     
-    // Get placement buffer
-    RID placement_buffer = get_placement_buffer_rid(chunk_origin, veg_type);
-    if (!placement_buffer.is_valid()) {
-        return RID();
+    uint64_t elapsed_us = Time::get_singleton()->get_ticks_usec() - start_time;
+    
+    // No transform pipeline: CPU-built transforms from the compacted buffers
+    std::vector<RID> fallback_sources;
+    std::vector<RID> fallback_args;
+    std::vector<uint32_t> fallback_counts;
+    std::vector<int> fallback_owners;
+    for (int i = 0; i < request_count; i++) {
+        if (requests[i].params.build_transforms && !transform_pipeline.is_valid() && placement_buffers[i].is_valid()) {
+            fallback_sources.push_back(placement_buffers[i]);
+            fallback_args.push_back(args_buffers[i]);
+            fallback_counts.push_back(counts[i]);
+            fallback_owners.push_back(i);
+        }
+    }
+    if (!fallback_sources.empty()) {
+        std::vector<RID> fallback_built;
+        create_transform_buffers(fallback_sources, fallback_args, fallback_counts, fallback_built);
+        for (size_t t = 0; t < fallback_built.size(); t++) {
+            const int owner = fallback_owners[t];
+            transform_buffers[owner] = fallback_built[t];
+            if (fallback_built[t].is_valid()) {
+                entry_bytes[owner] += counts[owner] * 12 * sizeof(float);
+            }
+        }
     }
     
-    // Read placement count (minimal readback)
-    PackedByteArray count_data = rd->buffer_get_data(placement_buffer, 0, 4);
-    if (count_data.size() < 4) {
-        return RID();
+    for (int i = 0; i < request_count; i++) {
+        if (!valid[i] && args_buffers[i].is_valid()) {
+            rd->free_rid(args_buffers[i]);
+            args_buffers[i] = RID();
+        } else if (valid[i]) {
+            entry_bytes[i] += INDIRECT_ARGS_SIZE;
+        }
     }
     
-    uint32_t placement_count;
-    memcpy(&placement_count, count_data.ptr(), sizeof(uint32_t));
+    const uint64_t per_request_us = dispatched > 0 ? elapsed_us / dispatched : 0;
+    const uint64_t now_us = Time::get_singleton()->get_ticks_usec();
     
-    if (placement_count == 0 || placement_count > MAX_PLACEMENTS) {
-        return RID();
-    }
+    batches_submitted++;
+    last_batch_size = dispatched;
+    last_batch_gpu_time_us = elapsed_us;
+    last_placement_time_us = per_request_us;
+    total_placement_time_us += elapsed_us;
+    placement_call_count += dispatched;
     
-    // Use GPU compute shader for transform generation if available
-    if (transform_pipeline.is_valid()) {
-        // Create output transform buffer (12 floats per instance)
-        size_t transform_buffer_size = placement_count * 12 * sizeof(float);
-        PackedByteArray initial_transform_data;
-        initial_transform_data.resize(transform_buffer_size);
-        memset(initial_transform_data.ptrw(), 0, transform_buffer_size);
+    std::vector<PlacementCache::Entry> removed;
+    cache_mutex->lock();
+    for (int i = 0; i < request_count; i++) {
+        if (!valid[i]) {
+            continue;
+        }
+        const ChunkTypePair& key = requests[i].key;
         
-        RID transform_buffer = rd->storage_buffer_create(transform_buffer_size, initial_transform_data);
+        PlacementCache::Entry entry;
+        entry.placements = placements[i];  // GPU-only mode: empty array
+        entry.packed = packed[i];
+        entry.has_packed = requests[i].params.packed_readback;
+        entry.placement_buffer = placement_buffers[i];
+        entry.transform_buffer = transform_buffers[i];
+        entry.args_buffer = args_buffers[i];
+        entry.placement_count = (int)counts[i];
+        entry.gpu_bytes = entry_bytes[i];
+        entry.params = requests[i].params;  // The caller's textures, not the resolved ones
+        // A synchronous call may have produced the same pair meanwhile: its buffers are retired
+        placement_cache.insert(key, entry, removed);
         
-        if (!transform_buffer.is_valid()) {
-            UtilityFunctions::push_warning("NativeVegetationDispatcher: Failed to create transform buffer");
-            return RID();
+        if (!timing_per_type.has(key.type)) {
+            Dictionary type_stats;
+            type_stats["total_ms"] = 0.0;
+            type_stats["count"] = 0;
+            type_stats["avg_ms"] = 0.0;
+            timing_per_type[key.type] = type_stats;
         }
         
+        Dictionary type_stats = timing_per_type[key.type];
+        double total_ms = type_stats["total_ms"];
+        int count = type_stats["count"];
+        
+        total_ms += per_request_us / 1000.0;
+        count++;
+        
+        type_stats["total_ms"] = total_ms;
+        type_stats["count"] = count;
+        type_stats["avg_ms"] = total_ms / count;
+        timing_per_type[key.type] = type_stats;
+        
+        uint64_t latency_us = now_us - requests[i].request_time_us;
+        TraceRecorder::record("vegetation", "placement_request", requests[i].request_time_us, now_us, key.chunk, 0, (int)counts[i]);
+        uint64_t avg = avg_request_latency_us.load();
+        avg_request_latency_us = avg == 0 ? latency_us : (avg * 7 + latency_us) / 8;
+    }
+    
+    // Entry limit and byte budget; running totals, so no walk over the cache
+    placement_cache.evict_to_fit(max_cache_entries, (uint64_t)std::max<int64_t>(max_cache_bytes, 0), removed);
+    cache_mutex->unlock();
+    
+    retire_entries(removed);
+    free_retired_buffers(false);
+    
+    std::vector<ChunkTypePair> requeued;
+    queue_mutex->lock();
+    for (int i = 0; i < request_count; i++) {
+        auto pending = pending_keys.find(requests[i].key);
+        const bool rerun = pending != pending_keys.end() && pending->second;
+        if (rerun) {
+            // The terrain was edited while this pass was pending and may have been sampled before
+            // the edit: place again and report only the rerun
+            PlacementRequest again = requests[i];
+            again.notify = true;
+            again.priority = 0.0f;
+            pending->second = false;
+            request_queue.push(again);
+            edit_reruns++;
+            requeued.push_back(requests[i].key);
+            continue;
+        }
+        if (pending != pending_keys.end()) {
+            pending_keys.erase(pending);
+        }
+        if (requests[i].notify) {
+            // -1: the pass could not run (uniform set or buffer creation failed)
+            int reported = valid[i] ? (int)counts[i] : -1;
+            ready_placements.push_back({ requests[i].key, reported });
+        }
+    }
+    queue_mutex->unlock();
+    
+    if (!requeued.empty()) {
+        cache_mutex->lock();
+        for (const ChunkTypePair& key : requeued) {
+            PlacementCache::Entry* entry = placement_cache.peek(key);
+            if (entry) {
+                entry->dirty = true;
+            }
+        }
+        cache_mutex->unlock();
+        gpu_context->wake();
+    }
+}
+
+int NativeVegetationDispatcher::record_transform_dispatches(int64_t compute_list, const std::vector<RID>& placement_buffers, const std::vector<RID>& args_buffers,
+        const std::vector<RID>& transform_buffers, std::vector<RID>& r_uniform_sets) {
+    const int buffer_count = (int)placement_buffers.size();
+    r_uniform_sets.assign(buffer_count, RID());
+    int dispatched = 0;
+    
+    rd->compute_list_bind_compute_pipeline(compute_list, transform_pipeline);
+    
+    // Push constants: instance_count 0 makes the shader take the count the placement pass wrote
+    PackedByteArray push_constants;
+    push_constants.resize(16);  // uint + padding
+    memset(push_constants.ptrw(), 0, 16);
+    
+    for (int i = 0; i < buffer_count; i++) {
         // Create uniform set for transform shader
         Array uniforms;
         
@@ -665,112 +1060,786 @@ RID NativeVegetationDispatcher::get_transform_buffer_rid(Vector3i chunk_origin,
             uniform.instantiate();
             uniform->set_uniform_type(RenderingDevice::UNIFORM_TYPE_STORAGE_BUFFER);
             uniform->set_binding(0);
-            uniform->add_id(placement_buffer);
+            uniform->add_id(placement_buffers[i]);
             uniforms.push_back(uniform);
         }
         
-        // Binding 1: Output transform buffer (writeonly)
+        // Binding 1: Output transform buffer (writeonly, 12 floats per instance)
         {
             Ref<RDUniform> uniform;
             uniform.instantiate();
             uniform->set_uniform_type(RenderingDevice::UNIFORM_TYPE_STORAGE_BUFFER);
             uniform->set_binding(1);
-            uniform->add_id(transform_buffer);
+            uniform->add_id(transform_buffers[i]);
             uniforms.push_back(uniform);
         }
         
-        RID uniform_set = rd->uniform_set_create(uniforms, transform_shader, 0);
+        r_uniform_sets[i] = rd->uniform_set_create(uniforms, transform_shader, 0);
         
-        if (!uniform_set.is_valid()) {
+        if (!r_uniform_sets[i].is_valid()) {
             UtilityFunctions::push_warning("NativeVegetationDispatcher: Failed to create transform uniform set");
-            rd->free_rid(transform_buffer);
-            return RID();
+            continue;
         }
         
-        // Push constants: instance count
-        PackedByteArray push_constants;
-        push_constants.resize(16);  // uint + padding
-        uint8_t* pc_data = push_constants.ptrw();
-        memcpy(pc_data, &placement_count, sizeof(uint32_t));
-        
-        // Dispatch compute shader
-        int workgroups = static_cast<int>(std::ceil(placement_count / 64.0));
+        rd->compute_list_bind_uniform_set(compute_list, r_uniform_sets[i], 0);
+        rd->compute_list_set_push_constant(compute_list, push_constants, push_constants.size());
+        rd->compute_list_dispatch_indirect(compute_list, args_buffers[i], 0);
+        dispatched++;
+    }
+    
+    return dispatched;
+}
+
+void NativeVegetationDispatcher::create_transform_buffers(const std::vector<RID>& placement_buffers, const std::vector<RID>& args_buffers, const std::vector<uint32_t>& counts, std::vector<RID>& r_transform_buffers) {
+    const int buffer_count = (int)placement_buffers.size();
+    r_transform_buffers.assign(buffer_count, RID());
+    
+    // Use GPU compute shader for transform generation if available
+    if (transform_pipeline.is_valid()) {
+        // Sized to the known count; every instance is written by the shader
+        std::vector<RID> targets(buffer_count);
+        for (int i = 0; i < buffer_count; i++) {
+            targets[i] = rd->storage_buffer_create(counts[i] * 12 * sizeof(float));
+            if (!targets[i].is_valid()) {
+                UtilityFunctions::push_warning("NativeVegetationDispatcher: Failed to create transform buffer");
+            }
+        }
         
+        std::vector<RID> uniform_sets(buffer_count);
+        int dispatched = 0;
         int64_t compute_list = rd->compute_list_begin();
-        rd->compute_list_bind_compute_pipeline(compute_list, transform_pipeline);
-        rd->compute_list_bind_uniform_set(compute_list, uniform_set, 0);
-        rd->compute_list_set_push_constant(compute_list, push_constants, push_constants.size());
-        rd->compute_list_dispatch(compute_list, workgroups, 1, 1);
+        {
+            std::vector<RID> sources;
+            std::vector<RID> args;
+            std::vector<RID> outputs;
+            std::vector<int> owners;
+            for (int i = 0; i < buffer_count; i++) {
+                if (targets[i].is_valid()) {
+                    sources.push_back(placement_buffers[i]);
+                    args.push_back(args_buffers[i]);
+                    outputs.push_back(targets[i]);
+                    owners.push_back(i);
+                }
+            }
+            std::vector<RID> sets;
+            dispatched = record_transform_dispatches(compute_list, sources, args, outputs, sets);
+            for (size_t t = 0; t < owners.size(); t++) {
+                uniform_sets[owners[t]] = sets[t];
+            }
+        }
         rd->compute_list_end();
         
-        rd->submit();
-        rd->sync();
+        if (dispatched > 0) {
+            rd->submit();
+            rd->sync();
+        }
+        
+        for (int i = 0; i < buffer_count; i++) {
+            if (uniform_sets[i].is_valid()) {
+                rd->free_rid(uniform_sets[i]);
+                r_transform_buffers[i] = targets[i];
+            } else if (targets[i].is_valid()) {
+                rd->free_rid(targets[i]);
+            }
+        }
+        return;
+    }
+    
+    // CPU fallback path (original implementation)
+    for (int b = 0; b < buffer_count; b++) {
+        uint32_t placement_count = counts[b];
+        size_t placement_data_size = placement_count * sizeof(PlacementData);
+        PackedByteArray placement_data = rd->buffer_get_data(placement_buffers[b], PLACEMENT_HEADER_SIZE, placement_data_size);
+        
+        if (placement_data.size() < placement_data_size) {
+            continue;
+        }
+        
+        size_t transform_buffer_size = placement_count * 12 * sizeof(float);
+        PackedByteArray transform_data;
+        transform_data.resize(transform_buffer_size);
+        
+        const PlacementData* placements = reinterpret_cast<const PlacementData*>(placement_data.ptr());
+        float* transforms = reinterpret_cast<float*>(transform_data.ptrw());
+        
+        for (uint32_t i = 0; i < placement_count; i++) {
+            const PlacementData& pd = placements[i];
+            
+            float cos_y = std::cos(pd.rotation_y);
+            float sin_y = std::sin(pd.rotation_y);
+            float scale = pd.scale;
+            
+            // Row 0: X basis (rotated and scaled)
+            transforms[i * 12 + 0] = cos_y * scale;
+            transforms[i * 12 + 1] = 0.0f;
+            transforms[i * 12 + 2] = sin_y * scale;
+            transforms[i * 12 + 3] = pd.position.x;
+            
+            // Row 1: Y basis (up, scaled)
+            transforms[i * 12 + 4] = 0.0f;
+            transforms[i * 12 + 5] = scale;
+            transforms[i * 12 + 6] = 0.0f;
+            transforms[i * 12 + 7] = pd.position.y;
+            
+            // Row 2: Z basis (rotated and scaled)
+            transforms[i * 12 + 8] = -sin_y * scale;
+            transforms[i * 12 + 9] = 0.0f;
+            transforms[i * 12 + 10] = cos_y * scale;
+            transforms[i * 12 + 11] = pd.position.z;
+        }
+        
+        RID transform_buffer = rd->storage_buffer_create(transform_buffer_size, transform_data);
         
-        rd->free_rid(uniform_set);
+        if (!transform_buffer.is_valid()) {
+            UtilityFunctions::push_warning("NativeVegetationDispatcher: Failed to create transform buffer");
+            continue;
+        }
+        
+        r_transform_buffers[b] = transform_buffer;
+    }
+}
+
+Array NativeVegetationDispatcher::generate_placements(
+    Vector3i chunk_origin,
+    int veg_type,
+    float density,
+    float grid_spacing,
+    float noise_frequency,
+    float slope_max,
+    Dictionary height_range,
+    int world_seed,
+    RID biome_map_texture,
+    bool cpu_fallback
+) {
+    if (!gpu_initialized) {
+        if (!initialize_gpu()) {
+            return Array();
+        }
+    }
+    
+    const bool stale = needs_replacement(ChunkTypePair{chunk_origin, veg_type});
+    cache_mutex->lock();
+    const PlacementCache::Entry* cached = placement_cache.find(ChunkTypePair{chunk_origin, veg_type});
+    if (cached && !stale) {
+        Array placements = cached->placements;
+        cache_mutex->unlock();
+        return placements;
+    }
+    cache_mutex->unlock();
+    
+    PlacementRequest request;
+    if (!make_placement_request(request, chunk_origin, veg_type, density, grid_spacing, noise_frequency,
+            slope_max, height_range, world_seed, biome_map_texture)) {
+        return Array();
+    }
+    // GPU-only mode optimization: skip CPU readback when cpu_fallback is false
+    request.params.cpu_readback = cpu_fallback;
+    
+    // Blocking compatibility path: a one-request batch on the worker, waited for here.
+    // Streaming code should use enqueue_placement_request() instead.
+    Array placements;
+    TraceSpan span("vegetation", "placement_sync_wait", chunk_origin, 0);
+    run_on_worker([&]() {
+        run_placement_batch({ request });
         
-        // Cache the transform buffer
         cache_mutex->lock();
-        transform_buffer_cache[chunk_origin][veg_type] = transform_buffer;
+        const PlacementCache::Entry* result = placement_cache.peek(ChunkTypePair{chunk_origin, veg_type});
+        if (result) {
+            placements = result->placements;
+        }
         cache_mutex->unlock();
+    });
+    
+    return placements;
+}
+
+Dictionary NativeVegetationDispatcher::generate_placement_arrays(
+    Vector3i chunk_origin,
+    int veg_type,
+    float density,
+    float grid_spacing,
+    float noise_frequency,
+    float slope_max,
+    Dictionary height_range,
+    int world_seed,
+    RID biome_map_texture
+) {
+    if (!gpu_initialized) {
+        if (!initialize_gpu()) {
+            return Dictionary();
+        }
+    }
+    
+    PackedPlacements packed;
+    if (!needs_replacement(ChunkTypePair{chunk_origin, veg_type}) && find_packed_placements(chunk_origin, veg_type, packed)) {
+        return packed_to_dictionary(packed);
+    }
+    
+    PlacementRequest request;
+    if (!make_placement_request(request, chunk_origin, veg_type, density, grid_spacing, noise_frequency,
+            slope_max, height_range, world_seed, biome_map_texture)) {
+        return Dictionary();
+    }
+    request.params.packed_readback = true;
+    
+    Dictionary result;
+    run_on_worker([&]() {
+        run_placement_batch({ request });
         
-        return transform_buffer;
+        cache_mutex->lock();
+        const PlacementCache::Entry* entry = placement_cache.peek(ChunkTypePair{chunk_origin, veg_type});
+        if (entry) {
+            // Zero placements leave the arrays empty
+            result = packed_to_dictionary(entry->packed);
+        }
+        cache_mutex->unlock();
+    });
+    
+    return result;
+}
+
+bool NativeVegetationDispatcher::enqueue_placement_request(
+    Vector3i chunk_origin,
+    int veg_type,
+    float density,
+    float grid_spacing,
+    float noise_frequency,
+    float slope_max,
+    Dictionary height_range,
+    int world_seed,
+    RID biome_map_texture,
+    float priority,
+    bool cpu_readback,
+    bool build_transforms
+) {
+    if (!gpu_initialized) {
+        if (!initialize_gpu()) {
+            return false;
+        }
     }
     
-    // CPU fallback path (original implementation)
-    size_t placement_data_size = placement_count * sizeof(PlacementData);
-    PackedByteArray placement_data = rd->buffer_get_data(placement_buffer, 4, placement_data_size);
+    ChunkTypePair key{chunk_origin, veg_type};
     
-    if (placement_data.size() < placement_data_size) {
-        return RID();
+    // Already cached: report it on the next poll so callers keep a single completion path.
+    // A dirty entry is placed again unless its replacement is already pending.
+    cache_mutex->lock();
+    const PlacementCache::Entry* cached = placement_cache.find(key);
+    int cached_count = cached && !cached->dirty ? cached->placement_count : -1;
+    cache_mutex->unlock();
+    
+    if (cached_count >= 0) {
+        queue_mutex->lock();
+        ready_placements.push_back({ key, cached_count });
+        queue_mutex->unlock();
+        return true;
+    }
+    
+    queue_mutex->lock();
+    bool pending = pending_keys.find(key) != pending_keys.end();
+    queue_mutex->unlock();
+    if (pending) {
+        return true;
     }
     
-    size_t transform_buffer_size = placement_count * 12 * sizeof(float);
-    PackedByteArray transform_data;
-    transform_data.resize(transform_buffer_size);
+    PlacementRequest request;
+    if (!make_placement_request(request, chunk_origin, veg_type, density, grid_spacing, noise_frequency,
+            slope_max, height_range, world_seed, biome_map_texture)) {
+        return false;
+    }
+    request.params.cpu_readback = cpu_readback;
+    request.params.build_transforms = build_transforms;
+    request.notify = true;
+    request.priority = priority;
     
-    const PlacementData* placements = reinterpret_cast<const PlacementData*>(placement_data.ptr());
-    float* transforms = reinterpret_cast<float*>(transform_data.ptrw());
+    queue_mutex->lock();
+    pending_keys[key] = false;
+    request_queue.push(request);
+    queue_mutex->unlock();
     
-    for (uint32_t i = 0; i < placement_count; i++) {
-        const PlacementData& pd = placements[i];
-        
-        float cos_y = std::cos(pd.rotation_y);
-        float sin_y = std::sin(pd.rotation_y);
-        float scale = pd.scale;
-        
-        // Row 0: X basis (rotated and scaled)
-        transforms[i * 12 + 0] = cos_y * scale;
-        transforms[i * 12 + 1] = 0.0f;
-        transforms[i * 12 + 2] = sin_y * scale;
-        transforms[i * 12 + 3] = pd.position.x;
+    gpu_context->wake();
+    return true;
+}
+
+Array NativeVegetationDispatcher::poll_ready_placements() {
+    std::vector<ReadyPlacement> ready;
+    queue_mutex->lock();
+    ready.swap(ready_placements);
+    queue_mutex->unlock();
+    
+    Array result;
+    for (const ReadyPlacement& placement : ready) {
+        Dictionary entry;
+        entry["chunk_origin"] = placement.key.chunk;
+        entry["veg_type"] = placement.key.type;
+        entry["placement_count"] = placement.placement_count;
+        entry["ok"] = placement.placement_count >= 0;
+        result.push_back(entry);
         
-        // Row 1: Y basis (up, scaled)
-        transforms[i * 12 + 4] = 0.0f;
-        transforms[i * 12 + 5] = scale;
-        transforms[i * 12 + 6] = 0.0f;
-        transforms[i * 12 + 7] = pd.position.y;
+        // Emitted here, on the polling thread, never from the worker
+        emit_signal("placements_ready", placement.key.chunk, placement.key.type, placement.placement_count);
+    }
+    return result;
+}
+
+bool NativeVegetationDispatcher::is_request_pending(Vector3i chunk_origin, int veg_type) {
+    queue_mutex->lock();
+    bool pending = pending_keys.find(ChunkTypePair{chunk_origin, veg_type}) != pending_keys.end();
+    queue_mutex->unlock();
+    return pending;
+}
+
+int NativeVegetationDispatcher::get_pending_request_count() {
+    queue_mutex->lock();
+    int count = (int)pending_keys.size();
+    queue_mutex->unlock();
+    return count;
+}
+
+Array NativeVegetationDispatcher::invalidate_region(AABB region, bool regenerate) {
+    // Placement chunks cover [origin, origin + CHUNK_SIZE) on every axis, the extent of the SDF texture they sample
+    const Vector3 region_end = region.position + region.size;
+    return invalidate_matching([&](const Vector3i& chunk) {
+        return region.position.x < chunk.x + CHUNK_SIZE && region_end.x > chunk.x &&
+            region.position.y < chunk.y + CHUNK_SIZE && region_end.y > chunk.y &&
+            region.position.z < chunk.z + CHUNK_SIZE && region_end.z > chunk.z;
+    }, regenerate);
+}
+
+Array NativeVegetationDispatcher::invalidate_chunks(Array chunk_origins, bool regenerate) {
+    std::vector<Vector3i> chunks;
+    chunks.reserve(chunk_origins.size());
+    for (int64_t i = 0; i < chunk_origins.size(); i++) {
+        chunks.push_back(chunk_origins[i]);
+    }
+    return invalidate_matching([&](const Vector3i& chunk) {
+        return std::find(chunks.begin(), chunks.end(), chunk) != chunks.end();
+    }, regenerate);
+}
+
+Array NativeVegetationDispatcher::invalidate_matching(const std::function<bool(const Vector3i&)>& touches, bool regenerate) {
+    // Only the touched (chunk, type) pairs are marked; each keeps serving its old result until the
+    // replacement lands, so an edit never leaves a hole in the vegetation while it is re-placed
+    std::vector<ChunkTypePair> keys;
+    std::vector<PlacementRequest> touched;
+    cache_mutex->lock();
+    placement_cache.collect_keys(keys);
+    for (const ChunkTypePair& key : keys) {
+        if (!touches(key.chunk)) {
+            continue;
+        }
+        PlacementCache::Entry* entry = placement_cache.peek(key);
+        entry->dirty = true;
+        PlacementRequest request;
+        request.key = key;
+        request.params = entry->params;
+        touched.push_back(request);
+    }
+    cache_mutex->unlock();
+    invalidated_entries += (int)touched.size();
+    
+    Array result;
+    for (const PlacementRequest& request : touched) {
+        Dictionary pair;
+        pair["chunk_origin"] = request.key.chunk;
+        pair["veg_type"] = request.key.type;
+        result.push_back(pair);
+    }
+    
+    // Passes queued or in flight for a touched chunk may sample the terrain before the edit
+    queue_mutex->lock();
+    for (auto& pending : pending_keys) {
+        if (touches(pending.first.chunk)) {
+            pending.second = true;
+        }
+    }
+    queue_mutex->unlock();
+    
+    if (!regenerate || touched.empty()) {
+        return result;
+    }
+    
+    int queued = 0;
+    for (const PlacementRequest& request : touched) {
+        PlacementRequest again;
+        if (!make_placement_request(again, request.key, request.params)) {
+            continue;
+        }
+        // Edits happen around the player: ahead of streaming requests
+        again.notify = true;
+        again.priority = 0.0f;
         
-        // Row 2: Z basis (rotated and scaled)
-        transforms[i * 12 + 8] = -sin_y * scale;
-        transforms[i * 12 + 9] = 0.0f;
-        transforms[i * 12 + 10] = cos_y * scale;
-        transforms[i * 12 + 11] = pd.position.z;
+        queue_mutex->lock();
+        if (pending_keys.find(request.key) == pending_keys.end()) {
+            pending_keys[request.key] = false;
+            request_queue.push(again);
+            queued++;
+        }
+        queue_mutex->unlock();
+    }
+    
+    if (queued > 0 && gpu_context) {
+        gpu_context->wake();
+    }
+    return result;
+}
+
+bool NativeVegetationDispatcher::is_chunk_dirty(Vector3i chunk_origin, int veg_type) {
+    cache_mutex->lock();
+    const PlacementCache::Entry* entry = placement_cache.peek(ChunkTypePair{chunk_origin, veg_type});
+    bool dirty = entry && entry->dirty;
+    cache_mutex->unlock();
+    return dirty;
+}
+
+Array NativeVegetationDispatcher::get_cached_placements(Vector3i chunk_origin, int veg_type) {
+    Array placements;
+    cache_mutex->lock();
+    const PlacementCache::Entry* entry = placement_cache.find(ChunkTypePair{chunk_origin, veg_type});
+    if (entry) {
+        placements = entry->placements;
     }
+    cache_mutex->unlock();
+    return placements;
+}
+
+Dictionary NativeVegetationDispatcher::get_placement_arrays(Vector3i chunk_origin, int veg_type) {
+    PackedPlacements packed;
+    if (!find_packed_placements(chunk_origin, veg_type, packed)) {
+        return Dictionary();
+    }
+    return packed_to_dictionary(packed);
+}
+
+PackedFloat32Array NativeVegetationDispatcher::get_multimesh_buffer(Vector3i chunk_origin, int veg_type) {
+    // Arrays already on the CPU: build the matrices here rather than waiting on the device
+    const ChunkTypePair key{chunk_origin, veg_type};
+    cache_mutex->lock();
+    const PlacementCache::Entry* entry = placement_cache.peek(key);
+    bool have_packed = entry && entry->has_packed;
+    RID transform_buffer = entry ? entry->transform_buffer : RID();
+    cache_mutex->unlock();
     
-    RID transform_buffer = rd->storage_buffer_create(transform_buffer_size, transform_data);
+    if (!have_packed && transform_buffer.is_valid()) {
+        // The GPU already produced them: one readback of n * 48 bytes
+        PackedFloat32Array buffer;
+        bool read = false;
+        run_on_worker([&]() {
+            // Retired buffers outlive their entry for a few batches, but only a live one is read
+            cache_mutex->lock();
+            const PlacementCache::Entry* current = placement_cache.peek(key);
+            bool still_cached = current && current->transform_buffer == transform_buffer;
+            cache_mutex->unlock();
+            if (still_cached) {
+                buffer = rd->buffer_get_data(transform_buffer).to_float32_array();
+                read = true;
+            }
+        });
+        if (read) {
+            return buffer;
+        }
+    }
     
-    if (!transform_buffer.is_valid()) {
-        UtilityFunctions::push_warning("NativeVegetationDispatcher: Failed to create transform buffer");
-        return RID();
+    PackedPlacements packed;
+    if (!find_packed_placements(chunk_origin, veg_type, packed)) {
+        return PackedFloat32Array();
     }
+    return build_multimesh_buffer(packed);
+}
+
+Dictionary NativeVegetationDispatcher::get_telemetry() const {
+    Dictionary stats;
+    stats["gpu_initialized"] = gpu_initialized.load();
+    stats["batches_submitted"] = batches_submitted.load();
+    stats["last_batch_size"] = last_batch_size.load();
+    stats["last_batch_gpu_time_ms"] = (float)last_batch_gpu_time_us.load() / 1000.0f;
+    stats["avg_request_latency_ms"] = (float)avg_request_latency_us.load() / 1000.0f;
+    stats["total_placement_calls"] = placement_call_count.load();
+    
+    queue_mutex->lock();
+    stats["queue_size"] = (int)request_queue.size();
+    stats["pending_requests"] = (int)pending_keys.size();
+    stats["ready_unpolled"] = (int)ready_placements.size();
+    queue_mutex->unlock();
+    
+    stats["cache_size"] = get_cache_size();
+    stats["cache_bytes"] = get_cache_bytes();
+    stats["max_cache_bytes"] = max_cache_bytes;
+    stats["compacted_bytes_saved"] = (int64_t)compacted_bytes_saved.load();
+    cache_mutex->lock();
+    stats["cache_evictions"] = (int64_t)placement_cache.get_evictions();
+    cache_mutex->unlock();
+    stats["shared_terrain_passes"] = shared_terrain_passes.load();
+    stats["invalidated_entries"] = invalidated_entries.load();
+    stats["edit_reruns"] = edit_reruns.load();
+    stats["decode_calls"] = decode_calls.load();
+    stats["decode_time_ms"] = (float)decode_time_us.load() / 1000.0f;
+    return stats;
+}
+
+bool NativeVegetationDispatcher::is_chunk_ready(Vector3i chunk_origin, int veg_type) {
+    cache_mutex->lock();
+    bool ready = placement_cache.contains(ChunkTypePair{chunk_origin, veg_type});
+    cache_mutex->unlock();
+    return ready;
+}
+
+bool NativeVegetationDispatcher::is_gpu_ready(Vector3i chunk_origin, int veg_type) {
+    cache_mutex->lock();
+    // Check if both placement buffer and transform buffer exist
+    const PlacementCache::Entry* entry = placement_cache.peek(ChunkTypePair{chunk_origin, veg_type});
+    bool ready = entry && entry->placement_buffer.is_valid() && entry->transform_buffer.is_valid();
+    cache_mutex->unlock();
+    return ready;
+}
+
+void NativeVegetationDispatcher::clear_cache() {
+    // Buffers belong to the worker's device; without a worker there is nothing left to free
+    run_on_worker([this]() {
+        clear_cache_on_worker();
+    });
+}
+
+void NativeVegetationDispatcher::clear_cache_on_worker() {
+    std::vector<PlacementCache::Entry> removed;
+    cache_mutex->lock();
+    placement_cache.clear(removed);
+    cache_mutex->unlock();
+    
+    // Retired like evictions: RIDs handed out before the clear stay valid for a few batches
+    retire_entries(removed);
+}
+
+RID NativeVegetationDispatcher::get_placement_buffer_rid(Vector3i chunk_origin, int veg_type) {
+    cache_mutex->lock();
+    const PlacementCache::Entry* entry = placement_cache.peek(ChunkTypePair{chunk_origin, veg_type});
+    RID buffer = entry ? entry->placement_buffer : RID();
+    cache_mutex->unlock();
+    return buffer;
+}
+
+int NativeVegetationDispatcher::get_placement_count(Vector3i chunk_origin, int veg_type) {
+    // Recorded when the pass completed: no readback
+    cache_mutex->lock();
+    const PlacementCache::Entry* entry = placement_cache.peek(ChunkTypePair{chunk_origin, veg_type});
+    int count = entry ? entry->placement_count : 0;
+    cache_mutex->unlock();
+    return count;
+}
+
+RID NativeVegetationDispatcher::get_transform_buffer_rid(Vector3i chunk_origin, int veg_type) {
+    const ChunkTypePair key{chunk_origin, veg_type};
     
+    // Check if transform buffer already exists
     cache_mutex->lock();
-    transform_buffer_cache[chunk_origin][veg_type] = transform_buffer;
+    const PlacementCache::Entry* entry = placement_cache.peek(key);
+    RID existing = entry ? entry->transform_buffer : RID();
+    int placement_count = entry ? entry->placement_count : 0;
     cache_mutex->unlock();
     
+    if (existing.is_valid()) {
+        return existing;
+    }
+    if (placement_count <= 0 || placement_count > MAX_PLACEMENTS) {
+        return RID();
+    }
+    
+    // Requests enqueued with build_transforms already have one; this builds it on demand (blocking)
+    RID transform_buffer;
+    run_on_worker([&]() {
+        cache_mutex->lock();
+        // Looked up again on the worker: the pair may have been evicted or built meanwhile
+        const PlacementCache::Entry* current = placement_cache.peek(key);
+        RID placement_buffer = current ? current->placement_buffer : RID();
+        RID args_buffer = current ? current->args_buffer : RID();
+        transform_buffer = current ? current->transform_buffer : RID();
+        cache_mutex->unlock();
+        
+        if (transform_buffer.is_valid() || !placement_buffer.is_valid() || !args_buffer.is_valid()) {
+            return;
+        }
+        
+        std::vector<RID> built;
+        create_transform_buffers({ placement_buffer }, { args_buffer }, { (uint32_t)placement_count }, built);
+        transform_buffer = built[0];
+        
+        if (transform_buffer.is_valid()) {
+            // Cache the transform buffer
+            cache_mutex->lock();
+            PlacementCache::Entry* target = placement_cache.peek(key);
+            if (target) {
+                target->transform_buffer = transform_buffer;
+                placement_cache.add_gpu_bytes(key, (uint64_t)placement_count * 12 * sizeof(float));
+            }
+            cache_mutex->unlock();
+            if (!target) {
+                rd->free_rid(transform_buffer);
+                transform_buffer = RID();
+            }
+        }
+    });
+    
     return transform_buffer;
 }
 
+RID NativeVegetationDispatcher::get_indirect_args_buffer_rid(Vector3i chunk_origin, int veg_type) {
+    // {dispatch_x, dispatch_y, dispatch_z, instance_count} as written by the placement pass
+    cache_mutex->lock();
+    const PlacementCache::Entry* entry = placement_cache.peek(ChunkTypePair{chunk_origin, veg_type});
+    RID buffer = entry ? entry->args_buffer : RID();
+    cache_mutex->unlock();
+    return buffer;
+}
+
+Dictionary NativeVegetationDispatcher::prebake_atlas(Object* terrain_generator, String path, Rect2 bounds, Array passes,
+        int world_seed, float surface_spacing) {
+    Dictionary result;
+    result["ok"] = false;
+    result["path"] = path;
+
+    NativeTerrainGenerator* generator = Object::cast_to<NativeTerrainGenerator>(terrain_generator);
+    if (!generator && terrain_generator) {
+        // NativeVoxelGeneratorBridge
+        Object* native = terrain_generator->get("native_generator");
+        generator = Object::cast_to<NativeTerrainGenerator>(native);
+    }
+    if (!generator) {
+        UtilityFunctions::printerr("[NativeVegetationDispatcher] prebake_atlas() needs a NativeTerrainGenerator");
+        return result;
+    }
+    if (path.is_empty() || bounds.size.x <= 0.0f || bounds.size.y <= 0.0f) {
+        UtilityFunctions::printerr("[NativeVegetationDispatcher] prebake_atlas() needs a path and non-empty bounds");
+        return result;
+    }
+
+    TraceSpan span("vegetation", "prebake_atlas");
+    uint64_t start_us = Time::get_singleton()->get_ticks_usec();
+
+    prebake_mutex->lock();
+    PrebakeJob& job = prebake_job;
+    job.passes.clear();
+    job.pass_tags.clear();
+    for (int i = 0; i < passes.size(); i++) {
+        Dictionary entry = passes[i];
+        CpuPlacementSampler::Pass pass;
+        pass.biome = (int32_t)(int)entry.get("native_biome", -1);
+        pass.type = (int)entry.get("type", 0);
+        pass.variant_count = std::max((int)entry.get("variants", 1), 1);
+        pass.density = (float)entry.get("density", 0.0f);
+        pass.grid_spacing = (float)entry.get("grid_spacing", 1.0f);
+        pass.noise_frequency = (float)entry.get("noise_frequency", 0.1f);
+        pass.slope_max = (float)entry.get("slope_max", 90.0f);
+        pass.height_min = (float)entry.get("height_min", -1.0e9f);
+        pass.height_max = (float)entry.get("height_max", 1.0e9f);
+        if (pass.density <= 0.0f || pass.grid_spacing <= 0.0f) {
+            continue;
+        }
+        job.passes.push_back(pass);
+        job.pass_tags.push_back((int32_t)(int)entry.get("biome", pass.biome));
+    }
+
+    const float chunk_size = (float)CHUNK_SIZE;
+    job.chunk_x0 = (int32_t)std::floor(bounds.position.x / chunk_size);
+    job.chunk_z0 = (int32_t)std::floor(bounds.position.y / chunk_size);
+    job.chunks_x = (int32_t)std::ceil((bounds.position.x + bounds.size.x) / chunk_size) - job.chunk_x0;
+    const int32_t chunks_z = (int32_t)std::ceil((bounds.position.y + bounds.size.y) / chunk_size) - job.chunk_z0;
+    const int chunk_count = (int)job.chunks_x * chunks_z;
+    job.surface_spacing = surface_spacing;
+    job.world_seed = (uint32_t)world_seed;
+    job.biome_map = generator->get_cpu_biome_map();
+    job.terrain = generator->get_cpu_sampler_params();
+    job.results.assign((size_t)chunk_count, {});
+
+    prebake_chunks_done = 0;
+    prebake_chunks_total = chunk_count;
+    prebake_cancel_requested = false;
+    if (!job.passes.empty()) {
+        WorkerThreadPool* pool = WorkerThreadPool::get_singleton();
+        int64_t group = pool->add_group_task(callable_mp(this, &NativeVegetationDispatcher::prebake_chunk_job),
+                chunk_count, -1, true, "Vegetation atlas prebake");
+        pool->wait_for_group_task_completion(group);
+    }
+    const bool cancelled = prebake_cancel_requested.load();
+
+    // Chunks are visited in (z, x) order, the atlas' chunk order. Passes of several native biomes may
+    // share an atlas biome, so each chunk's instances are merged per group before they are added.
+    VegetationAtlas::Builder builder;
+    std::map<std::tuple<int32_t, int32_t, int32_t>, std::vector<float>> chunk_groups;
+    for (int index = 0; index < chunk_count && !cancelled; index++) {
+        std::vector<std::vector<CpuPlacementSampler::Instance>>& chunk_results = job.results[(size_t)index];
+        chunk_groups.clear();
+        for (size_t p = 0; p < chunk_results.size(); p++) {
+            for (const CpuPlacementSampler::Instance& instance : chunk_results[p]) {
+                std::vector<float>& transforms = chunk_groups[std::make_tuple(job.pass_tags[p], job.passes[p].type, instance.variant)];
+                transforms.insert(transforms.end(), instance.transform, instance.transform + VegetationAtlas::FLOATS_PER_INSTANCE);
+            }
+        }
+        for (const auto& pair : chunk_groups) {
+            builder.add(std::get<0>(pair.first), std::get<1>(pair.first), std::get<2>(pair.first),
+                    job.chunk_x0 + index % job.chunks_x, job.chunk_z0 + index / job.chunks_x,
+                    pair.second.data(), (uint32_t)(pair.second.size() / VegetationAtlas::FLOATS_PER_INSTANCE));
+        }
+        std::vector<std::vector<CpuPlacementSampler::Instance>>().swap(chunk_results);
+    }
+    job.results.clear();
+    job.results.shrink_to_fit();
+    job.biome_map.reset();
+    prebake_mutex->unlock();
+
+    result["chunks"] = chunk_count;
+    if (cancelled) {
+        return result;
+    }
+
+    VegetationAtlas::Info info;
+    info.world_seed = world_seed;
+    info.chunk_size = CHUNK_SIZE;
+    info.bounds[0] = bounds.position.x;
+    info.bounds[1] = bounds.position.y;
+    info.bounds[2] = bounds.size.x;
+    info.bounds[3] = bounds.size.y;
+
+    String absolute = ProjectSettings::get_singleton()->globalize_path(path);
+    uint64_t bytes = 0;
+    if (DirAccess::make_dir_recursive_absolute(absolute.get_base_dir()) != OK ||
+            !builder.write(std::string(absolute.utf8().get_data()), info, bytes)) {
+        UtilityFunctions::printerr("[NativeVegetationDispatcher] Cannot write vegetation atlas: ", absolute);
+        return result;
+    }
+
+    span.set_count((int)builder.get_instance_count());
+    result["ok"] = true;
+    result["groups"] = (int)builder.get_group_count();
+    result["instances"] = (int64_t)builder.get_instance_count();
+    result["bytes"] = (int64_t)bytes;
+    result["elapsed_ms"] = (float)(Time::get_singleton()->get_ticks_usec() - start_us) / 1000.0f;
+    return result;
+}
+
+void NativeVegetationDispatcher::prebake_chunk_job(uint32_t index) {
+    // Cancelled columns are skipped but still counted, so progress reaches its total
+    if (!prebake_cancel_requested.load()) {
+        PrebakeJob& job = prebake_job;
+        const float origin[2] = {
+            (float)((job.chunk_x0 + (int32_t)index % job.chunks_x) * CHUNK_SIZE),
+            (float)((job.chunk_z0 + (int32_t)index / job.chunks_x) * CHUNK_SIZE)
+        };
+        CpuPlacementSampler::place_chunk(*job.biome_map, job.terrain, origin, CHUNK_SIZE, job.surface_spacing, job.world_seed,
+                job.passes.data(), (int)job.passes.size(), job.results[index]);
+    }
+    prebake_chunks_done++;
+}
+
+Dictionary NativeVegetationDispatcher::get_prebake_progress() const {
+    Dictionary progress;
+    progress["done"] = prebake_chunks_done.load();
+    progress["total"] = prebake_chunks_total.load();
+    return progress;
+}
+
+void NativeVegetationDispatcher::cancel_prebake() {
+    prebake_cancel_requested = true;
+}
+
 void NativeVegetationDispatcher::set_terrain_dispatcher(Object* dispatcher) {
     terrain_dispatcher = dispatcher;
 }
@@ -787,12 +1856,25 @@ int NativeVegetationDispatcher::get_max_cache_entries() const {
     return max_cache_entries;
 }
 
+void NativeVegetationDispatcher::set_max_cache_bytes(int64_t bytes) {
+    // Applied on the next published batch
+    max_cache_bytes = bytes;
+}
+
+int64_t NativeVegetationDispatcher::get_max_cache_bytes() const {
+    return max_cache_bytes;
+}
+
+int64_t NativeVegetationDispatcher::get_cache_bytes() const {
+    cache_mutex->lock();
+    int64_t bytes = (int64_t)placement_cache.get_size_bytes();
+    cache_mutex->unlock();
+    return bytes;
+}
+
 int NativeVegetationDispatcher::get_cache_size() const {
     cache_mutex->lock();
-    int size = 0;
-    for (const auto& chunk_pair : placement_cache) {
-        size += chunk_pair.second.size();
-    }
+    int size = placement_cache.get_entry_count();
     cache_mutex->unlock();
     return size;
 }
@@ -810,7 +1892,11 @@ float NativeVegetationDispatcher::get_average_placement_time_ms() const {
 }
 
 Dictionary NativeVegetationDispatcher::get_timing_per_type_ms() const {
-    return timing_per_type;
+    // Updated by the worker: hand out a copy
+    cache_mutex->lock();
+    Dictionary timings = timing_per_type.duplicate(true);
+    cache_mutex->unlock();
+    return timings;
 }
 
 int NativeVegetationDispatcher::get_total_placement_calls() const {
@@ -821,7 +1907,9 @@ void NativeVegetationDispatcher::reset_timing_stats() {
     total_placement_time_us = 0;
     last_placement_time_us = 0;
     placement_call_count = 0;
+    cache_mutex->lock();
     timing_per_type.clear();
+    cache_mutex->unlock();
 }
 
 void NativeVegetationDispatcher::_bind_methods() {
@@ -831,6 +1919,26 @@ void NativeVegetationDispatcher::_bind_methods() {
     ClassDB::bind_method(D_METHOD("generate_placements", "chunk_origin", "veg_type", "density", "grid_spacing", "noise_frequency", "slope_max", "height_range", "world_seed", "biome_map_texture", "cpu_fallback"), 
         &NativeVegetationDispatcher::generate_placements, DEFVAL(true));
     
+    // Async placement pipeline
+    ClassDB::bind_method(D_METHOD("enqueue_placement_request", "chunk_origin", "veg_type", "density", "grid_spacing", "noise_frequency", "slope_max", "height_range", "world_seed", "biome_map_texture", "priority", "cpu_readback", "build_transforms"),
+        &NativeVegetationDispatcher::enqueue_placement_request, DEFVAL(0.0f), DEFVAL(false), DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("generate_placement_arrays", "chunk_origin", "veg_type", "density", "grid_spacing", "noise_frequency", "slope_max", "height_range", "world_seed", "biome_map_texture"),
+        &NativeVegetationDispatcher::generate_placement_arrays);
+    ClassDB::bind_method(D_METHOD("poll_ready_placements"), &NativeVegetationDispatcher::poll_ready_placements);
+    ClassDB::bind_method(D_METHOD("is_request_pending", "chunk_origin", "veg_type"), &NativeVegetationDispatcher::is_request_pending);
+    ClassDB::bind_method(D_METHOD("get_pending_request_count"), &NativeVegetationDispatcher::get_pending_request_count);
+    ClassDB::bind_method(D_METHOD("invalidate_region", "region", "regenerate"), &NativeVegetationDispatcher::invalidate_region, DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("invalidate_chunks", "chunk_origins", "regenerate"), &NativeVegetationDispatcher::invalidate_chunks, DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("is_chunk_dirty", "chunk_origin", "veg_type"), &NativeVegetationDispatcher::is_chunk_dirty);
+    ClassDB::bind_method(D_METHOD("get_cached_placements", "chunk_origin", "veg_type"), &NativeVegetationDispatcher::get_cached_placements);
+    ClassDB::bind_method(D_METHOD("get_placement_arrays", "chunk_origin", "veg_type"), &NativeVegetationDispatcher::get_placement_arrays);
+    ClassDB::bind_method(D_METHOD("get_multimesh_buffer", "chunk_origin", "veg_type"), &NativeVegetationDispatcher::get_multimesh_buffer);
+    ClassDB::bind_method(D_METHOD("prebake_atlas", "terrain_generator", "path", "bounds", "passes", "world_seed", "surface_spacing"),
+        &NativeVegetationDispatcher::prebake_atlas, DEFVAL(DEFAULT_PREBAKE_SURFACE_SPACING));
+    ClassDB::bind_method(D_METHOD("get_prebake_progress"), &NativeVegetationDispatcher::get_prebake_progress);
+    ClassDB::bind_method(D_METHOD("cancel_prebake"), &NativeVegetationDispatcher::cancel_prebake);
+    ClassDB::bind_method(D_METHOD("get_telemetry"), &NativeVegetationDispatcher::get_telemetry);
+    
     ClassDB::bind_method(D_METHOD("is_chunk_ready", "chunk_origin", "veg_type"), &NativeVegetationDispatcher::is_chunk_ready);
     ClassDB::bind_method(D_METHOD("is_gpu_ready", "chunk_origin", "veg_type"), &NativeVegetationDispatcher::is_gpu_ready);
     ClassDB::bind_method(D_METHOD("clear_cache"), &NativeVegetationDispatcher::clear_cache);
@@ -838,13 +1946,17 @@ void NativeVegetationDispatcher::_bind_methods() {
     ClassDB::bind_method(D_METHOD("get_placement_buffer_rid", "chunk_origin", "veg_type"), &NativeVegetationDispatcher::get_placement_buffer_rid);
     ClassDB::bind_method(D_METHOD("get_placement_count", "chunk_origin", "veg_type"), &NativeVegetationDispatcher::get_placement_count);
     ClassDB::bind_method(D_METHOD("get_transform_buffer_rid", "chunk_origin", "veg_type"), &NativeVegetationDispatcher::get_transform_buffer_rid);
+    ClassDB::bind_method(D_METHOD("get_indirect_args_buffer_rid", "chunk_origin", "veg_type"), &NativeVegetationDispatcher::get_indirect_args_buffer_rid);
     
     ClassDB::bind_method(D_METHOD("set_terrain_dispatcher", "dispatcher"), &NativeVegetationDispatcher::set_terrain_dispatcher);
     ClassDB::bind_method(D_METHOD("get_terrain_dispatcher"), &NativeVegetationDispatcher::get_terrain_dispatcher);
     
     ClassDB::bind_method(D_METHOD("set_max_cache_entries", "count"), &NativeVegetationDispatcher::set_max_cache_entries);
     ClassDB::bind_method(D_METHOD("get_max_cache_entries"), &NativeVegetationDispatcher::get_max_cache_entries);
+    ClassDB::bind_method(D_METHOD("set_max_cache_bytes", "bytes"), &NativeVegetationDispatcher::set_max_cache_bytes);
+    ClassDB::bind_method(D_METHOD("get_max_cache_bytes"), &NativeVegetationDispatcher::get_max_cache_bytes);
     ClassDB::bind_method(D_METHOD("get_cache_size"), &NativeVegetationDispatcher::get_cache_size);
+    ClassDB::bind_method(D_METHOD("get_cache_bytes"), &NativeVegetationDispatcher::get_cache_bytes);
     
     ClassDB::bind_method(D_METHOD("get_last_placement_time_ms"), &NativeVegetationDispatcher::get_last_placement_time_ms);
     ClassDB::bind_method(D_METHOD("get_average_placement_time_ms"), &NativeVegetationDispatcher::get_average_placement_time_ms);
@@ -853,5 +1965,12 @@ void NativeVegetationDispatcher::_bind_methods() {
     ClassDB::bind_method(D_METHOD("reset_timing_stats"), &NativeVegetationDispatcher::reset_timing_stats);
     
     ADD_PROPERTY(PropertyInfo(Variant::INT, "max_cache_entries"), "set_max_cache_entries", "get_max_cache_entries");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_cache_bytes"), "set_max_cache_bytes", "get_max_cache_bytes");
     ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "terrain_dispatcher"), "set_terrain_dispatcher", "get_terrain_dispatcher");
+    
+    // placement_count is -1 when the pass could not run
+    ADD_SIGNAL(MethodInfo("placements_ready",
+        PropertyInfo(Variant::VECTOR3I, "chunk_origin"),
+        PropertyInfo(Variant::INT, "veg_type"),
+        PropertyInfo(Variant::INT, "placement_count")));
 }
@@ -4,14 +4,25 @@
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/classes/rendering_device.hpp>
 #include <godot_cpp/classes/mutex.hpp>
+#include <godot_cpp/variant/aabb.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/rect2.hpp>
 #include <godot_cpp/variant/vector3i.hpp>
 #include <godot_cpp/variant/rid.hpp>
 
+#include "cpu_placement_sampler.h"
+#include "gpu_context.h"
+#include "placement_cache.h"
+
 #include <unordered_map>
-#include <list>
+#include <deque>
+#include <queue>
+#include <vector>
 #include <atomic>
+#include <functional>
+#include <future>
 #include <memory>
 
 namespace godot {
@@ -27,48 +38,43 @@ struct PlacementData {
     float rotation_y;
 };
 
-struct Vector3iHash {
-    std::size_t operator()(const Vector3i& v) const {
-        std::size_t h1 = std::hash<int>{}(v.x);
-        std::size_t h2 = std::hash<int>{}(v.y);
-        std::size_t h3 = std::hash<int>{}(v.z);
-        return h1 ^ (h2 << 1) ^ (h3 << 2);
-    }
-};
+// Runs its placement passes on the shared NativeGPUContext device thread, where the terrain
+// generator's biome map and chunk SDF textures can be bound without copies
+class NativeVegetationDispatcher : public RefCounted, public NativeGPUContext::Client {
+    GDCLASS(NativeVegetationDispatcher, RefCounted)
 
-struct ChunkTypePair {
-    Vector3i chunk;
-    int type;
-    
-    bool operator==(const ChunkTypePair& other) const {
-        return chunk == other.chunk && type == other.type;
-    }
-};
+private:
+    // One placement pass for a (chunk, vegetation type). Textures of the terrain generator on the
+    // shared device are resolved by the device thread when the batch runs; otherwise the caller's
+    // biome map and the GDScript terrain dispatcher's SDF texture are used.
+    struct PlacementRequest {
+        ChunkTypePair key;
+        PlacementParams params;
+        RID terrain_sdf_texture;
+        bool notify;  // Report through poll_ready_placements() / placements_ready
+        float priority;  // Lower = sooner (distance to the player)
+        uint64_t request_time_us;
 
-struct ChunkTypePairHash {
-    std::size_t operator()(const ChunkTypePair& p) const {
-        Vector3iHash vh;
-        return vh(p.chunk) ^ (std::hash<int>{}(p.type) << 1);
-    }
-};
+        bool operator<(const PlacementRequest& other) const {
+            return priority > other.priority;  // Min-heap
+        }
+    };
 
-class NativeVegetationDispatcher : public RefCounted {
-    GDCLASS(NativeVegetationDispatcher, RefCounted)
+    struct ReadyPlacement {
+        ChunkTypePair key;
+        int placement_count;
+    };
 
-private:
-    RenderingDevice* rd;
+    NativeGPUContext* gpu_context;  // Held from a successful initialize_gpu() until cleanup_gpu()
+    RenderingDevice* rd;  // The shared device; used on the context's device thread only
     RID shader;
     RID pipeline;
     RID transform_shader;
     RID transform_pipeline;
-    RID cached_sampler_linear;
-    
-    std::unordered_map<Vector3i, std::unordered_map<int, Array>, Vector3iHash> placement_cache;
-    std::unordered_map<Vector3i, std::unordered_map<int, RID>, Vector3iHash> buffer_cache;
-    std::unordered_map<Vector3i, std::unordered_map<int, RID>, Vector3iHash> transform_buffer_cache;
+    RID cached_sampler_linear;  // Owned by gpu_context
+    RID placeholder_biome_map;  // 1x1, bound when no biome map is available (the shader never samples it)
     
-    std::list<ChunkTypePair> lru_list;
-    std::unordered_map<ChunkTypePair, std::list<ChunkTypePair>::iterator, ChunkTypePairHash> lru_map;
+    PlacementCache placement_cache;  // Guarded by cache_mutex
     
     Ref<Mutex> cache_mutex;
     
@@ -78,21 +84,112 @@ private:
     Dictionary timing_per_type;
     
     int max_cache_entries;
-    bool gpu_initialized;
+    int64_t max_cache_bytes;
+    std::atomic<bool> gpu_initialized;
     
     Object* terrain_dispatcher;
+
+    // Placement pipeline: the context's device thread ("the worker") drains request_queue into
+    // batches of up to MAX_BATCH_REQUESTS dispatches per compute list, submits, syncs and publishes
+    // the results into the caches. The main thread only enqueues and polls.
+    Ref<Mutex> init_mutex;
+    std::priority_queue<PlacementRequest> request_queue;  // Guarded by queue_mutex
+    // Queued or in flight; true when an edit touched the chunk meanwhile (it is placed again once done)
+    std::unordered_map<ChunkTypePair, bool, ChunkTypePairHash> pending_keys;
+    std::vector<ReadyPlacement> ready_placements;  // Completed since the last poll
+    Ref<Mutex> queue_mutex;
+    std::atomic<int> shared_terrain_passes;  // Passes that bound the generator's textures directly
+    std::atomic<int> invalidated_entries;  // Cached pairs marked dirty by terrain edits
+    std::atomic<int> edit_reruns;  // Passes placed again because an edit raced them
+    std::atomic<int> decode_calls;  // decode_placements() / decode_placements_packed() after readback
+    std::atomic<uint64_t> decode_time_us;
+
+    std::atomic<int> batches_submitted;
+    std::atomic<int> last_batch_size;
+    std::atomic<uint64_t> last_batch_gpu_time_us;
+    std::atomic<uint64_t> avg_request_latency_us;  // Enqueue to publish, moving average
+
+    // Full-size scratch buffers, one slot per batch position, reused by every batch (worker only).
+    // Passes write here; results are copied into buffers sized to the actual placement count.
+    std::vector<RID> scratch_placement_buffers;
+    std::vector<RID> scratch_transform_buffers;
+    std::atomic<uint64_t> compacted_bytes_saved;  // Scratch size minus compacted size, all passes
     
-    void evict_lru_entry();
-    void update_lru_access(const Vector3i& chunk, int type);
+    // Buffers of removed cache entries wait RETIRE_DELAY_BATCHES batches before being freed, so a
+    // RID handed out by get_*_buffer_rid() stays valid for a while after its entry is evicted
+    struct RetiredBuffer {
+        RID buffer;
+        int retired_at_batch;
+    };
+    std::deque<RetiredBuffer> retired_buffers;  // Worker only
+
+    // prebake_atlas(): one WorkerThreadPool task per chunk column of the baked area
+    struct PrebakeJob {
+        std::shared_ptr<const CpuBiomeMap> biome_map;
+        CpuTerrainSampler::Params terrain;
+        int32_t chunk_x0;
+        int32_t chunk_z0;
+        int32_t chunks_x;
+        float surface_spacing;
+        uint32_t world_seed;
+        std::vector<CpuPlacementSampler::Pass> passes;
+        std::vector<int32_t> pass_tags;  // Biome written to the atlas for each pass
+        std::vector<std::vector<std::vector<CpuPlacementSampler::Instance>>> results;  // [chunk][pass]
+    };
+    PrebakeJob prebake_job;  // Guarded by prebake_mutex (one prebake at a time)
+    Ref<Mutex> prebake_mutex;
+    std::atomic<int> prebake_chunks_done;
+    std::atomic<int> prebake_chunks_total;
+    std::atomic<bool> prebake_cancel_requested;
+    void prebake_chunk_job(uint32_t index);
+
+    void retire_entries(const std::vector<PlacementCache::Entry>& entries);
+    void free_retired_buffers(bool all);
+    void clear_cache_on_worker();
+    bool ensure_scratch_buffers();
+    void free_scratch_buffers();
     Array decode_placements(const PackedByteArray& buffer_data);
+    static PackedPlacements decode_placements_packed(const PackedByteArray& buffer_data);
+    static Dictionary packed_to_dictionary(const PackedPlacements& packed);
+    static PackedFloat32Array build_multimesh_buffer(const PackedPlacements& packed);
+    bool find_packed_placements(const Vector3i& chunk, int type, PackedPlacements& r_packed);
+
+    bool needs_replacement(const ChunkTypePair& key);
+    Array invalidate_matching(const std::function<bool(const Vector3i&)>& touches, bool regenerate);
+    bool make_placement_request(PlacementRequest& r_request, const ChunkTypePair& key, const PlacementParams& params);
+    bool make_placement_request(PlacementRequest& r_request, Vector3i chunk_origin, int veg_type, float density,
+        float grid_spacing, float noise_frequency, float slope_max, const Dictionary& height_range,
+        int world_seed, RID biome_map_texture);
+    PackedByteArray build_push_constants(const PlacementRequest& request) const;
+    RID create_placement_uniform_set(const PlacementRequest& request, RID storage_buffer, RID args_buffer);
+    void run_placement_batch(const std::vector<PlacementRequest>& requests);
+    int record_transform_dispatches(int64_t compute_list, const std::vector<RID>& placement_buffers, const std::vector<RID>& args_buffers,
+        const std::vector<RID>& transform_buffers, std::vector<RID>& r_uniform_sets);
+    void create_transform_buffers(const std::vector<RID>& placement_buffers, const std::vector<RID>& args_buffers, const std::vector<uint32_t>& counts, std::vector<RID>& r_transform_buffers);
+    bool run_on_worker(const std::function<void()>& task);
+    bool resolve_request_textures(PlacementRequest& r_request);
+
+    void detach_gpu_context();
+    bool initialize_gpu_on_worker();
+    void release_gpu_resources();
 
 protected:
     static void _bind_methods();
 
 public:
     static constexpr int MAX_PLACEMENTS = 4096;
+    // placement_count + std430 padding before placements[] (vec3 members align the array to 16)
+    static constexpr int PLACEMENT_HEADER_SIZE = 16;
+    // {dispatch_x, dispatch_y, dispatch_z, instance_count}, written by the placement pass
+    static constexpr int INDIRECT_ARGS_SIZE = 16;
     static constexpr int CHUNK_SIZE = 32;
     static constexpr int DEFAULT_MAX_CACHE_ENTRIES = 500;
+    static constexpr int64_t DEFAULT_MAX_CACHE_BYTES = 64ll * 1024 * 1024;
+    static constexpr int RETIRE_DELAY_BATCHES = 2;
+    // Placement dispatches recorded into one compute list / submit
+    static constexpr int MAX_BATCH_REQUESTS = 32;
+    // Spacing of the surface height samples prebake_atlas() takes over each chunk column (world units)
+    static constexpr float DEFAULT_PREBAKE_SURFACE_SPACING = 2.0f;
     
     NativeVegetationDispatcher();
     ~NativeVegetationDispatcher();
@@ -113,6 +210,65 @@ public:
         bool cpu_fallback = true
     );
     
+    // Async pipeline: returns immediately; results land in the caches and are reported by
+    // poll_ready_placements() (and the placements_ready signal it emits) on the calling thread
+    bool enqueue_placement_request(
+        Vector3i chunk_origin,
+        int veg_type,
+        float density,
+        float grid_spacing,
+        float noise_frequency,
+        float slope_max,
+        Dictionary height_range,
+        int world_seed,
+        RID biome_map_texture,
+        float priority = 0.0f,
+        bool cpu_readback = false,
+        bool build_transforms = true
+    );
+    // Same pass as generate_placements(), returned as packed arrays (see get_placement_arrays())
+    Dictionary generate_placement_arrays(
+        Vector3i chunk_origin,
+        int veg_type,
+        float density,
+        float grid_spacing,
+        float noise_frequency,
+        float slope_max,
+        Dictionary height_range,
+        int world_seed,
+        RID biome_map_texture
+    );
+    Array poll_ready_placements();
+    bool is_request_pending(Vector3i chunk_origin, int veg_type);
+    int get_pending_request_count();
+    // Terrain edits: every cached (chunk, type) pair whose chunk overlaps the region (or is listed)
+    // is marked dirty and, with regenerate, queued again with its original parameters ahead of
+    // streaming requests. Old results stay readable until the new ones are reported through
+    // poll_ready_placements(). Returns the touched pairs as {chunk_origin, veg_type}.
+    Array invalidate_region(AABB region, bool regenerate = true);
+    Array invalidate_chunks(Array chunk_origins, bool regenerate = true);
+    bool is_chunk_dirty(Vector3i chunk_origin, int veg_type);
+    Array get_cached_placements(Vector3i chunk_origin, int veg_type);
+    // {positions, normals: PackedVector3Array, scales, rotations: PackedFloat32Array,
+    //  variants, seeds: PackedInt32Array}; read back from the cached GPU buffer on first use
+    Dictionary get_placement_arrays(Vector3i chunk_origin, int veg_type);
+    // 12 floats per instance in MultiMesh.buffer order (TRANSFORM_3D, no color/custom data)
+    PackedFloat32Array get_multimesh_buffer(Vector3i chunk_origin, int veg_type);
+
+    // Blocking offline bake of every chunk column in bounds (world XZ) into a VegetationAtlas file
+    // (see NativeVegetationAtlas), spread over the WorkerThreadPool. Placement runs on the CPU with
+    // vegetation_placement.compute's rules over terrain_generator's surface (a NativeTerrainGenerator
+    // or an object with a native_generator property), so no chunk is generated or read back.
+    // passes: {native_biome, biome (stored in the atlas), type, variants, density, grid_spacing,
+    // noise_frequency, slope_max, height_min, height_max}. Returns {ok, path, chunks, groups,
+    // instances, bytes, elapsed_ms}; with cancel_prebake() ok is false and nothing is written.
+    Dictionary prebake_atlas(Object* terrain_generator, String path, Rect2 bounds, Array passes, int world_seed,
+        float surface_spacing = DEFAULT_PREBAKE_SURFACE_SPACING);
+    // {done, total} chunk columns of the running prebake; callable from any thread
+    Dictionary get_prebake_progress() const;
+    void cancel_prebake();
+    Dictionary get_telemetry() const;
+    
     bool is_chunk_ready(Vector3i chunk_origin, int veg_type);
     bool is_gpu_ready(Vector3i chunk_origin, int veg_type);
     void clear_cache();
@@ -120,19 +276,26 @@ public:
     RID get_placement_buffer_rid(Vector3i chunk_origin, int veg_type);
     int get_placement_count(Vector3i chunk_origin, int veg_type);
     RID get_transform_buffer_rid(Vector3i chunk_origin, int veg_type);
+    RID get_indirect_args_buffer_rid(Vector3i chunk_origin, int veg_type);
     
     void set_terrain_dispatcher(Object* dispatcher);
     Object* get_terrain_dispatcher() const;
     
     void set_max_cache_entries(int count);
     int get_max_cache_entries() const;
+    void set_max_cache_bytes(int64_t bytes);
+    int64_t get_max_cache_bytes() const;
     int get_cache_size() const;
+    int64_t get_cache_bytes() const;
     
     float get_last_placement_time_ms() const;
     float get_average_placement_time_ms() const;
     Dictionary get_timing_per_type_ms() const;
     int get_total_placement_calls() const;
     void reset_timing_stats();
+
+    // NativeGPUContext::Client (device thread): one batch from request_queue per call
+    bool process_gpu_work() override;
 };
 
 }
@@ -0,0 +1,211 @@
+#include "placement_cache.h"
+
+size_t PlacementCache::home_bucket(const ChunkTypePair &key) const {
+    return ChunkTypePairHash()(key) & (table.size() - 1);
+}
+
+size_t PlacementCache::find_bucket(const ChunkTypePair &key) const {
+    if (table.empty()) {
+        return 0;
+    }
+    const size_t mask = table.size() - 1;
+    for (size_t bucket = home_bucket(key);; bucket = (bucket + 1) & mask) {
+        const int32_t slot_index = table[bucket];
+        if (slot_index == NONE) {
+            return table.size();
+        }
+        if (slots[slot_index].key == key) {
+            return bucket;
+        }
+    }
+}
+
+PlacementCache::Entry *PlacementCache::find(const ChunkTypePair &key) {
+    const size_t bucket = find_bucket(key);
+    if (bucket >= table.size()) {
+        return nullptr;
+    }
+    const int32_t slot_index = table[bucket];
+    if (lru_head != slot_index) {
+        unlink(slot_index);
+        link_front(slot_index);
+    }
+    return &slots[slot_index].entry;
+}
+
+PlacementCache::Entry *PlacementCache::peek(const ChunkTypePair &key) {
+    const size_t bucket = find_bucket(key);
+    return bucket < table.size() ? &slots[table[bucket]].entry : nullptr;
+}
+
+const PlacementCache::Entry *PlacementCache::peek(const ChunkTypePair &key) const {
+    const size_t bucket = find_bucket(key);
+    return bucket < table.size() ? &slots[table[bucket]].entry : nullptr;
+}
+
+bool PlacementCache::contains(const ChunkTypePair &key) const {
+    return find_bucket(key) < table.size();
+}
+
+PlacementCache::Entry &PlacementCache::insert(const ChunkTypePair &key, const Entry &entry, std::vector<Entry> &r_replaced) {
+    const size_t existing = find_bucket(key);
+    if (existing < table.size()) {
+        Entry replaced;
+        remove_at_bucket(existing, replaced);
+        r_replaced.push_back(replaced);
+    }
+
+    // Load factor stays at or below 1/2, which keeps probe runs short
+    if ((count + 1) * 2 > table.size()) {
+        grow_table();
+    }
+
+    int32_t slot_index;
+    if (!free_slots.empty()) {
+        slot_index = free_slots.back();
+        free_slots.pop_back();
+    } else {
+        slot_index = (int32_t)slots.size();
+        slots.push_back(Slot());
+    }
+
+    Slot &slot = slots[slot_index];
+    slot.key = key;
+    slot.entry = entry;
+    slot.occupied = true;
+    link_front(slot_index);
+
+    const size_t mask = table.size() - 1;
+    size_t bucket = home_bucket(key);
+    while (table[bucket] != NONE) {
+        bucket = (bucket + 1) & mask;
+    }
+    table[bucket] = slot_index;
+
+    count++;
+    size_bytes += entry.gpu_bytes;
+    return slot.entry;
+}
+
+bool PlacementCache::erase(const ChunkTypePair &key, Entry &r_entry) {
+    const size_t bucket = find_bucket(key);
+    if (bucket >= table.size()) {
+        return false;
+    }
+    remove_at_bucket(bucket, r_entry);
+    return true;
+}
+
+void PlacementCache::clear(std::vector<Entry> &r_removed) {
+    for (Slot &slot : slots) {
+        if (slot.occupied) {
+            r_removed.push_back(slot.entry);
+        }
+    }
+    slots.clear();
+    free_slots.clear();
+    table.clear();
+    lru_head = NONE;
+    lru_tail = NONE;
+    count = 0;
+    size_bytes = 0;
+}
+
+void PlacementCache::collect_keys(std::vector<ChunkTypePair> &r_keys) const {
+    r_keys.reserve(r_keys.size() + count);
+    for (int32_t slot_index = lru_head; slot_index != NONE; slot_index = slots[slot_index].next) {
+        r_keys.push_back(slots[slot_index].key);
+    }
+}
+
+void PlacementCache::add_gpu_bytes(const ChunkTypePair &key, uint64_t bytes) {
+    Entry *entry = peek(key);
+    if (entry) {
+        entry->gpu_bytes += bytes;
+        size_bytes += bytes;
+    }
+}
+
+void PlacementCache::evict_to_fit(int max_entries, uint64_t max_bytes, std::vector<Entry> &r_evicted) {
+    while (count > 1 && ((int64_t)count > (int64_t)max_entries || size_bytes > max_bytes)) {
+        Entry evicted;
+        remove_at_bucket(find_bucket(slots[lru_tail].key), evicted);
+        r_evicted.push_back(evicted);
+        evictions++;
+    }
+}
+
+void PlacementCache::grow_table() {
+    const size_t new_size = table.empty() ? 64 : table.size() * 2;
+    table.assign(new_size, NONE);
+    const size_t mask = new_size - 1;
+    for (int32_t slot_index = 0; slot_index < (int32_t)slots.size(); slot_index++) {
+        if (!slots[slot_index].occupied) {
+            continue;
+        }
+        size_t bucket = home_bucket(slots[slot_index].key);
+        while (table[bucket] != NONE) {
+            bucket = (bucket + 1) & mask;
+        }
+        table[bucket] = slot_index;
+    }
+}
+
+void PlacementCache::link_front(int32_t slot_index) {
+    Slot &slot = slots[slot_index];
+    slot.prev = NONE;
+    slot.next = lru_head;
+    if (lru_head != NONE) {
+        slots[lru_head].prev = slot_index;
+    }
+    lru_head = slot_index;
+    if (lru_tail == NONE) {
+        lru_tail = slot_index;
+    }
+}
+
+void PlacementCache::unlink(int32_t slot_index) {
+    Slot &slot = slots[slot_index];
+    if (slot.prev != NONE) {
+        slots[slot.prev].next = slot.next;
+    } else {
+        lru_head = slot.next;
+    }
+    if (slot.next != NONE) {
+        slots[slot.next].prev = slot.prev;
+    } else {
+        lru_tail = slot.prev;
+    }
+    slot.prev = NONE;
+    slot.next = NONE;
+}
+
+void PlacementCache::remove_at_bucket(size_t bucket, Entry &r_entry) {
+    const int32_t slot_index = table[bucket];
+    Slot &slot = slots[slot_index];
+    r_entry = slot.entry;
+    size_bytes -= slot.entry.gpu_bytes;
+    count--;
+
+    unlink(slot_index);
+    slot.entry = Entry();
+    slot.occupied = false;
+    free_slots.push_back(slot_index);
+
+    // Backward-shift deletion: pull later members of the probe run into the hole so lookups
+    // never need tombstones
+    const size_t mask = table.size() - 1;
+    size_t hole = bucket;
+    size_t next = (hole + 1) & mask;
+    while (table[next] != NONE) {
+        const size_t home = home_bucket(slots[table[next]].key);
+        // The entry can fill the hole unless its home lies cyclically in (hole, next]
+        const bool home_after_hole = hole <= next ? (home > hole && home <= next) : (home > hole || home <= next);
+        if (!home_after_hole) {
+            table[hole] = table[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    table[hole] = NONE;
+}
@@ -0,0 +1,137 @@
+#ifndef PLACEMENT_CACHE_H
+#define PLACEMENT_CACHE_H
+
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/rid.hpp>
+#include <godot_cpp/variant/vector3i.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace godot;
+
+// Cache key for vegetation placements: one entry per (chunk origin, vegetation type)
+struct ChunkTypePair {
+    Vector3i chunk;
+    int type;
+
+    bool operator==(const ChunkTypePair &other) const {
+        return chunk == other.chunk && type == other.type;
+    }
+};
+
+struct ChunkTypePairHash {
+    std::size_t operator()(const ChunkTypePair &key) const {
+        // Multiply-xorshift mix: grid-aligned origins (multiples of the chunk size) land in distant buckets
+        uint64_t h = (uint64_t)(uint32_t)key.chunk.x * 0x9E3779B97F4A7C15ull;
+        h ^= (uint64_t)(uint32_t)key.chunk.y * 0xC2B2AE3D27D4EB4Full;
+        h ^= (uint64_t)(uint32_t)key.chunk.z * 0x165667B19E3779F9ull;
+        h ^= (uint64_t)(uint32_t)key.type * 0x27D4EB2F165667C5ull;
+        h ^= h >> 29;
+        h *= 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 32;
+        return (std::size_t)h;
+    }
+};
+
+// Structure-of-arrays copy of a placement buffer: filled without a Variant per instance
+struct PackedPlacements {
+    PackedVector3Array positions;
+    PackedVector3Array normals;
+    PackedFloat32Array scales;
+    PackedFloat32Array rotations;
+    PackedInt32Array variants;
+    PackedInt32Array seeds;
+};
+
+// Inputs of one placement pass; kept with the cached result so an edited chunk can be placed again
+struct PlacementParams {
+    float density = 0.0f;
+    float grid_spacing = 1.0f;
+    float noise_frequency = 0.0f;
+    float slope_max = 0.0f;
+    float height_min = -100.0f;
+    float height_max = 500.0f;
+    int world_seed = 0;
+    RID biome_map_texture;  // The caller's; the shared device's biome map replaces it when present
+    bool cpu_readback = false;  // Decode placements into Dictionaries (cpu_fallback)
+    bool packed_readback = false;  // Decode placements into PackedPlacements
+    bool build_transforms = false;  // Also run transform_placement.compute (indirect) in the same compute list
+};
+
+// PlacementCache: LRU cache of vegetation placement results with one entry per ChunkTypePair
+// Slots live in a stable array with intrusive LRU links; lookups go through an open-addressing
+// index (linear probing, backward-shift deletion) so no operation allocates once warmed up.
+// Entry and byte counts are kept as running totals. Not synchronized; NativeVegetationDispatcher
+// guards it with cache_mutex. Removed entries are handed back so their RIDs can be freed later.
+class PlacementCache {
+public:
+    struct Entry {
+        Array placements;  // Dictionaries, only for cpu_readback requests
+        PackedPlacements packed;
+        bool has_packed = false;
+        RID placement_buffer;  // Compacted to placement_count; invalid when the count is 0
+        RID transform_buffer;
+        RID args_buffer;  // Indirect dispatch args written by the placement pass
+        int placement_count = 0;
+        uint64_t gpu_bytes = 0;  // Buffer memory held by this entry
+        PlacementParams params;  // What produced this result
+        bool dirty = false;  // Terrain under the chunk was edited; still served until replaced
+    };
+
+    // Counted lookup: moves the entry to the most recently used end
+    Entry *find(const ChunkTypePair &key);
+    // Lookup that does not affect eviction order
+    Entry *peek(const ChunkTypePair &key);
+    const Entry *peek(const ChunkTypePair &key) const;
+    bool contains(const ChunkTypePair &key) const;
+
+    // Inserts or replaces (a replaced entry is appended to r_replaced so its buffers are not leaked)
+    Entry &insert(const ChunkTypePair &key, const Entry &entry, std::vector<Entry> &r_replaced);
+    bool erase(const ChunkTypePair &key, Entry &r_entry);
+    void clear(std::vector<Entry> &r_removed);
+    // Appends the key of every cached entry, most recently used first
+    void collect_keys(std::vector<ChunkTypePair> &r_keys) const;
+    // Buffers attached to an existing entry after insertion (on-demand transforms)
+    void add_gpu_bytes(const ChunkTypePair &key, uint64_t bytes);
+
+    // Evicts least recently used entries until both limits hold; the newest entry always stays
+    void evict_to_fit(int max_entries, uint64_t max_bytes, std::vector<Entry> &r_evicted);
+
+    int get_entry_count() const { return (int)count; }
+    uint64_t get_size_bytes() const { return size_bytes; }
+    uint64_t get_evictions() const { return evictions; }
+
+private:
+    static constexpr int32_t NONE = -1;
+
+    struct Slot {
+        ChunkTypePair key;
+        Entry entry;
+        int32_t prev = NONE;  // Towards the most recently used end
+        int32_t next = NONE;
+        bool occupied = false;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<int32_t> free_slots;
+    std::vector<int32_t> table;  // Slot index per bucket, NONE when empty; size is a power of two
+    int32_t lru_head = NONE;  // Most recently used
+    int32_t lru_tail = NONE;  // Least recently used
+
+    size_t count = 0;
+    uint64_t size_bytes = 0;
+    uint64_t evictions = 0;
+
+    size_t home_bucket(const ChunkTypePair &key) const;
+    size_t find_bucket(const ChunkTypePair &key) const;  // table.size() when absent
+    void grow_table();
+    void link_front(int32_t slot_index);
+    void unlink(int32_t slot_index);
+    void remove_at_bucket(size_t bucket, Entry &r_entry);
+};
+
+#endif // PLACEMENT_CACHE_H
@@ -0,0 +1,339 @@
+#include "region_store.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const uint32_t REGION_MAGIC = 0x47525245u;  // "ERRG"
+const uint32_t REGION_VERSION = 1;
+const uint64_t HEADER_SIZE = 64;
+const int CHUNKS_PER_REGION = RegionStore::REGION_DIM * RegionStore::REGION_DIM * RegionStore::REGION_DIM;
+const uint64_t INDEX_ENTRY_SIZE = 16;
+const uint64_t DATA_START = HEADER_SIZE + (uint64_t)CHUNKS_PER_REGION * INDEX_ENTRY_SIZE;
+
+bool seek64(FILE *file, uint64_t offset) {
+#ifdef _WIN32
+    return _fseeki64(file, (__int64)offset, SEEK_SET) == 0;
+#else
+    return fseeko(file, (off_t)offset, SEEK_SET) == 0;
+#endif
+}
+
+uint64_t file_size_of(FILE *file) {
+#ifdef _WIN32
+    if (_fseeki64(file, 0, SEEK_END) != 0) {
+        return 0;
+    }
+    return (uint64_t)_ftelli64(file);
+#else
+    if (fseeko(file, 0, SEEK_END) != 0) {
+        return 0;
+    }
+    return (uint64_t)ftello(file);
+#endif
+}
+
+inline int32_t floor_div(int32_t v, int32_t d) {
+    return v >= 0 ? v / d : -((-v + d - 1) / d);
+}
+
+} // namespace
+
+// MappedFile
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string &path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    file_handle = file;
+    mapping_handle = mapping;
+    mapped = static_cast<const uint8_t *>(view);
+    mapped_size = (size_t)size.QuadPart;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void *view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    mapped = static_cast<const uint8_t *>(view);
+    mapped_size = (size_t)st.st_size;
+#endif
+    return true;
+}
+
+void MappedFile::close() {
+    if (!mapped) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(mapped);
+    CloseHandle((HANDLE)mapping_handle);
+    CloseHandle((HANDLE)file_handle);
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+#else
+    munmap(const_cast<uint8_t *>(mapped), mapped_size);
+#endif
+    mapped = nullptr;
+    mapped_size = 0;
+}
+
+// RegionStore
+
+RegionStore::RegionStore(const std::string &p_directory) :
+        directory(p_directory) {
+}
+
+RegionStore::~RegionStore() {
+    for (auto &pair : regions) {
+        close_region(pair.second);
+        delete pair.second;
+    }
+    regions.clear();
+}
+
+RegionStore::RegionKey RegionStore::region_key_of(int32_t cx, int32_t cy, int32_t cz, int32_t lod, int &r_local_index) {
+    RegionKey key = { floor_div(cx, REGION_DIM), floor_div(cy, REGION_DIM), floor_div(cz, REGION_DIM), lod };
+    int lx = cx - key.x * REGION_DIM;
+    int ly = cy - key.y * REGION_DIM;
+    int lz = cz - key.z * REGION_DIM;
+    r_local_index = lx + REGION_DIM * (ly + REGION_DIM * lz);
+    return key;
+}
+
+RegionStore::Region *RegionStore::get_region(const RegionKey &key) {
+    auto it = regions.find(key);
+    if (it != regions.end()) {
+        it->second->last_use = ++use_counter;
+        return it->second;
+    }
+
+    if ((int)regions.size() >= MAX_OPEN_REGIONS) {
+        auto oldest = regions.begin();
+        for (auto candidate = regions.begin(); candidate != regions.end(); ++candidate) {
+            if (candidate->second->last_use < oldest->second->last_use) {
+                oldest = candidate;
+            }
+        }
+        close_region(oldest->second);
+        delete oldest->second;
+        regions.erase(oldest);
+    }
+
+    Region *region = new Region();
+    region->path = directory + "/r." + std::to_string(key.lod) + "." + std::to_string(key.x) + "." +
+            std::to_string(key.y) + "." + std::to_string(key.z) + ".erreg";
+    region->index.assign(CHUNKS_PER_REGION, IndexEntry{ 0, 0, 0 });
+    region->last_use = ++use_counter;
+
+    // A missing or unreadable file is remembered as an empty region, so misses cost no further I/O
+    FILE *file = std::fopen(region->path.c_str(), "rb");
+    if (file) {
+        uint32_t header[4] = {};
+        bool valid = std::fread(header, sizeof(uint32_t), 4, file) == 4 &&
+                header[0] == REGION_MAGIC && header[1] == REGION_VERSION && header[2] == (uint32_t)REGION_DIM;
+        if (valid && seek64(file, HEADER_SIZE)) {
+            for (int i = 0; i < CHUNKS_PER_REGION && valid; i++) {
+                uint8_t raw[INDEX_ENTRY_SIZE];
+                if (std::fread(raw, 1, INDEX_ENTRY_SIZE, file) != INDEX_ENTRY_SIZE) {
+                    valid = false;
+                    break;
+                }
+                IndexEntry &entry = region->index[i];
+                std::memcpy(&entry.offset, raw, 8);
+                std::memcpy(&entry.size, raw + 8, 4);
+                std::memcpy(&entry.raw_size, raw + 12, 4);
+            }
+        }
+        if (valid) {
+            region->file_size = file_size_of(file);
+        } else {
+            region->index.assign(CHUNKS_PER_REGION, IndexEntry{ 0, 0, 0 });
+        }
+        std::fclose(file);
+    }
+
+    regions[key] = region;
+    return region;
+}
+
+void RegionStore::close_region(Region *region) {
+    if (region->file) {
+        std::fclose(region->file);
+        region->file = nullptr;
+    }
+    region->mapping.close();
+}
+
+bool RegionStore::open_for_write(Region *region) {
+    if (region->file) {
+        return true;
+    }
+
+    if (region->file_size >= DATA_START) {
+        region->file = std::fopen(region->path.c_str(), "r+b");
+        return region->file != nullptr;
+    }
+
+    // New (or unreadable) region: header plus an empty index
+    region->file = std::fopen(region->path.c_str(), "w+b");
+    if (!region->file) {
+        return false;
+    }
+    uint32_t header[16] = {};
+    header[0] = REGION_MAGIC;
+    header[1] = REGION_VERSION;
+    header[2] = (uint32_t)REGION_DIM;
+    std::vector<uint8_t> empty_index((size_t)CHUNKS_PER_REGION * INDEX_ENTRY_SIZE, 0);
+    bool ok = std::fwrite(header, 1, HEADER_SIZE, region->file) == HEADER_SIZE &&
+            std::fwrite(empty_index.data(), 1, empty_index.size(), region->file) == empty_index.size();
+    if (!ok) {
+        std::fclose(region->file);
+        region->file = nullptr;
+        return false;
+    }
+    region->index.assign(CHUNKS_PER_REGION, IndexEntry{ 0, 0, 0 });
+    region->file_size = DATA_START;
+    return true;
+}
+
+bool RegionStore::write_index_entry(Region *region, int local_index) {
+    const IndexEntry &entry = region->index[local_index];
+    uint8_t raw[INDEX_ENTRY_SIZE];
+    std::memcpy(raw, &entry.offset, 8);
+    std::memcpy(raw + 8, &entry.size, 4);
+    std::memcpy(raw + 12, &entry.raw_size, 4);
+    if (!seek64(region->file, HEADER_SIZE + (uint64_t)local_index * INDEX_ENTRY_SIZE)) {
+        return false;
+    }
+    return std::fwrite(raw, 1, INDEX_ENTRY_SIZE, region->file) == INDEX_ENTRY_SIZE;
+}
+
+bool RegionStore::read(int32_t cx, int32_t cy, int32_t cz, int32_t lod, std::vector<uint8_t> &r_blob, uint32_t &r_raw_size) {
+    int local_index;
+    RegionKey key = region_key_of(cx, cy, cz, lod, local_index);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Region *region = get_region(key);
+    const IndexEntry entry = region->index[local_index];
+    if (entry.offset == 0 || entry.size == 0) {
+        return false;
+    }
+
+    // Blobs written after the mapping was made are past its end: remap the grown file
+    if (entry.offset + entry.size > region->mapping.size()) {
+        if (region->file) {
+            std::fflush(region->file);
+        }
+        if (!region->mapping.open(region->path) || entry.offset + entry.size > region->mapping.size()) {
+            return false;
+        }
+    }
+
+    const uint8_t *src = region->mapping.data() + entry.offset;
+    r_blob.assign(src, src + entry.size);
+    r_raw_size = entry.raw_size;
+    return true;
+}
+
+bool RegionStore::write(int32_t cx, int32_t cy, int32_t cz, int32_t lod, const uint8_t *blob, uint32_t size, uint32_t raw_size) {
+    if (!blob || size == 0) {
+        return false;
+    }
+
+    int local_index;
+    RegionKey key = region_key_of(cx, cy, cz, lod, local_index);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Region *region = get_region(key);
+    if (!open_for_write(region)) {
+        return false;
+    }
+
+    const uint64_t offset = region->file_size;
+    if (!seek64(region->file, offset) || std::fwrite(blob, 1, size, region->file) != size) {
+        return false;
+    }
+
+    region->index[local_index] = IndexEntry{ offset, size, raw_size };
+    region->file_size = offset + size;
+    bool ok = write_index_entry(region, local_index);
+    std::fflush(region->file);
+
+    bytes_written += size;
+    return ok;
+}
+
+bool RegionStore::contains(int32_t cx, int32_t cy, int32_t cz, int32_t lod) {
+    int local_index;
+    RegionKey key = region_key_of(cx, cy, cz, lod, local_index);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return get_region(key)->index[local_index].offset != 0;
+}
+
+bool RegionStore::erase(int32_t cx, int32_t cy, int32_t cz, int32_t lod) {
+    int local_index;
+    RegionKey key = region_key_of(cx, cy, cz, lod, local_index);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Region *region = get_region(key);
+    if (region->index[local_index].offset == 0) {
+        return false;
+    }
+    if (!open_for_write(region)) {
+        return false;
+    }
+    region->index[local_index] = IndexEntry{ 0, 0, 0 };
+    bool ok = write_index_entry(region, local_index);
+    std::fflush(region->file);
+    return ok;
+}
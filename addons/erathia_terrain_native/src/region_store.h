@@ -0,0 +1,104 @@
+#ifndef REGION_STORE_H
+#define REGION_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// MappedFile: read-only memory mapping of a whole file (mmap / MapViewOfFile)
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool open(const std::string &path);
+    void close();
+    const uint8_t *data() const { return mapped; }
+    size_t size() const { return mapped_size; }
+
+private:
+    const uint8_t *mapped = nullptr;
+    size_t mapped_size = 0;
+#ifdef _WIN32
+    void *file_handle = nullptr;
+    void *mapping_handle = nullptr;
+#endif
+};
+
+// RegionStore: persistent chunk blobs grouped into region files of REGION_DIM^3 chunks per LOD
+// File layout: 64-byte header, fixed index of REGION_DIM^3 entries {u64 offset, u32 size, u32 raw_size},
+// then blobs. Blobs are appended; rewriting a chunk appends a new blob and repoints its index entry.
+// Reads come from a memory mapping of the region file, remapped when the file has grown past it.
+// Blobs are opaque here (callers compress them); thread-safe through one internal mutex.
+class RegionStore {
+public:
+    static constexpr int REGION_DIM = 16;
+    static constexpr int MAX_OPEN_REGIONS = 64;
+
+    explicit RegionStore(const std::string &directory);
+    ~RegionStore();
+
+    // Chunk coordinates are origin / chunk_size (floored); each LOD has its own region files
+    bool read(int32_t cx, int32_t cy, int32_t cz, int32_t lod, std::vector<uint8_t> &r_blob, uint32_t &r_raw_size);
+    bool write(int32_t cx, int32_t cy, int32_t cz, int32_t lod, const uint8_t *blob, uint32_t size, uint32_t raw_size);
+    bool contains(int32_t cx, int32_t cy, int32_t cz, int32_t lod);
+    // Drops the chunk from the index (its blob stays in the file until the region is rewritten)
+    bool erase(int32_t cx, int32_t cy, int32_t cz, int32_t lod);
+
+    const std::string &get_directory() const { return directory; }
+    uint64_t get_bytes_written() const { return bytes_written; }
+
+private:
+    struct IndexEntry {
+        uint64_t offset;
+        uint32_t size;
+        uint32_t raw_size;
+    };
+
+    struct RegionKey {
+        int32_t x, y, z, lod;
+        bool operator==(const RegionKey &other) const {
+            return x == other.x && y == other.y && z == other.z && lod == other.lod;
+        }
+    };
+
+    struct RegionKeyHash {
+        size_t operator()(const RegionKey &key) const {
+            uint64_t h = (uint64_t)(uint32_t)key.x * 0x9E3779B97F4A7C15ull;
+            h ^= (uint64_t)(uint32_t)key.y * 0xC2B2AE3D27D4EB4Full;
+            h ^= (uint64_t)(uint32_t)key.z * 0x165667B19E3779F9ull;
+            h ^= (uint64_t)(uint32_t)key.lod * 0x27D4EB2F165667C5ull;
+            h ^= h >> 31;
+            return (size_t)h;
+        }
+    };
+
+    struct Region {
+        std::string path;
+        std::vector<IndexEntry> index;
+        uint64_t file_size = 0;
+        FILE *file = nullptr;  // Opened for writing on first write
+        MappedFile mapping;
+        uint64_t last_use = 0;
+    };
+
+    std::string directory;
+    std::mutex mutex;
+    std::unordered_map<RegionKey, Region *, RegionKeyHash> regions;
+    uint64_t use_counter = 0;
+    uint64_t bytes_written = 0;
+
+    static RegionKey region_key_of(int32_t cx, int32_t cy, int32_t cz, int32_t lod, int &r_local_index);
+    Region *get_region(const RegionKey &key);
+    void close_region(Region *region);
+    bool open_for_write(Region *region);
+    bool write_index_entry(Region *region, int local_index);
+};
+
+#endif // REGION_STORE_H
@@ -1,6 +1,9 @@
 #include "register_types.h"
 #include "test_native_class.h"
+#include "gpu_context.h"
 #include "native_terrain_generator.h"
+#include "native_vegetation_atlas.h"
+#include "native_vegetation_culler.h"
 #include "native_vegetation_dispatcher.h"
 
 #include <gdextension_interface.h>
@@ -23,12 +26,22 @@ void initialize_erathia_terrain_module(ModuleInitializationLevel p_level) {
     ClassDB::register_class<NativeTerrainTest>();
     UtilityFunctions::print("[Erathia] ✓ NativeTerrainTest registered");
     
+    // Shared device for the classes below; created on demand from C++, never from scripts
+    ClassDB::register_abstract_class<NativeGPUContext>();
+    UtilityFunctions::print("[Erathia] ✓ NativeGPUContext registered");
+    
     ClassDB::register_class<NativeTerrainGenerator>();
     UtilityFunctions::print("[Erathia] ✓ NativeTerrainGenerator registered");
     
     ClassDB::register_class<NativeVegetationDispatcher>();
     UtilityFunctions::print("[Erathia] ✓ NativeVegetationDispatcher registered");
     
+    ClassDB::register_class<NativeVegetationAtlas>();
+    UtilityFunctions::print("[Erathia] ✓ NativeVegetationAtlas registered");
+    
+    ClassDB::register_class<NativeVegetationCuller>();
+    UtilityFunctions::print("[Erathia] ✓ NativeVegetationCuller registered");
+    
     UtilityFunctions::print("[Erathia] === All classes registered successfully ===");
 }
 
@@ -0,0 +1,217 @@
+#include "trace_recorder.h"
+
+#include <godot_cpp/classes/time.hpp>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> TraceRecorder::enabled(false);
+
+namespace {
+
+struct TraceEvent {
+    const char *category;
+    const char *name;
+    uint64_t start_us;
+    uint64_t duration_us;
+    int32_t origin[3];
+    int32_t lod;
+    int32_t count;
+};
+
+// The payload is stored as relaxed atomic words so a racing export reads stale or torn values,
+// never undefined ones; the sequence check then discards torn slots
+enum SlotWord {
+    WORD_CATEGORY,
+    WORD_NAME,
+    WORD_START,
+    WORD_DURATION,
+    WORD_ORIGIN_XY,
+    WORD_ORIGIN_Z_LOD,
+    WORD_COUNT,
+    WORD_MAX,
+};
+
+struct TraceSlot {
+    // Odd while the owner thread writes the slot, 2 * (write index + 1) once it is complete
+    std::atomic<uint64_t> sequence{ 0 };
+    std::atomic<uint64_t> words[WORD_MAX] = {};
+};
+
+uint64_t pack_pair(int32_t a, int32_t b) {
+    return ((uint64_t)(uint32_t)a << 32) | (uint32_t)b;
+}
+
+int32_t unpack_high(uint64_t word) {
+    return (int32_t)(uint32_t)(word >> 32);
+}
+
+int32_t unpack_low(uint64_t word) {
+    return (int32_t)(uint32_t)word;
+}
+
+struct ThreadRing {
+    std::unique_ptr<TraceSlot[]> slots{ new TraceSlot[TraceRecorder::EVENTS_PER_THREAD] };
+    std::atomic<uint64_t> write_index{ 0 };  // Written by the owner thread only
+    std::atomic<uint64_t> clear_index{ 0 };  // Events before this were cleared
+    int thread_id = 0;
+    char thread_name[32] = {};
+};
+
+// Rings are never freed: a slot may be read by an export after its thread has exited
+std::mutex registry_mutex;
+std::vector<ThreadRing *> registry;
+
+// A thread gets its ring on its first event, so threads that never record while tracing is
+// enabled cost no memory; a name set before that waits in thread_name
+thread_local ThreadRing *thread_ring = nullptr;
+thread_local char thread_name[32] = {};
+
+ThreadRing *get_thread_ring() {
+    if (!thread_ring) {
+        ThreadRing *ring = new ThreadRing();
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        ring->thread_id = (int)registry.size() + 1;
+        if (thread_name[0] != '\0') {
+            std::snprintf(ring->thread_name, sizeof(ring->thread_name), "%s", thread_name);
+        } else {
+            std::snprintf(ring->thread_name, sizeof(ring->thread_name), "Thread %d", ring->thread_id);
+        }
+        registry.push_back(ring);
+        thread_ring = ring;
+    }
+    return thread_ring;
+}
+
+} // namespace
+
+void TraceRecorder::set_enabled(bool p_enabled) {
+    enabled.store(p_enabled, std::memory_order_relaxed);
+}
+
+uint64_t TraceRecorder::now_us() {
+    return Time::get_singleton()->get_ticks_usec();
+}
+
+void TraceRecorder::record(const char *category, const char *name, uint64_t start_us, uint64_t end_us,
+        const Vector3i &chunk_origin, int lod, int count) {
+    if (!is_enabled()) {
+        return;
+    }
+    ThreadRing *ring = get_thread_ring();
+    const uint64_t index = ring->write_index.load(std::memory_order_relaxed);
+    TraceSlot &slot = ring->slots[index % EVENTS_PER_THREAD];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.words[WORD_CATEGORY].store((uint64_t)(uintptr_t)category, std::memory_order_relaxed);
+    slot.words[WORD_NAME].store((uint64_t)(uintptr_t)name, std::memory_order_relaxed);
+    slot.words[WORD_START].store(start_us, std::memory_order_relaxed);
+    slot.words[WORD_DURATION].store(end_us > start_us ? end_us - start_us : 0, std::memory_order_relaxed);
+    slot.words[WORD_ORIGIN_XY].store(pack_pair(chunk_origin.x, chunk_origin.y), std::memory_order_relaxed);
+    slot.words[WORD_ORIGIN_Z_LOD].store(pack_pair(chunk_origin.z, lod), std::memory_order_relaxed);
+    slot.words[WORD_COUNT].store((uint64_t)(uint32_t)count, std::memory_order_relaxed);
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+    ring->write_index.store(index + 1, std::memory_order_release);
+}
+
+void TraceRecorder::set_thread_name(const char *name) {
+    std::snprintf(thread_name, sizeof(thread_name), "%s", name);
+    if (thread_ring) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        std::snprintf(thread_ring->thread_name, sizeof(thread_ring->thread_name), "%s", name);
+    }
+}
+
+std::string TraceRecorder::export_chrome_json() {
+    std::vector<ThreadRing *> rings;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        rings = registry;
+    }
+
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    char line[384];
+    for (ThreadRing *ring : rings) {
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            std::snprintf(line, sizeof(line), "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                    first ? "" : ",", ring->thread_id, ring->thread_name);
+        }
+        json += line;
+        first = false;
+
+        const uint64_t end = ring->write_index.load(std::memory_order_acquire);
+        uint64_t begin = end > (uint64_t)EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0;
+        begin = std::max(begin, ring->clear_index.load(std::memory_order_relaxed));
+        for (uint64_t index = begin; index < end; index++) {
+            const TraceSlot &slot = ring->slots[index % EVENTS_PER_THREAD];
+            if (slot.sequence.load(std::memory_order_acquire) != 2 * index + 2) {
+                continue;  // Overwritten since end was read
+            }
+            uint64_t words[WORD_MAX];
+            for (int w = 0; w < WORD_MAX; w++) {
+                words[w] = slot.words[w].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != 2 * index + 2) {
+                continue;
+            }
+            TraceEvent event;
+            event.category = (const char *)(uintptr_t)words[WORD_CATEGORY];
+            event.name = (const char *)(uintptr_t)words[WORD_NAME];
+            event.start_us = words[WORD_START];
+            event.duration_us = words[WORD_DURATION];
+            event.origin[0] = unpack_high(words[WORD_ORIGIN_XY]);
+            event.origin[1] = unpack_low(words[WORD_ORIGIN_XY]);
+            event.origin[2] = unpack_high(words[WORD_ORIGIN_Z_LOD]);
+            event.lod = unpack_low(words[WORD_ORIGIN_Z_LOD]);
+            event.count = (int32_t)(uint32_t)words[WORD_COUNT];
+
+            int written = std::snprintf(line, sizeof(line), ",{\"ph\":\"X\",\"cat\":\"%s\",\"name\":\"%s\",\"pid\":1,\"tid\":%d,\"ts\":%" PRIu64 ",\"dur\":%" PRIu64,
+                    event.category, event.name, ring->thread_id, event.start_us, event.duration_us);
+            json.append(line, std::min<size_t>((size_t)written, sizeof(line) - 1));
+            if (event.lod >= 0 || event.count >= 0) {
+                json += ",\"args\":{";
+                if (event.lod >= 0) {
+                    std::snprintf(line, sizeof(line), "\"chunk\":\"%d,%d,%d\",\"lod\":%d",
+                            event.origin[0], event.origin[1], event.origin[2], event.lod);
+                    json += line;
+                }
+                if (event.count >= 0) {
+                    std::snprintf(line, sizeof(line), "%s\"count\":%d", event.lod >= 0 ? "," : "", event.count);
+                    json += line;
+                }
+                json += "}";
+            }
+            json += "}";
+        }
+    }
+    json += "]}";
+    return json;
+}
+
+void TraceRecorder::clear() {
+    // Rings belong to their threads: clearing only moves each ring's export start forward
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (ThreadRing *ring : registry) {
+        ring->clear_index.store(ring->write_index.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+int TraceRecorder::get_event_count() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    uint64_t count = 0;
+    for (ThreadRing *ring : registry) {
+        const uint64_t end = ring->write_index.load(std::memory_order_acquire);
+        uint64_t begin = end > (uint64_t)EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0;
+        begin = std::max(begin, ring->clear_index.load(std::memory_order_relaxed));
+        count += end - begin;
+    }
+    return (int)count;
+}
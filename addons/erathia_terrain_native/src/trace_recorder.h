@@ -0,0 +1,72 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <godot_cpp/variant/vector3i.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+using namespace godot;
+
+// TraceRecorder: process-wide span log for the terrain and vegetation hot paths
+// Each thread appends to its own fixed-size ring (the oldest events are overwritten), so recording
+// is wait-free and never contends with other threads; a ring is allocated and registered on its
+// thread's first event recorded while tracing is enabled.
+// Slots carry a sequence number, so an export that races a writer skips that slot instead of
+// reading it half written. Disabled by default; a disabled span costs one relaxed load.
+// Timestamps are Time::get_ticks_usec(), the clock the generator already stamps requests with,
+// so spans that start on one thread and end on another can be recorded after the fact.
+class TraceRecorder {
+public:
+    static constexpr int EVENTS_PER_THREAD = 16384;
+
+    static void set_enabled(bool enabled);
+    static bool is_enabled() { return enabled.load(std::memory_order_relaxed); }
+    static uint64_t now_us();
+
+    // lod < 0: the span is not about one chunk. count < 0: no item count (e.g. chunks in a batch).
+    // category and name must be string literals (only the pointer is stored).
+    static void record(const char *category, const char *name, uint64_t start_us, uint64_t end_us,
+            const Vector3i &chunk_origin = Vector3i(), int lod = -1, int count = -1);
+    // Shown as the thread's track name in trace viewers; allocates nothing until the thread records
+    static void set_thread_name(const char *name);
+
+    // Chrome trace event format (chrome://tracing, ui.perfetto.dev), oldest event first per thread
+    static std::string export_chrome_json();
+    static void clear();
+    static int get_event_count();
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+// Records [construction, destruction) when tracing was enabled at construction
+class TraceSpan {
+public:
+    TraceSpan(const char *p_category, const char *p_name) :
+            category(p_category), name(p_name), start_us(TraceRecorder::is_enabled() ? TraceRecorder::now_us() : 0) {}
+    TraceSpan(const char *p_category, const char *p_name, const Vector3i &p_origin, int p_lod) :
+            category(p_category), name(p_name), start_us(TraceRecorder::is_enabled() ? TraceRecorder::now_us() : 0),
+            origin(p_origin), lod(p_lod) {}
+    ~TraceSpan() {
+        if (start_us != 0) {
+            TraceRecorder::record(category, name, start_us, TraceRecorder::now_us(), origin, lod, count);
+        }
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+    void set_count(int p_count) { count = p_count; }
+
+private:
+    const char *category;
+    const char *name;
+    uint64_t start_us;
+    Vector3i origin;
+    int lod = -1;
+    int count = -1;
+};
+
+#endif // TRACE_RECORDER_H
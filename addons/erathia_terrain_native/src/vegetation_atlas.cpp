@@ -0,0 +1,261 @@
+#include "vegetation_atlas.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+const uint32_t ATLAS_MAGIC = 0x31415645u;  // "EVA1"
+const uint32_t ATLAS_VERSION = 1;
+const uint64_t HEADER_SIZE = 64;
+const uint64_t GROUP_ENTRY_SIZE = 32;
+const uint64_t CHUNK_ENTRY_SIZE = 16;
+const uint64_t INSTANCE_SIZE = VegetationAtlas::FLOATS_PER_INSTANCE * sizeof(float);
+
+void encode_group(const VegetationAtlas::Group &group, uint8_t *raw) {
+    std::memcpy(raw, &group.biome, 4);
+    std::memcpy(raw + 4, &group.type, 4);
+    std::memcpy(raw + 8, &group.variant, 4);
+    std::memcpy(raw + 12, &group.chunk_count, 4);
+    std::memcpy(raw + 16, &group.first_chunk, 4);
+    std::memcpy(raw + 20, &group.instance_count, 4);
+    std::memcpy(raw + 24, &group.first_instance, 8);
+}
+
+VegetationAtlas::Group decode_group(const uint8_t *raw) {
+    VegetationAtlas::Group group;
+    std::memcpy(&group.biome, raw, 4);
+    std::memcpy(&group.type, raw + 4, 4);
+    std::memcpy(&group.variant, raw + 8, 4);
+    std::memcpy(&group.chunk_count, raw + 12, 4);
+    std::memcpy(&group.first_chunk, raw + 16, 4);
+    std::memcpy(&group.instance_count, raw + 20, 4);
+    std::memcpy(&group.first_instance, raw + 24, 8);
+    return group;
+}
+
+void encode_chunk(const VegetationAtlas::Chunk &chunk, uint8_t *raw) {
+    std::memcpy(raw, &chunk.x, 4);
+    std::memcpy(raw + 4, &chunk.z, 4);
+    std::memcpy(raw + 8, &chunk.instance_count, 4);
+    std::memcpy(raw + 12, &chunk.first_instance, 4);
+}
+
+VegetationAtlas::Chunk decode_chunk(const uint8_t *raw) {
+    VegetationAtlas::Chunk chunk;
+    std::memcpy(&chunk.x, raw, 4);
+    std::memcpy(&chunk.z, raw + 4, 4);
+    std::memcpy(&chunk.instance_count, raw + 8, 4);
+    std::memcpy(&chunk.first_instance, raw + 12, 4);
+    return chunk;
+}
+
+inline bool chunk_before(const VegetationAtlas::Chunk &chunk, int32_t x, int32_t z) {
+    return chunk.z < z || (chunk.z == z && chunk.x < x);
+}
+
+} // namespace
+
+// Builder
+
+void VegetationAtlas::Builder::add(int32_t biome, int32_t type, int32_t variant, int32_t chunk_x, int32_t chunk_z,
+        const float *transforms, uint32_t p_instance_count) {
+    if (p_instance_count == 0) {
+        return;
+    }
+    PendingGroup &group = groups[std::make_tuple(biome, type, variant)];
+    Chunk chunk;
+    chunk.x = chunk_x;
+    chunk.z = chunk_z;
+    chunk.instance_count = p_instance_count;
+    chunk.first_instance = (uint32_t)(group.transforms.size() / FLOATS_PER_INSTANCE);
+    group.chunks.push_back(chunk);
+    group.transforms.insert(group.transforms.end(), transforms, transforms + (size_t)p_instance_count * FLOATS_PER_INSTANCE);
+    instance_count += p_instance_count;
+}
+
+bool VegetationAtlas::Builder::write(const std::string &path, const Info &info, uint64_t &r_bytes) const {
+    r_bytes = 0;
+
+    uint32_t total_chunks = 0;
+    for (const auto &pair : groups) {
+        total_chunks += (uint32_t)pair.second.chunks.size();
+    }
+
+    uint32_t header[16] = {};
+    header[0] = ATLAS_MAGIC;
+    header[1] = ATLAS_VERSION;
+    std::memcpy(&header[2], &info.world_seed, 4);
+    std::memcpy(&header[3], &info.chunk_size, 4);
+    header[4] = (uint32_t)groups.size();
+    header[5] = total_chunks;
+    std::memcpy(&header[6], &instance_count, 8);
+    std::memcpy(&header[8], info.bounds, 16);
+
+    // Group and chunk tables are small next to the transforms: build them in memory, stream the rest
+    std::vector<uint8_t> tables((size_t)(groups.size() * GROUP_ENTRY_SIZE + total_chunks * CHUNK_ENTRY_SIZE));
+    uint8_t *group_raw = tables.data();
+    uint8_t *chunk_raw = tables.data() + groups.size() * GROUP_ENTRY_SIZE;
+    uint32_t first_chunk = 0;
+    uint64_t first_instance = 0;
+    for (const auto &pair : groups) {
+        Group group;
+        group.biome = std::get<0>(pair.first);
+        group.type = std::get<1>(pair.first);
+        group.variant = std::get<2>(pair.first);
+        group.chunk_count = (uint32_t)pair.second.chunks.size();
+        group.first_chunk = first_chunk;
+        group.instance_count = (uint32_t)(pair.second.transforms.size() / FLOATS_PER_INSTANCE);
+        group.first_instance = first_instance;
+        encode_group(group, group_raw);
+        group_raw += GROUP_ENTRY_SIZE;
+        for (const Chunk &chunk : pair.second.chunks) {
+            encode_chunk(chunk, chunk_raw);
+            chunk_raw += CHUNK_ENTRY_SIZE;
+        }
+        first_chunk += group.chunk_count;
+        first_instance += group.instance_count;
+    }
+
+    const std::string temp_path = path + ".tmp";
+    FILE *file = std::fopen(temp_path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fwrite(header, 1, HEADER_SIZE, file) == HEADER_SIZE &&
+            std::fwrite(tables.data(), 1, tables.size(), file) == tables.size();
+    for (const auto &pair : groups) {
+        if (!ok) {
+            break;
+        }
+        const std::vector<float> &transforms = pair.second.transforms;
+        ok = std::fwrite(transforms.data(), sizeof(float), transforms.size(), file) == transforms.size();
+    }
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    // rename() does not replace an existing file on Windows
+    std::remove(path.c_str());
+#endif
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    r_bytes = HEADER_SIZE + tables.size() + instance_count * INSTANCE_SIZE;
+    return true;
+}
+
+// VegetationAtlas
+
+bool VegetationAtlas::open(const std::string &path) {
+    close();
+    if (!mapping.open(path) || mapping.size() < HEADER_SIZE) {
+        mapping.close();
+        return false;
+    }
+
+    uint32_t header[16];
+    std::memcpy(header, mapping.data(), HEADER_SIZE);
+    if (header[0] != ATLAS_MAGIC || header[1] != ATLAS_VERSION) {
+        mapping.close();
+        return false;
+    }
+    std::memcpy(&info.world_seed, &header[2], 4);
+    std::memcpy(&info.chunk_size, &header[3], 4);
+    group_count = header[4];
+    chunk_count = header[5];
+    std::memcpy(&instance_count, &header[6], 8);
+    std::memcpy(info.bounds, &header[8], 16);
+
+    group_offset = HEADER_SIZE;
+    chunk_offset = group_offset + (uint64_t)group_count * GROUP_ENTRY_SIZE;
+    data_offset = chunk_offset + (uint64_t)chunk_count * CHUNK_ENTRY_SIZE;
+    // A truncated file (e.g. a copy cut short) must not be read past its end
+    if (data_offset + instance_count * INSTANCE_SIZE != (uint64_t)mapping.size()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void VegetationAtlas::close() {
+    mapping.close();
+    info = Info();
+    instance_count = 0;
+    group_count = 0;
+    chunk_count = 0;
+    group_offset = 0;
+    chunk_offset = 0;
+    data_offset = 0;
+}
+
+VegetationAtlas::Group VegetationAtlas::get_group(int index) const {
+    return decode_group(mapping.data() + group_offset + (uint64_t)index * GROUP_ENTRY_SIZE);
+}
+
+int VegetationAtlas::find_group(int32_t biome, int32_t type, int32_t variant) const {
+    const auto key = std::make_tuple(biome, type, variant);
+    int low = 0;
+    int high = (int)group_count - 1;
+    while (low <= high) {
+        const int mid = (low + high) / 2;
+        const Group group = get_group(mid);
+        const auto mid_key = std::make_tuple(group.biome, group.type, group.variant);
+        if (mid_key == key) {
+            return mid;
+        }
+        if (mid_key < key) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return -1;
+}
+
+VegetationAtlas::Chunk VegetationAtlas::get_chunk(const Group &group, uint32_t index) const {
+    return decode_chunk(mapping.data() + chunk_offset + ((uint64_t)group.first_chunk + index) * CHUNK_ENTRY_SIZE);
+}
+
+const float *VegetationAtlas::get_transforms(const Group &group, uint64_t instance) const {
+    return reinterpret_cast<const float *>(mapping.data() + data_offset + (group.first_instance + instance) * INSTANCE_SIZE);
+}
+
+void VegetationAtlas::find_runs(const Group &group, int32_t x0, int32_t z0, int32_t x1, int32_t z1,
+        std::vector<std::pair<uint64_t, uint32_t>> &r_runs) const {
+    r_runs.clear();
+    if (x1 < x0 || z1 < z0) {
+        return;
+    }
+
+    // First chunk at or after (x0, z0)
+    uint32_t low = 0;
+    uint32_t high = group.chunk_count;
+    while (low < high) {
+        const uint32_t mid = (low + high) / 2;
+        if (chunk_before(get_chunk(group, mid), x0, z0)) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    for (uint32_t i = low; i < group.chunk_count; i++) {
+        const Chunk chunk = get_chunk(group, i);
+        if (chunk.z > z1) {
+            break;
+        }
+        if (chunk.x < x0 || chunk.x > x1) {
+            continue;
+        }
+        if (!r_runs.empty() && r_runs.back().first + r_runs.back().second == chunk.first_instance) {
+            r_runs.back().second += chunk.instance_count;
+        } else {
+            r_runs.emplace_back((uint64_t)chunk.first_instance, chunk.instance_count);
+        }
+    }
+}
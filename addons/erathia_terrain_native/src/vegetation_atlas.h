@@ -0,0 +1,99 @@
+#ifndef VEGETATION_ATLAS_H
+#define VEGETATION_ATLAS_H
+
+#include "region_store.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// VegetationAtlas: prebaked vegetation instances of a world in one memory-mapped file
+// File layout (little-endian): 64-byte header, group table, chunk table, then transforms.
+// A group is one (biome, type, variant), i.e. one MultiMesh; its chunks are sorted by (z, x) and
+// their instances are contiguous, so a whole group or a row of its chunks is one copy from the
+// mapping into a MultiMesh buffer. Transforms are 12 floats in MultiMesh TRANSFORM_3D order.
+// Read-only once opened; safe to read from several threads.
+class VegetationAtlas {
+public:
+    static constexpr int FLOATS_PER_INSTANCE = 12;
+
+    struct Group {
+        int32_t biome;
+        int32_t type;
+        int32_t variant;
+        uint32_t chunk_count;
+        uint32_t first_chunk;  // Into the chunk table
+        uint32_t instance_count;
+        uint64_t first_instance;
+    };
+
+    // Chunk column (origin / chunk_size, floored), and its instances within the group
+    struct Chunk {
+        int32_t x;
+        int32_t z;
+        uint32_t instance_count;
+        uint32_t first_instance;  // Relative to the group's first instance
+    };
+
+    struct Info {
+        int32_t world_seed = 0;
+        int32_t chunk_size = 0;
+        float bounds[4] = {};  // x, z, size_x, size_z of the prebaked area
+    };
+
+    // Collects a prebake in memory and writes it in one pass. Chunks of each group must be added
+    // in (z, x) order, once per group.
+    class Builder {
+    public:
+        void add(int32_t biome, int32_t type, int32_t variant, int32_t chunk_x, int32_t chunk_z,
+                const float *transforms, uint32_t instance_count);
+        // Written next to path and renamed over it, so readers of an older atlas never see half a file
+        bool write(const std::string &path, const Info &info, uint64_t &r_bytes) const;
+
+        uint64_t get_instance_count() const { return instance_count; }
+        size_t get_group_count() const { return groups.size(); }
+
+    private:
+        struct PendingGroup {
+            std::vector<Chunk> chunks;
+            std::vector<float> transforms;
+        };
+        std::map<std::tuple<int32_t, int32_t, int32_t>, PendingGroup> groups;
+        uint64_t instance_count = 0;
+    };
+
+    bool open(const std::string &path);
+    void close();
+    bool is_open() const { return mapping.data() != nullptr; }
+
+    const Info &get_info() const { return info; }
+    uint64_t get_instance_count() const { return instance_count; }
+    size_t get_file_size() const { return mapping.size(); }
+
+    int get_group_count() const { return (int)group_count; }
+    Group get_group(int index) const;
+    int find_group(int32_t biome, int32_t type, int32_t variant) const;  // -1 when absent
+    Chunk get_chunk(const Group &group, uint32_t index) const;
+    // First instance of the group with the given offset, FLOATS_PER_INSTANCE floats each
+    const float *get_transforms(const Group &group, uint64_t instance) const;
+
+    // Chunks of the group with x in [x0, x1] and z in [z0, z1], as runs of contiguous instances
+    // {first instance within the group, count}; one run per chunk row
+    void find_runs(const Group &group, int32_t x0, int32_t z0, int32_t x1, int32_t z1,
+            std::vector<std::pair<uint64_t, uint32_t>> &r_runs) const;
+
+private:
+    MappedFile mapping;
+    Info info;
+    uint64_t instance_count = 0;
+    uint32_t group_count = 0;
+    uint32_t chunk_count = 0;
+    uint64_t group_offset = 0;
+    uint64_t chunk_offset = 0;
+    uint64_t data_offset = 0;
+};
+
+#endif // VEGETATION_ATLAS_H
@@ -0,0 +1,238 @@
+#include "voxel_bulk_copy.h"
+
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VOXEL_BULK_COPY_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define VOXEL_BULK_COPY_NEON
+#endif
+
+namespace {
+
+// Scalar reference; float -> integer conversion truncates toward zero like VoxelBuffer's snorm_to_s*
+inline float clamp_snorm(float v) {
+    return v < -1.0f ? -1.0f : (v > 1.0f ? 1.0f : v);
+}
+
+void quantize_row_s16(const float *src, int16_t *dst, int count, float scale) {
+    int i = 0;
+#if defined(VOXEL_BULK_COPY_SSE2)
+    const __m128 vscale = _mm_set1_ps(scale);
+    const __m128 vmin = _mm_set1_ps(-1.0f);
+    const __m128 vmax = _mm_set1_ps(1.0f);
+    const __m128 vrange = _mm_set1_ps(32767.0f);
+    for (; i + 8 <= count; i += 8) {
+        __m128 a = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i), vscale), vmin), vmax), vrange);
+        __m128 b = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i + 4), vscale), vmin), vmax), vrange);
+        __m128i packed = _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), packed);
+    }
+#elif defined(VOXEL_BULK_COPY_NEON)
+    const float32x4_t vscale = vdupq_n_f32(scale);
+    const float32x4_t vmin = vdupq_n_f32(-1.0f);
+    const float32x4_t vmax = vdupq_n_f32(1.0f);
+    const float32x4_t vrange = vdupq_n_f32(32767.0f);
+    for (; i + 8 <= count; i += 8) {
+        float32x4_t a = vmulq_f32(vminq_f32(vmaxq_f32(vmulq_f32(vld1q_f32(src + i), vscale), vmin), vmax), vrange);
+        float32x4_t b = vmulq_f32(vminq_f32(vmaxq_f32(vmulq_f32(vld1q_f32(src + i + 4), vscale), vmin), vmax), vrange);
+        vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(vcvtq_s32_f32(a)), vqmovn_s32(vcvtq_s32_f32(b))));
+    }
+#endif
+    for (; i < count; i++) {
+        dst[i] = static_cast<int16_t>(clamp_snorm(src[i] * scale) * 32767.0f);
+    }
+}
+
+void quantize_row_s8(const float *src, int8_t *dst, int count, float scale) {
+    int i = 0;
+#if defined(VOXEL_BULK_COPY_SSE2)
+    const __m128 vscale = _mm_set1_ps(scale);
+    const __m128 vmin = _mm_set1_ps(-1.0f);
+    const __m128 vmax = _mm_set1_ps(1.0f);
+    const __m128 vrange = _mm_set1_ps(127.0f);
+    for (; i + 16 <= count; i += 16) {
+        __m128i q[4];
+        for (int k = 0; k < 4; k++) {
+            __m128 v = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i + k * 4), vscale), vmin), vmax), vrange);
+            q[k] = _mm_cvttps_epi32(v);
+        }
+        __m128i lo = _mm_packs_epi32(q[0], q[1]);
+        __m128i hi = _mm_packs_epi32(q[2], q[3]);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packs_epi16(lo, hi));
+    }
+#elif defined(VOXEL_BULK_COPY_NEON)
+    const float32x4_t vscale = vdupq_n_f32(scale);
+    const float32x4_t vmin = vdupq_n_f32(-1.0f);
+    const float32x4_t vmax = vdupq_n_f32(1.0f);
+    const float32x4_t vrange = vdupq_n_f32(127.0f);
+    for (; i + 8 <= count; i += 8) {
+        float32x4_t a = vmulq_f32(vminq_f32(vmaxq_f32(vmulq_f32(vld1q_f32(src + i), vscale), vmin), vmax), vrange);
+        float32x4_t b = vmulq_f32(vminq_f32(vmaxq_f32(vmulq_f32(vld1q_f32(src + i + 4), vscale), vmin), vmax), vrange);
+        int16x8_t s16 = vcombine_s16(vqmovn_s32(vcvtq_s32_f32(a)), vqmovn_s32(vcvtq_s32_f32(b)));
+        vst1_s8(dst + i, vqmovn_s16(s16));
+    }
+#endif
+    for (; i < count; i++) {
+        dst[i] = static_cast<int8_t>(clamp_snorm(src[i] * scale) * 127.0f);
+    }
+}
+
+// IEEE 754 binary16 -> binary32, including subnormals, infinities and NaN
+inline float half_to_float(uint16_t h) {
+    uint32_t sign = (uint32_t)(h & 0x8000u) << 16;
+    uint32_t exponent = (h >> 10) & 0x1Fu;
+    uint32_t mantissa = h & 0x3FFu;
+    uint32_t bits;
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // Subnormal: normalize the mantissa
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400u) == 0) {
+                mantissa <<= 1;
+                exponent--;
+            }
+            mantissa &= 0x3FFu;
+            bits = sign | (exponent << 23) | (mantissa << 13);
+        }
+    } else if (exponent == 0x1Fu) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + (127 - 15)) << 23) | (mantissa << 13);
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+template <typename S, typename T>
+void narrow_row(const S *src, T *dst, int count) {
+    for (int i = 0; i < count; i++) {
+        dst[i] = static_cast<T>(src[i]);
+    }
+}
+
+// Converts one Z slice at a time into a contiguous scratch (SIMD-friendly), checks it for
+// uniformity, then transposes it from (y, x) to the VoxelBuffer's (x, y) layout.
+template <typename S, typename T, typename RowFn>
+bool convert_chunk(const S *src, T *dst, int size, RowFn row_fn) {
+    const size_t slice = (size_t)size * (size_t)size;
+    thread_local std::vector<T> scratch;
+    scratch.resize(slice);
+    T *tmp = scratch.data();
+
+    bool uniform = true;
+    T first;
+
+    for (int z = 0; z < size; z++) {
+        const S *src_slice = src + (size_t)z * slice;
+        T *dst_slice = dst + (size_t)z * slice;
+
+        for (int y = 0; y < size; y++) {
+            row_fn(src_slice + (size_t)y * size, tmp + (size_t)y * size, size);
+        }
+
+        if (z == 0) {
+            std::memcpy(&first, tmp, sizeof(T));
+        }
+        if (uniform) {
+            for (size_t i = 0; i < slice; i++) {
+                if (std::memcmp(&tmp[i], &first, sizeof(T)) != 0) {
+                    uniform = false;
+                    break;
+                }
+            }
+        }
+
+        for (int x = 0; x < size; x++) {
+            T *dst_column = dst_slice + (size_t)x * size;
+            for (int y = 0; y < size; y++) {
+                dst_column[y] = tmp[(size_t)y * size + x];
+            }
+        }
+    }
+
+    return uniform;
+}
+
+} // namespace
+
+bool VoxelBulkCopy::quantize_sdf_s8(const float *src, int8_t *dst, int size, float scale) {
+    return convert_chunk(src, dst, size, [scale](const float *s, int8_t *d, int n) {
+        quantize_row_s8(s, d, n, scale);
+    });
+}
+
+bool VoxelBulkCopy::quantize_sdf_s16(const float *src, int16_t *dst, int size, float scale) {
+    return convert_chunk(src, dst, size, [scale](const float *s, int16_t *d, int n) {
+        quantize_row_s16(s, d, n, scale);
+    });
+}
+
+bool VoxelBulkCopy::copy_sdf_f32(const float *src, float *dst, int size) {
+    return convert_chunk(src, dst, size, [](const float *s, float *d, int n) {
+        std::memcpy(d, s, (size_t)n * sizeof(float));
+    });
+}
+
+bool VoxelBulkCopy::copy_sdf_s16(const int16_t *src, int16_t *dst, int size) {
+    return convert_chunk(src, dst, size, [](const int16_t *s, int16_t *d, int n) {
+        std::memcpy(d, s, (size_t)n * sizeof(int16_t));
+    });
+}
+
+bool VoxelBulkCopy::narrow_indices_u8(const uint32_t *src, uint8_t *dst, int size) {
+    return convert_chunk(src, dst, size, [](const uint32_t *s, uint8_t *d, int n) {
+        narrow_row(s, d, n);
+    });
+}
+
+bool VoxelBulkCopy::narrow_indices_u16(const uint32_t *src, uint16_t *dst, int size) {
+    return convert_chunk(src, dst, size, [](const uint32_t *s, uint16_t *d, int n) {
+        narrow_row(s, d, n);
+    });
+}
+
+bool VoxelBulkCopy::copy_indices_u32(const uint32_t *src, uint32_t *dst, int size) {
+    return convert_chunk(src, dst, size, [](const uint32_t *s, uint32_t *d, int n) {
+        std::memcpy(d, s, (size_t)n * sizeof(uint32_t));
+    });
+}
+
+bool VoxelBulkCopy::copy_indices_u8(const uint8_t *src, uint8_t *dst, int size) {
+    return convert_chunk(src, dst, size, [](const uint8_t *s, uint8_t *d, int n) {
+        std::memcpy(d, s, (size_t)n);
+    });
+}
+
+bool VoxelBulkCopy::widen_indices_u16(const uint8_t *src, uint16_t *dst, int size) {
+    return convert_chunk(src, dst, size, [](const uint8_t *s, uint16_t *d, int n) {
+        narrow_row(s, d, n);
+    });
+}
+
+bool VoxelBulkCopy::widen_indices_u32(const uint8_t *src, uint32_t *dst, int size) {
+    return convert_chunk(src, dst, size, [](const uint8_t *s, uint32_t *d, int n) {
+        narrow_row(s, d, n);
+    });
+}
+
+void VoxelBulkCopy::decode_f16(const uint16_t *src, float *dst, int count) {
+    for (int i = 0; i < count; i++) {
+        dst[i] = half_to_float(src[i]);
+    }
+}
+
+void VoxelBulkCopy::decode_snorm16(const int16_t *src, float *dst, int count, float inv_scale) {
+    // Same mapping as the GPU's SNORM fetch: max(s / 32767, -1), then undo the storage scale
+    const float factor = inv_scale / 32767.0f;
+    for (int i = 0; i < count; i++) {
+        float v = (float)src[i] * factor;
+        dst[i] = v < -inv_scale ? -inv_scale : v;
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef VOXEL_BULK_COPY_H
+#define VOXEL_BULK_COPY_H
+
+#include <cstdint>
+
+// VoxelBulkCopy: converts GPU chunk readback into VoxelBuffer channel storage in bulk
+// Sources are size^3 texels in GPU order (x fastest, then y, then z); destinations are in
+// VoxelBuffer ZXY order (y fastest, then x, then z). Every kernel returns true when all
+// written values are identical, so the caller can keep the channel compressed as uniform.
+// SDF quantization matches VoxelBuffer::set_voxel_f (clamp(v * scale, -1, 1) * max, truncated).
+class VoxelBulkCopy {
+public:
+    static bool quantize_sdf_s8(const float *src, int8_t *dst, int size, float scale);
+    static bool quantize_sdf_s16(const float *src, int16_t *dst, int size, float scale);
+    static bool copy_sdf_f32(const float *src, float *dst, int size);
+    // SNORM16 storage that already uses the destination's 16-bit SDF scale: transposed copy only
+    static bool copy_sdf_s16(const int16_t *src, int16_t *dst, int size);
+
+    static bool narrow_indices_u8(const uint32_t *src, uint8_t *dst, int size);
+    static bool narrow_indices_u16(const uint32_t *src, uint16_t *dst, int size);
+    static bool copy_indices_u32(const uint32_t *src, uint32_t *dst, int size);
+    // R8UI material storage
+    static bool copy_indices_u8(const uint8_t *src, uint8_t *dst, int size);
+    static bool widen_indices_u16(const uint8_t *src, uint16_t *dst, int size);
+    static bool widen_indices_u32(const uint8_t *src, uint32_t *dst, int size);
+
+    // Linear decoders (no reordering) for narrow SDF storage, used before quantizing to another depth
+    static void decode_f16(const uint16_t *src, float *dst, int count);
+    static void decode_snorm16(const int16_t *src, float *dst, int count, float inv_scale);
+};
+
+#endif // VOXEL_BULK_COPY_H
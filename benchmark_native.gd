@@ -0,0 +1,234 @@
+extends Node
+
+# Fixed-workload benchmark of the native terrain and vegetation hot paths, for comparing builds.
+# Run through the CMake `benchmark` target or directly:
+#   godot --headless --path . res://benchmark_native.tscn -- --output=results.json --chunks=64
+# Writes one JSON report (latency percentiles, throughput, peak memory) and quits. Headless Godot
+# has no RenderingDevice: GPU workloads are then reported as skipped and only the CPU paths run.
+
+const FIRST_ORIGIN := Vector3i(-4096, -32, -4096)
+const VEG_TYPES: Array[int] = [0, 1, 2, 3, 4]  # VegetationManager.VegetationType TREE..GRASS_TUFT
+
+var chunk_count: int = 64
+var output_path: String = "user://benchmark_results.json"
+
+var generator: NativeTerrainGenerator
+var dispatcher: NativeVegetationDispatcher
+var results: Dictionary = {}
+
+func _ready():
+	print("=== Native Terrain/Vegetation Benchmark ===")
+	_parse_args()
+
+	if not ClassDB.class_exists("NativeTerrainGenerator"):
+		push_error("NativeTerrainGenerator class not found! Extension may not be loaded.")
+		get_tree().quit(1)
+		return
+
+	generator = NativeTerrainGenerator.new()
+	# The region cache would turn misses into disk reads
+	generator.set_region_cache_path("")
+	generator.initialize_gpu()
+	var gpu: bool = generator.is_gpu_available()
+	print("GPU: %s (CPU fallback active: %s)" % [generator.get_gpu_status(), generator.is_cpu_fallback_active()])
+
+	bench_sdf_cpu()
+	if gpu:
+		bench_sdf_gpu()
+		await bench_sdf_batched()
+	else:
+		_skip(["sdf_gpu", "sdf_batched"])
+
+	if ClassDB.class_exists("VoxelBuffer") and gpu:
+		bench_generate_block()
+	else:
+		_skip(["generate_block_miss", "generate_block_hit"])
+
+	if ClassDB.class_exists("NativeVegetationDispatcher") and gpu:
+		dispatcher = NativeVegetationDispatcher.new()
+		if dispatcher.initialize_gpu():
+			bench_placements()
+		else:
+			_skip(["placements", "decode_placements"])
+	else:
+		_skip(["placements", "decode_placements"])
+
+	_write_report(gpu)
+	get_tree().quit(0)
+
+func _parse_args():
+	for arg in OS.get_cmdline_user_args():
+		if arg.begins_with("--output="):
+			output_path = arg.trim_prefix("--output=")
+		elif arg.begins_with("--chunks="):
+			chunk_count = max(1, arg.trim_prefix("--chunks=").to_int())
+
+# Unique, LOD 0 aligned origins on a square grid, far from anything generated before
+func _origins(offset: int) -> Array[Vector3i]:
+	var cs := generator.get_chunk_size()
+	var side := int(ceil(sqrt(float(chunk_count))))
+	var origins: Array[Vector3i] = []
+	for i in range(chunk_count):
+		origins.append(FIRST_ORIGIN + Vector3i((i % side) * cs, 0, (i / side + offset * side) * cs))
+	return origins
+
+func bench_sdf_cpu():
+	var samples: Array[float] = []
+	for origin in _origins(0):
+		var start_us = Time.get_ticks_usec()
+		generator.generate_chunk_data(origin, true)
+		samples.append((Time.get_ticks_usec() - start_us) / 1000.0)
+	_record("sdf_cpu", samples)
+
+func bench_sdf_gpu():
+	# One blocking chunk per call: dispatch, sync and readback round trip
+	generator.clear_cache()
+	var samples: Array[float] = []
+	for origin in _origins(1):
+		var start_us = Time.get_ticks_usec()
+		generator.generate_chunk_data(origin, false)
+		samples.append((Time.get_ticks_usec() - start_us) / 1000.0)
+	_record("sdf_gpu", samples)
+
+func bench_sdf_batched():
+	# Full batches through prewarm_region(); one sample per batch-sized share of the run
+	generator.clear_cache()
+	var cs := generator.get_chunk_size()
+	var radius := cs * (pow(float(chunk_count), 1.0 / 3.0) * 0.5)
+	var completion := {}
+	generator.prewarm_completed.connect(func(total: int, failed: int, elapsed_ms: float):
+		completion["total"] = total
+		completion["failed"] = failed
+		completion["elapsed_ms"] = elapsed_ms, CONNECT_ONE_SHOT)
+	var scheduled: int = generator.prewarm_region(Vector3(4096, 0, 4096), radius)
+	while completion.is_empty() and scheduled > 0:
+		generator.poll_prewarm()
+		await get_tree().process_frame
+
+	if completion.is_empty():
+		_skip(["sdf_batched"])
+		return
+	var per_chunk_ms: float = completion.elapsed_ms / max(completion.total, 1)
+	var entry := _summarize([per_chunk_ms])
+	entry["samples"] = completion.total
+	entry["failed"] = completion.failed
+	entry["total_ms"] = completion.elapsed_ms
+	entry["throughput_per_s"] = completion.total / max(completion.elapsed_ms / 1000.0, 0.000001)
+	results["sdf_batched"] = entry
+	print("sdf_batched: %d chunks in %.2f ms (%.1f chunks/s)" % [completion.total, completion.elapsed_ms, entry.throughput_per_s])
+
+func bench_generate_block():
+	# Miss: blocking GPU generation; hit: cache lookup plus the bulk channel write into the buffer
+	generator.clear_cache()
+	var cs := generator.get_chunk_size()
+	var buffer = ClassDB.instantiate("VoxelBuffer")
+	buffer.create(cs, cs, cs)
+	var origins := _origins(2)
+
+	var misses: Array[float] = []
+	for origin in origins:
+		var start_us = Time.get_ticks_usec()
+		generator.generate_block(buffer, origin, 0)
+		misses.append((Time.get_ticks_usec() - start_us) / 1000.0)
+	_record("generate_block_miss", misses)
+
+	var hits: Array[float] = []
+	for origin in origins:
+		var start_us = Time.get_ticks_usec()
+		generator.generate_block(buffer, origin, 0)
+		hits.append((Time.get_ticks_usec() - start_us) / 1000.0)
+	_record("generate_block_hit", hits)
+
+func bench_placements():
+	# Terrain for the placement chunks comes from the generator's cache through the shared context
+	var origins := _origins(3)
+	for origin in origins:
+		generator.generate_chunk_data(origin, false)
+
+	var height_range := {"min": -50.0, "max": 200.0}
+	var decode_samples: Array[float] = []
+	var per_type := {}
+	for veg_type in VEG_TYPES:
+		dispatcher.clear_cache()
+		var samples: Array[float] = []
+		for origin in origins:
+			var decode_before: float = dispatcher.get_telemetry().decode_time_ms
+			var start_us = Time.get_ticks_usec()
+			dispatcher.generate_placements(origin, veg_type, 0.8, 2.0, 0.1, 30.0, height_range, 12345, RID())
+			samples.append((Time.get_ticks_usec() - start_us) / 1000.0)
+			decode_samples.append(dispatcher.get_telemetry().decode_time_ms - decode_before)
+		per_type[str(veg_type)] = _summarize(samples)
+		print("placements[%d]: p50 %.3f ms, p99 %.3f ms" % [veg_type, per_type[str(veg_type)].p50_ms, per_type[str(veg_type)].p99_ms])
+	results["placements"] = per_type
+	_record("decode_placements", decode_samples)
+
+func _record(workload: String, samples: Array[float]):
+	var entry := _summarize(samples)
+	results[workload] = entry
+	print("%s: p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, %.1f/s" % [workload, entry.p50_ms, entry.p95_ms, entry.p99_ms, entry.throughput_per_s])
+
+func _skip(workloads: Array):
+	for workload in workloads:
+		results[workload] = {"skipped": true}
+		print("%s: skipped" % workload)
+
+func _summarize(samples: Array[float]) -> Dictionary:
+	var sorted := samples.duplicate()
+	sorted.sort()
+	var total := 0.0
+	for sample in sorted:
+		total += sample
+	return {
+		"samples": sorted.size(),
+		"p50_ms": _percentile(sorted, 0.50),
+		"p95_ms": _percentile(sorted, 0.95),
+		"p99_ms": _percentile(sorted, 0.99),
+		"max_ms": sorted.back() if not sorted.is_empty() else 0.0,
+		"mean_ms": total / max(sorted.size(), 1),
+		"throughput_per_s": sorted.size() / max(total / 1000.0, 0.000001),
+	}
+
+func _percentile(sorted: Array, fraction: float) -> float:
+	if sorted.is_empty():
+		return 0.0
+	var rank := clampi(int(round(fraction * (sorted.size() - 1))), 0, sorted.size() - 1)
+	return sorted[rank]
+
+# Peak resident set size from /proc on Linux, -1 elsewhere
+func _peak_rss_bytes() -> int:
+	var status := FileAccess.open("/proc/self/status", FileAccess.READ)
+	if not status:
+		return -1
+	while not status.eof_reached():
+		var line := status.get_line()
+		if line.begins_with("VmHWM:"):
+			return line.trim_prefix("VmHWM:").strip_edges().trim_suffix("kB").strip_edges().to_int() * 1024
+	return -1
+
+func _write_report(gpu: bool):
+	var terrain: Dictionary = generator.get_telemetry()
+	var report := {
+		"timestamp": Time.get_datetime_string_from_system(true),
+		"godot_version": Engine.get_version_info().string,
+		"gpu_available": gpu,
+		"gpu_status": generator.get_gpu_status(),
+		"cpu_simd": terrain.get("cpu_simd", ""),
+		"chunk_count": chunk_count,
+		"chunk_size": generator.get_chunk_size(),
+		"storage_mode": generator.get_storage_mode(),
+		"results": results,
+		"memory": {
+			"peak_rss_bytes": _peak_rss_bytes(),
+			"static_peak_bytes": OS.get_static_memory_peak_usage(),
+			"device_memory_peak_bytes": terrain.gpu_context.get("device_memory_peak_bytes", 0),
+		},
+	}
+
+	var json := JSON.stringify(report, "  ")
+	var file := FileAccess.open(output_path, FileAccess.WRITE)
+	if file:
+		file.store_string(json)
+		print("Report written to %s" % ProjectSettings.globalize_path(output_path))
+	else:
+		push_error("Could not write benchmark report to %s" % output_path)
+	print(json)
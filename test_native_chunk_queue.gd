@@ -0,0 +1,355 @@
+extends Node
+
+# Exercises NativeTerrainGenerator's async request scheduler: deduplication, cancellation,
+# distance-based dropping and, when a GPU is available, queue age / time-to-first-chunk telemetry
+# prewarm_region() (also over a region cache that already holds the chunks), collision-only mode
+# (including seams between neighbouring chunks) and hot-path tracing.
+
+const RING_CHUNKS := 3  # Chunks per side of the requested ring, around the origin
+const MAX_FRAMES := 600
+const PREWARM_REGION_PATH := "user://test_chunk_queue_regions"
+
+var generator: NativeTerrainGenerator
+var test_results: Dictionary = {}
+
+func _ready():
+	print("=== Native Chunk Queue Test ===")
+
+	if not ClassDB.class_exists("NativeTerrainGenerator"):
+		push_error("NativeTerrainGenerator class not found! Extension may not be loaded.")
+		return
+
+	generator = NativeTerrainGenerator.new()
+
+	test_deduplication()
+	test_cancellation()
+	test_distance_drop()
+
+	if generator.is_gpu_available():
+		await test_queue_drain()
+		await test_prewarm()
+		await test_prewarm_from_region_cache()
+		await test_collision_only()
+		await test_collision_seams()
+		test_tracing()
+	else:
+		print("⚠ GPU not available, skipping queue drain, prewarm, collision and tracing tests")
+
+	print_test_summary()
+
+func _enqueue_ring(lod: int) -> int:
+	var size = generator.get_chunk_size() << lod
+	var count = 0
+	for x in range(-RING_CHUNKS, RING_CHUNKS + 1):
+		for z in range(-RING_CHUNKS, RING_CHUNKS + 1):
+			generator.enqueue_chunk_request(Vector3i(x * size, 0, z * size), lod, Vector3.ZERO)
+			count += 1
+	return count
+
+func test_deduplication():
+	print("\n--- Test: Deduplication ---")
+
+	var before: int = generator.get_telemetry().requests_deduplicated
+	var count = _enqueue_ring(0)
+	_enqueue_ring(0)
+	var stats = generator.get_telemetry()
+
+	var ok = stats.queue_size == count and stats.requests_deduplicated - before == count
+	test_results["deduplication"] = ok
+	print("%s %d requests queued, %d duplicates ignored" % ["✓" if ok else "✗", stats.queue_size, stats.requests_deduplicated - before])
+
+func test_cancellation():
+	print("\n--- Test: Cancellation ---")
+
+	var queued: int = generator.get_telemetry().queue_size
+	var first = generator.cancel_chunk_request(Vector3i(0, 0, 0), 0)
+	var second = generator.cancel_chunk_request(Vector3i(0, 0, 0), 0)
+	var stats = generator.get_telemetry()
+
+	var ok = first and not second and stats.queue_size == queued - 1
+	test_results["cancellation"] = ok
+	print("%s cancel: %s, repeated cancel: %s, queue %d -> %d" % ["✓" if ok else "✗", first, second, queued, stats.queue_size])
+
+func test_distance_drop():
+	print("\n--- Test: Distance Drop ---")
+
+	# Teleport far away: everything queued around the origin is out of range on the next pass
+	var before: int = generator.get_telemetry().requests_dropped
+	generator.set_max_request_distance(256.0)
+	generator.set_player_position(Vector3(100000, 0, 100000))
+	generator.process_chunk_queue(0.016)
+	var stats = generator.get_telemetry()
+
+	var ok = stats.queue_size == 0 and stats.requests_dropped > before
+	test_results["distance_drop"] = ok
+	print("%s %d requests dropped after teleport" % ["✓" if ok else "✗", stats.requests_dropped - before])
+
+	generator.set_max_request_distance(0.0)
+	generator.set_player_position(Vector3.ZERO)
+
+func test_queue_drain():
+	print("\n--- Test: Queue Drain ---")
+
+	generator.clear_cache()
+	generator.set_view_direction(Vector3(0, 0, -1))
+	var count = _enqueue_ring(0) + _enqueue_ring(1)
+
+	var frames = 0
+	var stats = generator.get_telemetry()
+	var max_age_p99 := 0.0
+	while frames < MAX_FRAMES and (stats.queue_size > 0 or stats.in_flight_chunks > 0):
+		generator.process_chunk_queue(0.016)
+		await get_tree().process_frame
+		stats = generator.get_telemetry()
+		max_age_p99 = maxf(max_age_p99, stats.queue_age_p99_ms)
+		frames += 1
+
+	var ok = stats.queue_size == 0 and stats.time_to_first_chunk_ms > 0.0
+	test_results["queue_drain"] = ok
+	print("%s %d requests drained in %d frames" % ["✓" if ok else "✗", count, frames])
+	print("  time to first chunk: %.2f ms" % stats.time_to_first_chunk_ms)
+	print("  dispatch wait p50/p95/p99: %.2f / %.2f / %.2f ms" % [stats.dispatch_wait_p50_ms, stats.dispatch_wait_p95_ms, stats.dispatch_wait_p99_ms])
+	print("  worst queue age p99: %.2f ms" % max_age_p99)
+
+func test_prewarm():
+	print("\n--- Test: Prewarm Region ---")
+
+	generator.clear_cache()
+	var center := Vector3(1024, 0, -512)
+	var progress_signals := [0]
+	var completion := {}
+	generator.prewarm_progress.connect(func(_completed: int, _total: int): progress_signals[0] += 1)
+	generator.prewarm_completed.connect(func(total: int, failed: int, elapsed_ms: float):
+		completion["total"] = total
+		completion["failed"] = failed
+		completion["elapsed_ms"] = elapsed_ms, CONNECT_ONE_SHOT)
+
+	var scheduled: int = generator.prewarm_region(center, 96.0, PackedFloat32Array([1.0, 2.0]))
+	var frames = 0
+	while frames < MAX_FRAMES and completion.is_empty():
+		generator.poll_prewarm()
+		await get_tree().process_frame
+		frames += 1
+
+	var ok = scheduled > 0 and not completion.is_empty() and completion.total == scheduled and completion.failed == 0 and progress_signals[0] > 0
+	test_results["prewarm"] = ok
+	if completion.is_empty():
+		print("✗ prewarm of %d chunks did not complete in %d frames" % [scheduled, frames])
+	else:
+		print("%s %d chunks prewarmed in %.2f ms (%d progress signals, %d failed)" % ["✓" if ok else "✗", completion.total, completion.elapsed_ms, progress_signals[0], completion.failed])
+
+func test_prewarm_from_region_cache():
+	print("\n--- Test: Prewarm From Region Cache ---")
+
+	# First prewarm generates and stores the chunks; after clear_cache() the second must load them all
+	# into the chunk cache, so generate_block() hits it without generating anything
+	_remove_dir_recursive(ProjectSettings.globalize_path(PREWARM_REGION_PATH))
+	generator.set_region_cache_path(PREWARM_REGION_PATH)
+	generator.clear_cache()
+	var center := Vector3(-1536, 0, 768)
+	var writes_before: int = generator.get_telemetry().region_writes
+	var generated := await _prewarm_and_wait(center, 48.0)
+	var frames := 0
+	while frames < MAX_FRAMES and generator.get_telemetry().region_writes - writes_before < generated:
+		await get_tree().process_frame
+		frames += 1
+
+	generator.clear_cache()
+	var before: Dictionary = generator.get_telemetry()
+	var loaded := await _prewarm_and_wait(center, 48.0)
+	var stats: Dictionary = generator.get_telemetry()
+	var region_hits: int = stats.region_hits - before.region_hits
+
+	var block_hit := true
+	if ClassDB.class_exists("VoxelBuffer"):
+		var cs := generator.get_chunk_size()
+		var buffer = ClassDB.instantiate("VoxelBuffer")
+		buffer.create(cs, cs, cs)
+		var origin := Vector3i(floori(center.x / cs) * cs, floori(center.y / cs) * cs, floori(center.z / cs) * cs)
+		generator.generate_block(buffer, origin, 0)
+		var after: Dictionary = generator.get_telemetry()
+		block_hit = after.cache_hits > stats.cache_hits and after.total_chunks_generated == stats.total_chunks_generated
+
+	generator.set_region_cache_path("")
+	_remove_dir_recursive(ProjectSettings.globalize_path(PREWARM_REGION_PATH))
+
+	var ok = generated > 0 and loaded == generated and region_hits == loaded and stats.cached_chunks == loaded and block_hit
+	test_results["prewarm_from_region_cache"] = ok
+	print("%s %d chunks loaded from %d region hits, %d cached, generate_block %s" % ["✓" if ok else "✗",
+		loaded, region_hits, stats.cached_chunks, "hit the cache" if block_hit else "missed the cache"])
+
+# Chunks prewarmed, or -1 when prewarm_completed did not arrive in time
+func _prewarm_and_wait(center: Vector3, radius: float) -> int:
+	var completion := {}
+	generator.prewarm_completed.connect(func(total: int, _failed: int, _elapsed_ms: float):
+		completion["total"] = total, CONNECT_ONE_SHOT)
+	var scheduled: int = generator.prewarm_region(center, radius, PackedFloat32Array([1.0]))
+	var frames := 0
+	while frames < MAX_FRAMES and completion.is_empty():
+		generator.poll_prewarm()
+		await get_tree().process_frame
+		frames += 1
+	return scheduled if completion.get("total", -1) == scheduled else -1
+
+# The region cache keeps one directory per terrain signature
+func _remove_dir_recursive(path: String):
+	var dir := DirAccess.open(path)
+	if dir == null:
+		return
+	for file in dir.get_files():
+		dir.remove(file)
+	for sub in dir.get_directories():
+		_remove_dir_recursive(path.path_join(sub))
+	DirAccess.remove_absolute(path)
+
+func test_collision_only():
+	print("\n--- Test: Collision-Only Mode ---")
+
+	generator.clear_cache()
+	var before: Dictionary = generator.get_telemetry()
+	var size = generator.get_chunk_size()
+	# The chunks around the generated surface height, so at least one has faces
+	var height: float = generator.sample_surface(PackedVector2Array([Vector2(4096, 4096)])).heights[0]
+	var surface_y = floori(height / size) * size
+	var origins: Array[Vector3i] = []
+	for y in range(-1, 2):
+		origins.append(Vector3i(4096, surface_y + y * size, 4096))
+	var stats = await _generate_collision_chunks(origins)
+
+	# Surface chunks carry a face list and no CPU copy; a blocking request still gets the full data
+	var meshed := 0
+	var faces := 0
+	var faces_ok := true
+	var surface_origin = null
+	for origin in origins:
+		if not generator.has_collision_mesh(origin):
+			continue
+		meshed += 1
+		var chunk_faces: PackedVector3Array = generator.get_collision_faces(origin)
+		faces_ok = faces_ok and chunk_faces.size() % 3 == 0
+		faces += chunk_faces.size() / 3
+		if chunk_faces.size() > 0 and surface_origin == null:
+			surface_origin = origin
+	var textures_only = surface_origin != null and not generator.get_chunk_gpu_textures(surface_origin).has_cpu_data
+	var data: Dictionary = generator.generate_chunk_data(surface_origin, false) if surface_origin != null else {}
+	var read_back = data.has("sdf") and data.sdf.size() == size * size * size
+
+	var built: int = stats.collision_meshes_built - before.collision_meshes_built
+	var overflowed: int = stats.collision_overflows - before.collision_overflows
+	var ok = meshed + overflowed == origins.size() and faces > 0 and faces_ok and textures_only and read_back
+	test_results["collision_only"] = ok
+	print("%s %d/%d chunks meshed (%d overflowed), %d triangles" % ["✓" if ok else "✗", meshed, origins.size(), overflowed, faces])
+	print("  meshes built: %d, readback saved: %d KiB, mesh bytes read: %d KiB" % [built,
+		(stats.collision_readback_bytes_saved - before.collision_readback_bytes_saved) / 1024,
+		(stats.collision_bytes_read - before.collision_bytes_read) / 1024])
+
+func test_collision_seams():
+	print("\n--- Test: Collision Seams ---")
+
+	generator.clear_cache()
+	var size = generator.get_chunk_size()
+	# Two columns of three chunks on the chunk_size grid, side by side along X, around the surface
+	var seam_x = 4096 + size
+	var height: float = generator.sample_surface(PackedVector2Array([Vector2(seam_x, 4096 + size / 2)])).heights[0]
+	var surface_y = floori(height / size) * size
+	var origins: Array[Vector3i] = []
+	for x in range(2):
+		for y in range(-1, 2):
+			origins.append(Vector3i(4096 + x * size, surface_y + y * size, 4096))
+	await _generate_collision_chunks(origins)
+
+	# Joined, the meshes are closed inside the block: every edge there belongs to two triangles
+	var edge_uses := {}
+	var meshed := 0
+	for origin in origins:
+		if not generator.has_collision_mesh(origin):
+			continue
+		meshed += 1
+		var faces: PackedVector3Array = generator.get_collision_faces(origin)
+		for i in range(0, faces.size(), 3):
+			for k in range(3):
+				var a: Vector3 = faces[i + k]
+				var b: Vector3 = faces[i + (k + 1) % 3]
+				var edge = [a, b] if a < b else [b, a]
+				edge_uses[edge] = edge_uses.get(edge, 0) + 1
+
+	# Open edges on the block's outside are expected; the mesh reaches one voxel beyond each chunk
+	var inner_min := Vector3(4096, surface_y - size, 4096) + Vector3.ONE
+	var inner_max := Vector3(4096 + 2 * size, surface_y + 2 * size, 4096 + size) - Vector3.ONE
+	var crossing := 0
+	var open := 0
+	for edge in edge_uses:
+		var a: Vector3 = edge[0]
+		var b: Vector3 = edge[1]
+		if minf(a.x, b.x) < seam_x and maxf(a.x, b.x) > seam_x:
+			crossing += 1
+		var inside = a.clamp(inner_min, inner_max) == a and b.clamp(inner_min, inner_max) == b
+		if inside and edge_uses[edge] == 1:
+			open += 1
+
+	var ok = meshed == origins.size() and crossing > 0 and open == 0
+	test_results["collision_seams"] = ok
+	print("%s %d/%d chunks meshed, %d edges across the seam, %d open edges inside" % ["✓" if ok else "✗", meshed, origins.size(), crossing, open])
+
+# Collision-only requests for origins, processed until none is queued or in flight; returns the telemetry
+func _generate_collision_chunks(origins: Array[Vector3i]) -> Dictionary:
+	generator.set_collision_only(true)
+	for origin in origins:
+		generator.enqueue_chunk_request(origin, 0, Vector3.ZERO)
+
+	var frames = 0
+	var stats = generator.get_telemetry()
+	while frames < MAX_FRAMES and (stats.queue_size > 0 or stats.in_flight_chunks > 0):
+		generator.process_chunk_queue(0.016)
+		await get_tree().process_frame
+		stats = generator.get_telemetry()
+		frames += 1
+	generator.set_collision_only(false)
+	return stats
+
+func test_tracing():
+	print("\n--- Test: Tracing ---")
+
+	generator.clear_cache()
+	generator.clear_trace()
+	generator.set_tracing_enabled(true)
+	for i in range(4):
+		generator.generate_chunk_data(Vector3i(-2048 + i * generator.get_chunk_size(), 0, 2048), false)
+	generator.set_tracing_enabled(false)
+
+	var trace = JSON.parse_string(generator.export_trace("user://test_chunk_queue_trace.json"))
+	var names := {}
+	var gpu_thread_named := false
+	if trace is Dictionary:
+		for event in trace.traceEvents:
+			if event.ph == "X":
+				names[event.name] = true
+			elif event.name == "thread_name" and event.args.name == "NativeGPUContext":
+				gpu_thread_named = true
+
+	var expected := ["sync_request_wait", "sdf_batch", "sdf_batch_gpu", "chunk_dispatch_to_complete", "chunk_cache_insert"]
+	var missing := expected.filter(func(span_name): return not names.has(span_name))
+	var ok = trace is Dictionary and missing.is_empty() and gpu_thread_named and not generator.is_tracing_enabled()
+	test_results["tracing"] = ok
+	print("%s %d events, span names: %s" % ["✓" if ok else "✗", generator.get_trace_event_count(), ", ".join(names.keys())])
+	if not missing.is_empty():
+		print("  missing spans: %s" % ", ".join(missing))
+
+func print_test_summary():
+	print("\n=== Test Summary ===")
+	var passed = 0
+	var total = test_results.size()
+
+	for test_name in test_results:
+		var result = test_results[test_name]
+		var status = "✓ PASS" if result else "✗ FAIL"
+		print("%s: %s" % [test_name, status])
+		if result:
+			passed += 1
+
+	print("\nResults: %d/%d tests passed" % [passed, total])
+
+	if passed == total:
+		print("🎉 All tests passed!")
+	else:
+		print("⚠ Some tests failed")
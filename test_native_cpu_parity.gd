@@ -0,0 +1,265 @@
+extends Node
+
+# Compares NativeTerrainGenerator's CPU fallback (CpuTerrainSampler) against biome_gpu_sdf.compute.
+# The CPU path mirrors the shader's hash/noise math, but GPU sin() precision and FMA contraction are
+# driver-defined, so chunks are compared within tolerances instead of bit-exactly.
+
+const CHUNK_ORIGINS: Array[Vector3i] = [
+	Vector3i(0, -32, 0),
+	Vector3i(0, 0, 0),
+	Vector3i(-96, -16, 64),
+	Vector3i(480, -32, -256),
+	Vector3i(-1024, 0, 1024),
+	Vector3i(2048, -32, 2048),
+]
+
+# Blocks below LOD 0 sample every 2^lod voxels; origins are aligned to the block's extent.
+# LOD 5 spans too many biome tiles to make them resident: the shader evaluates its biomes in place.
+const LOD_CHUNKS: Array[Dictionary] = [
+	{"origin": Vector3i(0, -64, 0), "lod": 1},
+	{"origin": Vector3i(-512, -128, 256), "lod": 3},
+	{"origin": Vector3i(-2048, -512, 1024), "lod": 5},
+]
+
+# Past the old fixed map's edge (world_size / 2): the virtual biome map has no bounds
+const FAR_ORIGIN := Vector3i(24576, -32, -20480)
+
+# Fraction of voxels allowed to land on the other side of the surface
+@export var max_sign_mismatch_ratio: float = 0.01
+# Fraction of voxels allowed a different material (ore and slope thresholds amplify tiny SDF differences)
+@export var max_material_mismatch_ratio: float = 0.03
+# Mean absolute SDF difference, in voxels
+@export var max_mean_sdf_error: float = 0.25
+
+var generator: NativeTerrainGenerator
+var test_results: Dictionary = {}
+
+func _ready():
+	print("=== Native CPU/GPU Terrain Parity Test ===")
+
+	if not ClassDB.class_exists("NativeTerrainGenerator"):
+		push_error("NativeTerrainGenerator class not found! Extension may not be loaded.")
+		return
+
+	generator = NativeTerrainGenerator.new()
+
+	test_cpu_generation()
+	test_sample_surface()
+
+	if generator.is_gpu_available():
+		test_gpu_parity()
+		test_biome_tiles()
+		test_ore_and_caves()
+	else:
+		print("⚠ GPU not available, skipping parity comparison (CPU fallback active: %s)" % generator.is_cpu_fallback_active())
+
+	print_test_summary()
+
+func test_cpu_generation():
+	print("\n--- Test: CPU Generation ---")
+
+	var start_us = Time.get_ticks_usec()
+	var data: Dictionary = generator.generate_chunk_data(CHUNK_ORIGINS[0], true)
+	var elapsed_ms = (Time.get_ticks_usec() - start_us) / 1000.0
+
+	var expected = generator.get_chunk_size() * generator.get_chunk_size() * generator.get_chunk_size()
+	var ok = data.has("sdf") and data["sdf"].size() == expected and data["material"].size() == expected
+	test_results["cpu_generation"] = ok
+
+	if ok:
+		print("✓ CPU chunk generated in %.2f ms (%s)" % [elapsed_ms, generator.get_telemetry().get("cpu_simd", "?")])
+	else:
+		push_warning("✗ CPU chunk generation returned no data")
+
+func test_sample_surface():
+	print("\n--- Test: Surface Queries ---")
+
+	# Columns of the two stacked chunks CHUNK_ORIGINS[0] (y -32..-1) and CHUNK_ORIGINS[1] (y 0..31):
+	# the SDF must cross zero between floor(height) and the voxel above it
+	var cs = generator.get_chunk_size()
+	var low: Dictionary = generator.generate_chunk_data(CHUNK_ORIGINS[0], true)
+	var high: Dictionary = generator.generate_chunk_data(CHUNK_ORIGINS[1], true)
+	var base = CHUNK_ORIGINS[0]
+	var positions = PackedVector2Array()
+	for z in range(cs):
+		for x in range(cs):
+			positions.append(Vector2(base.x + x, base.z + z))
+
+	var surface: Dictionary = generator.sample_surface(positions)
+	var biome_ids: PackedInt32Array = surface.get("biome_ids", PackedInt32Array())
+	var edge_distances: PackedFloat32Array = surface.get("edge_distances", PackedFloat32Array())
+	var heights: PackedFloat32Array = surface.get("heights", PackedFloat32Array())
+	var ok = low.has("sdf") and high.has("sdf") and biome_ids.size() == positions.size() and heights.size() == positions.size()
+	if not ok:
+		push_warning("✗ sample_surface() returned no data")
+		test_results["sample_surface"] = false
+		return
+
+	var checked = 0
+	var mismatched = 0
+	for i in range(positions.size()):
+		ok = ok and biome_ids[i] >= 0 and biome_ids[i] < 15 and edge_distances[i] >= 0.0 and edge_distances[i] <= 1.0
+		var y = floori(heights[i])
+		if y < base.y or y + 1 >= base.y + cs * 2:
+			continue
+		checked += 1
+		# Within the root search's precision of an integer height the voxel can be on either side
+		var below = _stacked_sdf(low, high, i % cs, y - base.y, i / cs)
+		var above = _stacked_sdf(low, high, i % cs, y + 1 - base.y, i / cs)
+		if below > 0.01 or above <= -0.01:
+			mismatched += 1
+	ok = ok and checked > 0 and mismatched == 0
+
+	# Biomes alone skip the height search and must agree with the full query
+	var biomes_only: Dictionary = generator.sample_surface(positions, false)
+	ok = ok and biomes_only["biome_ids"] == biome_ids and biomes_only["heights"].is_empty()
+
+	# A prebake-sized batch, spread over the worker pool
+	var batch = PackedVector2Array()
+	for i in range(65536):
+		batch.append(Vector2(float(i % 256) * 31.25 - 4000.0, float(i / 256) * 31.25 - 4000.0))
+	var start_us = Time.get_ticks_usec()
+	var batch_surface: Dictionary = generator.sample_surface(batch)
+	var elapsed_ms = (Time.get_ticks_usec() - start_us) / 1000.0
+	ok = ok and batch_surface["heights"].size() == batch.size()
+
+	print("%s %d/%d columns on the SDF surface, %d points in %.1f ms (%.2f us/point)" % [
+		"✓" if ok else "✗", checked - mismatched, checked, batch.size(), elapsed_ms, elapsed_ms * 1000.0 / batch.size()])
+	test_results["sample_surface"] = ok
+
+func _stacked_sdf(low: Dictionary, high: Dictionary, x: int, y: int, z: int) -> float:
+	var cs = generator.get_chunk_size()
+	var chunk: Dictionary = low if y < cs else high
+	return chunk["sdf"][(z * cs + (y % cs)) * cs + x]
+
+func test_gpu_parity():
+	print("\n--- Test: GPU Parity ---")
+
+	var chunks: Array[Dictionary] = []
+	for origin in CHUNK_ORIGINS:
+		chunks.append({"origin": origin, "lod": 0})
+	chunks.append_array(LOD_CHUNKS)
+
+	var all_ok = true
+	for chunk in chunks:
+		all_ok = _compare_chunk(chunk.origin, chunk.lod) and all_ok
+	all_ok = _compare_chunk(FAR_ORIGIN, 0) and all_ok
+
+	test_results["gpu_parity"] = all_ok
+
+func test_biome_tiles():
+	print("\n--- Test: Virtual Biome Map ---")
+
+	var telemetry: Dictionary = generator.get_telemetry()
+	var resident: int = telemetry.get("biome_tiles_resident", 0)
+	var generated: int = telemetry.get("biome_tiles_generated", 0)
+	var ok = telemetry.get("biome_map_virtual", false) and generated > 0 and resident > 0 and resident <= telemetry.get("biome_tile_capacity", 0)
+	print("%s %d tiles resident, %d generated, %d hits, %d evictions" % [
+		"✓" if ok else "✗", resident, generated, telemetry.get("biome_tile_hits", 0), telemetry.get("biome_tile_evictions", 0)])
+
+	# A new resolution drops every resident tile; both paths must follow it
+	var texel_size: float = generator.get_biome_map_texel_size()
+	generator.set_biome_map_texel_size(texel_size * 2.0)
+	generator.clear_cache()
+	ok = _compare_chunk(CHUNK_ORIGINS[2], 0) and ok
+	generator.set_biome_map_texel_size(texel_size)
+	generator.clear_cache()
+
+	test_results["biome_tiles"] = ok
+
+func test_ore_and_caves():
+	print("\n--- Test: Ore Veins and Caves ---")
+
+	# Denser ore and caves on: both paths carve in the same pass, so they must still agree
+	var ore_threshold: float = generator.ore_threshold
+	generator.ore_threshold = 0.3
+	generator.caves_enabled = true
+	generator.clear_cache()
+
+	var ok = true
+	var carved = 0
+	var filled = 0
+	var ore = 0
+	for origin in [CHUNK_ORIGINS[0], Vector3i(0, -96, 0), Vector3i(-96, -64, 64)]:
+		ok = _compare_chunk(origin, 0) and ok
+		var data: Dictionary = generator.generate_chunk_data(origin, true)
+		var plain: Dictionary = _generate_without_caves(origin)
+		for i in range(data["sdf"].size()):
+			if data["sdf"][i] > 0.0 and plain["sdf"][i] <= 0.0:
+				carved += 1
+			elif data["sdf"][i] < plain["sdf"][i]:
+				filled += 1
+			if data["material"][i] == generator.ore_material_id:
+				ore += 1
+	# Caves only ever remove solid voxels
+	ok = ok and carved > 0 and filled == 0 and ore > 0
+	print("%s %d voxels carved, %d filled, %d ore voxels" % ["✓" if ok else "✗", carved, filled, ore])
+
+	generator.ore_threshold = ore_threshold
+	generator.caves_enabled = false
+	generator.clear_cache()
+
+	test_results["ore_and_caves"] = ok
+
+func _generate_without_caves(origin: Vector3i) -> Dictionary:
+	generator.caves_enabled = false
+	generator.clear_cache()
+	var data: Dictionary = generator.generate_chunk_data(origin, true)
+	generator.caves_enabled = true
+	generator.clear_cache()
+	return data
+
+func _compare_chunk(origin: Vector3i, lod: int) -> bool:
+	var gpu: Dictionary = generator.generate_chunk_data(origin, false, lod)
+	var cpu: Dictionary = generator.generate_chunk_data(origin, true, lod)
+	if not gpu.has("sdf") or not cpu.has("sdf"):
+		push_warning("✗ %s LOD %d: missing chunk data" % [str(origin), lod])
+		return false
+
+	var gpu_sdf: PackedFloat32Array = gpu["sdf"]
+	var cpu_sdf: PackedFloat32Array = cpu["sdf"]
+	var gpu_mat: PackedInt32Array = gpu["material"]
+	var cpu_mat: PackedInt32Array = cpu["material"]
+
+	var count = gpu_sdf.size()
+	var sign_mismatch = 0
+	var material_mismatch = 0
+	var sdf_error_sum = 0.0
+	var sdf_error_max = 0.0
+	for i in range(count):
+		var diff = absf(gpu_sdf[i] - cpu_sdf[i])
+		sdf_error_sum += diff
+		sdf_error_max = maxf(sdf_error_max, diff)
+		if (gpu_sdf[i] > 0.0) != (cpu_sdf[i] > 0.0):
+			sign_mismatch += 1
+		if gpu_mat[i] != cpu_mat[i]:
+			material_mismatch += 1
+
+	var sign_ratio = float(sign_mismatch) / count
+	var material_ratio = float(material_mismatch) / count
+	# Tolerances are in voxels; SDF values are in world units
+	var mean_error = sdf_error_sum / count / float(1 << lod)
+	var ok = sign_ratio <= max_sign_mismatch_ratio and material_ratio <= max_material_mismatch_ratio and mean_error <= max_mean_sdf_error
+
+	print("%s %s LOD %d: mean |dSDF| %.4f, max %.4f, sign mismatch %.3f%%, material mismatch %.3f%%" % [
+		"✓" if ok else "✗", str(origin), lod, mean_error, sdf_error_max, sign_ratio * 100.0, material_ratio * 100.0])
+	return ok
+
+func print_test_summary():
+	print("\n=== Test Summary ===")
+	var passed = 0
+	var total = test_results.size()
+
+	for test_name in test_results:
+		var result = test_results[test_name]
+		var status = "✓ PASS" if result else "✗ FAIL"
+		print("%s: %s" % [test_name, status])
+		if result:
+			passed += 1
+
+	print("\nResults: %d/%d tests passed" % [passed, total])
+
+	if passed == total:
+		print("🎉 All tests passed!")
+	else:
+		print("⚠ CPU fallback diverges from biome_gpu_sdf.compute beyond tolerance")
@@ -0,0 +1,524 @@
+extends Node
+
+# Seed-scoped determinism suite for NativeTerrainGenerator and NativeVegetationDispatcher.
+# A fixed set of seeds and chunk origins goes through every generation path:
+# - Repeating a path (fresh instance or cleared cache) must give the same SHA-256 of SDF and
+#   material, collision faces or placements. The GPU batched queue and the region cache must match
+#   the chunks they are built from.
+# - Alternate paths are compared with their reference within tolerances: the CPU fallback against
+#   biome_gpu_sdf.compute, and the narrow storage modes against STORAGE_FULL.
+# Every path is timed. Run through the CMake `determinism` target or directly:
+#   godot --headless --path . res://test_native_determinism.tscn -- --output=a.json --reference=b.json
+# --output writes the per-seed hashes and timings; --reference compares them with a report written
+# on another machine (e.g. the dedicated server). CPU hashes must match across machines running the
+# same build. GPU hashes only match on the same GPU and driver, so GPU mismatches are reported
+# without failing. Quits with exit code 1 when a check fails. Headless Godot has no RenderingDevice:
+# only the CPU paths run there.
+
+const SEEDS: Array[int] = [0, 12345, 987654321]
+
+# Grid-aligned origins; blocks below LOD 0 sample every 2^lod voxels
+const CHUNKS: Array[Dictionary] = [
+	{"origin": Vector3i(0, -32, 0), "lod": 0},
+	{"origin": Vector3i(0, 0, 0), "lod": 0},
+	{"origin": Vector3i(-96, -32, 64), "lod": 0},
+	{"origin": Vector3i(480, -32, -256), "lod": 0},
+	{"origin": Vector3i(0, -64, 0), "lod": 1},
+	{"origin": Vector3i(-512, -128, 256), "lod": 3},
+]
+
+# Columns whose surface chunks are meshed for collision and populated with vegetation
+const SURFACE_COLUMNS: Array[Vector2] = [Vector2(0, 0), Vector2(480, -256)]
+const VEG_TYPES: Array[int] = [0, 4]  # VegetationManager.VegetationType TREE, GRASS_TUFT
+const PLACEMENT_HEIGHT_RANGE := {"min": -50.0, "max": 200.0}
+
+const ATLAS_BOUNDS := Rect2(-64, -64, 128, 128)
+const ATLAS_PATH := "user://test_determinism_%d.atlas"
+const REGION_CACHE_PATH := "user://test_determinism_regions"
+
+# Device-independent fingerprints: a mismatch against --reference fails the run
+const CPU_PATHS: Array[String] = ["cpu", "cpu_caves", "atlas"]
+
+const STORAGE_HALF := 1  # NativeTerrainGenerator.StorageMode
+const STORAGE_SNORM16 := 2
+const QUANTIZATION_BAND := 8.0  # Voxels from the surface checked against max_quantization_error
+const MAX_FRAMES := 600
+
+# CPU fallback against the GPU, as in test_native_cpu_parity.gd
+@export var max_sign_mismatch_ratio: float = 0.01
+@export var max_material_mismatch_ratio: float = 0.03
+@export var max_mean_sdf_error: float = 0.25
+# Narrow storage modes against STORAGE_FULL, in voxels
+@export var max_quantization_error: float = 0.01
+
+var output_path: String = ""
+var reference_path: String = ""
+
+var gpu_available := false
+var cpu_simd := "?"
+var gpu_status := ""
+var fingerprints: Dictionary = {}  # str(seed) -> path -> hash
+var timings: Dictionary = {}  # path -> {"items": int, "us": int}
+var test_results: Dictionary = {}
+
+func _ready():
+	print("=== Native Determinism Test ===")
+	_parse_args()
+
+	if not ClassDB.class_exists("NativeTerrainGenerator"):
+		push_error("NativeTerrainGenerator class not found! Extension may not be loaded.")
+		get_tree().quit(1)
+		return
+
+	var probe := NativeTerrainGenerator.new()
+	probe.initialize_gpu()
+	gpu_available = probe.is_gpu_available()
+	cpu_simd = probe.get_telemetry().get("cpu_simd", "?")
+	gpu_status = probe.get_gpu_status()
+	probe = null
+	print("GPU: %s, CPU sampler: %s" % [gpu_status, cpu_simd])
+
+	for world_seed in SEEDS:
+		print("\n--- Seed %d ---" % world_seed)
+		fingerprints[str(world_seed)] = {}
+		await _run_seed(world_seed)
+
+	_compare_reference()
+	_write_output()
+	print_test_summary()
+	get_tree().quit(0 if _all_passed() else 1)
+
+func _parse_args():
+	for arg in OS.get_cmdline_user_args():
+		if arg.begins_with("--output="):
+			output_path = arg.trim_prefix("--output=")
+		elif arg.begins_with("--reference="):
+			reference_path = arg.trim_prefix("--reference=")
+
+func _run_seed(world_seed: int) -> void:
+	var cpu := _run_chunks("cpu", _new_generator(world_seed), true)
+	_check_repeat(world_seed, "cpu", cpu, _run_chunks("cpu", _new_generator(world_seed), true))
+
+	var cpu_caves := _run_chunks("cpu_caves", _new_generator(world_seed, false, true), true)
+	_check_repeat(world_seed, "cpu_caves", cpu_caves, _run_chunks("cpu_caves", _new_generator(world_seed, false, true), true))
+
+	_run_atlas(world_seed)
+	await _run_region_cache(world_seed)
+
+	if not gpu_available:
+		print("⚠ GPU not available, skipping GPU, storage mode, batching, collision and placement paths")
+		return
+
+	var generator := _new_generator(world_seed, true)
+	var gpu := _run_chunks("gpu", generator, false)
+	generator.clear_cache()
+	_check_repeat(world_seed, "gpu", gpu, _run_chunks("gpu", generator, false))
+	_check_parity("cpu_gpu_parity", gpu, cpu)
+
+	var caves_generator := _new_generator(world_seed, true, true)
+	var gpu_caves := _run_chunks("gpu_caves", caves_generator, false)
+	caves_generator.clear_cache()
+	_check_repeat(world_seed, "gpu_caves", gpu_caves, _run_chunks("gpu_caves", caves_generator, false))
+	_check_parity("cpu_gpu_caves_parity", gpu_caves, cpu_caves)
+
+	for mode in [STORAGE_HALF, STORAGE_SNORM16]:
+		var path: String = "gpu_half" if mode == STORAGE_HALF else "gpu_snorm16"
+		var narrow_generator := _new_generator(world_seed, true)
+		narrow_generator.set_storage_mode(mode)
+		var narrow := _run_chunks(path, narrow_generator, false)
+		narrow_generator.clear_cache()
+		_check_repeat(world_seed, path, narrow, _run_chunks(path, narrow_generator, false))
+		_check_quantized(path, gpu, narrow)
+
+	await _run_batched(world_seed, gpu)
+	await _run_collision(world_seed)
+	_run_placements(world_seed, generator)
+
+func _new_generator(world_seed: int, use_gpu: bool = false, caves: bool = false) -> NativeTerrainGenerator:
+	var generator := NativeTerrainGenerator.new()
+	generator.set_world_seed(world_seed)
+	generator.caves_enabled = caves
+	# The region cache would serve chunks of earlier runs instead of generating them
+	generator.set_region_cache_path("")
+	if use_gpu:
+		generator.initialize_gpu()
+	return generator
+
+func _run_chunks(path: String, generator: NativeTerrainGenerator, use_cpu: bool) -> Array:
+	var chunks: Array = []
+	var start_us := Time.get_ticks_usec()
+	for chunk in CHUNKS:
+		chunks.append(generator.generate_chunk_data(chunk.origin, use_cpu, chunk.lod))
+	_time(path, CHUNKS.size(), Time.get_ticks_usec() - start_us)
+	return chunks
+
+func _run_batched(world_seed: int, reference: Array) -> void:
+	# Every chunk queued in one frame rides the same batches; they must come out exactly as one-chunk dispatches
+	var generator := _new_generator(world_seed, true)
+	var start_us := Time.get_ticks_usec()
+	for chunk in CHUNKS:
+		generator.enqueue_chunk_request(chunk.origin, chunk.lod, Vector3.ZERO)
+	await _drain_queue(generator)
+	# Includes the frames waited for, like a streaming client would
+	_time("gpu_batched", CHUNKS.size(), Time.get_ticks_usec() - start_us)
+
+	var chunks: Array = []
+	for chunk in CHUNKS:
+		chunks.append(generator.generate_chunk_data(chunk.origin, false, chunk.lod))
+	var expected := _hash_chunks(reference)
+	var batched := _hash_chunks(chunks)
+	_record("gpu_batched", not batched.is_empty() and batched == expected,
+		"%s %s one-chunk dispatches" % [batched, "matches" if batched == expected else "differs from"])
+
+func _run_region_cache(world_seed: int) -> void:
+	if not ClassDB.class_exists("VoxelBuffer"):
+		print("⚠ VoxelBuffer class not found, skipping region cache path")
+		return
+
+	# Blocks come from the GPU or, without one, the CPU fallback; a second generator must load them unchanged
+	_remove_dir_recursive(ProjectSettings.globalize_path(REGION_CACHE_PATH))
+	var origins := _lod0_origins()
+	var writer := _new_generator(world_seed)
+	writer.set_region_cache_path(REGION_CACHE_PATH)
+	var generated := _generate_blocks("region_generate", writer, origins)
+	# GPU chunks are written after their waiters are released
+	var frames := 0
+	while frames < MAX_FRAMES and writer.get_telemetry().region_writes < origins.size():
+		await get_tree().process_frame
+		frames += 1
+
+	var reader := _new_generator(world_seed)
+	reader.set_region_cache_path(REGION_CACHE_PATH)
+	var loaded := _generate_blocks("region_cache", reader, origins)
+	var hits: int = reader.get_telemetry().region_hits
+	var expected := _hash_chunks(generated)
+	var cached := _hash_chunks(loaded)
+	_record("region_cache", hits == origins.size() and not cached.is_empty() and cached == expected,
+		"%s from %d/%d region hits %s the generated blocks" % [cached, hits, origins.size(), "matches" if cached == expected else "differs from"])
+	writer = null
+	reader = null
+	_remove_dir_recursive(ProjectSettings.globalize_path(REGION_CACHE_PATH))
+
+func _generate_blocks(path: String, generator: NativeTerrainGenerator, origins: Array[Vector3i]) -> Array:
+	var cs := generator.get_chunk_size()
+	var buffer = ClassDB.instantiate("VoxelBuffer")
+	buffer.create(cs, cs, cs)
+	var chunks: Array = []
+	var elapsed_us := 0
+	for origin in origins:
+		var start_us := Time.get_ticks_usec()
+		generator.generate_block(buffer, origin, 0)
+		elapsed_us += Time.get_ticks_usec() - start_us
+		chunks.append(_read_buffer(buffer, cs))
+	_time(path, origins.size(), elapsed_us)
+	return chunks
+
+func _read_buffer(buffer, cs: int) -> Dictionary:
+	# Texel order of generate_chunk_data(); CHANNEL_SDF = 1, CHANNEL_INDICES = 3
+	var sdf := PackedFloat32Array()
+	var material := PackedInt32Array()
+	sdf.resize(cs * cs * cs)
+	material.resize(cs * cs * cs)
+	var i := 0
+	for z in range(cs):
+		for y in range(cs):
+			for x in range(cs):
+				sdf[i] = buffer.get_voxel_f(x, y, z, 1)
+				material[i] = buffer.get_voxel(x, y, z, 3)
+				i += 1
+	return {"sdf": sdf, "material": material}
+
+func _run_collision(world_seed: int) -> void:
+	var hashes: Array[String] = []
+	var triangles := 0
+	for run in range(2):
+		var generator := _new_generator(world_seed, true)
+		generator.set_collision_only(true)
+		var origins := _surface_origins(generator)
+		var start_us := Time.get_ticks_usec()
+		for origin in origins:
+			generator.enqueue_chunk_request(origin, 0, Vector3.ZERO)
+		await _drain_queue(generator)
+		_time("collision", origins.size(), Time.get_ticks_usec() - start_us)
+
+		var ctx := HashingContext.new()
+		ctx.start(HashingContext.HASH_SHA256)
+		for origin in origins:
+			var faces: PackedVector3Array = generator.get_collision_faces(origin)
+			ctx.update(var_to_bytes(faces.size()))
+			if not faces.is_empty():
+				ctx.update(faces.to_byte_array())
+			triangles += faces.size() / 3 if run == 0 else 0
+		hashes.append(ctx.finish().hex_encode().left(16))
+
+	fingerprints[str(world_seed)]["collision"] = hashes[0]
+	_record("collision", triangles > 0 and hashes[0] == hashes[1],
+		"%s, %d triangles, repeated run %s" % [hashes[0], triangles, "matches" if hashes[0] == hashes[1] else "differs (%s)" % hashes[1]])
+
+func _run_placements(world_seed: int, generator: NativeTerrainGenerator) -> void:
+	if not ClassDB.class_exists("NativeVegetationDispatcher"):
+		print("⚠ NativeVegetationDispatcher class not found, skipping placement path")
+		return
+	var dispatcher := NativeVegetationDispatcher.new()
+	if not dispatcher.initialize_gpu():
+		print("⚠ NativeVegetationDispatcher GPU unavailable, skipping placement path")
+		return
+
+	# Placements read the terrain from the generator's cache through the shared context
+	var origins := _surface_origins(generator)
+	for origin in origins:
+		generator.generate_chunk_data(origin, false)
+
+	var hashes: Array[String] = []
+	var placements := 0
+	for run in range(2):
+		dispatcher.clear_cache()
+		var ctx := HashingContext.new()
+		ctx.start(HashingContext.HASH_SHA256)
+		var start_us := Time.get_ticks_usec()
+		for origin in origins:
+			for veg_type in VEG_TYPES:
+				var result: Array = dispatcher.generate_placements(origin, veg_type, 0.8, 2.0, 0.1, 30.0, PLACEMENT_HEIGHT_RANGE, world_seed, RID())
+				ctx.update(var_to_bytes(result))
+				placements += result.size() if run == 0 else 0
+		_time("placements", origins.size() * VEG_TYPES.size(), Time.get_ticks_usec() - start_us)
+		hashes.append(ctx.finish().hex_encode().left(16))
+
+	fingerprints[str(world_seed)]["placements"] = hashes[0]
+	_record("placements", placements > 0 and hashes[0] == hashes[1],
+		"%s, %d placements, repeated run %s" % [hashes[0], placements, "matches" if hashes[0] == hashes[1] else "differs (%s)" % hashes[1]])
+
+func _run_atlas(world_seed: int) -> void:
+	if not ClassDB.class_exists("NativeVegetationDispatcher"):
+		return
+
+	# CPU only, like the prebake on a dedicated server
+	var dispatcher := NativeVegetationDispatcher.new()
+	var generator := _new_generator(world_seed)
+	var passes: Array = []
+	for native_biome in range(15):
+		for type in [0, 1]:
+			passes.append({"native_biome": native_biome, "biome": native_biome, "type": type, "variants": 3,
+				"density": 0.6, "grid_spacing": 2.0 + type * 2.0, "noise_frequency": 0.1,
+				"slope_max": 60.0, "height_min": -200.0, "height_max": 400.0})
+
+	var hashes: Array[String] = []
+	var instances := 0
+	for run in range(2):
+		var path := ATLAS_PATH % run
+		var start_us := Time.get_ticks_usec()
+		var result: Dictionary = dispatcher.prebake_atlas(generator, path, ATLAS_BOUNDS, passes, world_seed)
+		_time("atlas", result.get("chunks", 0), Time.get_ticks_usec() - start_us)
+		instances = result.get("instances", 0)
+		var bytes := FileAccess.get_file_as_bytes(path)
+		hashes.append(_hash_bytes(bytes) if result.get("ok", false) and not bytes.is_empty() else "")
+		DirAccess.remove_absolute(ProjectSettings.globalize_path(path))
+
+	fingerprints[str(world_seed)]["atlas"] = hashes[0]
+	_record("atlas", not hashes[0].is_empty() and hashes[0] == hashes[1],
+		"%s, %d instances, repeated bake %s" % [hashes[0], instances, "matches" if hashes[0] == hashes[1] else "differs (%s)" % hashes[1]])
+
+func _drain_queue(generator: NativeTerrainGenerator) -> void:
+	var frames := 0
+	var stats: Dictionary = generator.get_telemetry()
+	while frames < MAX_FRAMES and (stats.queue_size > 0 or stats.in_flight_chunks > 0):
+		generator.process_chunk_queue(0.016)
+		await get_tree().process_frame
+		stats = generator.get_telemetry()
+		frames += 1
+
+func _lod0_origins() -> Array[Vector3i]:
+	var origins: Array[Vector3i] = []
+	for chunk in CHUNKS:
+		if chunk.lod == 0:
+			origins.append(chunk.origin)
+	return origins
+
+# The chunk holding each column's surface and the ones above and below it
+func _surface_origins(generator: NativeTerrainGenerator) -> Array[Vector3i]:
+	var cs := generator.get_chunk_size()
+	var heights: PackedFloat32Array = generator.sample_surface(PackedVector2Array(SURFACE_COLUMNS)).heights
+	var origins: Array[Vector3i] = []
+	for i in range(SURFACE_COLUMNS.size()):
+		var surface_y := floori(heights[i] / cs) * cs
+		for y in range(-1, 2):
+			origins.append(Vector3i(int(SURFACE_COLUMNS[i].x), surface_y + y * cs, int(SURFACE_COLUMNS[i].y)))
+	return origins
+
+func _hash_chunks(chunks: Array) -> String:
+	var ctx := HashingContext.new()
+	ctx.start(HashingContext.HASH_SHA256)
+	for data in chunks:
+		if not data.has("sdf"):
+			return ""
+		ctx.update(data.sdf.to_byte_array())
+		ctx.update(data.material.to_byte_array())
+	return ctx.finish().hex_encode().left(16)
+
+func _hash_bytes(bytes: PackedByteArray) -> String:
+	var ctx := HashingContext.new()
+	ctx.start(HashingContext.HASH_SHA256)
+	ctx.update(bytes)
+	return ctx.finish().hex_encode().left(16)
+
+func _check_repeat(world_seed: int, path: String, first: Array, second: Array):
+	var expected := _hash_chunks(first)
+	var repeated := _hash_chunks(second)
+	fingerprints[str(world_seed)][path] = expected
+	_record(path, not expected.is_empty() and expected == repeated,
+		"%s, repeated run %s" % [expected, "matches" if expected == repeated else "differs (%s)" % repeated])
+
+func _check_parity(path: String, reference: Array, candidate: Array):
+	var voxels := 0
+	var sign_mismatch := 0
+	var material_mismatch := 0
+	var error_sum := 0.0
+	for i in range(CHUNKS.size()):
+		if not reference[i].has("sdf") or not candidate[i].has("sdf"):
+			_record(path, false, "missing chunk data at %s" % str(CHUNKS[i].origin))
+			return
+		var ref_sdf: PackedFloat32Array = reference[i].sdf
+		var sdf: PackedFloat32Array = candidate[i].sdf
+		var ref_mat: PackedInt32Array = reference[i].material
+		var mat: PackedInt32Array = candidate[i].material
+		# Tolerances are in voxels; SDF values are in world units
+		var voxel_scale := 1.0 / float(1 << CHUNKS[i].lod)
+		for j in range(ref_sdf.size()):
+			error_sum += absf(ref_sdf[j] - sdf[j]) * voxel_scale
+			if (ref_sdf[j] > 0.0) != (sdf[j] > 0.0):
+				sign_mismatch += 1
+			if ref_mat[j] != mat[j]:
+				material_mismatch += 1
+		voxels += ref_sdf.size()
+
+	var sign_ratio := float(sign_mismatch) / voxels
+	var material_ratio := float(material_mismatch) / voxels
+	var mean_error := error_sum / voxels
+	_record(path, sign_ratio <= max_sign_mismatch_ratio and material_ratio <= max_material_mismatch_ratio and mean_error <= max_mean_sdf_error,
+		"mean |dSDF| %.4f voxels, sign mismatch %.3f%%, material mismatch %.3f%%" % [mean_error, sign_ratio * 100.0, material_ratio * 100.0])
+
+func _check_quantized(path: String, reference: Array, candidate: Array):
+	# Same shader, narrower texels: materials are exact and near-surface SDF is within the format's step
+	var material_mismatch := 0
+	var max_error := 0.0
+	for i in range(CHUNKS.size()):
+		if not reference[i].has("sdf") or not candidate[i].has("sdf"):
+			_record(path + "_quantization", false, "missing chunk data at %s" % str(CHUNKS[i].origin))
+			return
+		var ref_sdf: PackedFloat32Array = reference[i].sdf
+		var sdf: PackedFloat32Array = candidate[i].sdf
+		var ref_mat: PackedInt32Array = reference[i].material
+		var mat: PackedInt32Array = candidate[i].material
+		var voxel_scale := 1.0 / float(1 << CHUNKS[i].lod)
+		for j in range(ref_sdf.size()):
+			if ref_mat[j] != mat[j]:
+				material_mismatch += 1
+			if absf(ref_sdf[j]) * voxel_scale < QUANTIZATION_BAND:
+				max_error = maxf(max_error, absf(ref_sdf[j] - sdf[j]) * voxel_scale)
+	_record(path + "_quantization", material_mismatch == 0 and max_error <= max_quantization_error,
+		"max near-surface |dSDF| %.5f voxels, %d material mismatches against STORAGE_FULL" % [max_error, material_mismatch])
+
+func _compare_reference():
+	if reference_path.is_empty():
+		return
+	print("\n--- Reference: %s ---" % reference_path)
+
+	var reference = JSON.parse_string(FileAccess.get_file_as_string(reference_path))
+	if not reference is Dictionary or not reference.has("fingerprints"):
+		_record("reference", false, "cannot read %s" % reference_path)
+		return
+	print("Reference GPU: %s, CPU sampler: %s" % [reference.get("gpu", "?"), reference.get("cpu_simd", "?")])
+
+	var compared := 0
+	var mismatched: Array[String] = []
+	for seed_key in fingerprints:
+		var theirs: Dictionary = reference.fingerprints.get(seed_key, {})
+		for path in fingerprints[seed_key]:
+			if not theirs.has(path):
+				continue
+			compared += 1
+			if theirs[path] == fingerprints[seed_key][path]:
+				continue
+			if path in CPU_PATHS:
+				mismatched.append("%s/%s" % [seed_key, path])
+			else:
+				print("⚠ seed %s %s differs from the reference (device dependent): %s vs %s" % [seed_key, path, fingerprints[seed_key][path], theirs[path]])
+	_record("reference", compared > 0 and mismatched.is_empty(),
+		"%d fingerprints compared, CPU mismatches: %s" % [compared, ", ".join(PackedStringArray(mismatched)) if not mismatched.is_empty() else "none"])
+
+func _write_output():
+	if output_path.is_empty():
+		return
+	var timing_report := {}
+	for path in timings:
+		timing_report[path] = {"items": timings[path].items, "total_ms": timings[path].us / 1000.0, "per_item_ms": _per_item_ms(path)}
+	var report := {
+		"gpu": gpu_status if gpu_available else "",
+		"cpu_simd": cpu_simd,
+		"seeds": SEEDS,
+		"fingerprints": fingerprints,
+		"timings": timing_report,
+		"passed": _all_passed(),
+	}
+	var file := FileAccess.open(output_path, FileAccess.WRITE)
+	if file == null:
+		push_error("Cannot write determinism report to %s" % output_path)
+		return
+	file.store_string(JSON.stringify(report, "  "))
+	print("Report written to %s" % output_path)
+
+func _time(path: String, items: int, elapsed_us: int):
+	var entry: Dictionary = timings.get(path, {"items": 0, "us": 0})
+	entry.items += items
+	entry.us += elapsed_us
+	timings[path] = entry
+
+func _per_item_ms(path: String) -> float:
+	return timings[path].us / 1000.0 / max(timings[path].items, 1)
+
+func _record(path: String, ok: bool, detail: String):
+	test_results[path] = test_results.get(path, true) and ok
+	if ok:
+		print("✓ %s: %s" % [path, detail])
+	else:
+		push_warning("✗ %s: %s" % [path, detail])
+
+# The region cache keeps one directory per terrain signature
+func _remove_dir_recursive(path: String):
+	var dir := DirAccess.open(path)
+	if dir == null:
+		return
+	for file in dir.get_files():
+		dir.remove(file)
+	for sub in dir.get_directories():
+		_remove_dir_recursive(path.path_join(sub))
+	DirAccess.remove_absolute(path)
+
+func _all_passed() -> bool:
+	for test_name in test_results:
+		if not test_results[test_name]:
+			return false
+	return not test_results.is_empty()
+
+func print_test_summary():
+	print("\n=== Timings ===")
+	for path in timings:
+		print("%s: %d items, %.3f ms each" % [path, timings[path].items, _per_item_ms(path)])
+
+	print("\n=== Test Summary ===")
+	var passed = 0
+	var total = test_results.size()
+
+	for test_name in test_results:
+		var result = test_results[test_name]
+		var status = "✓ PASS" if result else "✗ FAIL"
+		print("%s: %s" % [test_name, status])
+		if result:
+			passed += 1
+
+	print("\nResults: %d/%d tests passed" % [passed, total])
+
+	if passed == total:
+		print("🎉 All tests passed!")
+	else:
+		print("⚠ Generation paths are not deterministic for every seed")
@@ -19,9 +19,16 @@ func _ready():
 	print("✓ NativeVegetationDispatcher instantiated successfully")
 	
 	test_gpu_initialization()
+	test_shared_gpu_context()
+	test_shader_cache()
 	test_cache_configuration()
 	test_placement_generation()
 	test_cache_behavior()
+	test_async_queue()
+	test_packed_arrays()
+	test_edit_invalidation()
+	test_prebake_atlas()
+	test_gpu_culler()
 	test_telemetry()
 	
 	print_test_summary()
@@ -37,6 +44,58 @@ func test_gpu_initialization():
 	else:
 		push_warning("✗ GPU initialization failed")
 
+func test_shared_gpu_context():
+	print("\n--- Test: Shared GPU Context ---")
+	
+	if not ClassDB.class_exists("NativeTerrainGenerator"):
+		push_warning("✗ NativeTerrainGenerator class not found")
+		test_results["shared_gpu_context"] = false
+		return
+	
+	# Both classes join one device: the generator's context telemetry counts every client
+	var generator = NativeTerrainGenerator.new()
+	var telemetry: Dictionary = generator.get_telemetry()
+	var context: Dictionary = telemetry.get("gpu_context", {})
+	print("GPU context: %s" % str(context))
+	
+	var ok: bool
+	if generator.is_gpu_available() and test_results.get("gpu_init", false):
+		ok = context.get("clients", 0) >= 2 and context.get("has_biome_map", false)
+	else:
+		ok = telemetry.has("gpu_context") and native_dispatcher.get_telemetry().has("shared_terrain_passes")
+	
+	generator = null
+	test_results["shared_gpu_context"] = ok
+	
+	if ok:
+		print("✓ Terrain and vegetation share one GPU context")
+	else:
+		push_warning("✗ Shared GPU context state unexpected")
+
+func test_shader_cache():
+	print("\n--- Test: Shader Cache ---")
+	
+	if not ClassDB.class_exists("NativeTerrainGenerator") or not test_results.get("gpu_init", false):
+		print("⚠ GPU not available, skipping shader cache test")
+		return
+	
+	# The dispatcher keeps the context alive; a second generator finds its SPIR-V already compiled
+	var generator = NativeTerrainGenerator.new()
+	var before: Dictionary = generator.get_telemetry().get("gpu_context", {})
+	generator = null
+	var start_us = Time.get_ticks_usec()
+	generator = NativeTerrainGenerator.new()
+	var init_ms = (Time.get_ticks_usec() - start_us) / 1000.0
+	var after: Dictionary = generator.get_telemetry().get("gpu_context", {})
+	generator = null
+	
+	var hits = after.get("shader_cache_memory_hits", 0) - before.get("shader_cache_memory_hits", 0)
+	var compiles = after.get("shader_compiles", 0) - before.get("shader_compiles", 0)
+	var ok = hits >= 2 and compiles == 0
+	test_results["shader_cache"] = ok
+	print("%s Generator re-created in %.2f ms: %d cached shaders, %d compiled" % ["✓" if ok else "✗", init_ms, hits, compiles])
+	print("  total: %d compiled (%.2f ms), %d from disk, create %.2f ms" % [after.get("shader_compiles", 0), after.get("shader_compile_ms", 0.0), after.get("shader_cache_disk_hits", 0), after.get("shader_create_ms", 0.0)])
+
 func test_cache_configuration():
 	print("\n--- Test: Cache Configuration ---")
 	
@@ -46,9 +105,13 @@ func test_cache_configuration():
 	native_dispatcher.set_max_cache_entries(100)
 	var new_max = native_dispatcher.get_max_cache_entries()
 	
-	test_results["cache_config"] = (new_max == 100)
+	native_dispatcher.set_max_cache_bytes(16 * 1024 * 1024)
+	var new_max_bytes = native_dispatcher.get_max_cache_bytes()
+	print("Max cache bytes: %d (in use: %d)" % [new_max_bytes, native_dispatcher.get_cache_bytes()])
 	
-	if new_max == 100:
+	test_results["cache_config"] = (new_max == 100 and new_max_bytes == 16 * 1024 * 1024)
+	
+	if test_results["cache_config"]:
 		print("✓ Cache configuration works correctly")
 	else:
 		push_warning("✗ Cache configuration failed")
@@ -115,6 +178,188 @@ func test_cache_behavior():
 	else:
 		push_warning("✗ Cache clear failed")
 
+func test_async_queue():
+	print("\n--- Test: Async Placement Queue ---")
+	
+	var chunk = Vector3i(32, 0, 32)
+	var type = 0
+	
+	# Without a biome map / terrain SDF the request is rejected up front instead of queued
+	var queued = native_dispatcher.enqueue_placement_request(
+		chunk, type, 0.5, 4.0, 0.1, 45.0, {"min": 0.0, "max": 100.0}, 12345, RID(), 10.0)
+	var pending = native_dispatcher.is_request_pending(chunk, type)
+	var ready: Array = native_dispatcher.poll_ready_placements()
+	var telemetry: Dictionary = native_dispatcher.get_telemetry()
+	
+	print("Queued: %s, pending: %s, ready: %d" % [queued, pending, ready.size()])
+	print("Queue telemetry: %s" % str(telemetry))
+	
+	var ok = not queued and not pending and ready.is_empty() and telemetry.has("queue_size") and telemetry.has("batches_submitted")
+	test_results["async_queue"] = ok
+	
+	if ok:
+		print("✓ Async queue rejects incomplete requests and polls cleanly")
+	else:
+		push_warning("✗ Async queue state unexpected")
+
+func test_packed_arrays():
+	print("\n--- Test: Packed Placement Arrays ---")
+	
+	var chunk = Vector3i(64, 0, 64)
+	var type = 2
+	
+	# Nothing generated for this pair: both packed views come back empty without touching the GPU
+	var arrays: Dictionary = native_dispatcher.get_placement_arrays(chunk, type)
+	var mm_buffer: PackedFloat32Array = native_dispatcher.get_multimesh_buffer(chunk, type)
+	var generated: Dictionary = native_dispatcher.generate_placement_arrays(
+		chunk, type, 0.5, 4.0, 0.1, 45.0, {"min": 0.0, "max": 100.0}, 12345, RID())
+	
+	print("Arrays: %d keys, MultiMesh floats: %d, generated: %d keys" % [arrays.size(), mm_buffer.size(), generated.size()])
+	
+	if generated.has("positions"):
+		var positions: PackedVector3Array = generated["positions"]
+		print("Generated %d packed placements" % positions.size())
+	
+	var ok = arrays.is_empty() and mm_buffer.is_empty()
+	test_results["packed_arrays"] = ok
+	
+	if ok:
+		print("✓ Packed placement API handles uncached pairs")
+	else:
+		push_warning("✗ Packed placement API returned data for an uncached pair")
+
+func test_edit_invalidation():
+	print("\n--- Test: Edit Invalidation ---")
+	
+	var chunk = Vector3i(96, 0, 96)
+	var type = 1
+	
+	# Nothing cached around the edit: no pair is touched, marked dirty or queued again
+	var region = AABB(Vector3(100, 4, 100), Vector3(6, 6, 6))
+	var touched: Array = native_dispatcher.invalidate_region(region)
+	var touched_list: Array = native_dispatcher.invalidate_chunks([chunk], false)
+	var dirty = native_dispatcher.is_chunk_dirty(chunk, type)
+	var pending = native_dispatcher.is_request_pending(chunk, type)
+	var telemetry: Dictionary = native_dispatcher.get_telemetry()
+	
+	print("Touched: %d (region), %d (list), dirty: %s, pending: %s" % [touched.size(), touched_list.size(), dirty, pending])
+	
+	var ok = touched.is_empty() and touched_list.is_empty() and not dirty and not pending and telemetry.has("invalidated_entries") and telemetry.has("edit_reruns")
+	test_results["edit_invalidation"] = ok
+	
+	if ok:
+		print("✓ Invalidation leaves uncached regions alone")
+	else:
+		push_warning("✗ Invalidation touched an uncached region")
+
+func test_prebake_atlas():
+	print("\n--- Test: Prebake Atlas ---")
+	
+	if not ClassDB.class_exists("NativeTerrainGenerator") or not ClassDB.class_exists("NativeVegetationAtlas"):
+		push_warning("✗ NativeTerrainGenerator / NativeVegetationAtlas class not found")
+		test_results["prebake_atlas"] = false
+		return
+	
+	# CPU only: runs on headless machines too
+	var generator = NativeTerrainGenerator.new()
+	generator.set_world_seed(4242)
+	var passes: Array = []
+	for native_biome in range(15):
+		for type in [0, 1]:
+			passes.append({"native_biome": native_biome, "biome": native_biome, "type": type, "variants": 3,
+				"density": 0.6, "grid_spacing": 2.0 + type * 2.0, "noise_frequency": 0.1,
+				"slope_max": 60.0, "height_min": -200.0, "height_max": 400.0})
+	var bounds = Rect2(-128, -96, 256, 192)
+	var path_a = "user://test_vegetation_a.atlas"
+	var path_b = "user://test_vegetation_b.atlas"
+	var result: Dictionary = native_dispatcher.prebake_atlas(generator, path_a, bounds, passes, 4242)
+	var result_b: Dictionary = native_dispatcher.prebake_atlas(generator, path_b, bounds, passes, 4242)
+	var progress: Dictionary = native_dispatcher.get_prebake_progress()
+	generator = null
+	print("Prebake: %d chunks, %d groups, %d instances, %d bytes in %.1f ms" % [result.get("chunks", 0), result.get("groups", 0), result.get("instances", 0), result.get("bytes", 0), result.get("elapsed_ms", 0.0)])
+	
+	# Same seed and passes: byte-identical files
+	var deterministic = result.get("ok", false) and result_b.get("ok", false) and FileAccess.get_file_as_bytes(path_a) == FileAccess.get_file_as_bytes(path_b)
+	
+	var atlas = NativeVegetationAtlas.new()
+	var opened = atlas.open(path_a)
+	var group_total = 0
+	var buffers_ok = opened and atlas.get_world_seed() == 4242 and atlas.get_bounds() == bounds
+	for group in atlas.get_groups():
+		var count: int = group["instance_count"]
+		group_total += count
+		var buffer: PackedFloat32Array = atlas.get_group_buffer(group["biome"], group["type"], group["variant"])
+		var region: PackedFloat32Array = atlas.get_region_buffer(group["biome"], group["type"], group["variant"], bounds)
+		buffers_ok = buffers_ok and buffer.size() == count * 12 and region == buffer
+		for i in range(0, buffer.size(), 12):
+			buffers_ok = buffers_ok and bounds.grow(32.0).has_point(Vector2(buffer[i + 3], buffer[i + 11]))
+	atlas.close()
+	DirAccess.remove_absolute(ProjectSettings.globalize_path(path_a))
+	DirAccess.remove_absolute(ProjectSettings.globalize_path(path_b))
+	
+	var ok = deterministic and buffers_ok and result.get("instances", 0) > 0 and group_total == result.get("instances", -1) and progress.get("done", -1) == result.get("chunks", 0)
+	test_results["prebake_atlas"] = ok
+	
+	if ok:
+		print("✓ Atlas is deterministic and its buffers match its tables")
+	else:
+		push_warning("✗ Atlas prebake unexpected (deterministic: %s, buffers: %s, %d/%d instances)" % [deterministic, buffers_ok, group_total, result.get("instances", 0)])
+
+func test_gpu_culler():
+	print("\n--- Test: GPU Culler ---")
+	
+	if not ClassDB.class_exists("NativeVegetationCuller"):
+		push_warning("✗ NativeVegetationCuller class not found")
+		test_results["gpu_culler"] = false
+		return
+	
+	var culler = NativeVegetationCuller.new()
+	if RenderingServer.get_rendering_device() == null:
+		# Compatibility renderer / headless: the culler must refuse cleanly
+		test_results["gpu_culler"] = not culler.initialize() and culler.create_bucket([], PackedFloat32Array(), 1, 1.0) == -1
+		print("Skipped (no renderer RenderingDevice)")
+		return
+	
+	var multimeshes: Array = []
+	for size in [1.0, 2.0]:
+		var mm = MultiMesh.new()
+		mm.transform_format = MultiMesh.TRANSFORM_3D
+		var box = BoxMesh.new()
+		box.size = Vector3.ONE * size
+		mm.mesh = box
+		multimeshes.append(mm)
+	
+	var ok = culler.initialize()
+	var rejected = culler.create_bucket(multimeshes, PackedFloat32Array([64.0]), 256, 1.0) == -1
+	var bucket: int = culler.create_bucket(multimeshes, PackedFloat32Array([64.0, 128.0]), 256, 1.0, 64.0, 0.5)
+	
+	var transforms = PackedFloat32Array()
+	for i in range(100):
+		transforms.append_array([1.0, 0.0, 0.0, float(i), 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, float(i % 10)])
+	culler.set_chunk(bucket, Vector3i.ZERO, transforms)
+	culler.set_chunk(bucket, Vector3i.ZERO, transforms)  # Replaces, does not add
+	var count_after_set: int = culler.get_bucket_instance_count(bucket)
+	
+	var camera = Camera3D.new()
+	add_child(camera)
+	camera.look_at_from_position(Vector3(50, 20, 50), Vector3.ZERO)
+	culler.cull(camera)
+	RenderingServer.force_sync()
+	var telemetry: Dictionary = culler.get_telemetry()
+	camera.queue_free()
+	
+	culler.remove_chunk_all(Vector3i.ZERO)
+	var count_after_remove: int = culler.get_bucket_instance_count(bucket)
+	culler.free_bucket(bucket)
+	
+	ok = ok and rejected and bucket >= 0 and count_after_set == 100 and count_after_remove == 0 and telemetry.get("chunks", 0) == 1 and telemetry.get("frames_culled", 0) >= 1
+	test_results["gpu_culler"] = ok
+	
+	if ok:
+		print("✓ Culler tracks chunks and records a frame (%d dispatches)" % telemetry.get("last_dispatches", 0))
+	else:
+		push_warning("✗ Culler unexpected (bucket: %d, counts: %d/%d, telemetry: %s)" % [bucket, count_after_set, count_after_remove, str(telemetry)])
+
 func test_telemetry():
 	print("\n--- Test: Telemetry ---")
 	